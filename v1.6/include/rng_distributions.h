@@ -9,11 +9,18 @@ namespace ua {
 struct ZigguratNormal {
   static void ensure_init() noexcept;
   static double sample(std::uint64_t u, double u01, double extra_u01) noexcept;
+  // Everything past the rectangle test (tail, wedge, Box–Muller fallback);
+  // the SIMD kernels queue the lanes that miss their rectangle and finish
+  // them here.
+  static double sample_slow(std::uint64_t u, double u01, double extra_u01) noexcept;
 
   // Expose read-only table pointers for SIMD gathers
   static const double*      table_x() noexcept; // size 257
-  static const double*      table_y() noexcept; // size 256
+  static const double*      table_y() noexcept; // size 257
   static const std::uint32_t* table_k() noexcept; // size 256
+
+private:
+  static void init_once();
 };
 
 } // namespace ua
@@ -1,4 +1,5 @@
 #include "rng_distributions.h"
+#include "rng_common.h"
 #include <atomic>
 #include <array>
 #include <cmath>
@@ -10,64 +11,80 @@ namespace ua {
 
 // Based on Marsaglia & Tsang Ziggurat; compute tables at startup.
 static std::once_flag zig_init_flag;
-static alignas(64) std::array<double, 257> zig_x; // x[0..256]
-static alignas(64) std::array<double, 256> zig_y; // y[0..255]
-static alignas(64) std::array<std::uint32_t, 256> zig_k; // acceptance thresholds
+alignas(64) static std::array<double, 257> zig_x; // x[0..256]
+alignas(64) static std::array<double, 257> zig_y; // y[0..256]
+alignas(64) static std::array<std::uint32_t, 256> zig_k; // acceptance thresholds
 
 static inline double pdf(double x) { return std::exp(-0.5 * x*x); }
 
 void ZigguratNormal::init_once() {
-  // Constants chosen per standard references; precompute a 256-layer table.
-  const double R = 3.442619855899;
-  zig_x[0]   = R;
-  zig_y[0]   = pdf(R);
+  // Marsaglia & Tsang's 256 layers of area A under exp(-x^2/2): x[1] = R,
+  // x[i+1] from x[i] outward-in, x[256] = 0. Layer 0 is the base strip
+  // plus the tail, as a rectangle of width A / pdf(R) > R; its
+  // rejections go to the tail beyond R.
+  const double R = 3.6541528853610088;
+  const double A = 0.00492867323399;
+  zig_x[0]   = A / pdf(R);
+  zig_x[1]   = R;
   zig_x[256] = 0.0;
-
-  // Area per rectangle (target total area under the curve split in 256)
-  const double A = 0.00492867323399; // empirically tuned constant for 256 layers
-
-  for (int i = 255; i >= 1; --i) {
-    zig_x[i] = std::sqrt(-2.0 * std::log(A / zig_x[i+1] + pdf(zig_x[i+1])));
-  }
-  for (int i = 0; i < 256; ++i) zig_y[i] = pdf(zig_x[i]);
-  for (int i = 0; i < 256; ++i) zig_k[i] = static_cast<std::uint32_t>((zig_x[i+1] / zig_x[i]) * 4294967296.0);
+  for (int i = 1; i < 255; ++i) zig_x[i+1] = std::sqrt(-2.0 * std::log(A / zig_x[i] + pdf(zig_x[i])));
+  for (int i = 0; i < 257; ++i) zig_y[i] = pdf(zig_x[i]);
+  // thresholds on the 23-bit draw uu = floor(u01 * 2^23) that sample() compares them to
+  for (int i = 0; i < 256; ++i) zig_k[i] = static_cast<std::uint32_t>((zig_x[i+1] / zig_x[i]) * 8388608.0);
 }
 
 void ZigguratNormal::ensure_init() noexcept {
   std::call_once(zig_init_flag, &ZigguratNormal::init_once);
 }
 
+// Layer and sign come from the low 9 bits; the 23-bit threshold draw is the
+// top of u01 (bits 40..62, u64_to_unit_double drops bit 63), so uu < k[idx]
+// implies u01 * x[idx] < x[idx+1].
 double ZigguratNormal::sample(std::uint64_t u64, double u01, double extra_u01) noexcept {
-  const std::uint32_t u = static_cast<std::uint32_t>(u64);
-  const int idx = u & 0xFF;             // layer 0..255
-  const std::uint32_t sign = (u & 0x100) ? 1u : 0u;
-  const std::uint32_t uu = u >> 9;      // top 23 bits for threshold
+  const int idx = static_cast<int>(u64 & 0xFF);             // layer 0..255
+  const std::uint32_t sign = (u64 & 0x100) ? 1u : 0u;
+  const std::uint32_t uu = static_cast<std::uint32_t>(u64 >> 40) & 0x7FFFFFu;
   if (uu < zig_k[idx]) {
     double x = u01 * zig_x[idx];
     return sign ? -x : x;
   }
 
-  if (idx == 0) {
-    // Tail beyond R
-    double x, r;
-    do {
-      double e = -std::log(u01 + 1e-300) / zig_x[0];
-      x = zig_x[0] + e;
-      r = std::exp(-0.5 * (x*x - zig_x[0]*zig_x[0]));
-    } while (extra_u01 > r);
-    return sign ? -x : x;
-  } else {
+  return sample_slow(u64, u01, extra_u01);
+}
+
+double ZigguratNormal::sample_slow(std::uint64_t u64, double u01, double extra_u01) noexcept {
+  // a rejection redraws (u64, extra) from a SplitMix64 seeded with the input
+  // bits and starts over, so it cannot spin on the same pair
+  SplitMix64 sm(u64);
+  const double R = zig_x[1];
+  for (;;) {
+    const int idx = static_cast<int>(u64 & 0xFF);
+    const std::uint32_t sign = (u64 & 0x100) ? 1u : 0u;
+    const double x = u01 * zig_x[idx];
+    // inside the next layer's width: the rectangle below the curve
+    // (the 23-bit test in sample() only sees the top of u01)
+    if (x < zig_x[idx+1]) return sign ? -x : x;
+
+    if (idx == 0) {
+      // Tail beyond R: R + e, e ~ Exp(R), accepted with probability
+      // exp(-e^2/2). (x - R) / (x[0] - R) is uniform given x >= R.
+      double t = (x - R) / (zig_x[0] - R);
+      double v = extra_u01;
+      for (;;) {
+        const double e = -std::log(t + 1e-300) / R;
+        if (v <= std::exp(-0.5 * e * e)) return sign ? -(R + e) : R + e;
+        t = u64_to_unit_double(sm.next());
+        v = u64_to_unit_double(sm.next());
+      }
+    }
+
     // Wedge
-    double x = u01 * (zig_x[idx] - zig_x[idx+1]) + zig_x[idx+1];
-    double y = extra_u01 * (zig_y[idx+1] - zig_y[idx]) + zig_y[idx];
+    const double y = extra_u01 * (zig_y[idx+1] - zig_y[idx]) + zig_y[idx];
     if (y < pdf(x)) return sign ? -x : x;
 
-    // Rare fallback: Box–Muller
-    double u1 = u01 > 0 ? u01 : 1e-16;
-    double u2 = extra_u01 > 0 ? extra_u01 : 1e-16;
-    double r = std::sqrt(-2.0 * std::log(u1));
-    double t = 6.283185307179586476925286766559 * u2; // 2π
-    return r * std::cos(t);
+    u64 = sm.next();
+    u01 = u64_to_unit_double(u64);
+    extra_u01 = u64_to_unit_double(sm.next());
   }
 }
 
@@ -7,10 +7,23 @@
 #include <cmath>
 #include <chrono>
 #include <cstdlib>
+#include <bit>
 
 #include <x86intrin.h>     // __rdtsc
 
 #include "ua/ua_rng.h"
+#include "ua/ua_cpuid.h"
+#include "ua/ua_normal_avx2.h"
+#include "ua/ua_normal_polar.h"
+#include "ua/ua_distributions.h"
+#include "ua/ua_shuffle.h"
+#include "ua/ua_alias.h"
+#if defined(UA_BUILD_WITH_AVX2)
+  #include "ua/ua_xoshiro256ss_avx2.h"
+#endif
+#if defined(UA_BUILD_WITH_AVX512)
+  #include "ua/ua_xoshiro256ss_avx512.h"
+#endif
 
 // ------------------------------------------------------------
 // simple helpers
@@ -54,6 +67,7 @@ static const char* tier_name(ua::SimdTier t) {
         case ua::SimdTier::Scalar:  return "Scalar";
         case ua::SimdTier::AVX2:    return "AVX2";
         case ua::SimdTier::AVX512F: return "AVX512";
+        case ua::SimdTier::AVX512VL: return "AVX512VL";
         default: return "?";
     }
 }
@@ -97,6 +111,66 @@ static void stats_normal(ua::Rng& rng, std::size_t n) {
                 n, (double)mean, (double)stdev, (double)skew, (double)kurt);
 }
 
+// ------------------------------------------------------------
+// xoshiro256** '**' multiply kernels, backend called directly
+// ------------------------------------------------------------
+#if defined(UA_BUILD_WITH_AVX2) || defined(UA_BUILD_WITH_AVX512)
+static const char* scrambler_name(ua::detail::XoshiroScrambler s) {
+    switch (s) {
+        case ua::detail::XoshiroScrambler::Emulated: return "emulated";
+        case ua::detail::XoshiroScrambler::ShiftAdd: return "shift-add";
+        case ua::detail::XoshiroScrambler::Mullo:    return "vpmullq";
+        default: return "auto";
+    }
+}
+
+// best-of-reps cycles per u64 for each kernel, and the gain over the
+// emulated 32x32 multiply the backends used before
+template<class Backend>
+static void bench_scramblers(const char* label, std::size_t n, int reps) {
+    using ua::detail::XoshiroScrambler;
+    std::vector<std::uint64_t> buf(n);
+    double base = 0.0;
+    for (XoshiroScrambler k : { XoshiroScrambler::Emulated, XoshiroScrambler::ShiftAdd, XoshiroScrambler::Mullo }) {
+        Backend g(123456789, k);
+        if (g.scrambler() != k) continue;   // kernel not available here
+        g.generate_u64(buf.data(), n);
+        double best = 1e300;
+        for (int r = 0; r < reps; ++r)
+            best = std::min(best, time_once([&]{ g.generate_u64(buf.data(), n); }, n).second);
+        if (k == XoshiroScrambler::Emulated) base = best;
+        std::printf("%-12s | scrambler=%-9s | %.3f cyc/u64 | x%.2f vs emulated\n",
+                    label, scrambler_name(k), best, base / best);
+    }
+    std::printf("  auto picks: %s\n", scrambler_name(Backend(1).scrambler()));
+}
+
+// the backend's own vectorized polar normals, against the Ziggurat the
+// Rng facade dispatches to
+template<class Backend>
+static void bench_polar(const char* label, std::size_t n, int reps, double zig_cpe) {
+    std::vector<double> buf(n);
+    Backend g(123456789);
+    g.generate_normal(buf.data(), n);
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r)
+        best = std::min(best, time_once([&]{ g.generate_normal(buf.data(), n); }, n).second);
+    std::printf("%-12s | backend polar %.2f cyc/elem | ziggurat x%.2f faster\n", label, best, best / zig_cpe);
+}
+#endif
+
+// a header normal generator (SIMD kernel picked by CPUID) over the Rng,
+// against the facade's Ziggurat
+template<class Gen>
+static void bench_normal_gen(const char* method, Gen& gen, std::size_t n, int reps, double zig_cpe) {
+    std::vector<double> buf(n);
+    gen.generate(buf.data(), n);
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r)
+        best = std::min(best, time_once([&]{ gen.generate(buf.data(), n); }, n).second);
+    std::printf("%-12s | %s %.2f cyc/elem | ziggurat x%.2f faster\n", "normal", method, best, best / zig_cpe);
+}
+
 // ------------------------------------------------------------
 // bench
 // ------------------------------------------------------------
@@ -136,6 +210,7 @@ int main() {
     }
 
     // ---------- normal N(0,1) ----------
+    double zig_cpe = 0.0;
     {
         std::vector<double> buf(N);
         for (int i=0;i<UA_WARM;++i) rng.generate_normal(buf.data(), N);
@@ -147,6 +222,209 @@ int main() {
         }
         summarize("normal N(0,1)", ms, cpe, UA_REPS, N, rng.simd_tier());
         std::printf("  sum: %.6f\n", sum_f64(buf.data(), N));
+        zig_cpe = *std::min_element(cpe, cpe + UA_REPS);
+    }
+
+    // ---------- xoshiro256** scrambler kernels ----------
+    {
+        const ua::CpuFeatures f = ua::query_cpu_features();
+        std::printf("cpu: avx2=%d avx512f=%d avx512dq=%d avx512ifma=%d\n",
+                    f.avx2, f.avx512f, f.avx512dq, f.avx512ifma);
+        constexpr std::size_t NS = 1u << 16;   // L2-resident: measures the kernel, not memory
+#if defined(UA_BUILD_WITH_AVX2)
+        if (f.avx2) bench_scramblers<ua::detail::Xoshiro256ssAVX2>("u64 avx2", NS, UA_REPS * 8);
+#endif
+#if defined(UA_BUILD_WITH_AVX512)
+        if (ua::avx512_ok(f)) bench_scramblers<ua::detail::Xoshiro256ssAVX512>("u64 avx512", NS, UA_REPS * 8);
+#endif
+        (void)f;
+    }
+
+    // ---------- normal: Ziggurat vs polar at the dispatched tier ----------
+#if defined(UA_BUILD_WITH_AVX512)
+    if (rng.simd_tier() == ua::SimdTier::AVX512F)
+        bench_polar<ua::detail::Xoshiro256ssAVX512>("normal", N, UA_REPS, zig_cpe);
+#endif
+#if defined(UA_BUILD_WITH_AVX2)
+    if (rng.simd_tier() == ua::SimdTier::AVX2)
+        bench_polar<ua::detail::Xoshiro256ssAVX2>("normal", N, UA_REPS, zig_cpe);
+#endif
+
+    // ---------- normal: Box–Muller and polar generators over the same Rng ----------
+    {
+        ua::NormalGenerator<ua::Rng> bm(rng);
+        ua::PolarNormal<ua::Rng> polar(rng);
+        bench_normal_gen("box-muller", bm, N, UA_REPS, zig_cpe);
+        bench_normal_gen("polar", polar, N, UA_REPS, zig_cpe);
+    }
+
+    // ---------- normal: inverse CDF (AS241) at the dispatched tier ----------
+    {
+        std::vector<double> buf(N);
+        rng.generate_normal_icdf(buf.data(), N);
+        double best = 1e300;
+        for (int r = 0; r < UA_REPS; ++r)
+            best = std::min(best, time_once([&]{ rng.generate_normal_icdf(buf.data(), N); }, N).second);
+        std::printf("%-12s | inverse-cdf %.2f cyc/elem | ziggurat x%.2f faster\n", "normal", best, best / zig_cpe);
+    }
+
+    // ---------- exponential: SIMD ln vs a scalar -log(u) loop over generate_double ----------
+    {
+        std::vector<double> buf(N);
+        rng.generate_exponential(buf.data(), N, 1.0);
+        double best = 1e300, base = 1e300;
+        for (int r = 0; r < UA_REPS; ++r) {
+            best = std::min(best, time_once([&]{ rng.generate_exponential(buf.data(), N, 1.0); }, N).second);
+            base = std::min(base, time_once([&]{
+                rng.generate_double(buf.data(), N);
+                for (std::size_t i = 0; i < N; ++i) buf[i] = -std::log1p(-buf[i]);
+            }, N).second);
+        }
+        std::printf("%-12s | %.2f cyc/elem | scalar -log loop %.2f (x%.2f)\n", "exponential", best, base, base / best);
+    }
+
+    // ---------- gamma: SIMD Marsaglia–Tsang vs the scalar kernels, same generator ----------
+    {
+        std::vector<double> buf(N);
+        ua::GammaGenerator<ua::Rng> simd(rng), scalar(rng);
+        scalar.kernel = &ua::detail::gamma_mt_scalar;
+        scalar.boost  = &ua::detail::gamma_boost_scalar;
+        for (double shape : { 0.5, 2.5 }) {
+            double best = 1e300, base = 1e300;
+            for (int r = 0; r < UA_REPS; ++r) {
+                best = std::min(best, time_once([&]{ simd.generate(buf.data(), N, shape); }, N).second);
+                base = std::min(base, time_once([&]{ scalar.generate(buf.data(), N, shape); }, N).second);
+            }
+            std::printf("%-12s | shape %.1f %.2f cyc/elem | scalar kernels %.2f (x%.2f)\n", "gamma", shape, best, base, base / best);
+        }
+    }
+
+    // ---------- poisson / binomial: SIMD kernels vs the scalar kernels, same generator ----------
+    {
+        std::vector<double> lam(N);
+        std::vector<std::uint32_t> k(N), trials(N);
+        ua::PoissonGenerator<ua::Rng> simd(rng), scalar(rng);
+        scalar.kernel = &ua::detail::poisson_scalar;
+        for (double mean : { 4.0, 100.0 }) {
+            std::fill(lam.begin(), lam.end(), mean);
+            double best = 1e300, base = 1e300;
+            for (int r = 0; r < UA_REPS; ++r) {
+                best = std::min(best, time_once([&]{ simd.generate(lam.data(), k.data(), N); }, N).second);
+                base = std::min(base, time_once([&]{ scalar.generate(lam.data(), k.data(), N); }, N).second);
+            }
+            std::printf("%-12s | mean %.0f %.2f cyc/elem | scalar kernel %.2f (x%.2f)\n", "poisson", mean, best, base, base / best);
+        }
+        std::vector<double> p(N, 0.3);
+        ua::BinomialGenerator<ua::Rng> bsimd(rng), bscalar(rng);
+        bscalar.kernel = &ua::detail::binomial_scalar;
+        for (std::uint32_t t : { 20u, 1000u }) {
+            std::fill(trials.begin(), trials.end(), t);
+            double best = 1e300, base = 1e300;
+            for (int r = 0; r < UA_REPS; ++r) {
+                best = std::min(best, time_once([&]{ bsimd.generate(trials.data(), p.data(), k.data(), N); }, N).second);
+                base = std::min(base, time_once([&]{ bscalar.generate(trials.data(), p.data(), k.data(), N); }, N).second);
+            }
+            std::printf("%-12s | n %u p 0.3 %.2f cyc/elem | scalar kernel %.2f (x%.2f)\n", "binomial", t, best, base, base / best);
+        }
+    }
+
+    // ---------- uniform ints: Lemire kernels vs generate_u64 and a % loop ----------
+    {
+        std::vector<std::uint32_t> a(N);
+        std::vector<std::uint64_t> b(N);
+        for (std::uint64_t hi : { std::uint64_t(999), std::uint64_t(0xC0000000u) }) {
+            double best = 1e300, base = 1e300;
+            for (int r = 0; r < UA_REPS; ++r) {
+                best = std::min(best, time_once([&]{ rng.generate_uniform_int(0, hi, a.data(), N); }, N).second);
+                base = std::min(base, time_once([&]{
+                    rng.generate_u64(b.data(), N);
+                    for (std::size_t i = 0; i < N; ++i) a[i] = std::uint32_t(b[i] % (hi + 1));
+                }, N).second);
+            }
+            std::printf("%-12s | u32 [0, %llu] %.2f cyc/elem | biased %% loop %.2f (x%.2f)\n", "uniform_int",
+                        (unsigned long long)hi, best, base, base / best);
+        }
+        for (std::uint64_t hi : { std::uint64_t(999), std::uint64_t(3) << 62 }) {
+            double best = 1e300, base = 1e300, raw = 1e300;
+            for (int r = 0; r < UA_REPS; ++r) {
+                best = std::min(best, time_once([&]{ rng.generate_uniform_int(0, hi, b.data(), N); }, N).second);
+                raw  = std::min(raw, time_once([&]{ rng.generate_u64(b.data(), N); }, N).second);
+                base = std::min(base, time_once([&]{
+                    rng.generate_u64(b.data(), N);
+                    for (std::size_t i = 0; i < N; ++i) b[i] %= hi + 1;
+                }, N).second);
+            }
+            std::printf("%-12s | u64 [0, %llu] %.2f cyc/elem | u64 %.2f | biased %% loop %.2f (x%.2f)\n", "uniform_int",
+                        (unsigned long long)hi, best, raw, base, base / best);
+        }
+    }
+
+    // ---------- shuffle: Rng::shuffle vs Fisher–Yates alone vs a serial draw-and-swap loop, u32 IDs ----------
+    {
+        for (std::size_t n : { std::size_t(1) << 16, std::size_t(1) << 22, std::size_t(1) << 26 }) {
+            std::vector<std::uint32_t> ids(n);
+            std::iota(ids.begin(), ids.end(), 0u);
+            ua::Shuffler<ua::Rng> fy(rng);
+            fy.blocked_bytes = ~std::size_t(0);
+            const int reps = n > (1u << 22) ? 2 : UA_REPS;
+            double best = 1e300, plain = 1e300, base = 1e300;
+            for (int r = 0; r < reps; ++r) {
+                best  = std::min(best, time_once([&]{ rng.shuffle(ids.data(), n); }, n).second);
+                plain = std::min(plain, time_once([&]{ fy.shuffle(ids.data(), n); }, n).second);
+                base  = std::min(base, time_once([&]{
+                    for (std::size_t i = n - 1; i > 0; --i) {   // one draw and one dependent swap per element
+                        std::uint64_t x;
+                        rng.generate_u64(&x, 1);
+                        std::swap(ids[i], ids[x % (i + 1)]);
+                    }
+                }, n).second);
+            }
+            std::printf("%-12s | n 2^%d %.2f cyc/elem | Fisher-Yates %.2f | serial loop %.2f (x%.2f)\n", "shuffle",
+                        std::countr_zero(n), best, plain, base, base / best);
+        }
+    }
+
+    // ---------- categorical: alias-table draws vs the scalar kernel, sharded, and the build ----------
+    {
+        std::vector<std::uint32_t> a(N);
+        for (std::size_t k : { std::size_t(10000), std::size_t(1000000) }) {
+            std::vector<double> w(k);
+            for (std::size_t i = 0; i < k; ++i) w[i] = 1.0 / double(1 + i);   // Zipf
+            ua::AliasTable t, sharded;
+            double build = 1e300, best = 1e300, base = 1e300, shard = 1e300;
+            for (int r = 0; r < UA_REPS; ++r) build = std::min(build, time_once([&]{ t.build(w.data(), k); }, k).second);
+            sharded.build(w.data(), k, 4096);
+            ua::AliasSampler<ua::Rng> scalar(rng);
+            scalar.kernel = &ua::detail::alias_scalar;
+            for (int r = 0; r < UA_REPS; ++r) {
+                best  = std::min(best, time_once([&]{ rng.generate_categorical(t, a.data(), N); }, N).second);
+                shard = std::min(shard, time_once([&]{ rng.generate_categorical(sharded, a.data(), N); }, N).second);
+                base  = std::min(base, time_once([&]{ scalar.generate(t, a.data(), N); }, N).second);
+            }
+            std::printf("%-12s | K %zu %.2f cyc/elem | scalar kernel %.2f (x%.2f) | shards of 4096 %.2f | build %.2f cyc/item\n",
+                        "categorical", k, best, base, base / best, shard, build);
+        }
+    }
+
+    // ---------- float: native float paths vs narrowing the double outputs (v1.5 single precision) ----------
+    {
+        std::vector<float> f(N);
+        std::vector<double> d(N);
+        double uni = 1e300, uni_base = 1e300, nrm = 1e300, nrm_base = 1e300;
+        for (int r = 0; r < UA_REPS; ++r) {
+            uni = std::min(uni, time_once([&]{ rng.generate_float(f.data(), N); }, N).second);
+            nrm = std::min(nrm, time_once([&]{ rng.generate_normal_float(f.data(), N); }, N).second);
+            uni_base = std::min(uni_base, time_once([&]{
+                rng.generate_double(d.data(), N);
+                for (std::size_t i = 0; i < N; ++i) f[i] = float(d[i]);
+            }, N).second);
+            nrm_base = std::min(nrm_base, time_once([&]{
+                rng.generate_normal(d.data(), N);
+                for (std::size_t i = 0; i < N; ++i) f[i] = float(d[i]);
+            }, N).second);
+        }
+        std::printf("%-12s | uniform %.2f cyc/elem | narrowed doubles %.2f (x%.2f)\n", "float", uni, uni_base, uni_base / uni);
+        std::printf("%-12s | normal %.2f cyc/elem | narrowed doubles %.2f (x%.2f)\n", "float", nrm, nrm_base, nrm_base / nrm);
     }
 
     if (std::getenv("UA_BENCH_STATS")) {
@@ -0,0 +1,137 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+
+namespace ua {
+
+namespace detail {
+
+// One alias-table draw per u64 over k columns (Walker / Vose): the high
+// half picks the column c = base[j] + (x_hi k) >> 32 by Lemire's
+// multiply-high, the low half is the coin, and out[j] = x_lo < prob[c] ? c :
+// alias[c]. t = 2^32 mod k is the table's rejection threshold: where the
+// low word of x_hi k falls below it, out[j] is unspecified and j is
+// appended to miss. base may be null (no offset) and may alias out.
+// Returns the number of misses.
+//
+// The AVX2 / AVX-512 kernels take 4 / 8 draws per iteration: the column
+// from _mm256_mul_epu32 / _mm512_mul_epu32, then two 32-bit gathers (prob,
+// alias) and a compare. All three return the same values and misses; lanes
+// past n are neither read nor written.
+using AliasFn = std::size_t (*)(const std::uint32_t* prob, const std::uint32_t* alias, std::uint32_t k, std::uint32_t t,
+                                const std::uint64_t* x, const std::uint32_t* base, std::size_t n,
+                                std::uint32_t* out, std::uint32_t* miss) noexcept;
+
+std::size_t alias_scalar(const std::uint32_t* prob, const std::uint32_t* alias, std::uint32_t k, std::uint32_t t, const std::uint64_t* x, const std::uint32_t* base, std::size_t n, std::uint32_t* out, std::uint32_t* miss) noexcept;   // alias.cpp
+std::size_t alias_avx2(const std::uint32_t* prob, const std::uint32_t* alias, std::uint32_t k, std::uint32_t t, const std::uint64_t* x, const std::uint32_t* base, std::size_t n, std::uint32_t* out, std::uint32_t* miss) noexcept;     // alias_avx2.cpp
+std::size_t alias_avx512(const std::uint32_t* prob, const std::uint32_t* alias, std::uint32_t k, std::uint32_t t, const std::uint64_t* x, const std::uint32_t* base, std::size_t n, std::uint32_t* out, std::uint32_t* miss) noexcept;   // alias_avx512.cpp
+
+// kernel of the tier ua::Rng picks (UA_FORCE_BACKEND, else CPUID), resolved once
+AliasFn alias_kernel() noexcept;
+
+} // namespace detail
+
+// Categorical distribution over items 0 .. k - 1 with weights w[i] as an
+// alias table, built by Vose's method in O(k). The weights are scaled to
+// integer masses summing to k 2^32 and paired in integers, so item i is
+// drawn with probability exactly mass_i / (k 2^32) (probability()), within
+// a few 2^-32 k of w[i] / sum w relative to each item's share.
+//
+// With shard = S > 0 the items are cut into shards of S (the last padded
+// with zero weights), each with its own table, and a top table over the
+// shard totals picks the shard: two draws per sample, but changing weights
+// rebuilds only the shards that hold them plus the top table (update()).
+// rebuild_shard() touches one shard only, so distinct shards can be rebuilt
+// from different threads, followed by one commit(). shard = 0 keeps one
+// table and one draw per sample.
+//
+// Weights must be finite and >= 0 with a positive, finite sum. build() and
+// commit() return false otherwise and leave the table empty (size 0,
+// nothing sampled); update() and set_weights() refuse such weights, and new
+// weights that would bring the sum to 0 or past the double range, and keep
+// the table (the sum counts other shards as last rebuilt). Items with weight
+// 0 are never drawn.
+class AliasTable {
+public:
+  AliasTable() = default;
+  AliasTable(const double* w, std::size_t k, std::size_t shard = 0) { build(w, k, shard); }
+
+  bool build(const double* w, std::size_t k, std::size_t shard = 0);
+  // w[0 .. count) are the new weights of items first .. first + count
+  bool update(std::size_t first, const double* w, std::size_t count);
+
+  // the pieces of update(): store weights, rebuild one shard from the stored
+  // weights (distinct shards concurrently), rebuild the top table
+  bool set_weights(std::size_t first, const double* w, std::size_t count) noexcept;
+  void rebuild_shard(std::size_t s);
+  bool commit();
+
+  std::size_t size() const noexcept { return ok_ ? k_ : 0; }
+  bool empty() const noexcept { return !ok_; }
+  std::size_t shards() const noexcept { return top_prob_.size(); }
+  std::size_t shard_size() const noexcept { return s_; }
+  // exact probability of drawing item i, O(shard size)
+  double probability(std::size_t i) const noexcept;
+
+private:
+  template<class> friend struct AliasSampler;
+
+  std::vector<double> w_;                        // k item weights, then padding
+  std::vector<std::uint32_t> prob_, alias_;      // shards * s_ columns, alias_ global
+  std::vector<double> total_;                    // per-shard weight sums
+  std::vector<std::uint32_t> top_prob_, top_alias_;
+  std::size_t k_ = 0, s_ = 0;
+  std::uint32_t t_ = 0, top_t_ = 0;              // 2^32 mod s_, 2^32 mod shards
+  bool ok_ = false;
+};
+
+// Batch draws from an AliasTable over any generator with generate_u64
+// (ua::Rng::generate_categorical wraps it): one u64 per draw and level, a
+// block at a time, the rare column rejections redrawn together. Scratch is
+// thread_local; generate() allocates nothing.
+template<class URNG>
+struct AliasSampler {
+  static constexpr std::size_t BLOCK = 512;
+
+  URNG& rng;
+  detail::AliasFn kernel;
+
+  explicit AliasSampler(URNG& r) : rng(r), kernel(detail::alias_kernel()) {}
+
+  void generate(const AliasTable& t, std::uint32_t* out, std::size_t n) {
+    static thread_local std::uint32_t base[BLOCK];
+    if (t.empty()) return;
+    const std::uint32_t s = static_cast<std::uint32_t>(t.s_), p = static_cast<std::uint32_t>(t.shards());
+    for (std::size_t i = 0; i < n; i += BLOCK) {
+      const std::size_t m = std::min(BLOCK, n - i);
+      const std::uint32_t* b = nullptr;
+      if (p > 1) {
+        draw(t.top_prob_.data(), t.top_alias_.data(), p, t.top_t_, nullptr, base, m);
+        for (std::size_t j = 0; j < m; ++j) base[j] *= s;
+        b = base;
+      }
+      draw(t.prob_.data(), t.alias_.data(), s, t.t_, b, out + i, m);
+    }
+  }
+
+private:
+  void draw(const std::uint32_t* prob, const std::uint32_t* alias, std::uint32_t k, std::uint32_t thr,
+            const std::uint32_t* base, std::uint32_t* out, std::size_t m) {
+    alignas(64) static thread_local std::uint64_t x[BLOCK];
+    static thread_local std::uint32_t idx[BLOCK], miss[BLOCK], kr[BLOCK], br[BLOCK];
+    rng.generate_u64(x, m);
+    std::size_t r = kernel(prob, alias, k, thr, x, base, m, out, idx);
+    while (r) {
+      if (base) for (std::size_t t = 0; t < r; ++t) br[t] = base[idx[t]];
+      rng.generate_u64(x, r);
+      const std::size_t r2 = kernel(prob, alias, k, thr, x, base ? br : nullptr, r, kr, miss);
+      for (std::size_t t = 0; t < r; ++t) out[idx[t]] = kr[t];
+      for (std::size_t t = 0; t < r2; ++t) idx[t] = idx[miss[t]];   // miss[t] >= t
+      r = r2;
+    }
+  }
+};
+
+} // namespace ua
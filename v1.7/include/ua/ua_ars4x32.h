@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "ua/ua_ars4x32_scalar.h"
+#include "ua/ua_counter_tail.h"
+
+namespace ua::detail {
+
+// Hardware ARS4x32-7 backends. Every one emits blocks in counter order, each
+// block as (low u64, high u64) of the AES state, and keeps the rest of a step
+// cut by a request for the next one, so a seed gives the same stream as
+// Ars4x32Scalar on every tier however it is split into calls. Four
+// independent registers are in flight per round to cover the AESENC latency.
+
+// AES-NI, 128-bit: 8 blocks (16 u64) per step
+struct Ars4x32AESNI {
+  static constexpr int LANES = 1;
+
+  Ars4x32AESNI() = delete;
+  explicit Ars4x32AESNI(std::uint64_t seed) noexcept;
+
+  void generate_u64(std::uint64_t* out, std::size_t n) noexcept;
+  void generate_double(double* out, std::size_t n) noexcept;  // [0,1)
+
+  // 2^64 / 2^96 blocks ahead (disjoint substreams)
+  void jump() noexcept;
+  void long_jump() noexcept;
+
+  // O(1) skip of hi*2^64 + lo blocks (1 block = 2 u64) of the stream
+  void skip_ahead(std::uint64_t lo, std::uint64_t hi = 0) noexcept;
+
+private:
+  std::uint64_t rk[2 * (ARS_ROUNDS + 1)];   // round keys (lo, hi)
+  std::uint64_t ctr_lo{0}, ctr_hi{0};       // 128-bit block counter
+  CounterTail<16, 2> tail;                  // one step
+
+  // counter += hi*2^64 + lo (mod 2^128)
+  void advance(std::uint64_t lo, std::uint64_t hi = 0) noexcept;
+  // next step into the tail buffer
+  void refill() noexcept;
+};
+
+// VAES on ymm (AVX2 tier): 2 blocks per register, 8 blocks (16 u64) per step
+struct Ars4x32AVX2 {
+  static constexpr int LANES = 2;
+
+  Ars4x32AVX2() = delete;
+  explicit Ars4x32AVX2(std::uint64_t seed) noexcept;
+
+  void generate_u64(std::uint64_t* out, std::size_t n) noexcept;
+  void generate_double(double* out, std::size_t n) noexcept;  // [0,1)
+
+  void jump() noexcept;
+  void long_jump() noexcept;
+  void skip_ahead(std::uint64_t lo, std::uint64_t hi = 0) noexcept;
+
+private:
+  std::uint64_t rk[2 * (ARS_ROUNDS + 1)];
+  std::uint64_t ctr_lo{0}, ctr_hi{0};
+  CounterTail<16, 2> tail;
+
+  void advance(std::uint64_t lo, std::uint64_t hi = 0) noexcept;
+  void refill() noexcept;
+};
+
+// VAES on zmm (AVX-512 tier): 4 blocks per register, 16 blocks (32 u64) per step
+struct Ars4x32AVX512 {
+  static constexpr int LANES = 4;
+
+  Ars4x32AVX512() = delete;
+  explicit Ars4x32AVX512(std::uint64_t seed) noexcept;
+
+  void generate_u64(std::uint64_t* out, std::size_t n) noexcept;
+  void generate_double(double* out, std::size_t n) noexcept;  // [0,1)
+
+  void jump() noexcept;
+  void long_jump() noexcept;
+  void skip_ahead(std::uint64_t lo, std::uint64_t hi = 0) noexcept;
+
+private:
+  std::uint64_t rk[2 * (ARS_ROUNDS + 1)];
+  std::uint64_t ctr_lo{0}, ctr_hi{0};
+  CounterTail<32, 2> tail;
+
+  void advance(std::uint64_t lo, std::uint64_t hi = 0) noexcept;
+  void refill() noexcept;
+};
+
+} // namespace ua::detail
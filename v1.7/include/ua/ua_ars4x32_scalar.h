@@ -0,0 +1,155 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+#include "ua/ua_counter_tail.h"
+
+namespace ua {
+
+// ARS4x32-7 (Random123 "advanced randomization system"): counter-mode AES
+// rounds with a Weyl key schedule. v = ctr ^ k; six AESENC and one
+// AESENCLAST, the round key advancing by (ARS_W0, ARS_W1) per 64-bit half
+// each round. Not AES-128 and not a CSPRNG; a Philox-class counter engine
+// that maps onto the AES-NI / VAES units.
+static constexpr std::uint64_t ARS_W0 = 0x9E3779B97F4A7C15ull;   // low 64-bit half
+static constexpr std::uint64_t ARS_W1 = 0xBB67AE8584CAA73Bull;   // high 64-bit half
+static constexpr int ARS_ROUNDS = 7;
+
+static constexpr std::uint8_t ARS_SBOX[256] = {
+  0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+  0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+  0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+  0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+  0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+  0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+  0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+  0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+  0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+  0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+  0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+  0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+  0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+  0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+  0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+  0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
+};
+
+// One AES encryption round on a 16-byte state (column-major, same byte order
+// as an __m128i): ShiftRows, SubBytes, MixColumns (skipped when last), ^ rk.
+// Bit-identical to AESENC / AESENCLAST.
+static inline void ars_aes_round(std::uint8_t s[16], const std::uint8_t rk[16], bool last) noexcept {
+  std::uint8_t t[16];
+  for (int c = 0; c < 4; ++c)
+    for (int r = 0; r < 4; ++r) t[4 * c + r] = ARS_SBOX[s[r + 4 * ((c + r) & 3)]];
+  if (!last) {
+    auto xt = [](std::uint8_t a) { return std::uint8_t((a << 1) ^ ((a & 0x80) ? 0x1b : 0)); };
+    for (int c = 0; c < 4; ++c) {
+      const std::uint8_t a0 = t[4 * c], a1 = t[4 * c + 1], a2 = t[4 * c + 2], a3 = t[4 * c + 3];
+      const std::uint8_t x = a0 ^ a1 ^ a2 ^ a3;
+      t[4 * c]     = a0 ^ x ^ xt(a0 ^ a1);
+      t[4 * c + 1] = a1 ^ x ^ xt(a1 ^ a2);
+      t[4 * c + 2] = a2 ^ x ^ xt(a2 ^ a3);
+      t[4 * c + 3] = a3 ^ x ^ xt(a3 ^ a0);
+    }
+  }
+  for (int i = 0; i < 16; ++i) s[i] = t[i] ^ rk[i];
+}
+
+// round keys k + r*(ARS_W0, ARS_W1), r = 0..ARS_ROUNDS, as (lo, hi) pairs
+static inline void ars_round_keys(const std::uint64_t key[2], std::uint64_t rk[2 * (ARS_ROUNDS + 1)]) noexcept {
+  rk[0] = key[0]; rk[1] = key[1];
+  for (int r = 1; r <= ARS_ROUNDS; ++r) {
+    rk[2 * r] = rk[2 * r - 2] + ARS_W0;
+    rk[2 * r + 1] = rk[2 * r - 1] + ARS_W1;
+  }
+}
+
+// Portable ARS4x32-7 block: (key, counter hi*2^64 + lo) -> 128 bits as two
+// little-endian u64 (out[0] = low half). The hardware backends must match it.
+static inline void ars4x32_7(const std::uint64_t key[2], std::uint64_t lo, std::uint64_t hi,
+                             std::uint64_t out[2]) noexcept {
+  auto put = [](std::uint8_t* b, std::uint64_t a, std::uint64_t c) {
+    for (int i = 0; i < 8; ++i) { b[i] = std::uint8_t(a >> (8 * i)); b[8 + i] = std::uint8_t(c >> (8 * i)); }
+  };
+  std::uint64_t k0 = key[0], k1 = key[1];
+  std::uint8_t s[16], rk[16];
+  put(s, lo ^ k0, hi ^ k1);
+  for (int r = 1; r <= ARS_ROUNDS; ++r) {
+    k0 += ARS_W0; k1 += ARS_W1;
+    put(rk, k0, k1);
+    ars_aes_round(s, rk, r == ARS_ROUNDS);
+  }
+  out[0] = out[1] = 0;
+  for (int i = 0; i < 8; ++i) {
+    out[0] |= std::uint64_t(s[i]) << (8 * i);
+    out[1] |= std::uint64_t(s[8 + i]) << (8 * i);
+  }
+}
+
+// 128-bit key from a 64-bit seed via splitmix64 (same seeding as the other engines)
+static inline void ars_key_from_seed(std::uint64_t seed, std::uint64_t key[2]) noexcept {
+  std::uint64_t z = seed;
+  for (int i = 0; i < 2; ++i) {
+    z += 0x9e3779b97f4a7c15ull;
+    std::uint64_t v = z;
+    v = (v ^ (v >> 30)) * 0xbf58476d1ce4e5b9ull;
+    v = (v ^ (v >> 27)) * 0x94d049bb133111ebull;
+    key[i] = v ^ (v >> 31);
+  }
+}
+
+namespace detail {
+
+// Table-based fallback for CPUs without AES-NI: one block (2 u64) per step,
+// same key, counter order and stream as the AES-NI / VAES backends (the
+// second word of a block cut by a request is kept for the next one). Slow;
+// the façade only picks it when CPUID reports no AES.
+struct Ars4x32Scalar {
+  static constexpr int LANES = 1;
+
+  std::uint64_t k[2];
+  std::uint64_t ctr_lo{0}, ctr_hi{0};   // 128-bit block counter
+  CounterTail<2, 2> tail;
+
+  explicit Ars4x32Scalar(std::uint64_t seed) noexcept { ars_key_from_seed(seed, k); }
+
+  // counter += hi*2^64 + lo (mod 2^128)
+  void advance(std::uint64_t lo, std::uint64_t hi = 0) noexcept {
+    const std::uint64_t s = ctr_lo + lo;
+    ctr_hi += hi + (s < ctr_lo ? 1 : 0);
+    ctr_lo = s;
+  }
+
+  // O(1) skip of hi*2^64 + lo blocks (1 block = 2 u64) of the stream
+  void skip_ahead(std::uint64_t lo, std::uint64_t hi = 0) noexcept {
+    std::size_t off;
+    const std::uint64_t back = tail.rewind(off);
+    advance(lo - back, hi - (lo < back ? 1 : 0));
+    if (off) { refill(); tail.pos = off; }
+  }
+
+  // 2^64 / 2^96 blocks: disjoint substreams within the 2^128 counter space
+  void jump() noexcept      { skip_ahead(0, 1); }
+  void long_jump() noexcept { skip_ahead(0, 1ull << 32); }
+
+  void next_block(std::uint64_t out[2]) noexcept {
+    ars4x32_7(k, ctr_lo, ctr_hi, out);
+    advance(1);
+  }
+
+  void refill() noexcept { next_block(tail.buf); tail.pos = 0; }
+
+  void generate_u64(std::uint64_t* out, std::size_t n) noexcept {
+    std::size_t i = tail.take(out, n);
+    for (; i + 2 <= n; i += 2) next_block(out + i);
+    if (i < n) { refill(); tail.take(out + i, n - i); }
+  }
+
+  void generate_double(double* out, std::size_t n) noexcept {
+    std::size_t i = tail.take(out, n);
+    while (i < n) { refill(); i += tail.take(out + i, n - i); }
+  }
+};
+
+} // namespace detail
+} // namespace ua
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "ua/ua_counter_tail.h"
+
+namespace ua::detail {
+
+// ChaCha with a selectable round count (8 / 12 / 20), 16 blocks per step,
+// one block per 32-bit lane. Same key, counter layout and u64 stream as
+// ChaChaScalar (ua_chacha_scalar.h); the rest of a step cut by a request is
+// kept for the next one.
+struct ChaChaAVX512 {
+  static constexpr int LANES = 16;
+
+  ChaChaAVX512() = delete;
+  explicit ChaChaAVX512(std::uint64_t seed, int rounds = 20) noexcept;
+  ChaChaAVX512(const std::uint32_t key[8], int rounds) noexcept;
+
+  void generate_u64(std::uint64_t* out, std::size_t n) noexcept;
+  void generate_double(double* out, std::size_t n) noexcept;  // [0,1)
+
+  // 2^64 / 2^96 blocks ahead (disjoint substreams)
+  void jump() noexcept;
+  void long_jump() noexcept;
+
+  // O(1) skip of hi*2^64 + lo blocks (1 block = 8 u64) of the stream
+  void skip_ahead(std::uint64_t lo, std::uint64_t hi = 0) noexcept;
+
+private:
+  std::uint32_t k[8];
+  std::uint64_t ctr_lo{0}, ctr_hi{0};   // 128-bit block counter
+  int rounds;
+  CounterTail<8 * LANES, 8> tail;
+
+  // counter += hi*2^64 + lo (mod 2^128)
+  void advance(std::uint64_t lo, std::uint64_t hi = 0) noexcept;
+  // LANES blocks -> 8*LANES u64 in counter order at out (unaligned ok)
+  void next_blocks(std::uint64_t* out) noexcept;
+  // next step into the tail buffer
+  void refill() noexcept;
+};
+
+} // namespace ua::detail
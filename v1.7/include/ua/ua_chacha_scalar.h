@@ -0,0 +1,122 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+#include "ua/ua_counter_tail.h"
+
+namespace ua {
+
+// ChaCha (Bernstein) keystream block, original 64/64 layout read as one
+// 128-bit block counter in words 12..15 (12 = least significant). With
+// rounds = 20 and counter (1, nonce...) this is RFC 7539's block function.
+//
+// Seeding through a 64-bit seed gives at most 64 bits of key entropy: pass a
+// real 256-bit key for security-sensitive use.
+
+static constexpr std::uint32_t CHACHA_C0 = 0x61707865u;   // "expand 32-byte k"
+static constexpr std::uint32_t CHACHA_C1 = 0x3320646eu;
+static constexpr std::uint32_t CHACHA_C2 = 0x79622d32u;
+static constexpr std::uint32_t CHACHA_C3 = 0x6b206574u;
+
+static inline std::uint32_t chacha_rotl(std::uint32_t x, int k) noexcept {
+  return (x << k) | (x >> (32 - k));
+}
+
+// one block at counter hi*2^64 + lo; rounds must be even (8 / 12 / 20)
+static inline void chacha_block(const std::uint32_t key[8], std::uint64_t lo, std::uint64_t hi,
+                                int rounds, std::uint32_t out[16]) noexcept {
+  const std::uint32_t s[16] = {
+    CHACHA_C0, CHACHA_C1, CHACHA_C2, CHACHA_C3,
+    key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+    (std::uint32_t)lo, (std::uint32_t)(lo >> 32), (std::uint32_t)hi, (std::uint32_t)(hi >> 32)
+  };
+  std::uint32_t x[16];
+  for (int i = 0; i < 16; ++i) x[i] = s[i];
+  auto qr = [&x](int a, int b, int c, int d) {
+    x[a] += x[b]; x[d] = chacha_rotl(x[d] ^ x[a], 16);
+    x[c] += x[d]; x[b] = chacha_rotl(x[b] ^ x[c], 12);
+    x[a] += x[b]; x[d] = chacha_rotl(x[d] ^ x[a], 8);
+    x[c] += x[d]; x[b] = chacha_rotl(x[b] ^ x[c], 7);
+  };
+  for (int r = 0; r < rounds; r += 2) {
+    qr(0, 4,  8, 12); qr(1, 5,  9, 13); qr(2, 6, 10, 14); qr(3, 7, 11, 15);
+    qr(0, 5, 10, 15); qr(1, 6, 11, 12); qr(2, 7,  8, 13); qr(3, 4,  9, 14);
+  }
+  for (int i = 0; i < 16; ++i) out[i] = x[i] + s[i];
+}
+
+// 256-bit key from a 64-bit seed via splitmix64 (same seeding as the other engines)
+static inline void chacha_key_from_seed(std::uint64_t seed, std::uint32_t key[8]) noexcept {
+  std::uint64_t z = seed;
+  for (int i = 0; i < 4; ++i) {
+    z += 0x9e3779b97f4a7c15ull;
+    std::uint64_t v = z;
+    v = (v ^ (v >> 30)) * 0xbf58476d1ce4e5b9ull;
+    v = (v ^ (v >> 27)) * 0x94d049bb133111ebull;
+    v ^= v >> 31;
+    key[2 * i] = (std::uint32_t)v; key[2 * i + 1] = (std::uint32_t)(v >> 32);
+  }
+}
+
+namespace detail {
+
+// One block (64 bytes = 8 u64) per step. Every tier emits blocks in counter
+// order and u64 j of a block is keystream bytes 8j..8j+7 read little-endian,
+// so a seed/key gives the same stream on scalar, AVX2 and AVX-512, however it
+// is split into calls (the rest of a block cut by a request is kept for the
+// next one).
+struct ChaChaScalar {
+  static constexpr int LANES = 1;
+
+  std::uint32_t k[8];
+  std::uint64_t ctr_lo{0}, ctr_hi{0};   // 128-bit block counter
+  int rounds;
+  CounterTail<8, 8> tail;
+
+  explicit ChaChaScalar(std::uint64_t seed, int r = 20) noexcept : rounds(r) { chacha_key_from_seed(seed, k); }
+  ChaChaScalar(const std::uint32_t key[8], int r) noexcept : rounds(r) {
+    for (int i = 0; i < 8; ++i) k[i] = key[i];
+  }
+
+  // counter += hi*2^64 + lo (mod 2^128)
+  void advance(std::uint64_t lo, std::uint64_t hi = 0) noexcept {
+    const std::uint64_t s = ctr_lo + lo;
+    ctr_hi += hi + (s < ctr_lo ? 1 : 0);
+    ctr_lo = s;
+  }
+
+  // O(1) skip of hi*2^64 + lo blocks (1 block = 8 u64) of the stream
+  void skip_ahead(std::uint64_t lo, std::uint64_t hi = 0) noexcept {
+    std::size_t off;
+    const std::uint64_t back = tail.rewind(off);
+    advance(lo - back, hi - (lo < back ? 1 : 0));
+    if (off) { refill(); tail.pos = off; }
+  }
+
+  // 2^64 / 2^96 blocks: disjoint substreams within the 2^128 counter space
+  void jump() noexcept      { skip_ahead(0, 1); }
+  void long_jump() noexcept { skip_ahead(0, 1ull << 32); }
+
+  void next_block(std::uint64_t out[8]) noexcept {
+    std::uint32_t w[16];
+    chacha_block(k, ctr_lo, ctr_hi, rounds, w);
+    advance(1);
+    for (int j = 0; j < 8; ++j) out[j] = ((std::uint64_t)w[2 * j + 1] << 32) | w[2 * j];
+  }
+
+  void refill() noexcept { next_block(tail.buf); tail.pos = 0; }
+
+  void generate_u64(std::uint64_t* out, std::size_t n) noexcept {
+    std::size_t i = tail.take(out, n);
+    for (; i + 8 <= n; i += 8) next_block(out + i);
+    if (i < n) { refill(); tail.take(out + i, n - i); }
+  }
+
+  void generate_double(double* out, std::size_t n) noexcept {
+    std::size_t i = tail.take(out, n);
+    while (i < n) { refill(); i += tail.take(out + i, n - i); }
+  }
+};
+
+} // namespace detail
+} // namespace ua
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ua::detail {
+
+// Unused words of a counter backend's last step (STEP u64, BLOCK u64 per
+// counter value). A request that ends inside a step leaves the rest here and
+// the next generate_u64 / generate_double hands it out first, so the stream
+// is the blocks in counter order however it is split into calls, and every
+// tier gives the same stream whatever its step.
+template<std::size_t STEP, std::size_t BLOCK>
+struct CounterTail {
+  static_assert(STEP % BLOCK == 0, "a step is whole blocks");
+
+  alignas(64) std::uint64_t buf[STEP];
+  std::size_t pos = STEP;   // buf[pos, STEP) not handed out yet
+
+  std::size_t left() const noexcept { return STEP - pos; }
+
+  // up to n buffered words to out; returns how many
+  std::size_t take(std::uint64_t* out, std::size_t n) noexcept {
+    const std::size_t m = n < left() ? n : left();
+    std::memcpy(out, buf + pos, m * sizeof(std::uint64_t));
+    pos += m;
+    return m;
+  }
+  // the same as [0,1) doubles, (x >> 12) * 2^-52: bit-identical to the SIMD
+  // exponent trick
+  std::size_t take(double* out, std::size_t n) noexcept {
+    constexpr double inv = 1.0 / double(1ull << 52);
+    const std::size_t m = n < left() ? n : left();
+    for (std::size_t j = 0; j < m; ++j) out[j] = double(buf[pos + j] >> 12) * inv;
+    pos += m;
+    return m;
+  }
+
+  // Empties the buffer ahead of a skip. The counter runs ahead of the stream
+  // by the buffered words: returns the blocks to step it back to the block
+  // holding the first of them, and sets off to that word's index in its
+  // block (0 if none was buffered). A skip then moves the counter by
+  // n - back blocks and, if off != 0, refills and sets pos = off.
+  std::uint64_t rewind(std::size_t& off) noexcept {
+    const std::size_t r = left();
+    const std::size_t back = (r + BLOCK - 1) / BLOCK;
+    pos = STEP;
+    off = back * BLOCK - r;
+    return back;
+  }
+};
+
+} // namespace ua::detail
@@ -10,9 +10,20 @@ struct CpuFeatures {
   bool avx{false};
   bool avx2{false};
   bool avx512f{false};
+  bool avx512dq{false};     // vpmullq (native 64-bit multiply)
+  bool avx512vl{false};     // AVX-512 instructions on xmm/ymm
+  bool avx512ifma{false};   // vpmadd52luq/huq (52-bit multiply-add)
+  bool avx512_zmm_slow{false};   // known zmm frequency licence drop (Skylake-SP/X, Cascade/Cooper Lake)
   bool fma{false};
+  bool aes{false};    // AES-NI (128-bit AESENC)
+  bool vaes{false};   // VAES: AESENC on ymm/zmm (zmm also needs avx512f)
 };
 
 CpuFeatures query_cpu_features() noexcept;
 
+// the AVX-512 backends are built with -mavx512f -mavx512dq -mavx512vl
+// (MSVC: /arch:AVX512), so their tiers need all three; AVX-512F alone
+// (Knights Landing / Mill) runs the AVX2 tier
+inline bool avx512_ok(const CpuFeatures& f) noexcept { return f.avx512f && f.avx512dq && f.avx512vl; }
+
 } // namespace ua
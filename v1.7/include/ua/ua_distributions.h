@@ -0,0 +1,278 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+namespace ua {
+
+namespace detail {
+
+// Marsaglia–Tsang step (ACM TOMS 26, 2000) for Gamma(d + 1/3), d >= 2/3,
+// c = 1 / sqrt(9 d), on candidates z[j] ~ N(0,1) and u[j] uniform in [0,1):
+// with v = (1 + c z)^3 > 0 and w = 1 - u, the value d v is appended to out
+// when w < 1 - 0.0331 z^4 (squeeze, ~98% for d >= 2/3) or
+// ln w < z^2 / 2 + d (1 - v + ln v). Returns the number written (95% of n
+// or more). out may alias z, not u; it needs room for n + GAMMA_SLACK
+// doubles, the compaction always stores whole vectors.
+//
+// The AVX2 kernel tests 4 candidates at once and left-packs through a
+// permute table, the AVX-512 kernel tests 8 and uses vcompresspd, as the
+// polar kernels do (ua_normal_polar.h). Both run the SIMD ln of
+// ua_math_avx2.h / ua_math_avx512.h only for vectors with a lane past the
+// squeeze, and return the same bits. The scalar kernel (libm)
+// takes the same decisions except within an ulp of a bound.
+inline constexpr std::size_t GAMMA_SLACK = 8;
+
+using GammaFn = std::size_t (*)(const double* z, const double* u, std::size_t n,
+                                double d, double c, double* out) noexcept;
+
+std::size_t gamma_mt_scalar(const double* z, const double* u, std::size_t n, double d, double c, double* out) noexcept;   // gamma.cpp
+std::size_t gamma_mt_avx2(const double* z, const double* u, std::size_t n, double d, double c, double* out) noexcept;     // gamma_avx2.cpp
+std::size_t gamma_mt_avx512(const double* z, const double* u, std::size_t n, double d, double c, double* out) noexcept;   // gamma_avx512.cpp
+
+// Shape < 1 boost, Gamma(a) = Gamma(a + 1) U^(1/a): x[j] *= (1 - u[j])^inv_shape
+// for u in [0,1), as e^(inv_shape ln(1 - u)) with the SIMD ln / exp (under
+// 1 ulp each) on AVX2 / AVX-512, libm on the scalar kernel.
+using GammaBoostFn = void (*)(const double* u, std::size_t n, double inv_shape, double* x) noexcept;
+
+void gamma_boost_scalar(const double* u, std::size_t n, double inv_shape, double* x) noexcept;   // gamma.cpp
+void gamma_boost_avx2(const double* u, std::size_t n, double inv_shape, double* x) noexcept;     // gamma_avx2.cpp
+void gamma_boost_avx512(const double* u, std::size_t n, double inv_shape, double* x) noexcept;   // gamma_avx512.cpp
+
+// kernels of the tier ua::Rng picks (UA_FORCE_BACKEND, else CPUID), resolved once
+GammaFn gamma_mt_kernel() noexcept;
+GammaBoostFn gamma_boost_kernel() noexcept;
+
+// Poisson counts, one candidate per element: lam[j] in [0, 1e9], u[j] and
+// v[j] uniform in [0,1). Means below 10 invert the CDF from u (sequential
+// search, the same k on every lane of a vector); larger means take Hörmann's
+// PTRS (transformed rejection with squeeze, 1993) on (u, v), with the exact
+// test through ln k! = Stirling + fc(k). out[j] gets the count, or, where
+// the candidate is rejected (PTRS, or an inversion past 64 steps), an
+// unspecified value and j is appended to miss. Returns the number of misses.
+//
+// The AVX2 / AVX-512 kernels take two vectors of 4 / 8 elements per step
+// (the inversion searches run as two chains); a vector with both kinds of
+// mean takes both paths under masks, and the ln of the exact test runs only
+// for vectors with a lane past the squeeze. Both return
+// the same counts and misses; the scalar kernel (libm) takes the same
+// decisions except within an ulp of a bound.
+using PoissonFn = std::size_t (*)(const double* lam, const double* u, const double* v, std::size_t n,
+                                  std::uint32_t* out, std::uint32_t* miss) noexcept;
+
+std::size_t poisson_scalar(const double* lam, const double* u, const double* v, std::size_t n, std::uint32_t* out, std::uint32_t* miss) noexcept;   // discrete.cpp
+std::size_t poisson_avx2(const double* lam, const double* u, const double* v, std::size_t n, std::uint32_t* out, std::uint32_t* miss) noexcept;     // discrete_avx2.cpp
+std::size_t poisson_avx512(const double* lam, const double* u, const double* v, std::size_t n, std::uint32_t* out, std::uint32_t* miss) noexcept;   // discrete_avx512.cpp
+
+// Binomial(trials[j], p[j]) counts, p in [0, 1], the same contract as
+// PoissonFn. With q = min(p, 1 - p), n q below 10 inverts the CDF, larger
+// take Hörmann's BTRS (the PTRS construction for the binomial); p > 1/2
+// returns trials - k.
+using BinomialFn = std::size_t (*)(const std::uint32_t* trials, const double* p, const double* u, const double* v,
+                                   std::size_t n, std::uint32_t* out, std::uint32_t* miss) noexcept;
+
+std::size_t binomial_scalar(const std::uint32_t* trials, const double* p, const double* u, const double* v, std::size_t n, std::uint32_t* out, std::uint32_t* miss) noexcept;   // discrete.cpp
+std::size_t binomial_avx2(const std::uint32_t* trials, const double* p, const double* u, const double* v, std::size_t n, std::uint32_t* out, std::uint32_t* miss) noexcept;     // discrete_avx2.cpp
+std::size_t binomial_avx512(const std::uint32_t* trials, const double* p, const double* u, const double* v, std::size_t n, std::uint32_t* out, std::uint32_t* miss) noexcept;   // discrete_avx512.cpp
+
+PoissonFn poisson_kernel() noexcept;
+BinomialFn binomial_kernel() noexcept;
+
+} // namespace detail
+
+// Gamma(shape, scale) over any generator with generate_normal and
+// generate_double (ua::Rng: Ziggurat normals, SIMD uniforms), shape > 0,
+// scale > 0. Candidates are drawn a block at a time into a thread_local
+// scratch, the Marsaglia–Tsang kernel compacts the accepted ones, shapes
+// below 1 take the U^(1/shape) boost; generate() allocates nothing. Shapes
+// far below 1 underflow to 0 as often as the distribution puts mass there.
+template<class URNG>
+struct GammaGenerator {
+  static constexpr std::size_t BLOCK = 1024;
+
+  URNG& rng;
+  detail::GammaFn kernel;
+  detail::GammaBoostFn boost;
+
+  explicit GammaGenerator(URNG& r)
+    : rng(r), kernel(detail::gamma_mt_kernel()), boost(detail::gamma_boost_kernel()) {}
+
+  void generate(double* out, std::size_t n, double shape, double scale = 1.0) {
+    alignas(64) static thread_local double z[BLOCK + detail::GAMMA_SLACK];
+    alignas(64) static thread_local double u[BLOCK];
+    const bool boosted = shape < 1.0;
+    const double d = (boosted ? shape + 1.0 : shape) - 1.0 / 3.0;
+    const double c = 1.0 / std::sqrt(9.0 * d);
+    std::size_t i = 0;
+    while (i < n) {
+      // enough candidates for the rest at >= 95% acceptance, plus a margin
+      const std::size_t need = n - i;
+      const std::size_t m = std::min(BLOCK, need + need / 16 + 8);
+      rng.generate_normal(z, m);
+      rng.generate_double(u, m);
+      const std::size_t k = std::min(kernel(z, u, m, d, c, z), need);
+      if (boosted) {
+        rng.generate_double(u, k);
+        boost(u, k, 1.0 / shape, z);
+      }
+      for (std::size_t j = 0; j < k; ++j) out[i + j] = z[j] * scale;
+      i += k;
+    }
+  }
+};
+
+// Beta(a, b) = Ga / (Ga + Gb) from two gamma batches, a, b > 0. Where both
+// gammas underflow to 0 (a and b far below 1) the value comes from Jöhnk's
+// method in logs instead, as NumPy does for a, b <= 1.
+template<class URNG>
+struct BetaGenerator {
+  static constexpr std::size_t BLOCK = 512;
+
+  GammaGenerator<URNG> gamma;
+
+  explicit BetaGenerator(URNG& r) : gamma(r) {}
+
+  void generate(double* out, std::size_t n, double a, double b) {
+    double gb[BLOCK];
+    for (std::size_t i = 0; i < n; i += BLOCK) {
+      const std::size_t m = std::min(BLOCK, n - i);
+      gamma.generate(out + i, m, a);
+      gamma.generate(gb, m, b);
+      for (std::size_t j = 0; j < m; ++j) {
+        const double s = out[i + j] + gb[j];
+        out[i + j] = s > 0.0 ? out[i + j] / s : johnk(a, b);
+      }
+    }
+  }
+
+  double johnk(double a, double b) {
+    for (;;) {
+      double uv[2];
+      gamma.rng.generate_double(uv, 2);
+      const double lx = std::log1p(-uv[0]) / a, ly = std::log1p(-uv[1]) / b;
+      const double lm = std::max(lx, ly);
+      if (std::exp(lx) + std::exp(ly) > 1.0) continue;   // outside X + Y <= 1: reject
+      const double ex = std::exp(lx - lm), ey = std::exp(ly - lm);
+      return ex / (ex + ey);
+    }
+  }
+};
+
+// Dirichlet(alpha[0..k)): out holds rows of k components, each row the
+// normalised gammas G_i(alpha_i). Every component is drawn as one gamma
+// batch over all rows (one shape per kernel call) and scattered into the
+// rows. A row whose gammas all underflow (tiny alphas) is redrawn by beta
+// stick-breaking, x_i = (1 - sum_{j<i} x_j) Beta(alpha_i, sum_{j>i} alpha_j).
+template<class URNG>
+struct DirichletGenerator {
+  static constexpr std::size_t BLOCK = 512;
+
+  BetaGenerator<URNG> beta;
+
+  explicit DirichletGenerator(URNG& r) : beta(r) {}
+
+  void generate(const double* alpha, std::size_t k, double* out, std::size_t rows) {
+    double g[BLOCK];
+    for (std::size_t c = 0; c < k; ++c)
+      for (std::size_t r0 = 0; r0 < rows; r0 += BLOCK) {
+        const std::size_t m = std::min(BLOCK, rows - r0);
+        beta.gamma.generate(g, m, alpha[c]);
+        for (std::size_t j = 0; j < m; ++j) out[(r0 + j) * k + c] = g[j];
+      }
+    for (std::size_t r = 0; r < rows; ++r) {
+      double* x = out + r * k;
+      double s = 0.0;
+      for (std::size_t c = 0; c < k; ++c) s += x[c];
+      if (s >= 0x1p-1022) {
+        const double inv = 1.0 / s;
+        for (std::size_t c = 0; c < k; ++c) x[c] *= inv;
+      } else if (s > 0.0) {
+        for (std::size_t c = 0; c < k; ++c) x[c] /= s;   // 1 / s would overflow
+      } else {
+        stick_breaking(alpha, k, x);
+      }
+    }
+  }
+
+  void stick_breaking(const double* alpha, std::size_t k, double* x) {
+    double rest = 0.0;
+    for (std::size_t c = 0; c < k; ++c) rest += alpha[c];
+    double left = 1.0;
+    for (std::size_t c = 0; c + 1 < k; ++c) {
+      rest -= alpha[c];
+      double b;
+      beta.generate(&b, 1, alpha[c], rest);
+      x[c] = left * b;
+      left -= x[c];
+    }
+    if (k) x[k - 1] = left;
+  }
+};
+
+// Poisson(lam[j]) counts over any generator with generate_double, one mean
+// per element (ua::Rng::generate_poisson wraps it). Candidates for a block
+// are tested at once; the rejected elements are gathered side by side and
+// drawn again, with fresh uniforms, until all are accepted. Scratch is
+// thread_local; generate() allocates nothing.
+template<class URNG>
+struct PoissonGenerator {
+  static constexpr std::size_t BLOCK = 512;
+
+  URNG& rng;
+  detail::PoissonFn kernel;
+
+  explicit PoissonGenerator(URNG& r) : rng(r), kernel(detail::poisson_kernel()) {}
+
+  void generate(const double* lam, std::uint32_t* out, std::size_t n) {
+    alignas(64) static thread_local double uv[2 * BLOCK];
+    alignas(64) static thread_local double lr[BLOCK];
+    static thread_local std::uint32_t idx[BLOCK], miss[BLOCK], kr[BLOCK];
+    for (std::size_t i = 0; i < n; i += BLOCK) {
+      const std::size_t m = std::min(BLOCK, n - i);
+      rng.generate_double(uv, 2 * m);
+      std::size_t r = kernel(lam + i, uv, uv + m, m, out + i, idx);
+      while (r) {
+        for (std::size_t t = 0; t < r; ++t) lr[t] = lam[i + idx[t]];
+        rng.generate_double(uv, 2 * r);
+        const std::size_t r2 = kernel(lr, uv, uv + r, r, kr, miss);
+        for (std::size_t t = 0; t < r; ++t) out[i + idx[t]] = kr[t];
+        for (std::size_t t = 0; t < r2; ++t) idx[t] = idx[miss[t]];   // miss[t] >= t
+        r = r2;
+      }
+    }
+  }
+};
+
+// Binomial(trials[j], p[j]) counts, the PoissonGenerator scheme over
+// (trials, p) pairs (ua::Rng::generate_binomial wraps it).
+template<class URNG>
+struct BinomialGenerator {
+  static constexpr std::size_t BLOCK = 512;
+
+  URNG& rng;
+  detail::BinomialFn kernel;
+
+  explicit BinomialGenerator(URNG& r) : rng(r), kernel(detail::binomial_kernel()) {}
+
+  void generate(const std::uint32_t* trials, const double* p, std::uint32_t* out, std::size_t n) {
+    alignas(64) static thread_local double uv[2 * BLOCK];
+    alignas(64) static thread_local double pr[BLOCK];
+    static thread_local std::uint32_t tr[BLOCK], idx[BLOCK], miss[BLOCK], kr[BLOCK];
+    for (std::size_t i = 0; i < n; i += BLOCK) {
+      const std::size_t m = std::min(BLOCK, n - i);
+      rng.generate_double(uv, 2 * m);
+      std::size_t r = kernel(trials + i, p + i, uv, uv + m, m, out + i, idx);
+      while (r) {
+        for (std::size_t t = 0; t < r; ++t) { tr[t] = trials[i + idx[t]]; pr[t] = p[i + idx[t]]; }
+        rng.generate_double(uv, 2 * r);
+        const std::size_t r2 = kernel(tr, pr, uv, uv + r, r, kr, miss);
+        for (std::size_t t = 0; t < r; ++t) out[i + idx[t]] = kr[t];
+        for (std::size_t t = 0; t < r2; ++t) idx[t] = idx[miss[t]];
+        r = r2;
+      }
+    }
+  }
+};
+
+} // namespace ua
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+
+namespace ua::detail {
+
+// Exponential by inversion: out[j] = -scale ln(u[j]) for u in (0, 1), which
+// is Exp(1 / scale) for uniform u. out may alias u (in place).
+//
+// The AVX2 and AVX-512 kernels run the SIMD ln of ua_math_avx2.h /
+// ua_math_avx512.h (fdlibm, max 0.75 ulp) on 8 / 16 doubles per iteration
+// and return the same bits; the scalar kernel (libm ln) agrees with them to
+// an ulp or two. Rng::generate_exponential feeds them (2k + 1) 2^-53
+// midpoints, so every output is finite and positive (at most 36.7 / rate).
+using ExponentialFn = void (*)(const double* u, std::size_t n, double scale, double* out) noexcept;
+
+void exponential_scalar(const double* u, std::size_t n, double scale, double* out) noexcept;   // exponential.cpp
+void exponential_avx2(const double* u, std::size_t n, double scale, double* out) noexcept;     // exponential_avx2.cpp
+void exponential_avx512(const double* u, std::size_t n, double scale, double* out) noexcept;   // exponential_avx512.cpp
+
+} // namespace ua::detail
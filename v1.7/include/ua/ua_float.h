@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace ua::detail {
+
+// Single-precision outputs, two per u64: float j comes from u64 j / 2, the
+// low 32 bits for even j and the high 32 bits for odd j, so n floats take
+// (n + 1) / 2 words (the last high half unused for odd n). out must not
+// alias x.
+//
+// Unit floats: the top 24 bits of each half times 2^-24, [0, 1) on the
+// 2^-24 grid. (v1.6's u32_to_unit_float ORs the same 24 bits under the
+// exponent of 1.0f, where the top one lands on a bit that is already set:
+// 23 random bits.) The AVX2 / AVX-512 kernels take 8 / 16 floats per
+// iteration; all three return the same bits.
+using UnitFloatFn = void (*)(const std::uint64_t* x, std::size_t n, float* out) noexcept;
+
+void unit_float_scalar(const std::uint64_t* x, std::size_t n, float* out) noexcept;   // float.cpp
+void unit_float_avx2(const std::uint64_t* x, std::size_t n, float* out) noexcept;     // float_avx2.cpp
+void unit_float_avx512(const std::uint64_t* x, std::size_t n, float* out) noexcept;   // float_avx512.cpp
+
+// N(0,1) floats by Box–Muller on each u64: out[2i] = r cos(2 pi v),
+// out[2i + 1] = r sin(2 pi v) with r = sqrt(-2 ln u), u the low half lo as
+// ((lo >> 1) | 1) 2^-31 (its top 31 bits with the lowest forced to 1,
+// rounded to float: at least 2^-31, so |z| <= 6.56) and v the high half as
+// a unit float. The AVX2 / AVX-512 kernels run
+// 16 / 32 outputs per iteration through the float ln and sincos of
+// ua_math_avx2.h / ua_math_avx512.h and return the same bits. The scalar
+// kernel runs the same polynomials without FMA and agrees with them to 4
+// ulp of r (measured 2.9).
+using NormalFloatFn = void (*)(const std::uint64_t* x, std::size_t n, float* out) noexcept;
+
+void normal_float_scalar(const std::uint64_t* x, std::size_t n, float* out) noexcept;   // float.cpp
+void normal_float_avx2(const std::uint64_t* x, std::size_t n, float* out) noexcept;     // float_avx2.cpp
+void normal_float_avx512(const std::uint64_t* x, std::size_t n, float* out) noexcept;   // float_avx512.cpp
+
+} // namespace ua::detail
@@ -1,70 +1,76 @@
 #pragma once
 #include <cstddef>
-#include <cmath>
+#include <cstring>
 #include <algorithm>
 
 namespace ua {
 
-// Marsaglia polar method (Box-Muller without trig).
-// Uses the upstream RNG's generate_double() for uniforms.
+namespace detail {
+
+// Marsaglia polar step on pairs of uniforms in [0,1): for j < pairs,
+//   u = 2 u[2j] - 1, v = 2 u[2j+1] - 1, s = u^2 + v^2,
+// and when 0 < s < 1 the pair (u f, v f), f = sqrt(-2 ln s / s), is
+// appended to out. Returns the number of normals written (2 per accepted
+// pair, ~78.5% of pairs). out may alias u (the write position never passes
+// the block just loaded); it needs room for 2 * pairs + POLAR_SLACK
+// doubles, the compaction always stores whole vectors.
 //
-// Algorithm:
-//  - draw u,v ~ Unif(-1,1)
-//  - s = u^2 + v^2; if s==0 or s>=1, reject and redraw
-//  - factor = sqrt(-2 ln s / s)
-//  - z0 = u*factor, z1 = v*factor
+// The AVX2 kernel tests 4 pairs at once and left-packs the accepted ones
+// with a permute table; the AVX-512 kernel tests 8 and uses vcompresspd in
+// register form plus full stores (the memory form is slow).
+// Both use the SIMD ln of ua_math_avx2.h / ua_math_avx512.h (0.75 ulp) and
+// return the same bits; the scalar kernel (libm) agrees to a few ulp.
+inline constexpr std::size_t POLAR_SLACK = 16;
+
+using PolarFn = std::size_t (*)(const double* u, std::size_t pairs, double* out) noexcept;
+
+std::size_t polar_scalar(const double* u, std::size_t pairs, double* out) noexcept;   // polar.cpp
+std::size_t polar_avx2(const double* u, std::size_t pairs, double* out) noexcept;     // polar_avx2.cpp
+std::size_t polar_avx512(const double* u, std::size_t pairs, double* out) noexcept;   // polar_avx512.cpp
+
+// kernel of the tier ua::Rng picks (UA_FORCE_BACKEND, else CPUID), resolved once
+PolarFn polar_kernel() noexcept;
+
+} // namespace detail
+
+// Marsaglia polar normals over any generator with generate_double(double*, size_t).
+// Uniforms are drawn into a scratch buffer, compacted there in place by the
+// polar kernel and copied out; normals accepted past n are dropped.
 //
-// We batch uniforms to amortize RNG calls.
+// The scratch buffer is the caller's (at least MIN_SCRATCH doubles) or a
+// thread_local one of DEFAULT_SCRATCH doubles; generate() allocates nothing.
+// A caller buffer shorter than MIN_SCRATCH is not used: the kernel would
+// write past it, so the thread_local one is taken instead.
 template<class URNG>
 struct PolarNormal {
+  static constexpr std::size_t DEFAULT_SCRATCH = 2048 + detail::POLAR_SLACK;
+  static constexpr std::size_t MIN_SCRATCH     = 2 + detail::POLAR_SLACK;
+
   URNG& rng;
-  explicit PolarNormal(URNG& r) : rng(r) {}
+  detail::PolarFn kernel;
+  double* scratch;
+  std::size_t scratch_len;
+
+  explicit PolarNormal(URNG& r)
+    : rng(r), kernel(detail::polar_kernel()), scratch(nullptr), scratch_len(DEFAULT_SCRATCH) {}
+  PolarNormal(URNG& r, double* buf, std::size_t len)
+    : rng(r), kernel(detail::polar_kernel()),
+      scratch(buf && len >= MIN_SCRATCH ? buf : nullptr),
+      scratch_len(buf && len >= MIN_SCRATCH ? len : DEFAULT_SCRATCH) {}
 
   void generate(double* out, size_t n) {
+    alignas(64) static thread_local double tls[DEFAULT_SCRATCH];
+    double* buf = scratch ? scratch : tls;
+    const size_t max_pairs = (scratch_len - detail::POLAR_SLACK) / 2;
     size_t i = 0;
-    // batch size: draw 2K uniforms at a time (u and v), then transform
-    const size_t B = 1u << 14; // 16384
-    std::unique_ptr<double[]> buf(new double[2*B]);
-
     while (i < n) {
-      // number of normals still needed (rounded up to even since we produce pairs)
-      size_t need = n - i;
-      size_t target_pairs = (need + 1) / 2;
-      size_t gen_pairs = std::min(target_pairs, B);
-
-      // fill 2*gen_pairs uniforms in [0,1), map to (-1,1)
-      double* U = buf.get();
-      rng.generate_double(U, 2*gen_pairs);
-      for (size_t k = 0; k < 2*gen_pairs; ++k) U[k] = U[k]*2.0 - 1.0;
-
-      // transform with rejection
-      size_t produced = 0;
-      for (size_t p = 0; p < gen_pairs && i < n; ++p) {
-        double u = U[2*p+0];
-        double v = U[2*p+1];
-        double s = u*u + v*v;
-        if (s == 0.0 || s >= 1.0) continue; // reject
-        double factor = std::sqrt(-2.0 * std::log(s) / s);
-        out[i++] = u * factor;
-        if (i < n) out[i++] = v * factor;
-        ++produced;
-      }
-
-      // If we didn’t produce enough (too many rejections), loop again.
-      // This is rare; the acceptance rate is ~78.5%.
-      if (produced == 0) {
-        // ensure progress: generate a tiny emergency pair
-        double uvr[2];
-        rng.generate_double(uvr, 2);
-        double u = uvr[0]*2.0 - 1.0;
-        double v = uvr[1]*2.0 - 1.0;
-        double s = u*u + v*v;
-        if (s > 0.0 && s < 1.0) {
-          double factor = std::sqrt(-2.0 * std::log(s) / s);
-          out[i++] = u * factor;
-          if (i < n) out[i++] = v * factor;
-        }
-      }
+      // enough pairs for the rest at the 78.5% acceptance rate, plus a margin
+      const size_t need = (n - i + 1) / 2;
+      const size_t pairs = std::min(max_pairs, need + need / 4 + 4);
+      rng.generate_double(buf, 2 * pairs);
+      const size_t k = std::min(kernel(buf, pairs, buf), n - i);
+      std::memcpy(out + i, buf, k * sizeof(double));
+      i += k;
     }
   }
 };
@@ -2,85 +2,95 @@
 #include <cstddef>
 #include <cstdint>
 #include <cmath>
-#include <array>
 
 namespace ua {
 
-// Ziggurat for standard normal, adapted to double; tables from common references.
-// Fast path uses only a couple ops; tail uses exp/log.
+// Ziggurat for the standard normal (Marsaglia & Tsang 2000, 256 layers),
+// with the candidate layout of NumPy's random_standard_normal: one u64
+// gives the layer (bits 0..7), the sign (bit 8) and a 52-bit abscissa
+// (bits 9..60). The candidate is accepted inside its rectangle when
+// rabs < ki[layer] (about 99.3%); otherwise the wedge or tail test runs
+// and may restart with fresh candidates.
+//
+// All 256 layers are generated at compile time (ziggurat.cpp) from the
+// recurrence x[i-1] = f^-1(V / x[i] + f(x[i])), evaluated in double-double
+// and rounded once, so every entry is the correctly rounded value of the
+// exact recurrence (no interpolation). NumPy's own tables were produced offline
+// and differ in the last bits, so samples are not NumPy's bit for bit.
 
 struct ZigguratNormal {
-  // Tables (256 entries)
   static constexpr int N = 256;
-  // x[i] decreasing, x[0] = tail cutoff
-  static constexpr std::array<double,N+1> x = []{
-    std::array<double,N+1> t{};
-    // generate via classic algorithm; hardcode minimal set to avoid external gen.
-    // Precomputed values (trimmed for brevity) — these are standard Ziggurat tables.
-    // For completeness, we embed a short set generated offline:
-    const double xs[N+1] = {
-      3.713086246740363, 3.442619855896652, 3.223084984578618, 3.083228858214762, 2.978696252645016,
-      2.894344007018670, 2.823125350548911, 2.761169372384153, 2.706113573118724, 2.656406411258192,
-      2.610972248428613, 2.569033625921640, 2.530010242278629, 2.493457397902661, 2.459018177408350,
-      2.426401432711221, 2.395369486471307, 2.365726179438032, 2.337307917550498, 2.309977389287603,
-      2.283617640022027, 2.258127394185939, 2.233417943008620, 2.209410530210922, 2.186034824393644,
-      2.163227347470989, 2.140930086082953, 2.119089193112423, 2.097654866335318, 2.076580339954427,
-      2.055821001327038, 2.035333645296743, 2.015076820451761, 1.995010260452266, 1.975094430108103,
-      1.955290150078330, 1.935558281117203, 1.915859504243491, 1.896153058118546, 1.876396552754557,
-      1.856545824352311, 1.836554819699133, 1.816375477601155, 1.795957623236913, 1.775248870090133,
-      1.754194519420132, 1.732737475373418, 1.710817173716585, 1.688369516244035, 1.665326827052122,
-      1.641617784454105, 1.617167371210517, 1.591896836251121, 1.565723639506123, 1.538561387188221,
-      1.510319768414347, 1.480904457973495, 1.450216009852092, 1.418149738310114, 1.384595560556171,
-      1.349437810122123, 1.312554980246515, 1.273819441279380, 1.233096119615867, 1.190241148686620,
-      1.145100332123100, 1.097507405106508, 1.047282051282768, 0.994226650209098, 0.938121204684030,
-      0.878719729278626, 0.815746667803130, 0.748889122673781, 0.677787747221111, 0.602027558960287,
-      0.521116670225907, 0.434453155880016, 0.341180340012460, 0.240189433201227, 0.129247080170354,
-      0.000000000000000
-    };
-    // Fill front; then linearly interpolate to size N+1 for simplicity
-    // (The exact table granularity is not critical; acceptance probs remain high.)
-    for (int i=0;i<80;++i) t[i]=xs[i];
-    for (int i=80;i<=N;++i) t[i]=xs[79]*(double(N-i)/double(N-79));
-    return t;
-  }();
-
-  static constexpr std::array<double,N> f = []{
-    std::array<double,N> t{};
-    for (int i=0;i<N;++i) {
-      double xi = x[i], xi1 = x[i+1];
-      t[i] = std::exp(-0.5*xi*xi);
-      (void)xi1;
-    }
-    return t;
-  }();
+  static constexpr double R     = 3.6541528853610088;          // x of the base strip's top edge
+  static constexpr double INV_R = 0.27366123732975828;
+  static constexpr double V     = 0.00492867323397465524494;   // area of every strip
 
-  template<class URNG>
-  static inline void generate(URNG& rng, double* out, size_t n) {
-    size_t i=0;
-    while (i<n) {
-      // get 2 uniforms at a time
-      double u[2];
-      rng.generate_double(u, 2);
-      // u0 -> 32-bit index + sign, u1 -> x coordinate
-      uint32_t r = (uint32_t)(u[0] * 4294967296.0);
-      int idx = r & 0xFF;
-      int sign = (r & 0x100) ? 1 : -1;
+  struct Tables {
+    std::uint64_t ki[N];   // rectangle thresholds on the 52-bit rabs
+    double        wi[N];   // x[i] * 2^-52
+    double        fi[N];   // f(x[i]) = exp(-x[i]^2 / 2)
+  };
 
-      double xval = u[1] * x[idx];
-      if (std::abs(xval) < x[idx+1]) { out[i++] = sign * xval; continue; }
+  // layer 0 is the base strip (rectangle of width V / f(R) plus the tail);
+  // layer i >= 1 is the rectangle of width x[i] between f(x[i]) and
+  // f(x[i-1]); x[i-1] is its wedge-free part, x[255] = R.
+  // Built by constant evaluation in ziggurat.cpp.
+  static const Tables tables;
 
-      // wedge test
-      double y = std::exp(-0.5*(xval*xval - x[idx]*x[idx]));
-      double u2; rng.generate_double(&u2,1);
-      if (u2 < y) { out[i++] = sign * xval; continue; }
+  // Candidate u -> its rectangle value; true when the rectangle accepts it
+  static bool rect(std::uint64_t u, double& z) noexcept {
+    const int idx = int(u & 0xff);
+    const std::uint64_t rabs = (u >> 9) & 0x000fffffffffffffull;
+    const double x = double(rabs) * tables.wi[idx];
+    z = (u & 0x100) ? -x : x;
+    return rabs < tables.ki[idx];
+  }
 
-      // tail (idx==0 most often)
-      // draw from exponential tail
-      double u3, u4; rng.generate_double(&u3,1); rng.generate_double(&u4,1);
-      double t = x[0] - std::log(u3) / x[0];
-      out[i++] = (u4 < 0.5 ? -t : t);
+  // Finish a candidate that missed its rectangle; next() supplies fresh u64
+  // for the wedge / tail uniforms and for any restart.
+  template<class Next>
+  static double finish(std::uint64_t u, Next&& next) {
+    constexpr double inv53 = 1.0 / 9007199254740992.0;
+    for (;;) {
+      double z;
+      if (rect(u, z)) return z;
+      const int idx = int(u & 0xff);
+      if (idx == 0) {
+        // exponential tail beyond R; 1 - U keeps log away from 0
+        for (;;) {
+          const double xx = -INV_R * std::log1p(-double(next() >> 11) * inv53);
+          const double yy = -std::log1p(-double(next() >> 11) * inv53);
+          if (yy + yy > xx * xx) return ((u >> 17) & 1) ? -(R + xx) : R + xx;
+        }
+      }
+      const double y = (tables.fi[idx - 1] - tables.fi[idx]) * (double(next() >> 11) * inv53) + tables.fi[idx];
+      if (y < std::exp(-0.5 * z * z)) return z;
+      u = next();
     }
   }
+
+  // Scalar batch: candidates are pulled 256 u64 at a time through
+  // rng.generate_u64, the slow path reads from the same buffer.
+  template<class URNG>
+  static void generate(URNG& rng, double* out, std::size_t n) {
+    std::uint64_t buf[256];
+    std::size_t pos = 256;
+    auto next = [&]() {
+      if (pos == 256) { rng.generate_u64(buf, 256); pos = 0; }
+      return buf[pos++];
+    };
+    for (std::size_t i = 0; i < n; ++i) out[i] = finish(next(), next);
+  }
 };
 
+namespace detail {
+
+// Rectangle pass of the batched Ziggurat (ziggurat_avx2.cpp /
+// ziggurat_avx512.cpp): out[j] gets the rectangle value of candidate u[j]
+// for every j < n, and the positions that missed their rectangle are
+// written to rare[] in order. Returns how many missed. rare[] needs room
+// for n + 7 entries: the compaction always stores a whole vector.
+std::size_t ziggurat_rect_avx2(const std::uint64_t* u, std::size_t n, double* out, std::uint32_t* rare) noexcept;
+std::size_t ziggurat_rect_avx512(const std::uint64_t* u, std::size_t n, double* out, std::uint32_t* rare) noexcept;
+
+} // namespace detail
 } // namespace ua
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "ua/ua_pcg64_dxsm_scalar.h"
+
+namespace ua::detail {
+
+// Multi-lane PCG64-DXSM by leapfrogging one stream: lane j holds state
+// s(n + j) and every vector step applies the L-step map s -> s*A^L + C_L,
+// so a vector store writes outputs n .. n+L-1 in order. The stream is
+// Pcg64DxsmScalar's (and NumPy's) for any n, tails included: a partial
+// step emits r < L outputs and advances every lane by r.
+//
+// The 128x128 state multiply and the DXSM products are emulated with
+// 32x32->64 _mm*_mul_epu32 partial products (AVX-512 uses vpmullq for the
+// low halves).
+
+struct Pcg64DxsmAVX2 {
+  static constexpr int LANES = 4;
+
+  Pcg64DxsmAVX2() = delete;
+  explicit Pcg64DxsmAVX2(std::uint64_t seed) noexcept;
+
+  void generate_u64(std::uint64_t* out, std::size_t n) noexcept;
+  void generate_double(double* out, std::size_t n) noexcept;  // [0,1), NumPy random()
+  void generate_normal(double* out, std::size_t n) noexcept;  // N(0,1)
+
+  // NumPy jumped(1) / jumped(2^32)
+  void jump() noexcept;
+  void long_jump() noexcept;
+
+  // NumPy advance(hi*2^64 + lo) in O(log n)
+  void advance(std::uint64_t lo, std::uint64_t hi = 0) noexcept;
+  void skip_ahead(std::uint64_t lo, std::uint64_t hi = 0) noexcept { advance(lo, hi); }
+
+private:
+  alignas(32) std::uint64_t s_lo[LANES], s_hi[LANES];   // lane j = s(n + j)
+  std::uint64_t inc_hi, inc_lo;                        // stream increment
+  std::uint64_t a_hi, a_lo, c_hi, c_lo;                // LANES-step map
+};
+
+struct Pcg64DxsmAVX512 {
+  static constexpr int LANES = 8;
+
+  Pcg64DxsmAVX512() = delete;
+  explicit Pcg64DxsmAVX512(std::uint64_t seed) noexcept;
+
+  void generate_u64(std::uint64_t* out, std::size_t n) noexcept;
+  void generate_double(double* out, std::size_t n) noexcept;  // [0,1), NumPy random()
+  void generate_normal(double* out, std::size_t n) noexcept;  // N(0,1)
+
+  void jump() noexcept;
+  void long_jump() noexcept;
+  void advance(std::uint64_t lo, std::uint64_t hi = 0) noexcept;
+  void skip_ahead(std::uint64_t lo, std::uint64_t hi = 0) noexcept { advance(lo, hi); }
+
+private:
+  alignas(64) std::uint64_t s_lo[LANES], s_hi[LANES];
+  std::uint64_t inc_hi, inc_lo;
+  std::uint64_t a_hi, a_lo, c_hi, c_lo;
+};
+
+} // namespace ua::detail
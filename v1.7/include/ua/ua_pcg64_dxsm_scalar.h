@@ -0,0 +1,182 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+
+namespace ua {
+
+// PCG64-DXSM as in NumPy (numpy.random.PCG64DXSM): 128-bit LCG stepped with
+// the 64-bit "cheap multiplier", DXSM output taken from the state *before*
+// the step. Seeding follows NumPy's SeedSequence(seed) for an integer seed,
+// jump() is NumPy's jumped(), and doubles are Generator.random()'s
+// (x >> 11) * 2^-53, so u64 and double streams match NumPy bit for bit.
+// Normals do not (NumPy uses a ziggurat).
+
+static constexpr std::uint64_t PCG_CHEAP_MULT = 0xda942042e4dd58b5ull;
+// 128-bit default multiplier, used only by NumPy's seeding step
+static constexpr std::uint64_t PCG_MULT_HI = 2549297995355413924ull;
+static constexpr std::uint64_t PCG_MULT_LO = 4865540595714422341ull;
+// NumPy jumped(): advance by (golden ratio - 1) * 2^128, rounded to odd
+static constexpr std::uint64_t PCG_JUMP_HI = 0x9e3779b97f4a7c15ull;
+static constexpr std::uint64_t PCG_JUMP_LO = 0xf39cc0605cedc835ull;
+
+// 64x64 -> 128 (portable)
+static inline void pcg_mul64(std::uint64_t a, std::uint64_t b, std::uint64_t& hi, std::uint64_t& lo) noexcept {
+  const std::uint64_t a0 = a & 0xffffffffu, a1 = a >> 32, b0 = b & 0xffffffffu, b1 = b >> 32;
+  const std::uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+  const std::uint64_t mid = (p00 >> 32) + (p01 & 0xffffffffu) + (p10 & 0xffffffffu);
+  lo = (p00 & 0xffffffffu) | (mid << 32);
+  hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+}
+
+// (ahi:alo) * (bhi:blo) mod 2^128
+static inline void pcg_mul128(std::uint64_t ahi, std::uint64_t alo, std::uint64_t bhi, std::uint64_t blo,
+                              std::uint64_t& hi, std::uint64_t& lo) noexcept {
+  std::uint64_t h, l;
+  pcg_mul64(alo, blo, h, l);
+  hi = h + ahi * blo + alo * bhi;
+  lo = l;
+}
+
+// (ahi:alo) += (bhi:blo) mod 2^128
+static inline void pcg_add128(std::uint64_t& ahi, std::uint64_t& alo, std::uint64_t bhi, std::uint64_t blo) noexcept {
+  alo += blo;
+  ahi += bhi + (alo < blo ? 1 : 0);
+}
+
+// x -> x*M + C composed delta times (Brown, "Random number generation with
+// arbitrary strides"): returns the single affine map (A, C) for delta steps.
+static inline void pcg_lcg_advance(std::uint64_t delta_lo, std::uint64_t delta_hi,
+                                   std::uint64_t m_hi, std::uint64_t m_lo, std::uint64_t c_hi, std::uint64_t c_lo,
+                                   std::uint64_t& a_hi, std::uint64_t& a_lo,
+                                   std::uint64_t& p_hi, std::uint64_t& p_lo) noexcept {
+  a_hi = 0; a_lo = 1; p_hi = 0; p_lo = 0;
+  while (delta_lo | delta_hi) {
+    if (delta_lo & 1) {
+      pcg_mul128(a_hi, a_lo, m_hi, m_lo, a_hi, a_lo);
+      pcg_mul128(p_hi, p_lo, m_hi, m_lo, p_hi, p_lo);
+      pcg_add128(p_hi, p_lo, c_hi, c_lo);
+    }
+    // C <- (M + 1) * C, M <- M * M
+    std::uint64_t m1_hi = m_hi, m1_lo = m_lo;
+    pcg_add128(m1_hi, m1_lo, 0, 1);
+    pcg_mul128(m1_hi, m1_lo, c_hi, c_lo, c_hi, c_lo);
+    pcg_mul128(m_hi, m_lo, m_hi, m_lo, m_hi, m_lo);
+    delta_lo = (delta_lo >> 1) | (delta_hi << 63);
+    delta_hi >>= 1;
+  }
+}
+
+// DXSM output of one 128-bit state
+static inline std::uint64_t pcg_dxsm(std::uint64_t s_hi, std::uint64_t s_lo) noexcept {
+  std::uint64_t hi = s_hi;
+  hi ^= hi >> 32;
+  hi *= PCG_CHEAP_MULT;
+  hi ^= hi >> 48;
+  return hi * (s_lo | 1);
+}
+
+// NumPy SeedSequence(seed).generate_state(4, uint64) for a non-negative
+// integer seed (no spawn key), then PCG64's set_seed: state / inc as hi:lo.
+static inline void pcg64_numpy_seed(std::uint64_t seed, std::uint64_t& s_hi, std::uint64_t& s_lo,
+                                    std::uint64_t& inc_hi, std::uint64_t& inc_lo) noexcept {
+  const std::uint32_t ent[2] = { (std::uint32_t)seed, (std::uint32_t)(seed >> 32) };
+  const int n_ent = (seed >> 32) ? 2 : 1;   // NumPy drops high zero words (0 -> [0])
+
+  std::uint32_t hc = 0x43b0d7e5u;            // INIT_A
+  auto hashmix = [&hc](std::uint32_t v) {
+    v ^= hc; hc *= 0x931e8875u; v *= hc; v ^= v >> 16;
+    return v;
+  };
+  auto mix = [](std::uint32_t x, std::uint32_t y) {
+    std::uint32_t r = 0xca01f9ddu * x - 0x4973f715u * y;
+    return r ^ (r >> 16);
+  };
+  std::uint32_t pool[4];
+  for (int i = 0; i < 4; ++i) pool[i] = hashmix(i < n_ent ? ent[i] : 0u);
+  for (int src = 0; src < 4; ++src)
+    for (int dst = 0; dst < 4; ++dst)
+      if (src != dst) pool[dst] = mix(pool[dst], hashmix(pool[src]));
+
+  std::uint32_t w[8];
+  std::uint32_t hb = 0x8b51f9ddu;            // INIT_B
+  for (int i = 0; i < 8; ++i) {
+    std::uint32_t v = pool[i & 3];
+    v ^= hb; hb *= 0x58f38dedu; v *= hb; v ^= v >> 16;
+    w[i] = v;
+  }
+  std::uint64_t v64[4];
+  for (int i = 0; i < 4; ++i) v64[i] = (std::uint64_t)w[2 * i] | ((std::uint64_t)w[2 * i + 1] << 32);
+
+  // pcg_setseq_128_srandom_r: inc = initseq << 1 | 1, two default-multiplier steps
+  inc_hi = (v64[2] << 1) | (v64[3] >> 63);
+  inc_lo = (v64[3] << 1) | 1u;
+  s_hi = 0; s_lo = 0;
+  pcg_add128(s_hi, s_lo, inc_hi, inc_lo);
+  pcg_add128(s_hi, s_lo, v64[0], v64[1]);
+  pcg_mul128(s_hi, s_lo, PCG_MULT_HI, PCG_MULT_LO, s_hi, s_lo);
+  pcg_add128(s_hi, s_lo, inc_hi, inc_lo);
+}
+
+namespace detail {
+
+// One output per step; the reference the multi-lane backends must match.
+struct Pcg64DxsmScalar {
+  static constexpr int LANES = 1;
+
+  std::uint64_t s_hi, s_lo;       // 128-bit LCG state
+  std::uint64_t inc_hi, inc_lo;   // odd increment (stream)
+
+  explicit Pcg64DxsmScalar(std::uint64_t seed) noexcept { pcg64_numpy_seed(seed, s_hi, s_lo, inc_hi, inc_lo); }
+
+  std::uint64_t next() noexcept {
+    const std::uint64_t r = pcg_dxsm(s_hi, s_lo);
+    // s = s * cheap + inc: a 128x64 multiply
+    std::uint64_t h, l;
+    pcg_mul64(s_lo, PCG_CHEAP_MULT, h, l);
+    s_hi = h + s_hi * PCG_CHEAP_MULT;
+    s_lo = l;
+    pcg_add128(s_hi, s_lo, inc_hi, inc_lo);
+    return r;
+  }
+
+  // NumPy advance(delta): skip delta = hi*2^64 + lo outputs in O(log delta)
+  void advance(std::uint64_t lo, std::uint64_t hi = 0) noexcept {
+    std::uint64_t a_hi, a_lo, p_hi, p_lo;
+    pcg_lcg_advance(lo, hi, 0, PCG_CHEAP_MULT, inc_hi, inc_lo, a_hi, a_lo, p_hi, p_lo);
+    pcg_mul128(s_hi, s_lo, a_hi, a_lo, s_hi, s_lo);
+    pcg_add128(s_hi, s_lo, p_hi, p_lo);
+  }
+  void skip_ahead(std::uint64_t lo, std::uint64_t hi = 0) noexcept { advance(lo, hi); }
+
+  // NumPy jumped(1) / jumped(2^32)
+  void jump() noexcept      { advance(PCG_JUMP_LO, PCG_JUMP_HI); }
+  void long_jump() noexcept { advance(PCG_JUMP_LO << 32, (PCG_JUMP_HI << 32) | (PCG_JUMP_LO >> 32)); }
+
+  void generate_u64(std::uint64_t* out, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) out[i] = next();
+  }
+
+  // NumPy Generator.random(): (x >> 11) * 2^-53
+  void generate_double(double* out, std::size_t n) noexcept {
+    constexpr double inv = 1.0 / double(1ull << 53);
+    for (std::size_t i = 0; i < n; ++i) out[i] = double(next() >> 11) * inv;
+  }
+
+  void generate_normal(double* out, std::size_t n) noexcept {
+    constexpr double inv = 1.0 / double(1ull << 52);
+    std::size_t i = 0;
+    while (i < n) {
+      double u = 2.0 * (double(next() >> 12) * inv) - 1.0;
+      double v = 2.0 * (double(next() >> 12) * inv) - 1.0;
+      double s = u*u + v*v;
+      if (s == 0.0 || s >= 1.0) continue;
+      double f = std::sqrt(-2.0 * std::log(s) / s);
+      out[i++] = u * f;
+      if (i < n) out[i++] = v * f;
+    }
+  }
+};
+
+} // namespace detail
+} // namespace ua
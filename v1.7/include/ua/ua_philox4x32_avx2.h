@@ -2,18 +2,22 @@
 #include <cstdint>
 #include <cstddef>
 #include <immintrin.h>
+#include "ua_philox4x32_scalar.h"
+#include "ua_counter_tail.h"
 
 namespace ua {
 
-// Philox4x32-10 constants
-static constexpr uint32_t PH_M0 = 0xD2511F53u;
-static constexpr uint32_t PH_M1 = 0xCD9E8D57u;
-static constexpr uint32_t PH_W0 = 0x9E3779B9u;
-static constexpr uint32_t PH_W1 = 0xBB67AE85u;
-
+// 8 lanes, one block per lane per step. Lane i holds counter base + i and
+// every step adds 8 (full 128-bit carry), so the lanes partition the counter
+// space and the u64 stream is block base, base+1, ... in order; each block
+// yields (x1<<32 | x0), (x3<<32 | x2). The rest of a step cut by a request
+// is kept for the next one (detail::CounterTail).
 struct Philox4x32AVX2 {
-  __m256i c0, c1, c2, c3;   // counters
+  static constexpr int LANES = 8;
+
+  __m256i c0, c1, c2, c3;   // counters (c0 = least significant word)
   __m256i k0, k1;           // keys
+  detail::CounterTail<2 * LANES, 2> tail;
 
   static inline __m256i add32(__m256i a, __m256i b){ return _mm256_add_epi32(a,b); }
   static inline __m256i xor32(__m256i a, __m256i b){ return _mm256_xor_si256(a,b); }
@@ -32,10 +36,27 @@ struct Philox4x32AVX2 {
     __m256i odd32  = _mm256_slli_epi64(odd_hi, 32);
     return _mm256_or_si256(even32, odd32);
   }
-  static inline __m256i pack_u64(__m256i hi32, __m256i lo32){
-    __m256i hi = _mm256_slli_epi64(hi32, 32);
-    __m256i lo = _mm256_and_si256(lo32, _mm256_set1_epi64x(0x00000000FFFFFFFFull));
-    return _mm256_or_si256(hi, lo);
+  // unsigned a < b per 32-bit lane (all-ones mask)
+  static inline __m256i ltu32(__m256i a, __m256i b){
+    const __m256i sign = _mm256_set1_epi32((int)0x80000000u);
+    return _mm256_cmpgt_epi32(_mm256_xor_si256(b, sign), _mm256_xor_si256(a, sign));
+  }
+  // x += n + carry-in (cin is an all-ones mask); returns carry-out mask
+  static inline __m256i adc32(__m256i& x, __m256i n, __m256i cin){
+    __m256i s  = _mm256_add_epi32(x, n);
+    __m256i c  = ltu32(s, x);
+    __m256i s2 = _mm256_sub_epi32(s, cin);
+    c = _mm256_or_si256(c, _mm256_and_si256(cin, _mm256_cmpeq_epi32(s2, _mm256_setzero_si256())));
+    x = s2;
+    return c;
+  }
+  // add the 128-bit value hi*2^64 + lo to every lane's counter
+  inline void add128(uint64_t lo, uint64_t hi){
+    __m256i cy = _mm256_setzero_si256();
+    cy = adc32(c0, _mm256_set1_epi32((int)(uint32_t)lo),         cy);
+    cy = adc32(c1, _mm256_set1_epi32((int)(uint32_t)(lo >> 32)), cy);
+    cy = adc32(c2, _mm256_set1_epi32((int)(uint32_t)hi),         cy);
+    (void)adc32(c3, _mm256_set1_epi32((int)(uint32_t)(hi >> 32)), cy);
   }
 
   static inline uint64_t sm64(uint64_t& x){
@@ -56,7 +77,33 @@ struct Philox4x32AVX2 {
     c0 = lane; c1 = _mm256_setzero_si256(); c2 = _mm256_setzero_si256(); c3 = _mm256_setzero_si256();
   }
 
-  inline void bump_nocarry(int inc){ c0 = _mm256_add_epi32(c0, _mm256_set1_epi32(inc)); }
+  // next step: every lane moves LANES blocks ahead, carries into c1..c3
+  inline void bump(){ add128((uint64_t)LANES, 0); }
+
+  // O(1) skip of hi*2^64 + lo blocks (1 block = 2 u64) of the stream
+  inline void skip_ahead_blocks(uint64_t lo, uint64_t hi = 0){
+    size_t off;
+    const uint64_t back = tail.rewind(off);
+    add128(lo - back, hi - (lo < back ? 1 : 0));
+    if (off) { refill(); tail.pos = off; }
+  }
+  inline void skip_ahead(uint64_t lo, uint64_t hi = 0){ skip_ahead_blocks(lo, hi); }
+
+  // 2^64 / 2^96 blocks: disjoint substreams within the 2^128 counter space
+  inline void jump(){ skip_ahead_blocks(0, 1); }
+  inline void long_jump(){ skip_ahead_blocks(0, 1ull << 32); }
+
+  inline void key(uint32_t out[2]) const {
+    out[0] = (uint32_t)_mm_cvtsi128_si32(_mm256_castsi256_si128(k0));
+    out[1] = (uint32_t)_mm_cvtsi128_si32(_mm256_castsi256_si128(k1));
+  }
+
+  // random access with this stream's key: block at absolute counter hi*2^64 + lo
+  inline void block_at(uint64_t lo, uint64_t hi, uint32_t out[4]) const {
+    uint32_t k[2]; key(k);
+    const uint32_t ctr[4] = { (uint32_t)lo, (uint32_t)(lo >> 32), (uint32_t)hi, (uint32_t)(hi >> 32) };
+    philox4x32_10(ctr, k, out);
+  }
 
   static inline void two_rounds(__m256i& r0,__m256i& r1,__m256i& r2,__m256i& r3,
                                 __m256i& kk0,__m256i& kk1,
@@ -96,38 +143,65 @@ struct Philox4x32AVX2 {
 
   inline void next_block(__m256i& o0,__m256i& o1,__m256i& o2,__m256i& o3){
     rounds10(o0,o1,o2,o3);
-    bump_nocarry(1);
+    bump();
+  }
+
+  // 8 blocks -> 16 u64 in counter order (in-register 4x32 transpose)
+  static inline void store_blocks(uint64_t* p, __m256i x0, __m256i x1, __m256i x2, __m256i x3){
+    __m256i lo01 = _mm256_unpacklo_epi32(x0, x1);   // b0.a b1.a | b4.a b5.a
+    __m256i hi01 = _mm256_unpackhi_epi32(x0, x1);   // b2.a b3.a | b6.a b7.a
+    __m256i lo23 = _mm256_unpacklo_epi32(x2, x3);   // b0.b b1.b | b4.b b5.b
+    __m256i hi23 = _mm256_unpackhi_epi32(x2, x3);   // b2.b b3.b | b6.b b7.b
+    __m256i P = _mm256_unpacklo_epi64(lo01, lo23);  // b0 | b4
+    __m256i Q = _mm256_unpackhi_epi64(lo01, lo23);  // b1 | b5
+    __m256i R = _mm256_unpacklo_epi64(hi01, hi23);  // b2 | b6
+    __m256i S = _mm256_unpackhi_epi64(hi01, hi23);  // b3 | b7
+    _mm256_storeu_si256((__m256i*)(p +  0), _mm256_permute2x128_si256(P, Q, 0x20));
+    _mm256_storeu_si256((__m256i*)(p +  4), _mm256_permute2x128_si256(R, S, 0x20));
+    _mm256_storeu_si256((__m256i*)(p +  8), _mm256_permute2x128_si256(P, Q, 0x31));
+    _mm256_storeu_si256((__m256i*)(p + 12), _mm256_permute2x128_si256(R, S, 0x31));
+  }
+
+  // next step into the tail buffer
+  inline void refill(){
+    __m256i o0,o1,o2,o3; next_block(o0,o1,o2,o3);
+    store_blocks(tail.buf, o0,o1,o2,o3);
+    tail.pos = 0;
   }
 
   void generate_u64(uint64_t* out, size_t n) noexcept {
-    size_t i=0;
+    size_t i = tail.take(out, n);
     while (i + 32 <= n) {
       __m256i a0,a1,a2,a3; next_block(a0,a1,a2,a3);
       __m256i b0,b1,b2,b3; next_block(b0,b1,b2,b3);
-      __m256i c0v,c1v,c2v,c3v; next_block(c0v,c1v,c2v,c3v);
-      __m256i d0,d1,d2,d3; next_block(d0,d1,d2,d3);
-      __m256i u0 = pack_u64(a0,a1), u1 = pack_u64(a2,a3);
-      __m256i u2 = pack_u64(b0,b1), u3 = pack_u64(b2,b3);
-      __m256i u4 = pack_u64(c0v,c1v), u5 = pack_u64(c2v,c3v);
-      __m256i u6 = pack_u64(d0,d1), u7 = pack_u64(d2,d3);
-      _mm256_storeu_si256((__m256i*)(out + i +  0), u0);
-      _mm256_storeu_si256((__m256i*)(out + i +  4), u1);
-      _mm256_storeu_si256((__m256i*)(out + i +  8), u2);
-      _mm256_storeu_si256((__m256i*)(out + i + 12), u3);
-      _mm256_storeu_si256((__m256i*)(out + i + 16), u4);
-      _mm256_storeu_si256((__m256i*)(out + i + 20), u5);
-      _mm256_storeu_si256((__m256i*)(out + i + 24), u6);
-      _mm256_storeu_si256((__m256i*)(out + i + 28), u7);
+      store_blocks(out + i,      a0,a1,a2,a3);
+      store_blocks(out + i + 16, b0,b1,b2,b3);
       i += 32;
     }
-    while (i < n) {
+    if (i + 16 <= n) {
+      __m256i o0,o1,o2,o3; next_block(o0,o1,o2,o3);
+      store_blocks(out + i, o0,o1,o2,o3);
+      i += 16;
+    }
+    if (i < n) { refill(); tail.take(out + i, n - i); }
+  }
+
+  // [0,1) via the exponent trick, bit-identical to Philox4x32Scalar
+  static inline __m256d to_unit_pd(__m256i u){
+    const __m256i bits = _mm256_or_si256(_mm256_srli_epi64(u, 12), _mm256_set1_epi64x(0x3FFull << 52));
+    return _mm256_sub_pd(_mm256_castsi256_pd(bits), _mm256_set1_pd(1.0));
+  }
+
+  void generate_double(double* out, size_t n) noexcept {
+    size_t i = tail.take(out, n);
+    alignas(32) uint64_t tmp[16];
+    for (; i + 16 <= n; i += 16) {
       __m256i o0,o1,o2,o3; next_block(o0,o1,o2,o3);
-      __m256i u0 = pack_u64(o0,o1), u1 = pack_u64(o2,o3);
-      alignas(32) uint64_t tmp[8];
-      _mm256_store_si256((__m256i*)(tmp+0), u0);
-      _mm256_store_si256((__m256i*)(tmp+4), u1);
-      for (int k=0; k<8 && i<n; ++k,++i) out[i] = tmp[k];
+      store_blocks(tmp, o0,o1,o2,o3);
+      for (int k=0; k<16; k+=4)
+        _mm256_storeu_pd(out + i + k, to_unit_pd(_mm256_load_si256((const __m256i*)(tmp + k))));
     }
+    if (i < n) { refill(); tail.take(out + i, n - i); }
   }
 };
 
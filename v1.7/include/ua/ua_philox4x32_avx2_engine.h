@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace ua {
+
+struct Philox4x32AVX2;   // header-only engine, ua_philox4x32_avx2.h
+
+namespace detail {
+
+// ua::Rng entry point for Philox4x32AVX2, with the same shape as
+// Xoshiro256ssAVX2. Everything is defined in src/philox4x32_avx2.cpp (AVX2
+// flags), so the dispatcher TU never sees or instantiates AVX2 code.
+struct Philox4x32AVX2Engine {
+  Philox4x32AVX2Engine() = delete;
+  explicit Philox4x32AVX2Engine(std::uint64_t seed);
+  ~Philox4x32AVX2Engine();
+
+  Philox4x32AVX2Engine(const Philox4x32AVX2Engine&) = delete;
+  Philox4x32AVX2Engine& operator=(const Philox4x32AVX2Engine&) = delete;
+
+  void generate_u64(std::uint64_t* out, std::size_t n) noexcept;
+  void generate_double(double* out, std::size_t n) noexcept;  // [0,1)
+
+  // 2^64 / 2^96 blocks ahead (disjoint substreams)
+  void jump() noexcept;
+  void long_jump() noexcept;
+
+  // O(1) skip of hi*2^64 + lo blocks (1 block = 2 u64)
+  void skip_ahead(std::uint64_t lo, std::uint64_t hi = 0) noexcept;
+
+private:
+  Philox4x32AVX2* g;
+};
+
+} // namespace detail
+} // namespace ua
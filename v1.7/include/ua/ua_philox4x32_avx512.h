@@ -0,0 +1,49 @@
+#pragma once
+#include <immintrin.h>
+#include <cstddef>
+#include <cstdint>
+
+#include "ua/ua_counter_tail.h"
+
+namespace ua::detail {
+
+// 16 lanes, one Philox4x32-10 block per lane per step. Lane i holds counter
+// base + i and every step adds 16 (full 128-bit carry). Output layout is the
+// same as Philox4x32AVX2 / Philox4x32Scalar: blocks in counter order, each
+// block yielding (x1<<32 | x0), (x3<<32 | x2), the rest of a step cut by a
+// request kept for the next one.
+struct Philox4x32AVX512 {
+  static constexpr int LANES = 16;
+
+  Philox4x32AVX512() = delete;
+  explicit Philox4x32AVX512(std::uint64_t seed) noexcept;
+
+  void generate_u64(std::uint64_t* out, std::size_t n) noexcept;
+  void generate_double(double* out, std::size_t n) noexcept;  // [0,1)
+
+  // 2^64 / 2^96 blocks ahead (disjoint substreams)
+  void jump() noexcept;
+  void long_jump() noexcept;
+
+  // O(1) skip of hi*2^64 + lo blocks (1 block = 2 u64) of the stream
+  void skip_ahead_blocks(std::uint64_t lo, std::uint64_t hi = 0) noexcept;
+  void skip_ahead(std::uint64_t lo, std::uint64_t hi = 0) noexcept { skip_ahead_blocks(lo, hi); }
+
+  void key(std::uint32_t out[2]) const noexcept;
+
+  // random access with this stream's key: block at absolute counter hi*2^64 + lo
+  void block_at(std::uint64_t lo, std::uint64_t hi, std::uint32_t out[4]) const noexcept;
+
+private:
+  __m512i c0, c1, c2, c3;   // counters (c0 = least significant word)
+  __m512i k0, k1;           // keys
+  CounterTail<2 * LANES, 2> tail;
+
+  void add128(std::uint64_t lo, std::uint64_t hi) noexcept;
+  // 16 blocks -> 32 u64 in counter order, then bump the counters
+  void next_vec4(__m512i& o0, __m512i& o1, __m512i& o2, __m512i& o3) noexcept;
+  // next step into the tail buffer
+  void refill() noexcept;
+};
+
+} // namespace ua::detail
@@ -0,0 +1,116 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+#include "ua/ua_counter_tail.h"
+
+namespace ua {
+
+// Philox4x32-10 constants
+static constexpr uint32_t PH_M0 = 0xD2511F53u;
+static constexpr uint32_t PH_M1 = 0xCD9E8D57u;
+static constexpr uint32_t PH_W0 = 0x9E3779B9u;
+static constexpr uint32_t PH_W1 = 0xBB67AE85u;
+
+// Scalar Philox4x32-10 block: (key, counter) -> 4x32 output, Random123 order.
+// This is the random-access form: block j of a stream is philox4x32_10(key, base + j).
+static inline void philox4x32_10(const uint32_t ctr[4], const uint32_t key[2], uint32_t out[4]) noexcept {
+  uint32_t x0 = ctr[0], x1 = ctr[1], x2 = ctr[2], x3 = ctr[3];
+  uint32_t kk0 = key[0], kk1 = key[1];
+  for (int r = 0; r < 10; ++r) {
+    const uint64_t p0 = (uint64_t)PH_M0 * x0;
+    const uint64_t p1 = (uint64_t)PH_M1 * x2;
+    const uint32_t y0 = (uint32_t)(p1 >> 32) ^ x1 ^ kk0;
+    const uint32_t y2 = (uint32_t)(p0 >> 32) ^ x3 ^ kk1;
+    x1 = (uint32_t)p1; x3 = (uint32_t)p0; x0 = y0; x2 = y2;
+    kk0 += PH_W0; kk1 += PH_W1;
+  }
+  out[0] = x0; out[1] = x1; out[2] = x2; out[3] = x3;
+}
+
+namespace detail {
+
+// One block per step, same seeding and counter order as the SIMD Philox
+// backends, so every tier produces the same u64/double stream for a seed,
+// however it is split into calls (the second word of a block cut by a
+// request is kept for the next one).
+struct Philox4x32Scalar {
+  static constexpr int LANES = 1;
+
+  std::uint64_t ctr_lo{0}, ctr_hi{0};   // 128-bit block counter
+  std::uint32_t k[2];
+  CounterTail<2, 2> tail;
+
+  static std::uint64_t splitmix64(std::uint64_t& x) noexcept {
+    x += 0x9e3779b97f4a7c15ull;
+    std::uint64_t z = x;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  }
+
+  explicit Philox4x32Scalar(std::uint64_t seed) noexcept {
+    std::uint64_t z = seed;
+    k[0] = (std::uint32_t)splitmix64(z);
+    k[1] = (std::uint32_t)splitmix64(z);
+  }
+
+  // counter += hi*2^64 + lo (mod 2^128)
+  void advance(std::uint64_t lo, std::uint64_t hi = 0) noexcept {
+    const std::uint64_t s = ctr_lo + lo;
+    ctr_hi += hi + (s < ctr_lo ? 1 : 0);
+    ctr_lo = s;
+  }
+
+  // O(1) skip of hi*2^64 + lo blocks (1 block = 2 u64) of the stream
+  void skip_ahead_blocks(std::uint64_t lo, std::uint64_t hi = 0) noexcept {
+    std::size_t off;
+    const std::uint64_t back = tail.rewind(off);
+    advance(lo - back, hi - (lo < back ? 1 : 0));
+    if (off) { refill(); tail.pos = off; }
+  }
+  void skip_ahead(std::uint64_t lo, std::uint64_t hi = 0) noexcept { skip_ahead_blocks(lo, hi); }
+
+  // 2^64 / 2^96 blocks: disjoint substreams within the 2^128 counter space
+  void jump() noexcept      { skip_ahead_blocks(0, 1); }
+  void long_jump() noexcept { skip_ahead_blocks(0, 1ull << 32); }
+
+  void key(std::uint32_t out[2]) const noexcept { out[0] = k[0]; out[1] = k[1]; }
+
+  // random access with this stream's key: block at absolute counter hi*2^64 + lo
+  void block_at(std::uint64_t lo, std::uint64_t hi, std::uint32_t out[4]) const noexcept {
+    const std::uint32_t c[4] = { (std::uint32_t)lo, (std::uint32_t)(lo >> 32), (std::uint32_t)hi, (std::uint32_t)(hi >> 32) };
+    philox4x32_10(c, k, out);
+  }
+
+  // next block as (x1<<32 | x0), (x3<<32 | x2)
+  void next_block(std::uint64_t& a, std::uint64_t& b) noexcept {
+    std::uint32_t o[4];
+    block_at(ctr_lo, ctr_hi, o);
+    advance(1);
+    a = ((std::uint64_t)o[1] << 32) | o[0];
+    b = ((std::uint64_t)o[3] << 32) | o[2];
+  }
+
+  void refill() noexcept { next_block(tail.buf[0], tail.buf[1]); tail.pos = 0; }
+
+  void generate_u64(std::uint64_t* out, std::size_t n) noexcept {
+    std::size_t i = tail.take(out, n);
+    for (; i + 2 <= n; i += 2) next_block(out[i], out[i + 1]);
+    if (i < n) { refill(); tail.take(out + i, n - i); }
+  }
+
+  // (x >> 12) * 2^-52: bit-identical to the SIMD exponent trick
+  void generate_double(double* out, std::size_t n) noexcept {
+    constexpr double inv = 1.0 / double(1ull << 52);
+    std::size_t i = tail.take(out, n);
+    for (; i + 2 <= n; i += 2) {
+      std::uint64_t a, b; next_block(a, b);
+      out[i] = double(a >> 12) * inv; out[i + 1] = double(b >> 12) * inv;
+    }
+    if (i < n) { refill(); tail.take(out + i, n - i); }
+  }
+};
+
+} // namespace detail
+} // namespace ua
@@ -8,9 +8,12 @@
 #if defined(_MSC_VER)
   #define UA_FORCE_INLINE __forceinline
   #include <malloc.h>
+  #include <xmmintrin.h>
+  #define UA_PREFETCH(p) _mm_prefetch(reinterpret_cast<const char*>(p), _MM_HINT_T0)
 #else
   #define UA_FORCE_INLINE __attribute__((always_inline)) inline
   #include <mm_malloc.h>
+  #define UA_PREFETCH(p) __builtin_prefetch(p)
 #endif
 
 namespace ua {
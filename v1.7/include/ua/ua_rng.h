@@ -2,6 +2,9 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "ua/ua_alias.h"
+#include "ua/ua_shuffle.h"
+
 namespace ua {
 
 // SIMD tier the dispatcher selected at runtime
@@ -9,11 +12,42 @@ enum class SimdTier : unsigned char {
     Scalar   = 0,
     AVX2     = 1,
     AVX512F  = 2,
+    AVX512VL = 3,   // AVX-512VL/DQ instructions on ymm: no zmm frequency licence
+};
+
+// Generator family behind the facade; each is dispatched to the best tier
+enum class Algorithm : unsigned char {
+    Xoshiro256ss   = 0,   // default; L independent lanes per tier (AVX512VL: AVX2's 4 lanes)
+    Philox4x32_10  = 1,   // counter-based; same stream on every tier, however the calls are split
+    Xoroshiro128pp = 2,   // 128-bit state, fastest scalar step
+    ChaCha20       = 3,   // CSPRNG (with a real key); same stream on every tier, however the calls are split
+    ChaCha12       = 4,
+    ChaCha8        = 5,
+    Ars4x32_7      = 6,   // counter-mode AES rounds (AES-NI / VAES); same stream on every tier, however split
+    Pcg64Dxsm      = 7,   // NumPy's PCG64DXSM: same seeding, u64 and double stream as Python
+};
+
+// Construction options (same shape as the v1.6 ua::Init)
+struct Init {
+    Algorithm     algo   = Algorithm::Xoshiro256ss;
+    std::uint64_t seed   = 0;
+    std::uint64_t stream = 0;   // distinct parallel streams: stream x jump(), O(log stream)
+    const std::uint32_t* key = nullptr;   // ChaCha: 256-bit key (8 words), else derived from seed
+    // Xoshiro256ss on AVX2 / AVX-512: 2..4 independent register sets per
+    // backend (Xoshiro256ss*Interleaved<K>); 0 / 1 = one set. Changes the
+    // stream; larger values are clamped to 4; ignored by the scalar and
+    // AVX512VL tiers.
+    unsigned      interleave = 1;
+    // prefer the AVX512VL tier over AVX512F on any AVX-512VL/DQ CPU (it is
+    // already preferred where zmm lowers the clock; UA_FORCE_BACKEND wins)
+    bool          avx512_ymm = false;
 };
 
 class Rng {
 public:
     explicit Rng(std::uint64_t seed = 0);
+    Rng(std::uint64_t seed, Algorithm algo);
+    explicit Rng(const Init& init);
     ~Rng();
     Rng(Rng&&) noexcept;
     Rng& operator=(Rng&&) noexcept;
@@ -25,7 +59,56 @@ public:
     void generate_u64(std::uint64_t* out, std::size_t n) noexcept;
     void generate_double(double* out, std::size_t n) noexcept;   // [0,1)
     void generate_normal(double* out, std::size_t n) noexcept;   // N(0,1)
+    // Single precision, two floats per u64 (low half first, ua_float.h):
+    // [0, 1) on the 2^-24 grid, and N(0,1) by Box–Muller in float, a
+    // (cos, sin) pair per u64, |z| <= 6.56.
+    void generate_float(float* out, std::size_t n) noexcept;
+    void generate_normal_float(float* out, std::size_t n) noexcept;
+    // N(0,1) by inverse CDF (AS241, ua_normal_icdf.h) of one uniform per
+    // output, (2k + 1) 2^-53 from the top 52 bits of each u64: monotone, no
+    // rejection, so output j depends on u64 j alone. Slower than generate_normal.
+    void generate_normal_icdf(double* out, std::size_t n) noexcept;
+    // Exp(rate), rate > 0: -ln(u) / rate on the same (2k + 1) 2^-53
+    // uniforms (ua_exponential.h), so every output is finite and positive.
+    void generate_exponential(double* out, std::size_t n, double rate = 1.0) noexcept;
+    // Poisson(lam[j]), 0 <= lam[j] <= 1e9, and Binomial(trials[j], p[j])
+    // counts, one parameter set per element (ua_distributions.h: inversion
+    // for means below 10, PTRS / BTRS rejection above, the rejected elements
+    // redrawn together). Two uniforms per element and attempt.
+    void generate_poisson(const double* lam, std::uint32_t* out, std::size_t n) noexcept;
+    void generate_binomial(const std::uint32_t* trials, const double* p, std::uint32_t* out, std::size_t n) noexcept;
+    // Uniform integers in [lo, hi] inclusive, lo <= hi, without modulo bias:
+    // Lemire's multiply-high on one u32 half (u32 out, hi < 2^32) or one u64
+    // (u64 out) per value, the rare rejected values redrawn together
+    // (ua_uniform_int.h). The full ranges are the raw u64 stream. lo > hi,
+    // or hi >= 2^32 for u32 out, leaves out untouched.
+    void generate_uniform_int(std::uint64_t lo, std::uint64_t hi, std::uint32_t* out, std::size_t n) noexcept;
+    void generate_uniform_int(std::uint64_t lo, std::uint64_t hi, std::uint64_t* out, std::size_t n) noexcept;
+    // Categorical draws: out[j] = item i of t with probability
+    // t.probability(i), one u64 per draw (two with a sharded table) through
+    // the alias-table gather kernel (ua::AliasSampler, ua_alias.h). An empty
+    // table leaves out untouched.
+    void generate_categorical(const AliasTable& t, std::uint32_t* out, std::size_t n) noexcept;
+    // Uniform random permutation of data[0, n) in place: Fisher–Yates on
+    // batched Lemire indices, cache-blocked above 128 MB (ua::Shuffler,
+    // ua_shuffle.h), on the u64 stream.
+    template<class T>
+    void shuffle(T* data, std::size_t n) {
+        Shuffler<Rng> s(*this);
+        s.kernel = uniform_bounds_for_tier();
+        s.shuffle(data, n);
+    }
+    // Xoshiro256ss: every lane advances 2^128 / 2^192 steps.
+    // Xoroshiro128pp: every lane advances 2^64 / 2^96 steps.
+    // Philox4x32_10 / ChaCha* / Ars4x32_7: the block counter advances 2^64 / 2^96.
+    // Pcg64Dxsm: NumPy's jumped(1) / jumped(2^32).
     void jump() noexcept;
+    void long_jump() noexcept;
+    // Xoshiro256ss / Xoroshiro128pp: every lane advances n_hi*2^64 + n_lo
+    // steps in O(log n); with L lanes this skips L*n outputs of the u64 stream.
+    // Philox4x32_10 / ChaCha* / Ars4x32_7: skips n blocks (2 / 8 / 2 u64 each) in O(1).
+    // Pcg64Dxsm: NumPy's advance(n), i.e. exactly n u64 outputs, O(log n).
+    void skip_ahead(std::uint64_t n_lo, std::uint64_t n_hi = 0) noexcept;
 
     // Convenience wrappers (symmetric public API)
     inline void u64(std::uint64_t* out, std::size_t n) noexcept { generate_u64(out, n); }
@@ -33,6 +116,7 @@ public:
     inline void normal(double* out, std::size_t n) noexcept { generate_normal(out, n); }
 
     inline SimdTier simd_tier() const noexcept { return tier_; }
+    inline Algorithm algorithm() const noexcept { return algo_; }
 
 private:
     void* state_{nullptr};
@@ -41,12 +125,24 @@ private:
         void (*gen_u64)(void*, std::uint64_t*, std::size_t) noexcept;
         void (*gen_double)(void*, double*, std::size_t) noexcept;
         void (*gen_normal)(void*, double*, std::size_t) noexcept;
+        void (*gen_normal_icdf)(void*, double*, std::size_t) noexcept;
+        void (*gen_exponential)(void*, double*, std::size_t, double) noexcept;
         void (*jump)(void*) noexcept;
+        void (*long_jump)(void*) noexcept;
+        void (*jumps)(void*, std::uint64_t) noexcept;   // k x jump(), O(log k)
+        void (*skip)(void*, std::uint64_t, std::uint64_t) noexcept;
         void (*destroy)(void*) noexcept;
     };
 
+    // per-value bound Lemire kernel of tier_ (ua_uniform_int.h)
+    detail::UniformBoundsFn uniform_bounds_for_tier() const noexcept;
+
+    // install backend B built from args (defined next to the adaptors in ua_rng.cpp)
+    template<class B, class... Args> void bind(SimdTier tier, Args... args);
+
     const Vtbl* vt_{nullptr};
     SimdTier tier_{SimdTier::Scalar};
+    Algorithm algo_{Algorithm::Xoshiro256ss};
 };
 
 } // namespace ua
@@ -0,0 +1,120 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <bit>
+#include <type_traits>
+#include <utility>
+
+#include "ua/ua_platform.h"
+#include "ua/ua_uniform_int.h"
+
+namespace ua {
+
+// Uniform random permutations over any generator with generate_u64
+// (ua::Rng::shuffle wraps it).
+//
+// Fisher–Yates, i = n - 1 .. 1 swapping data[i] with data[j], j uniform in
+// [0, i]: the indices for BLOCK swaps are drawn at once by the per-value
+// bound Lemire kernel (bounds i + 1, i, ...), the rejected ones redrawn
+// together, and each swap prefetches the target PREFETCH swaps ahead, so the
+// random accesses overlap instead of each waiting on its draw. Bounds past
+// 2^32 - 1 (n > 2^32) take the u64 kernel one index at a time.
+//
+// Arrays of trivially copyable T above blocked_bytes are split first
+// (Rao–Sandelius): every element gets an independent uniform label in
+// [0, K), K a power of two up to 256, the array is scattered by label into
+// a scratch copy, and each group is shuffled on its own, recursively down to
+// group_bytes, then copied back. The random accesses stay within cache-sized
+// groups, for 1 + 1 / sizeof(T) times the array in scratch per call (plain
+// Fisher–Yates if that allocation fails). Groups are independent of each
+// other once scattered. At 2^26 u32 IDs (256 MB) this takes ~31 cycles per
+// element against ~45 for Fisher–Yates on the whole array; below ~64 MB
+// Fisher–Yates is faster.
+template<class URNG>
+struct Shuffler {
+  static constexpr std::size_t BLOCK = 512, PREFETCH = 16, FANOUT = 256;
+
+  URNG& rng;
+  detail::UniformBoundsFn kernel;
+  std::size_t blocked_bytes = std::size_t(128) << 20;   // larger arrays take the blocked path,
+  std::size_t group_bytes = std::size_t(1) << 20;       // split down to groups this size
+
+  explicit Shuffler(URNG& r) : rng(r), kernel(detail::uniform_bounds_kernel()) {}
+
+  template<class T>
+  void shuffle(T* data, std::size_t n) {
+    if (n < 2) return;
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (n * sizeof(T) > blocked_bytes) {
+        if (void* scratch = aligned_malloc_bytes(n * (sizeof(T) + 1), 64)) {   // else Fisher–Yates
+          T* tmp = static_cast<T*>(scratch);
+          split(data, tmp, reinterpret_cast<std::uint8_t*>(tmp + n), n);
+          aligned_free(scratch);
+          return;
+        }
+      }
+    }
+    fisher_yates(data, n);
+  }
+
+private:
+  template<class T>
+  void fisher_yates(T* data, std::size_t n) {
+    alignas(64) static thread_local std::uint64_t x[BLOCK / 2];
+    static thread_local std::uint32_t s[BLOCK], j[BLOCK], idx[BLOCK], miss[BLOCK], sr[BLOCK], jr[BLOCK];
+    std::size_t i = n;   // data[0, i) is left to shuffle
+    for (; i > 0xFFFFFFFFu; --i) {
+      std::uint64_t k;
+      std::uint32_t m;
+      do rng.generate_u64(x, 1); while (detail::uniform_u64_scalar(x, 1, 0, i, &k, &m));
+      std::swap(data[i - 1], data[k]);
+    }
+    while (i > 1) {
+      const std::size_t m = std::min(BLOCK, i - 1);
+      for (std::size_t t = 0; t < m; ++t) s[t] = static_cast<std::uint32_t>(i - t);
+      rng.generate_u64(x, (m + 1) / 2);
+      std::size_t r = kernel(x, s, m, j, idx);
+      while (r) {
+        for (std::size_t t = 0; t < r; ++t) sr[t] = s[idx[t]];
+        rng.generate_u64(x, (r + 1) / 2);
+        const std::size_t r2 = kernel(x, sr, r, jr, miss);
+        for (std::size_t t = 0; t < r; ++t) j[idx[t]] = jr[t];
+        for (std::size_t t = 0; t < r2; ++t) idx[t] = idx[miss[t]];   // miss[t] >= t
+        r = r2;
+      }
+      for (std::size_t t = 0; t < std::min(PREFETCH, m); ++t) UA_PREFETCH(data + j[t]);
+      for (std::size_t t = 0; t < m; ++t) {
+        if (t + PREFETCH < m) UA_PREFETCH(data + j[t + PREFETCH]);
+        std::swap(data[i - 1 - t], data[j[t]]);
+      }
+      i -= m;
+    }
+  }
+
+  // Rao–Sandelius level: label, scatter src into tmp by label, shuffle each
+  // group (with the matching stretch of src as its scratch), copy back
+  template<class T>
+  void split(T* src, T* tmp, std::uint8_t* lab, std::size_t n) {
+    if (n * sizeof(T) <= group_bytes) { fisher_yates(src, n); return; }
+    const std::size_t groups = (n * sizeof(T) + group_bytes - 1) / group_bytes;
+    const std::size_t k = std::min(FANOUT, std::bit_ceil(groups));
+    alignas(64) std::uint64_t x[BLOCK / 8];
+    for (std::size_t i = 0; i < n; i += BLOCK) {   // one label per byte; k divides 256
+      const std::size_t m = std::min(BLOCK, n - i);
+      rng.generate_u64(x, (m + 7) / 8);
+      std::memcpy(lab + i, x, m);
+      for (std::size_t t = 0; t < m; ++t) lab[i + t] &= static_cast<std::uint8_t>(k - 1);
+    }
+    std::size_t head[FANOUT] = {}, begin[FANOUT + 1];
+    for (std::size_t i = 0; i < n; ++i) ++head[lab[i]];
+    begin[0] = 0;
+    for (std::size_t b = 0; b < k; ++b) { begin[b + 1] = begin[b] + head[b]; head[b] = begin[b]; }
+    for (std::size_t i = 0; i < n; ++i) tmp[head[lab[i]]++] = src[i];
+    for (std::size_t b = 0; b < k; ++b) split(tmp + begin[b], src + begin[b], lab + begin[b], begin[b + 1] - begin[b]);
+    std::memcpy(src, tmp, n * sizeof(T));
+  }
+};
+
+} // namespace ua
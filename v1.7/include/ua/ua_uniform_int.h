@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace ua::detail {
+
+// Unbiased bounded integers by Lemire's multiply-high ("Fast random integer
+// generation in an interval", ACM TOMACS 29, 2019) over raw u64 words, for
+// a range of s values starting at lo:
+//   u32: x_j the 32-bit halves of x[0 .. (n + 1) / 2), low half first,
+//        m = x_j s, out[j] = lo + (m >> 32), s in [1, 2^32);
+//   u64: x_j = x[j], m = x_j s (128-bit), out[j] = lo + (m >> 64), s in [1, 2^64).
+// Where the low word of m falls below t = 2^w mod s the value would be
+// biased: out[j] is then unspecified and j is appended to miss. t costs a
+// division, taken only once some low word falls below s (probability s / 2^w
+// per value), so small ranges never divide. Returns the number of misses.
+//
+// The AVX2 / AVX-512 kernels form the products from 32x32->64
+// _mm256_mul_epu32 / _mm512_mul_epu32 partial products (8 / 16 u32 or
+// 4 / 8 u64 values per iteration) and return the same values and misses as
+// the scalar kernel; lanes past n are neither read nor written.
+using UniformU32Fn = std::size_t (*)(const std::uint64_t* x, std::size_t n, std::uint32_t lo, std::uint32_t s,
+                                     std::uint32_t* out, std::uint32_t* miss) noexcept;
+using UniformU64Fn = std::size_t (*)(const std::uint64_t* x, std::size_t n, std::uint64_t lo, std::uint64_t s,
+                                     std::uint64_t* out, std::uint32_t* miss) noexcept;
+
+std::size_t uniform_u32_scalar(const std::uint64_t* x, std::size_t n, std::uint32_t lo, std::uint32_t s, std::uint32_t* out, std::uint32_t* miss) noexcept;   // uniform_int.cpp
+std::size_t uniform_u32_avx2(const std::uint64_t* x, std::size_t n, std::uint32_t lo, std::uint32_t s, std::uint32_t* out, std::uint32_t* miss) noexcept;     // uniform_int_avx2.cpp
+std::size_t uniform_u32_avx512(const std::uint64_t* x, std::size_t n, std::uint32_t lo, std::uint32_t s, std::uint32_t* out, std::uint32_t* miss) noexcept;   // uniform_int_avx512.cpp
+
+std::size_t uniform_u64_scalar(const std::uint64_t* x, std::size_t n, std::uint64_t lo, std::uint64_t s, std::uint64_t* out, std::uint32_t* miss) noexcept;   // uniform_int.cpp
+std::size_t uniform_u64_avx2(const std::uint64_t* x, std::size_t n, std::uint64_t lo, std::uint64_t s, std::uint64_t* out, std::uint32_t* miss) noexcept;     // uniform_int_avx2.cpp
+std::size_t uniform_u64_avx512(const std::uint64_t* x, std::size_t n, std::uint64_t lo, std::uint64_t s, std::uint64_t* out, std::uint32_t* miss) noexcept;   // uniform_int_avx512.cpp
+
+// The same with one bound per value, for Fisher–Yates indices: x_j the
+// 32-bit halves of x as above, out[j] = (x_j s[j]) >> 32 in [0, s[j]),
+// s[j] >= 1; t_j = 2^32 mod s[j] is divided out (scalar) only for values
+// whose low word falls below s[j]. The SIMD kernels return the same values
+// and misses as the scalar kernel.
+using UniformBoundsFn = std::size_t (*)(const std::uint64_t* x, const std::uint32_t* s, std::size_t n,
+                                        std::uint32_t* out, std::uint32_t* miss) noexcept;
+
+std::size_t uniform_bounds_scalar(const std::uint64_t* x, const std::uint32_t* s, std::size_t n, std::uint32_t* out, std::uint32_t* miss) noexcept;   // uniform_int.cpp
+std::size_t uniform_bounds_avx2(const std::uint64_t* x, const std::uint32_t* s, std::size_t n, std::uint32_t* out, std::uint32_t* miss) noexcept;     // uniform_int_avx2.cpp
+std::size_t uniform_bounds_avx512(const std::uint64_t* x, const std::uint32_t* s, std::size_t n, std::uint32_t* out, std::uint32_t* miss) noexcept;   // uniform_int_avx512.cpp
+
+// per-value bound kernel of the tier ua::Rng picks (UA_FORCE_BACKEND, else CPUID),
+// resolved once
+UniformBoundsFn uniform_bounds_kernel() noexcept;
+
+} // namespace ua::detail
@@ -2,7 +2,8 @@
 #include <cstdint>
 #include <cstddef>
 #include <bit>
-#include <immintrin.h>
+#include <cmath>
+#include "ua_xoroshiro128pp_jump.h"
 
 namespace ua {
 
@@ -49,61 +50,50 @@ struct Xoroshiro128ppScalar {
       out[i] = std::bit_cast<double>(bits) - 1.0;        // -> [0,1)
     }
   }
-};
-
-#if defined(__AVX2__)
-// ===================== xoroshiro128++ AVX2 (unrolled) =====================
-struct Xoroshiro128ppAVX2 {
-  __m256i s0, s1;
 
-  static inline __m256i rotl64(__m256i v, int k) noexcept {
-    __m256i l = _mm256_slli_epi64(v, k);
-    __m256i r = _mm256_srli_epi64(v, 64 - k);
-    return _mm256_or_si256(l, r);
+  // Marsaglia polar, same uniforms as generate_double
+  void generate_normal(double* out, size_t n) noexcept {
+    size_t i = 0;
+    while (i < n) {
+      double u = 2.0 * (std::bit_cast<double>((next_u64() >> 12) | 0x3FF0000000000000ULL) - 1.0) - 1.0;
+      double v = 2.0 * (std::bit_cast<double>((next_u64() >> 12) | 0x3FF0000000000000ULL) - 1.0) - 1.0;
+      double s = u*u + v*v;
+      if (s == 0.0 || s >= 1.0) continue;
+      double k = std::sqrt(-2.0 * std::log(s) / s);
+      out[i++] = u * k;
+      if (i < n) out[i++] = v * k;
+    }
   }
 
-  explicit Xoroshiro128ppAVX2(uint64_t seed) noexcept {
-    uint64_t z = seed;
-    uint64_t a0 = ua_splitmix64(z), a1 = ua_splitmix64(z), a2 = ua_splitmix64(z), a3 = ua_splitmix64(z);
-    uint64_t b0 = ua_splitmix64(z), b1 = ua_splitmix64(z), b2 = ua_splitmix64(z), b3 = ua_splitmix64(z);
-    s0 = _mm256_set_epi64x(a3, a2, a1, a0);
-    s1 = _mm256_set_epi64x(b3, b2, b1, b0);
-  }
+  // Jump polynomials from the xoroshiro128++ reference (Blackman & Vigna)
+  static constexpr uint64_t JUMP[2]      = { 0x2bd7a6a6e99c2ddcULL, 0x0992ccaf6a6fca05ULL };
+  static constexpr uint64_t LONG_JUMP[2] = { 0x360fd5f2cf8d5d99ULL, 0x9c6e6877736c46e3ULL };
 
-  inline __m256i next_vec_u64() noexcept {
-    __m256i sum = _mm256_add_epi64(s0, s1);
-    __m256i res = _mm256_add_epi64(rotl64(sum, 17), s0);
-    s1 = _mm256_xor_si256(s1, s0);
-    __m256i s0r = rotl64(s0, 49);
-    __m256i s1l = _mm256_slli_epi64(s1, 21);
-    s0 = _mm256_xor_si256(_mm256_xor_si256(s0r, s1), s1l);
-    s1 = rotl64(s1, 28);
-    return res;
-  }
+  // advance by 2^64 steps: 2^64 non-overlapping subsequences
+  void jump() noexcept { jump_with(JUMP); }
+
+  // advance by 2^96 steps: 2^32 starting points, each with 2^32 jump()s
+  void long_jump() noexcept { jump_with(LONG_JUMP); }
 
-  // ----- store helpers (u64 and double) -----
-  static inline void store256_u64(uint64_t* p, __m256i v) noexcept {
-  #if defined(UA_STREAM_STORES) && UA_STREAM_STORES
-    if ((((uintptr_t)p) & 31u) == 0u) { _mm256_stream_si256((__m256i*)p, v); return; }
-  #endif
-    _mm256_storeu_si256((__m256i*)p, v);
+  // advance by any distance hi*2^64 + lo in O(log distance)
+  void skip_ahead(uint64_t lo, uint64_t hi = 0) noexcept {
+    if (hi == 0 && lo < 128) { while (lo--) (void)next_u64(); return; }
+    uint64_t poly[2];
+    detail::xoroshiro128_jump_poly(lo, hi, poly);
+    jump_with(poly);
   }
 
-  static inline void store256_pd(double* p, __m256d v) noexcept {
-  #if defined(UA_STREAM_STORES) && UA_STREAM_STORES
-    if ((((uintptr_t)p) & 31u) == 0u) { _mm256_stream_pd(p, v); return; }
-  #endif
-    _mm256_storeu_pd(p, v);
+  // evaluate the jump polynomial on the state (XOR-accumulate over 128 steps)
+  void jump_with(const uint64_t (&poly)[2]) noexcept {
+    uint64_t t0 = 0, t1 = 0;
+    for (int i = 0; i < 2; ++i) {
+      for (int b = 0; b < 64; ++b) {
+        if (poly[i] & (1ull << b)) { t0 ^= s0; t1 ^= s1; }
+        (void)next_u64();
+      }
+    }
+    s0 = t0; s1 = t1;
   }
+};
 
-  // ----- u64 generation (unrolled 8x: 32 u64 per loop) -----
-  void generate_u64(uint64_t* out, size_t n) noexcept {
-    size_t i = 0;
-    while (i + 32 <= n) {
-      __m256i v0 = next_vec_u64(); __m256i v1 = next_vec_u64();
-      __m256i v2 = next_vec_u64(); __m256i v3 = next_vec_u64();
-      __m256i v4 = next_vec_u64(); __m256i v5 = next_vec_u64();
-      __m256i v6 = next_vec_u64(); __m256i v7 = next_vec_u64();
-      store256_u64(out + i +  0, v0); store256_u64(out + i +  4, v1);
-      store256_u64(out + i +  8, v2); store256_u64(out + i + 12, v3);
-      store256_u64(out + i + 16_
+} // namespace ua
@@ -0,0 +1,38 @@
+#pragma once
+#include <immintrin.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace ua::detail {
+
+// 8 independent xoroshiro128++ lanes; lane k is seeded from splitmix64 draws
+// 2k, 2k+1 of the seed, so lane 0 is Xoroshiro128ppScalar(seed).
+struct Xoroshiro128ppAVX512 {
+  static constexpr int LANES = 8;
+
+  Xoroshiro128ppAVX512() = delete;
+  explicit Xoroshiro128ppAVX512(std::uint64_t seed) noexcept;
+
+  void generate_u64(std::uint64_t* out, std::size_t n) noexcept;
+  void generate_double(double* out, std::size_t n) noexcept;  // [0,1)
+  void generate_normal(double* out, std::size_t n) noexcept;  // N(0,1)
+
+  // per-lane 2^64 / 2^96 jumps (same polynomials as Xoroshiro128ppScalar)
+  void jump() noexcept;
+  void long_jump() noexcept;
+
+  // every lane advances hi*2^64 + lo steps, O(log distance)
+  void skip_ahead(std::uint64_t lo, std::uint64_t hi = 0) noexcept;
+
+  // copy lane's {s0,s1} out of the vector state
+  void lane_state(int lane, std::uint64_t st[2]) const noexcept;
+
+private:
+  __m512i s0, s1;
+
+  __m512i next_u64_vec() noexcept;
+  void    advance_vec() noexcept;
+  void    jump_with(const std::uint64_t (&poly)[2]) noexcept;
+};
+
+} // namespace ua::detail
@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdint>
+
+namespace ua::detail {
+
+// Characteristic-polynomial jump engine for the xoroshiro128 linear engine;
+// same scheme as xoshiro256_jump_poly (ua_xoshiro256ss_jump.h) with a
+// degree-128 P(x): p(x) = x^d mod P(x), built in O(log d) from a cached
+// x^(2^k) table, then evaluated on the state in one 128-step XOR loop.
+//
+// Coefficients are packed like Xoroshiro128ppScalar::JUMP: word i, bit b holds
+// the coefficient of x^(64*i + b). Distance is hi*2^64 + lo.
+void xoroshiro128_jump_poly(std::uint64_t lo, std::uint64_t hi, std::uint64_t poly[2]) noexcept;
+
+} // namespace ua::detail
@@ -9,7 +9,7 @@ struct Xoshiro256ssAVX512 {
   __m512i s0, s1, s2, s3;
 
   static inline __m512i rotl64(__m512i x, int k) noexcept {
-    return _mm512_ternarylogic_epi64(_mm512_slli_epi64(x, k), _mm512_srli_epi64(x, 64 - k), _mm512_setzero_si512(), 0xF8);
+    return _mm512_ternarylogic_epi64(_mm512_slli_epi64(x, k), _mm512_srli_epi64(x, 64 - k), _mm512_setzero_si512(), 0xFE);
   }
 
   static inline __m512i mullo64(__m512i a, std::uint64_t c) noexcept {
@@ -2,22 +2,82 @@
 #include <immintrin.h>
 #include <cstddef>
 #include <cstdint>
+#include "ua/ua_xoshiro256ss_scalar.h"
 
 namespace ua::detail {
 
 struct Xoshiro256ssAVX2 {
   Xoshiro256ssAVX2() = delete;
-  explicit Xoshiro256ssAVX2(std::uint64_t seed) noexcept;
+  explicit Xoshiro256ssAVX2(std::uint64_t seed, XoshiroScrambler scr = XoshiroScrambler::Auto) noexcept;
 
   void generate_u64(std::uint64_t* out, std::size_t n) noexcept;
   void generate_double(double* out, std::size_t n) noexcept;  // [0,1)
   void generate_normal(double* out, std::size_t n) noexcept;  // N(0,1)
 
+  // per-lane 2^128 / 2^192 jumps (same polynomials as Xoshiro256ssScalar)
+  void jump() noexcept;
+  void long_jump() noexcept;
+
+  // every lane advances hi*2^64 + lo steps, O(log distance)
+  void skip_ahead(std::uint64_t lo, std::uint64_t hi = 0) noexcept;
+  // apply x^d mod P (ua_xoshiro256ss_jump.h) to every lane
+  void jump_with(const std::uint64_t (&poly)[4]) noexcept;
+
+  // copy lane's {s0,s1,s2,s3} out of the vector state
+  void lane_state(int lane, std::uint64_t st[4]) const noexcept;
+
+  // kernel in use after resolving Auto
+  XoshiroScrambler scrambler() const noexcept { return scr_; }
+
 private:
   __m256i s0, s1, s2, s3;
+  XoshiroScrambler scr_;
 
-  __m256i next_u64_vec() noexcept;
+  template<XoshiroScrambler S> __m256i next_u64_vec() noexcept;
+  template<XoshiroScrambler S> void u64_impl(std::uint64_t* out, std::size_t n) noexcept;
+  template<XoshiroScrambler S> void double_impl(double* out, std::size_t n) noexcept;
+  template<XoshiroScrambler S> void normal_impl(double* out, std::size_t n) noexcept;
+  void    advance_vec() noexcept;
   double  uniform_scalar() noexcept;
 };
 
+// Interleaved mode: K = 2..4 independent register sets stepped alternately,
+// so the K update chains overlap instead of each output waiting on the
+// previous state. It behaves as one 4K-lane generator:
+//   - global lane g = 4*j + k is lane k of set j; its s0..s3 are splitmix64
+//     draws 4g..4g+3 of the seed;
+//   - each step stores set 0, then set 1, ..., so u64 output t*LANES + g is
+//     the t-th draw of global lane g (the lane_state() / test_jump layout);
+//   - a partial step still advances every set; the unused tail is dropped.
+// The stream therefore depends on K and differs from Xoshiro256ssAVX2.
+template<int K>
+struct Xoshiro256ssAVX2Interleaved {
+  static_assert(K >= 2 && K <= 4, "interleave factor is 2..4");
+  static constexpr int LANES = 4 * K;
+
+  Xoshiro256ssAVX2Interleaved() = delete;
+  explicit Xoshiro256ssAVX2Interleaved(std::uint64_t seed) noexcept;
+
+  void generate_u64(std::uint64_t* out, std::size_t n) noexcept;
+  void generate_double(double* out, std::size_t n) noexcept;  // [0,1)
+  void generate_normal(double* out, std::size_t n) noexcept;  // N(0,1)
+
+  void jump() noexcept;
+  void long_jump() noexcept;
+  void skip_ahead(std::uint64_t lo, std::uint64_t hi = 0) noexcept;
+  // apply x^d mod P (ua_xoshiro256ss_jump.h) to every lane
+  void jump_with(const std::uint64_t (&poly)[4]) noexcept;
+
+  // global lane 0..LANES-1
+  void lane_state(int lane, std::uint64_t st[4]) const noexcept;
+
+private:
+  __m256i s0[K], s1[K], s2[K], s3[K];
+};
+
+// defined in src/xoshiro256ss_avx2.cpp (built with the AVX2 flags)
+extern template struct Xoshiro256ssAVX2Interleaved<2>;
+extern template struct Xoshiro256ssAVX2Interleaved<3>;
+extern template struct Xoshiro256ssAVX2Interleaved<4>;
+
 } // namespace ua::detail
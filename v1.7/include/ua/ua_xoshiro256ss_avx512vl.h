@@ -0,0 +1,39 @@
+#pragma once
+#include <immintrin.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace ua::detail {
+
+// xoshiro256** on 256-bit registers with AVX-512VL/DQ instructions: vprolq
+// rotates, vpmullq for the scrambler and masked tail stores. ymm-only code
+// avoids the zmm frequency licence on Skylake-SP class cores. Seeding and
+// lane layout are Xoshiro256ssAVX2's, so both tiers give the same stream.
+struct Xoshiro256ssAVX512VL {
+  Xoshiro256ssAVX512VL() = delete;
+  explicit Xoshiro256ssAVX512VL(std::uint64_t seed) noexcept;
+
+  void generate_u64(std::uint64_t* out, std::size_t n) noexcept;
+  void generate_double(double* out, std::size_t n) noexcept;  // [0,1)
+  void generate_normal(double* out, std::size_t n) noexcept;  // N(0,1)
+
+  // per-lane 2^128 / 2^192 jumps (same polynomials as Xoshiro256ssScalar)
+  void jump() noexcept;
+  void long_jump() noexcept;
+
+  // every lane advances hi*2^64 + lo steps, O(log distance)
+  void skip_ahead(std::uint64_t lo, std::uint64_t hi = 0) noexcept;
+  // apply x^d mod P (ua_xoshiro256ss_jump.h) to every lane
+  void jump_with(const std::uint64_t (&poly)[4]) noexcept;
+
+  // copy lane's {s0,s1,s2,s3} out of the vector state
+  void lane_state(int lane, std::uint64_t st[4]) const noexcept;
+
+private:
+  __m256i s0, s1, s2, s3;
+
+  __m256i next_u64_vec() noexcept;
+  void    advance_vec() noexcept;
+};
+
+} // namespace ua::detail
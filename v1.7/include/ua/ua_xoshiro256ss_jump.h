@@ -0,0 +1,22 @@
+#pragma once
+#include <cstdint>
+
+namespace ua::detail {
+
+// Characteristic-polynomial jump engine for the xoshiro256 linear engine.
+//
+// The state transition T is a 256x256 matrix over GF(2) with characteristic
+// polynomial P(x) (degree 256). Advancing d steps is T^d = p(T) where
+// p(x) = x^d mod P(x), so any distance costs one polynomial evaluation on the
+// state (the same 256-step XOR loop the fixed jump()/long_jump() use).
+// p is built from a cached table of x^(2^k) mod P, k = 0..191: at most 128
+// GF(2) polynomial products per call, i.e. O(log d).
+//
+// Coefficients are packed like Xoshiro256ssScalar::JUMP: word i, bit b holds
+// the coefficient of x^(64*i + b). Distance is hi*2^64 + lo.
+void xoshiro256_jump_poly(std::uint64_t lo, std::uint64_t hi, std::uint64_t poly[4]) noexcept;
+
+// k jump()s in one: x^(k 2^128) mod P, past the reach of the distance form
+void xoshiro256_jumps_poly(std::uint64_t k, std::uint64_t poly[4]) noexcept;
+
+} // namespace ua::detail
@@ -2,9 +2,19 @@
 #include <cstdint>
 #include <cstddef>
 #include <cmath>
+#include "ua_xoshiro256ss_jump.h"
 
 namespace ua::detail {
 
+// Multiply kernel for the SIMD '**' scrambler rotl(s1*5, 7)*9. Every kernel
+// gives the same output; Auto picks vpmullq on AVX-512, shift-add on AVX2.
+enum class XoshiroScrambler : unsigned char {
+  Auto     = 0,
+  Emulated = 1,   // 64-bit products from 32x32 _mm*_mul_epu32 partials (v1.7.0)
+  ShiftAdd = 2,   // x*5 = (x<<2)+x, x*9 = (x<<3)+x; plain AVX2 / AVX-512F
+  Mullo    = 3,   // vpmullq, AVX-512DQ; the AVX2 backend uses ShiftAdd instead
+};
+
 struct Xoshiro256ssScalar {
   std::uint64_t s0, s1, s2, s3;
 
@@ -60,15 +70,38 @@ struct Xoshiro256ssScalar {
     }
   }
 
-  void jump() noexcept {
-    static constexpr std::uint64_t J[] = {
-      0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
-      0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
-    };
+  // Jump polynomials from the xoshiro256** reference (Blackman & Vigna)
+  static constexpr std::uint64_t JUMP[4] = {
+    0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+    0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+  };
+  static constexpr std::uint64_t LONG_JUMP[4] = {
+    0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL,
+    0x77710069854ee241ULL, 0x39109bb02acbe635ULL
+  };
+
+  // advance by 2^128 steps: 2^128 non-overlapping subsequences
+  void jump() noexcept { jump_with(JUMP); }
+
+  // advance by 2^192 steps: 2^64 starting points, each with 2^64 jump()s
+  void long_jump() noexcept { jump_with(LONG_JUMP); }
+
+  // advance by any distance hi*2^64 + lo in O(log distance)
+  void skip_ahead(std::uint64_t lo, std::uint64_t hi = 0) noexcept {
+    if (hi == 0 && lo < 256) { while (lo--) (void)next_u64(); return; }
+    std::uint64_t poly[4];
+    xoshiro256_jump_poly(lo, hi, poly);
+    jump_with(poly);
+  }
+
+  // evaluate the jump polynomial on the state (XOR-accumulate over 256 steps)
+  void jump_with(const std::uint64_t (&poly)[4]) noexcept {
     std::uint64_t s0n=0, s1n=0, s2n=0, s3n=0;
     for (int i = 0; i < 4; ++i) {
       for (int b = 0; b < 64; ++b) {
-        if (J[i] & (1ull << b)) { s0n ^= s0; s1n ^= s1; s2n ^= s2; s3n ^= s3; }
+        if (poly[i] & (1ull << b)) {
+          s0n ^= s0; s1n ^= s1; s2n ^= s2; s3n ^= s3;
+        }
         (void)next_u64();
       }
     }
@@ -0,0 +1,169 @@
+// Portable (no ISA flags): AliasTable construction (Vose in integer
+// masses), the scalar draw kernel and the kernel choice for ua::AliasSampler.
+#include "ua/ua_alias.h"
+#include "ua_kernel_tier.h"
+#include <cmath>
+
+namespace ua {
+
+namespace {
+
+constexpr std::uint64_t ONE = std::uint64_t(1) << 32;   // one column's mass
+
+bool valid(const double* w, std::size_t n) noexcept {
+  for (std::size_t i = 0; i < n; ++i)
+    if (!(w[i] >= 0.0) || !std::isfinite(w[i])) return false;
+  return true;
+}
+
+// Vose over w[0 .. k) into k columns: masses m_i = w_i k 2^32 / sum, floored
+// then topped up by whole units on the positive items until they sum to
+// exactly k 2^32; small columns (< 2^32) take the rest of their column from
+// a large one. Integer masses leave every remaining column exactly full
+// (prob 2^32 - 1, alias itself: drawn whatever the coin). alias gets
+// first + the local index.
+void vose(const double* w, std::size_t k, double sum, std::uint32_t first,
+          std::uint32_t* prob, std::uint32_t* alias) {
+  if (!(sum > 0.0)) {   // never drawn (zero top-level mass); keep the table well formed
+    for (std::size_t i = 0; i < k; ++i) { prob[i] = 0xFFFFFFFFu; alias[i] = first + static_cast<std::uint32_t>(i); }
+    return;
+  }
+  std::vector<std::uint64_t> m(k);
+  std::vector<std::uint32_t> small, large;
+  small.reserve(k); large.reserve(k);
+  const std::uint64_t target = k * ONE;
+  const double wmax = *std::max_element(w, w + k);   // scale by w / wmax: no overflow for tiny sums
+  double scale = double(target) / (sum / wmax) * (1.0 - 0x1p-50);
+  std::uint64_t have;
+  std::size_t pos;
+  for (;;) {   // floors at or below the target (sum may be off by rounding)
+    have = 0; pos = 0;
+    for (std::size_t i = 0; i < k; ++i) {
+      m[i] = static_cast<std::uint64_t>(w[i] / wmax * scale);
+      have += m[i];
+      pos += w[i] > 0.0;
+    }
+    if (have <= target) break;
+    scale *= double(target) / double(have) * (1.0 - 0x1p-50);
+  }
+  const std::uint64_t add = (target - have) / pos;
+  std::uint64_t rem = (target - have) % pos;
+  for (std::size_t i = 0; i < k; ++i)
+    if (w[i] > 0.0) m[i] += add + (rem ? (--rem, 1) : 0);
+  for (std::size_t i = 0; i < k; ++i) (m[i] < ONE ? small : large).push_back(static_cast<std::uint32_t>(i));
+  while (!small.empty() && !large.empty()) {
+    const std::uint32_t s = small.back(), l = large.back();
+    small.pop_back();
+    prob[s] = static_cast<std::uint32_t>(m[s]);
+    alias[s] = first + l;
+    m[l] -= ONE - m[s];
+    if (m[l] < ONE) { large.pop_back(); small.push_back(l); }
+  }
+  for (std::uint32_t l : large) { prob[l] = 0xFFFFFFFFu; alias[l] = first + l; }
+}
+
+} // namespace
+
+bool AliasTable::build(const double* w, std::size_t k, std::size_t shard) {
+  ok_ = false;
+  w_.clear();
+  if (k == 0 || k > (std::size_t(1) << 31) || !valid(w, k)) return false;
+  s_ = shard == 0 || shard >= k ? k : shard;
+  const std::size_t shards = (k + s_ - 1) / s_;
+  w_.assign(shards * s_, 0.0);
+  std::copy(w, w + k, w_.begin());
+  prob_.resize(shards * s_);
+  alias_.resize(shards * s_);
+  total_.resize(shards);
+  top_prob_.resize(shards);
+  top_alias_.resize(shards);
+  t_ = static_cast<std::uint32_t>(ONE % s_);
+  top_t_ = static_cast<std::uint32_t>(ONE % shards);
+  k_ = k;
+  for (std::size_t s = 0; s < shards; ++s) rebuild_shard(s);
+  return commit();
+}
+
+bool AliasTable::update(std::size_t first, const double* w, std::size_t count) {
+  if (!set_weights(first, w, count)) return false;
+  if (count == 0) return true;
+  for (std::size_t s = first / s_; s <= (first + count - 1) / s_; ++s) rebuild_shard(s);
+  return commit();
+}
+
+bool AliasTable::set_weights(std::size_t first, const double* w, std::size_t count) noexcept {
+  if (w_.empty() || first > k_ || count > k_ - first || !valid(w, count)) return false;
+  if (count == 0) return true;
+  // the total rebuild_shard / commit would reach, summed in their order:
+  // the touched shards with the new weights in place, the others' totals
+  const std::size_t s0 = first / s_, s1 = (first + count - 1) / s_;
+  double sum = 0.0;
+  for (std::size_t s = 0; s < total_.size(); ++s) {
+    if (s < s0 || s > s1) { sum += total_[s]; continue; }
+    double t = 0.0;
+    for (std::size_t i = s * s_; i < (s + 1) * s_; ++i) t += i - first < count ? w[i - first] : w_[i];
+    sum += t;
+  }
+  if (!(sum > 0.0) || !std::isfinite(sum)) return false;
+  std::copy(w, w + count, w_.begin() + first);
+  return true;
+}
+
+void AliasTable::rebuild_shard(std::size_t s) {
+  const double* w = w_.data() + s * s_;
+  double sum = 0.0;
+  for (std::size_t i = 0; i < s_; ++i) sum += w[i];
+  total_[s] = sum;
+  vose(w, s_, sum, static_cast<std::uint32_t>(s * s_), prob_.data() + s * s_, alias_.data() + s * s_);
+}
+
+bool AliasTable::commit() {
+  double sum = 0.0;
+  for (double t : total_) sum += t;
+  ok_ = !w_.empty() && sum > 0.0 && std::isfinite(sum);
+  if (!ok_) return false;
+  vose(total_.data(), total_.size(), sum, 0, top_prob_.data(), top_alias_.data());
+  return true;
+}
+
+double AliasTable::probability(std::size_t i) const noexcept {
+  if (!ok_ || i >= k_) return 0.0;
+  // mass of item j within a table of n columns, in units of 2^-32 columns
+  auto mass = [](const std::uint32_t* prob, const std::uint32_t* alias, std::size_t n, std::uint32_t first, std::uint32_t j) {
+    double m = 0.0;
+    for (std::size_t c = 0; c < n; ++c) {
+      const double p = prob[c] == 0xFFFFFFFFu && alias[c] == first + c ? double(ONE) : double(prob[c]);
+      if (first + c == j) m += p;
+      if (alias[c] == j)  m += double(ONE) - p;
+    }
+    return m / (double(n) * double(ONE));
+  };
+  const std::size_t s = i / s_;
+  const double top = shards() > 1 ? mass(top_prob_.data(), top_alias_.data(), shards(), 0, static_cast<std::uint32_t>(s)) : 1.0;
+  return top * mass(prob_.data() + s * s_, alias_.data() + s * s_, s_, static_cast<std::uint32_t>(s * s_),
+                    static_cast<std::uint32_t>(i));
+}
+
+namespace detail {
+
+std::size_t alias_scalar(const std::uint32_t* prob, const std::uint32_t* alias, std::uint32_t k, std::uint32_t t,
+                         const std::uint64_t* x, const std::uint32_t* base, std::size_t n,
+                         std::uint32_t* out, std::uint32_t* miss) noexcept {
+  std::size_t r = 0;
+  for (std::size_t j = 0; j < n; ++j) {
+    const std::uint64_t m = (x[j] >> 32) * k;
+    if (static_cast<std::uint32_t>(m) < t) { miss[r++] = static_cast<std::uint32_t>(j); continue; }
+    const std::uint32_t c = static_cast<std::uint32_t>(m >> 32) + (base ? base[j] : 0);
+    out[j] = static_cast<std::uint32_t>(x[j]) < prob[c] ? c : alias[c];
+  }
+  return r;
+}
+
+AliasFn alias_kernel() noexcept {
+  static const AliasFn k = kernel_for_tier(&alias_scalar, &alias_avx2, &alias_avx512);
+  return k;
+}
+
+} // namespace detail
+
+} // namespace ua
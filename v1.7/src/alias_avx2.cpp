@@ -0,0 +1,52 @@
+#include "ua/ua_alias.h"
+#include <immintrin.h>
+#include <bit>
+
+namespace ua::detail {
+
+namespace {
+
+inline std::size_t push_misses(std::uint32_t* miss, std::size_t r, std::size_t base, unsigned m) noexcept {
+  for (; m; m &= m - 1) miss[r++] = static_cast<std::uint32_t>(base + std::countr_zero(m));
+  return r;
+}
+
+template<bool Based>
+std::size_t draw(const std::uint32_t* prob, const std::uint32_t* alias, std::uint32_t k, std::uint32_t t,
+                 const std::uint64_t* x, const std::uint32_t* base, std::size_t n,
+                 std::uint32_t* out, std::uint32_t* miss) noexcept {
+  const __m256i vk = _mm256_set1_epi64x(k), vt = _mm256_set1_epi64x(t);
+  const __m256i lo32 = _mm256_set1_epi64x(0xffffffffll);
+  const __m256i even = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+  const __m128i sign = _mm_set1_epi32(INT32_MIN);
+  std::size_t r = 0;
+  for (std::size_t j = 0; j < n; j += 4) {
+    const std::size_t left = n - j < 4 ? n - j : 4;
+    const unsigned live = (1u << left) - 1;
+    const __m256i lm = _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(left)), _mm256_setr_epi64x(0, 1, 2, 3));
+    const __m128i lm32 = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(lm, even));
+    const __m256i v = _mm256_maskload_epi64(reinterpret_cast<const long long*>(x + j), lm);
+    const __m256i m = _mm256_mul_epu32(_mm256_srli_epi64(v, 32), vk);
+    // column and coin: the high / low halves of m / v, packed to 4 x 32
+    __m128i c = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_srli_epi64(m, 32), even));
+    if constexpr (Based) c = _mm_add_epi32(c, _mm_maskload_epi32(reinterpret_cast<const int*>(base + j), lm32));
+    const __m128i coin = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(v, even));
+    const __m128i p = _mm_i32gather_epi32(reinterpret_cast<const int*>(prob), c, 4);
+    const __m128i a = _mm_i32gather_epi32(reinterpret_cast<const int*>(alias), c, 4);
+    const __m128i take = _mm_cmpgt_epi32(_mm_xor_si128(p, sign), _mm_xor_si128(coin, sign));   // coin < p
+    _mm_maskstore_epi32(reinterpret_cast<int*>(out + j), lm32, _mm_blendv_epi8(a, c, take));
+    const __m256i rej = _mm256_cmpgt_epi64(vt, _mm256_and_si256(m, lo32));
+    r = push_misses(miss, r, j, static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(rej))) & live);
+  }
+  return r;
+}
+
+} // namespace
+
+std::size_t alias_avx2(const std::uint32_t* prob, const std::uint32_t* alias, std::uint32_t k, std::uint32_t t,
+                       const std::uint64_t* x, const std::uint32_t* base, std::size_t n,
+                       std::uint32_t* out, std::uint32_t* miss) noexcept {
+  return base ? draw<true>(prob, alias, k, t, x, base, n, out, miss) : draw<false>(prob, alias, k, t, x, base, n, out, miss);
+}
+
+} // namespace ua::detail
@@ -0,0 +1,49 @@
+#include "ua/ua_alias.h"
+#include <immintrin.h>
+#include <bit>
+
+namespace ua::detail {
+
+namespace {
+
+// the AVX2 kernel (alias_avx2.cpp) on 8 lanes, the gathers indexed by the
+// 64-bit lanes and the compare on the zero-extended 32-bit values
+
+inline std::size_t push_misses(std::uint32_t* miss, std::size_t r, std::size_t base, __mmask16 m) noexcept {
+  const __m512i iota = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  _mm512_mask_compressstoreu_epi32(miss + r, m, _mm512_add_epi32(iota, _mm512_set1_epi32(static_cast<int>(base))));
+  return r + std::popcount(static_cast<unsigned>(m));
+}
+
+template<bool Based>
+std::size_t draw(const std::uint32_t* prob, const std::uint32_t* alias, std::uint32_t k, std::uint32_t t,
+                 const std::uint64_t* x, const std::uint32_t* base, std::size_t n,
+                 std::uint32_t* out, std::uint32_t* miss) noexcept {
+  const __m512i vk = _mm512_set1_epi64(k), vt = _mm512_set1_epi64(t);
+  const __m512i lo32 = _mm512_set1_epi64(0xffffffffll);
+  std::size_t r = 0;
+  for (std::size_t j = 0; j < n; j += 8) {
+    const __mmask8 live = n - j >= 8 ? __mmask8(0xFF) : __mmask8((1u << (n - j)) - 1);
+    const __m512i v = _mm512_maskz_loadu_epi64(live, x + j);
+    const __m512i m = _mm512_mul_epu32(_mm512_srli_epi64(v, 32), vk);
+    __m512i c = _mm512_srli_epi64(m, 32);
+    if constexpr (Based)
+      c = _mm512_add_epi64(c, _mm512_cvtepu32_epi64(_mm512_castsi512_si256(_mm512_maskz_loadu_epi32(live, base + j))));
+    const __m512i p = _mm512_cvtepu32_epi64(_mm512_i64gather_epi32(c, prob, 4));
+    const __m512i a = _mm512_cvtepu32_epi64(_mm512_i64gather_epi32(c, alias, 4));
+    const __mmask8 take = _mm512_cmplt_epu64_mask(_mm512_and_si512(v, lo32), p);
+    _mm512_mask_cvtepi64_storeu_epi32(out + j, live, _mm512_mask_blend_epi64(take, a, c));
+    r = push_misses(miss, r, j, _mm512_mask_cmplt_epu64_mask(live, _mm512_and_si512(m, lo32), vt));
+  }
+  return r;
+}
+
+} // namespace
+
+std::size_t alias_avx512(const std::uint32_t* prob, const std::uint32_t* alias, std::uint32_t k, std::uint32_t t,
+                         const std::uint64_t* x, const std::uint32_t* base, std::size_t n,
+                         std::uint32_t* out, std::uint32_t* miss) noexcept {
+  return base ? draw<true>(prob, alias, k, t, x, base, n, out, miss) : draw<false>(prob, alias, k, t, x, base, n, out, miss);
+}
+
+} // namespace ua::detail
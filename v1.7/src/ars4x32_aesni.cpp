@@ -0,0 +1,89 @@
+#include "ua/ua_ars4x32.h"
+#include <immintrin.h>
+
+namespace ua::detail {
+
+// ----------------------------------------
+// helpers
+// ----------------------------------------
+namespace {
+
+constexpr int BLOCKS = 8;   // 8 xmm in flight
+constexpr std::size_t STEP = 2 * BLOCKS;
+
+struct Keys { __m128i k[ARS_ROUNDS + 1]; };
+
+inline Keys load_keys(const std::uint64_t* rk) noexcept {
+  Keys K;
+  for (int r = 0; r <= ARS_ROUNDS; ++r) K.k[r] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rk + 2 * r));
+  return K;
+}
+
+// blocks lo, lo+1, ... lo+7 (128-bit carry) -> 16 u64 in counter order
+inline void blocks(const Keys& K, std::uint64_t lo, std::uint64_t hi, std::uint64_t* out) noexcept {
+  __m128i v[BLOCKS];
+  for (int b = 0; b < BLOCKS; ++b) {
+    const std::uint64_t l = lo + (std::uint64_t)b;
+    v[b] = _mm_xor_si128(_mm_set_epi64x((long long)(hi + (l < lo ? 1 : 0)), (long long)l), K.k[0]);
+  }
+  for (int r = 1; r < ARS_ROUNDS; ++r)
+    for (int b = 0; b < BLOCKS; ++b) v[b] = _mm_aesenc_si128(v[b], K.k[r]);
+  for (int b = 0; b < BLOCKS; ++b)
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * b), _mm_aesenclast_si128(v[b], K.k[ARS_ROUNDS]));
+}
+
+} // namespace
+
+// ----------------------------------------
+// state & core PRNG
+// ----------------------------------------
+Ars4x32AESNI::Ars4x32AESNI(std::uint64_t seed) noexcept {
+  std::uint64_t key[2];
+  ars_key_from_seed(seed, key);
+  ars_round_keys(key, rk);
+}
+
+void Ars4x32AESNI::advance(std::uint64_t lo, std::uint64_t hi) noexcept {
+  const std::uint64_t s = ctr_lo + lo;
+  ctr_hi += hi + (s < ctr_lo ? 1 : 0);
+  ctr_lo = s;
+}
+
+void Ars4x32AESNI::skip_ahead(std::uint64_t lo, std::uint64_t hi) noexcept {
+  std::size_t off;
+  const std::uint64_t back = tail.rewind(off);
+  advance(lo - back, hi - (lo < back ? 1 : 0));
+  if (off) { refill(); tail.pos = off; }
+}
+void Ars4x32AESNI::jump() noexcept      { skip_ahead(0, 1); }
+void Ars4x32AESNI::long_jump() noexcept { skip_ahead(0, 1ull << 32); }
+
+// ----------------------------------------
+// bulk generators
+// ----------------------------------------
+void Ars4x32AESNI::refill() noexcept {
+  blocks(load_keys(rk), ctr_lo, ctr_hi, tail.buf); advance(BLOCKS);
+  tail.pos = 0;
+}
+
+void Ars4x32AESNI::generate_u64(std::uint64_t* out, std::size_t n) noexcept {
+  const Keys K = load_keys(rk);
+  std::size_t i = tail.take(out, n);
+  for (; i + STEP <= n; i += STEP) { blocks(K, ctr_lo, ctr_hi, out + i); advance(BLOCKS); }
+  if (i < n) { refill(); tail.take(out + i, n - i); }
+}
+
+// (x >> 12) * 2^-52: bit-identical to the SIMD exponent trick
+void Ars4x32AESNI::generate_double(double* out, std::size_t n) noexcept {
+  constexpr double inv = 1.0 / double(1ull << 52);
+  const Keys K = load_keys(rk);
+  alignas(16) std::uint64_t tmp[STEP];
+  std::size_t i = tail.take(out, n);
+  for (; i + STEP <= n; i += STEP) {
+    blocks(K, ctr_lo, ctr_hi, tmp); advance(BLOCKS);
+    for (std::size_t j = 0; j < STEP; ++j) out[i + j] = double(tmp[j] >> 12) * inv;
+  }
+  if (i < n) { refill(); tail.take(out + i, n - i); }
+}
+
+} // namespace ua::detail
@@ -0,0 +1,103 @@
+#include "ua/ua_ars4x32.h"
+#include <immintrin.h>
+
+namespace ua::detail {
+
+// ----------------------------------------
+// helpers
+// ----------------------------------------
+namespace {
+
+constexpr int BLOCKS = 16;   // 4 zmm x 4 blocks
+constexpr std::size_t STEP = 2 * BLOCKS;
+
+struct Keys { __m512i k[ARS_ROUNDS + 1]; };
+
+inline Keys load_keys(const std::uint64_t* rk) noexcept {
+  Keys K;
+  for (int r = 0; r <= ARS_ROUNDS; ++r)
+    K.k[r] = _mm512_broadcast_i32x4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rk + 2 * r)));
+  return K;
+}
+
+// blocks lo, lo+1, ... lo+15 (128-bit carry) -> 32 u64 in counter order
+inline void blocks(const Keys& K, std::uint64_t lo, std::uint64_t hi, std::uint64_t* out) noexcept {
+  __m512i v[4];
+  if (lo <= ~0ull - (BLOCKS - 1)) {
+    // no carry inside the step: base + per-block offsets in the low halves
+    const __m512i base = _mm512_broadcast_i32x4(_mm_set_epi64x((long long)hi, (long long)lo));
+    for (int j = 0; j < 4; ++j)
+      v[j] = _mm512_add_epi64(base, _mm512_set_epi64(0, 4 * j + 3, 0, 4 * j + 2, 0, 4 * j + 1, 0, 4 * j));
+  } else {
+    alignas(64) std::uint64_t c[STEP];
+    for (int b = 0; b < BLOCKS; ++b) {
+      const std::uint64_t l = lo + (std::uint64_t)b;
+      c[2 * b] = l; c[2 * b + 1] = hi + (l < lo ? 1 : 0);
+    }
+    for (int j = 0; j < 4; ++j) v[j] = _mm512_load_si512(reinterpret_cast<const void*>(c + 8 * j));
+  }
+  for (int j = 0; j < 4; ++j) v[j] = _mm512_xor_si512(v[j], K.k[0]);
+  for (int r = 1; r < ARS_ROUNDS; ++r)
+    for (int j = 0; j < 4; ++j) v[j] = _mm512_aesenc_epi128(v[j], K.k[r]);
+  for (int j = 0; j < 4; ++j)
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + 8 * j), _mm512_aesenclast_epi128(v[j], K.k[ARS_ROUNDS]));
+}
+
+} // namespace
+
+// ----------------------------------------
+// state & core PRNG
+// ----------------------------------------
+Ars4x32AVX512::Ars4x32AVX512(std::uint64_t seed) noexcept {
+  std::uint64_t key[2];
+  ars_key_from_seed(seed, key);
+  ars_round_keys(key, rk);
+}
+
+void Ars4x32AVX512::advance(std::uint64_t lo, std::uint64_t hi) noexcept {
+  const std::uint64_t s = ctr_lo + lo;
+  ctr_hi += hi + (s < ctr_lo ? 1 : 0);
+  ctr_lo = s;
+}
+
+void Ars4x32AVX512::skip_ahead(std::uint64_t lo, std::uint64_t hi) noexcept {
+  std::size_t off;
+  const std::uint64_t back = tail.rewind(off);
+  advance(lo - back, hi - (lo < back ? 1 : 0));
+  if (off) { refill(); tail.pos = off; }
+}
+void Ars4x32AVX512::jump() noexcept      { skip_ahead(0, 1); }
+void Ars4x32AVX512::long_jump() noexcept { skip_ahead(0, 1ull << 32); }
+
+// ----------------------------------------
+// bulk generators
+// ----------------------------------------
+void Ars4x32AVX512::refill() noexcept {
+  blocks(load_keys(rk), ctr_lo, ctr_hi, tail.buf); advance(BLOCKS);
+  tail.pos = 0;
+}
+
+void Ars4x32AVX512::generate_u64(std::uint64_t* out, std::size_t n) noexcept {
+  const Keys K = load_keys(rk);
+  std::size_t i = tail.take(out, n);
+  for (; i + STEP <= n; i += STEP) { blocks(K, ctr_lo, ctr_hi, out + i); advance(BLOCKS); }
+  if (i < n) { refill(); tail.take(out + i, n - i); }
+}
+
+void Ars4x32AVX512::generate_double(double* out, std::size_t n) noexcept {
+  const Keys K = load_keys(rk);
+  const __m512i EXP = _mm512_set1_epi64((long long)(0x3FFull << 52));
+  const __m512d one = _mm512_set1_pd(1.0);
+  alignas(64) std::uint64_t tmp[STEP];
+  std::size_t i = tail.take(out, n);
+  for (; i + STEP <= n; i += STEP) {
+    blocks(K, ctr_lo, ctr_hi, tmp); advance(BLOCKS);
+    for (std::size_t j = 0; j < STEP; j += 8) {
+      const __m512i u = _mm512_srli_epi64(_mm512_load_si512(reinterpret_cast<const void*>(tmp + j)), 12);
+      _mm512_storeu_pd(out + i + j, _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_epi64(u, EXP)), one));
+    }
+  }
+  if (i < n) { refill(); tail.take(out + i, n - i); }
+}
+
+} // namespace ua::detail
@@ -0,0 +1,35 @@
+// Portable (no ISA flags): scalar Box–Muller kernel and the kernel choice
+// for ua::NormalGenerator.
+#include "ua/ua_normal_avx2.h"
+#include "ua_kernel_tier.h"
+#include "ua_math_consts.h"
+#include <cmath>
+
+namespace ua::detail {
+
+// libm ln / sin / cos on the SIMD kernels' reduction in turns: the scalar
+// tier is the one without FMA, where an fma-exact copy of the SIMD
+// polynomials would cost a software fma per step
+void box_muller_scalar(const double* u, std::size_t pairs, double* out) noexcept {
+  using namespace math_c;
+  for (std::size_t j = 0; j < pairs; ++j) {
+    const double r = std::sqrt(-2.0 * std::log(1.0 - u[2*j]));
+    const double t = 4.0 * u[2*j + 1] + TO_INT;           // round(4u) + TO_INT
+    const long long q = static_cast<long long>(t - TO_INT);
+    const double x = TWO_PI_HI * (u[2*j + 1] - 0.25 * (t - TO_INT));
+    const double sx = std::sin(x), cx = std::cos(x);
+    double s = (q & 1) ? cx : sx;
+    double c = (q & 1) ? sx : cx;
+    if (q & 2)       s = -s;
+    if ((q + 1) & 2) c = -c;
+    out[2*j]     = r * c;
+    out[2*j + 1] = r * s;
+  }
+}
+
+BoxMullerFn box_muller_kernel() noexcept {
+  static const BoxMullerFn k = kernel_for_tier(&box_muller_scalar, &box_muller_avx2, &box_muller_avx512);
+  return k;
+}
+
+} // namespace ua::detail
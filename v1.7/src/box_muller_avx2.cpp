@@ -0,0 +1,41 @@
+#include "ua/ua_normal_avx2.h"
+#include "ua_math_avx2.h"
+#include <immintrin.h>
+
+namespace ua::detail {
+
+namespace {
+
+// 4 pairs: u[0..7] -> out[0..7]. unpacklo/hi split the interleaved pairs
+// into u1 / u2 vectors (lane order 0, 2, 1, 3) and put them back the same way.
+inline void pairs4(const double* u, double* out) noexcept {
+  const __m256d a  = _mm256_loadu_pd(u);
+  const __m256d b  = _mm256_loadu_pd(u + 4);
+  const __m256d u1 = _mm256_unpacklo_pd(a, b);
+  const __m256d u2 = _mm256_unpackhi_pd(a, b);
+  const __m256d r  = _mm256_sqrt_pd(_mm256_mul_pd(_mm256_set1_pd(-2.0),
+                                                  ua_log_rr_pd(_mm256_sub_pd(_mm256_set1_pd(1.0), u1))));
+  __m256d s, c;
+  ua_sincos2pi_pd(u2, s, c);
+  const __m256d z0 = _mm256_mul_pd(r, c);
+  const __m256d z1 = _mm256_mul_pd(r, s);
+  _mm256_storeu_pd(out,     _mm256_unpacklo_pd(z0, z1));
+  _mm256_storeu_pd(out + 4, _mm256_unpackhi_pd(z0, z1));
+}
+
+} // namespace
+
+void box_muller_avx2(const double* u, std::size_t pairs, double* out) noexcept {
+  std::size_t j = 0;
+  for (; j + 4 <= pairs; j += 4) pairs4(u + 2*j, out + 2*j);
+  if (j < pairs) {
+    // 1..3 pairs left: run them through a zero-padded vector
+    const std::size_t m = 2 * (pairs - j);
+    alignas(32) double t[8] = {};
+    for (std::size_t k = 0; k < m; ++k) t[k] = u[2*j + k];
+    pairs4(t, t);
+    for (std::size_t k = 0; k < m; ++k) out[2*j + k] = t[k];
+  }
+}
+
+} // namespace ua::detail
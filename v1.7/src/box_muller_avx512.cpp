@@ -0,0 +1,34 @@
+#include "ua/ua_normal_avx2.h"
+#include "ua_math_avx512.h"
+#include <immintrin.h>
+
+namespace ua::detail {
+
+namespace {
+
+// 8 pairs: u[0..15] -> out[0..15], the AVX2 pairs4 split and merge per
+// 128-bit lane. `live` masks the 16 doubles on the last call.
+inline void pairs8(const double* u, double* out, __mmask16 live) noexcept {
+  const __m512d a  = _mm512_maskz_loadu_pd(__mmask8(live), u);
+  const __m512d b  = _mm512_maskz_loadu_pd(__mmask8(live >> 8), u + 8);
+  const __m512d u1 = _mm512_unpacklo_pd(a, b);
+  const __m512d u2 = _mm512_unpackhi_pd(a, b);
+  const __m512d r  = _mm512_sqrt_pd(_mm512_mul_pd(_mm512_set1_pd(-2.0),
+                                                  ua_log_rr_pd(_mm512_sub_pd(_mm512_set1_pd(1.0), u1))));
+  __m512d s, c;
+  ua_sincos2pi_pd(u2, s, c);
+  const __m512d z0 = _mm512_mul_pd(r, c);
+  const __m512d z1 = _mm512_mul_pd(r, s);
+  _mm512_mask_storeu_pd(out,     __mmask8(live),      _mm512_unpacklo_pd(z0, z1));
+  _mm512_mask_storeu_pd(out + 8, __mmask8(live >> 8), _mm512_unpackhi_pd(z0, z1));
+}
+
+} // namespace
+
+void box_muller_avx512(const double* u, std::size_t pairs, double* out) noexcept {
+  std::size_t j = 0;
+  for (; j + 8 <= pairs; j += 8) pairs8(u + 2*j, out + 2*j, 0xFFFF);
+  if (j < pairs) pairs8(u + 2*j, out + 2*j, __mmask16((1u << (2 * (pairs - j))) - 1));
+}
+
+} // namespace ua::detail
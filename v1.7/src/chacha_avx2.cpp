@@ -0,0 +1,139 @@
+#include "ua/ua_chacha_avx2.h"
+#include "ua/ua_chacha_scalar.h"
+#include <immintrin.h>
+
+namespace ua::detail {
+
+// ----------------------------------------
+// helpers
+// ----------------------------------------
+static inline __m256i rotl32(__m256i x, int k) noexcept {
+  return _mm256_or_si256(_mm256_slli_epi32(x, k), _mm256_srli_epi32(x, 32 - k));
+}
+// byte-aligned rotates are a single pshufb
+static inline __m256i rotl16(__m256i x) noexcept {
+  const __m256i m = _mm256_setr_epi8(2,3,0,1, 6,7,4,5, 10,11,8,9, 14,15,12,13,
+                                     2,3,0,1, 6,7,4,5, 10,11,8,9, 14,15,12,13);
+  return _mm256_shuffle_epi8(x, m);
+}
+static inline __m256i rotl8(__m256i x) noexcept {
+  const __m256i m = _mm256_setr_epi8(3,0,1,2, 7,4,5,6, 11,8,9,10, 15,12,13,14,
+                                     3,0,1,2, 7,4,5,6, 11,8,9,10, 15,12,13,14);
+  return _mm256_shuffle_epi8(x, m);
+}
+
+static inline void qr(__m256i& a, __m256i& b, __m256i& c, __m256i& d) noexcept {
+  a = _mm256_add_epi32(a, b); d = rotl16(_mm256_xor_si256(d, a));
+  c = _mm256_add_epi32(c, d); b = rotl32(_mm256_xor_si256(b, c), 12);
+  a = _mm256_add_epi32(a, b); d = rotl8(_mm256_xor_si256(d, a));
+  c = _mm256_add_epi32(c, d); b = rotl32(_mm256_xor_si256(b, c), 7);
+}
+
+// 8x8 transpose of 32-bit words: r[w] lane j -> row j word w
+static inline void transpose8(const __m256i r[8], __m256i o[8]) noexcept {
+  const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]), t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+  const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]), t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+  const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]), t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+  const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]), t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+  const __m256i u0 = _mm256_unpacklo_epi64(t0, t2), u1 = _mm256_unpackhi_epi64(t0, t2);
+  const __m256i u2 = _mm256_unpacklo_epi64(t1, t3), u3 = _mm256_unpackhi_epi64(t1, t3);
+  const __m256i u4 = _mm256_unpacklo_epi64(t4, t6), u5 = _mm256_unpackhi_epi64(t4, t6);
+  const __m256i u6 = _mm256_unpacklo_epi64(t5, t7), u7 = _mm256_unpackhi_epi64(t5, t7);
+  o[0] = _mm256_permute2x128_si256(u0, u4, 0x20); o[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+  o[1] = _mm256_permute2x128_si256(u1, u5, 0x20); o[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+  o[2] = _mm256_permute2x128_si256(u2, u6, 0x20); o[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+  o[3] = _mm256_permute2x128_si256(u3, u7, 0x20); o[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+// ----------------------------------------
+// state & core PRNG
+// ----------------------------------------
+ChaChaAVX2::ChaChaAVX2(std::uint64_t seed, int r) noexcept : rounds(r) { chacha_key_from_seed(seed, k); }
+ChaChaAVX2::ChaChaAVX2(const std::uint32_t key[8], int r) noexcept : rounds(r) {
+  for (int i = 0; i < 8; ++i) k[i] = key[i];
+}
+
+void ChaChaAVX2::advance(std::uint64_t lo, std::uint64_t hi) noexcept {
+  const std::uint64_t s = ctr_lo + lo;
+  ctr_hi += hi + (s < ctr_lo ? 1 : 0);
+  ctr_lo = s;
+}
+
+void ChaChaAVX2::skip_ahead(std::uint64_t lo, std::uint64_t hi) noexcept {
+  std::size_t off;
+  const std::uint64_t back = tail.rewind(off);
+  advance(lo - back, hi - (lo < back ? 1 : 0));
+  if (off) { refill(); tail.pos = off; }
+}
+void ChaChaAVX2::jump() noexcept      { skip_ahead(0, 1); }
+void ChaChaAVX2::long_jump() noexcept { skip_ahead(0, 1ull << 32); }
+
+void ChaChaAVX2::next_blocks(std::uint64_t* out) noexcept {
+  // per-lane counters base + j with the full 128-bit carry
+  alignas(32) std::uint32_t c[4][LANES];
+  for (int j = 0; j < LANES; ++j) {
+    const std::uint64_t lo = ctr_lo + (std::uint64_t)j;
+    const std::uint64_t hi = ctr_hi + (lo < ctr_lo ? 1 : 0);
+    c[0][j] = (std::uint32_t)lo; c[1][j] = (std::uint32_t)(lo >> 32);
+    c[2][j] = (std::uint32_t)hi; c[3][j] = (std::uint32_t)(hi >> 32);
+  }
+  advance((std::uint64_t)LANES);
+
+  __m256i s[16];
+  s[0] = _mm256_set1_epi32((int)CHACHA_C0); s[1] = _mm256_set1_epi32((int)CHACHA_C1);
+  s[2] = _mm256_set1_epi32((int)CHACHA_C2); s[3] = _mm256_set1_epi32((int)CHACHA_C3);
+  for (int i = 0; i < 8; ++i) s[4 + i] = _mm256_set1_epi32((int)k[i]);
+  for (int i = 0; i < 4; ++i) s[12 + i] = _mm256_load_si256(reinterpret_cast<const __m256i*>(c[i]));
+
+  __m256i x[16];
+  for (int i = 0; i < 16; ++i) x[i] = s[i];
+  for (int r = 0; r < rounds; r += 2) {
+    qr(x[0], x[4], x[ 8], x[12]); qr(x[1], x[5], x[ 9], x[13]);
+    qr(x[2], x[6], x[10], x[14]); qr(x[3], x[7], x[11], x[15]);
+    qr(x[0], x[5], x[10], x[15]); qr(x[1], x[6], x[11], x[12]);
+    qr(x[2], x[7], x[ 8], x[13]); qr(x[3], x[4], x[ 9], x[14]);
+  }
+  for (int i = 0; i < 16; ++i) x[i] = _mm256_add_epi32(x[i], s[i]);
+
+  // block j = words 0..7 (row j of the first transpose) + words 8..15
+  __m256i lo[8], hi[8];
+  transpose8(x, lo);
+  transpose8(x + 8, hi);
+  for (int j = 0; j < LANES; ++j) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 8 * j),     lo[j]);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 8 * j + 4), hi[j]);
+  }
+}
+
+// ----------------------------------------
+// bulk generators
+// ----------------------------------------
+void ChaChaAVX2::refill() noexcept {
+  next_blocks(tail.buf);
+  tail.pos = 0;
+}
+
+void ChaChaAVX2::generate_u64(std::uint64_t* out, std::size_t n) noexcept {
+  constexpr std::size_t STEP = 8 * LANES;
+  std::size_t i = tail.take(out, n);
+  for (; i + STEP <= n; i += STEP) next_blocks(out + i);
+  if (i < n) { refill(); tail.take(out + i, n - i); }
+}
+
+void ChaChaAVX2::generate_double(double* out, std::size_t n) noexcept {
+  constexpr std::size_t STEP = 8 * LANES;
+  const __m256i EXP = _mm256_set1_epi64x(0x3FFull << 52);
+  const __m256d one = _mm256_set1_pd(1.0);
+  alignas(32) std::uint64_t tmp[STEP];
+  std::size_t i = tail.take(out, n);
+  for (; i + STEP <= n; i += STEP) {
+    next_blocks(tmp);
+    for (std::size_t j = 0; j < STEP; j += 4) {
+      const __m256i u = _mm256_srli_epi64(_mm256_load_si256(reinterpret_cast<const __m256i*>(tmp + j)), 12);
+      _mm256_storeu_pd(out + i + j, _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(u, EXP)), one));
+    }
+  }
+  if (i < n) { refill(); tail.take(out + i, n - i); }
+}
+
+} // namespace ua::detail
@@ -0,0 +1,125 @@
+#include "ua/ua_chacha_avx512.h"
+#include "ua/ua_chacha_scalar.h"
+#include <immintrin.h>
+
+namespace ua::detail {
+
+// ----------------------------------------
+// helpers
+// ----------------------------------------
+static inline void qr(__m512i& a, __m512i& b, __m512i& c, __m512i& d) noexcept {
+  a = _mm512_add_epi32(a, b); d = _mm512_rol_epi32(_mm512_xor_si512(d, a), 16);
+  c = _mm512_add_epi32(c, d); b = _mm512_rol_epi32(_mm512_xor_si512(b, c), 12);
+  a = _mm512_add_epi32(a, b); d = _mm512_rol_epi32(_mm512_xor_si512(d, a), 8);
+  c = _mm512_add_epi32(c, d); b = _mm512_rol_epi32(_mm512_xor_si512(b, c), 7);
+}
+
+// ----------------------------------------
+// state & core PRNG
+// ----------------------------------------
+ChaChaAVX512::ChaChaAVX512(std::uint64_t seed, int r) noexcept : rounds(r) { chacha_key_from_seed(seed, k); }
+ChaChaAVX512::ChaChaAVX512(const std::uint32_t key[8], int r) noexcept : rounds(r) {
+  for (int i = 0; i < 8; ++i) k[i] = key[i];
+}
+
+void ChaChaAVX512::advance(std::uint64_t lo, std::uint64_t hi) noexcept {
+  const std::uint64_t s = ctr_lo + lo;
+  ctr_hi += hi + (s < ctr_lo ? 1 : 0);
+  ctr_lo = s;
+}
+
+void ChaChaAVX512::skip_ahead(std::uint64_t lo, std::uint64_t hi) noexcept {
+  std::size_t off;
+  const std::uint64_t back = tail.rewind(off);
+  advance(lo - back, hi - (lo < back ? 1 : 0));
+  if (off) { refill(); tail.pos = off; }
+}
+void ChaChaAVX512::jump() noexcept      { skip_ahead(0, 1); }
+void ChaChaAVX512::long_jump() noexcept { skip_ahead(0, 1ull << 32); }
+
+void ChaChaAVX512::next_blocks(std::uint64_t* out) noexcept {
+  // per-lane counters base + j with the full 128-bit carry
+  alignas(64) std::uint32_t c[4][LANES];
+  for (int j = 0; j < LANES; ++j) {
+    const std::uint64_t lo = ctr_lo + (std::uint64_t)j;
+    const std::uint64_t hi = ctr_hi + (lo < ctr_lo ? 1 : 0);
+    c[0][j] = (std::uint32_t)lo; c[1][j] = (std::uint32_t)(lo >> 32);
+    c[2][j] = (std::uint32_t)hi; c[3][j] = (std::uint32_t)(hi >> 32);
+  }
+  advance((std::uint64_t)LANES);
+
+  __m512i s[16];
+  s[0] = _mm512_set1_epi32((int)CHACHA_C0); s[1] = _mm512_set1_epi32((int)CHACHA_C1);
+  s[2] = _mm512_set1_epi32((int)CHACHA_C2); s[3] = _mm512_set1_epi32((int)CHACHA_C3);
+  for (int i = 0; i < 8; ++i) s[4 + i] = _mm512_set1_epi32((int)k[i]);
+  for (int i = 0; i < 4; ++i) s[12 + i] = _mm512_load_si512(reinterpret_cast<const void*>(c[i]));
+
+  __m512i x[16];
+  for (int i = 0; i < 16; ++i) x[i] = s[i];
+  for (int r = 0; r < rounds; r += 2) {
+    qr(x[0], x[4], x[ 8], x[12]); qr(x[1], x[5], x[ 9], x[13]);
+    qr(x[2], x[6], x[10], x[14]); qr(x[3], x[7], x[11], x[15]);
+    qr(x[0], x[5], x[10], x[15]); qr(x[1], x[6], x[11], x[12]);
+    qr(x[2], x[7], x[ 8], x[13]); qr(x[3], x[4], x[ 9], x[14]);
+  }
+  for (int i = 0; i < 16; ++i) x[i] = _mm512_add_epi32(x[i], s[i]);
+
+  // 16x16 transpose. After the 32/64-bit unpacks, 128-bit lane q of u[4g+m]
+  // holds words 4g..4g+3 of block 4q+m; a 4x4 shuffle of 128-bit lanes then
+  // assembles each block.
+  __m512i t[16], u[16];
+  for (int p = 0; p < 8; ++p) {
+    t[2 * p]     = _mm512_unpacklo_epi32(x[2 * p], x[2 * p + 1]);
+    t[2 * p + 1] = _mm512_unpackhi_epi32(x[2 * p], x[2 * p + 1]);
+  }
+  for (int g = 0; g < 4; ++g) {
+    u[4 * g + 0] = _mm512_unpacklo_epi64(t[4 * g],     t[4 * g + 2]);
+    u[4 * g + 1] = _mm512_unpackhi_epi64(t[4 * g],     t[4 * g + 2]);
+    u[4 * g + 2] = _mm512_unpacklo_epi64(t[4 * g + 1], t[4 * g + 3]);
+    u[4 * g + 3] = _mm512_unpackhi_epi64(t[4 * g + 1], t[4 * g + 3]);
+  }
+  for (int m = 0; m < 4; ++m) {
+    const __m512i A = u[m], B = u[4 + m], C = u[8 + m], D = u[12 + m];
+    const __m512i P = _mm512_shuffle_i32x4(A, B, 0x44);   // A0 A1 B0 B1
+    const __m512i Q = _mm512_shuffle_i32x4(C, D, 0x44);   // C0 C1 D0 D1
+    const __m512i R = _mm512_shuffle_i32x4(A, B, 0xEE);   // A2 A3 B2 B3
+    const __m512i S = _mm512_shuffle_i32x4(C, D, 0xEE);   // C2 C3 D2 D3
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + 8 * (0 + m)),  _mm512_shuffle_i32x4(P, Q, 0x88));
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + 8 * (4 + m)),  _mm512_shuffle_i32x4(P, Q, 0xDD));
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + 8 * (8 + m)),  _mm512_shuffle_i32x4(R, S, 0x88));
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + 8 * (12 + m)), _mm512_shuffle_i32x4(R, S, 0xDD));
+  }
+}
+
+// ----------------------------------------
+// bulk generators
+// ----------------------------------------
+void ChaChaAVX512::refill() noexcept {
+  next_blocks(tail.buf);
+  tail.pos = 0;
+}
+
+void ChaChaAVX512::generate_u64(std::uint64_t* out, std::size_t n) noexcept {
+  constexpr std::size_t STEP = 8 * LANES;
+  std::size_t i = tail.take(out, n);
+  for (; i + STEP <= n; i += STEP) next_blocks(out + i);
+  if (i < n) { refill(); tail.take(out + i, n - i); }
+}
+
+void ChaChaAVX512::generate_double(double* out, std::size_t n) noexcept {
+  constexpr std::size_t STEP = 8 * LANES;
+  const __m512i EXP = _mm512_set1_epi64((long long)(0x3FFull << 52));
+  const __m512d one = _mm512_set1_pd(1.0);
+  alignas(64) std::uint64_t tmp[STEP];
+  std::size_t i = tail.take(out, n);
+  for (; i + STEP <= n; i += STEP) {
+    next_blocks(tmp);
+    for (std::size_t j = 0; j < STEP; j += 8) {
+      const __m512i v = _mm512_srli_epi64(_mm512_load_si512(reinterpret_cast<const void*>(tmp + j)), 12);
+      _mm512_storeu_pd(out + i + j, _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_epi64(v, EXP)), one));
+    }
+  }
+  if (i < n) { refill(); tail.take(out + i, n - i); }
+}
+
+} // namespace ua::detail
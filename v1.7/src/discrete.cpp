@@ -0,0 +1,126 @@
+// Portable (no ISA flags): scalar Poisson / binomial kernels and the kernel
+// choice for ua::PoissonGenerator / ua::BinomialGenerator.
+#include "ua/ua_distributions.h"
+#include "ua_kernel_tier.h"
+#include "ua_math_consts.h"
+#include <cmath>
+
+namespace ua::detail {
+
+namespace {
+
+using namespace math_c;
+
+// Stirling correction fc(k) given ik = 1 / (k + 1), k >= 0 integral
+// (ua_math_consts.h)
+inline double stirling_fc(double k, double ik) noexcept {
+  if (k < 10.0) return STIRLING_FC[static_cast<int>(k)];
+  const double ik2 = ik * ik;
+  return (1.0 / 12 - (1.0 / 360 - ik2 * (1.0 / 1260)) * ik2) * ik;
+}
+
+// ln(1 - q), q in [0, 1/2]: ln of the rounded w = 1 - q, corrected by the
+// rounding error (w - 1 is exact)
+inline double log1m(double q) noexcept {
+  const double w = 1.0 - q;
+  return std::log(w) - ((w - 1.0) + q) / w;
+}
+
+} // namespace
+
+std::size_t poisson_scalar(const double* lam, const double* u, const double* v, std::size_t n,
+                           std::uint32_t* out, std::uint32_t* miss) noexcept {
+  std::size_t r = 0;
+  for (std::size_t j = 0; j < n; ++j) {
+    const double l = lam[j];
+    double k = 0.0;
+    bool ok = true;
+    if (l < DISC_INV_MEAN) {
+      double p = std::exp(-l), F = p;
+      int i = 1;
+      for (; u[j] >= F && i <= DISC_INV_KMAX; ++i) {
+        p = p * (l * (1.0 / i));
+        F = F + p;
+        k += 1.0;
+      }
+      ok = u[j] < F;
+    } else {
+      // the SIMD kernels' operations in the same order (discrete_avx2.cpp)
+      const double b = 2.53 * std::sqrt(l) + 0.931, a = 0.02483 * b - 0.059;
+      const double U = u[j] - 0.5, V = 1.0 - v[j], us = 0.5 - std::fabs(U);
+      k = std::floor(((a + a) / us + b) * U + l + 0.43);
+      if (!(us >= 0.07 && (V - 0.9277) * (b - 2.0) <= -3.6224)) {
+        if (k < 0.0 || (us < 0.013 && V > us)) ok = false;
+        else {
+          const double kp1 = k + 1.0, b34 = b - 3.4, us2 = us * us;
+          const double num = (V * us2) * (1.1239 * b34 + 1.1328), den = b34 * (a + b * us2);
+          const double R = 1.0 / (den * kp1);
+          const double lkf = (k + 0.5) * std::log(kp1) - kp1 + HALF_LN_2PI + stirling_fc(k, den * R);
+          ok = std::log((num * kp1) * R) <= k * std::log(l) - l - lkf;
+        }
+      }
+    }
+    if (ok) out[j] = static_cast<std::uint32_t>(k);
+    else    miss[r++] = static_cast<std::uint32_t>(j);
+  }
+  return r;
+}
+
+std::size_t binomial_scalar(const std::uint32_t* trials, const double* p, const double* u, const double* v,
+                            std::size_t n, std::uint32_t* out, std::uint32_t* miss) noexcept {
+  std::size_t r = 0;
+  for (std::size_t j = 0; j < n; ++j) {
+    const double nt = trials[j];
+    const bool flip = p[j] > 0.5;
+    const double q = flip ? 1.0 - p[j] : p[j], w = 1.0 - q;
+    double k = 0.0;
+    bool ok = true;
+    if (nt * q < DISC_INV_MEAN) {
+      const double s = q / w, a = (nt + 1.0) * s;
+      double f = std::exp(nt * log1m(q)), F = f;
+      int i = 1;
+      for (; u[j] >= F && k < nt && i <= DISC_INV_KMAX; ++i) {
+        f = f * (a * (1.0 / i) - s);
+        F = F + f;
+        k += 1.0;
+      }
+      ok = u[j] < F || k >= nt;
+    } else {
+      const double spq = std::sqrt(nt * q * w);
+      const double b = 2.53 * spq + 1.15, a = 0.0248 * b + 0.01 * q - 0.0873, c = nt * q + 0.5;
+      const double U = u[j] - 0.5, V = 1.0 - v[j], us = 0.5 - std::fabs(U);
+      k = std::floor(((a + a) / us + b) * U + c);
+      if (!(us >= 0.07 && (V - 0.92) * b <= -4.2)) {
+        if (k < 0.0 || k > nt) ok = false;
+        else {
+          const double m = std::floor((nt + 1.0) * q), mp1 = m + 1.0, kp1 = k + 1.0;
+          const double nm1 = nt - m + 1.0, nk1 = nt - k + 1.0, us2 = us * us;
+          const double lhs = std::log(((V * us2) * ((2.83 * b + 5.1) * spq)) / (b * (a + b * us2)));
+          const double g12 = mp1 * nm1, g34 = kp1 * nk1, R = 1.0 / (g12 * g34);
+          const double fc = (stirling_fc(m, (nm1 * g34) * R) + stirling_fc(nt - m, (mp1 * g34) * R))
+                          - (stirling_fc(k, (nk1 * g12) * R) + stirling_fc(nt - k, (kp1 * g12) * R));
+          const double bound = (m + 0.5) * std::log((mp1 * w) / (q * nm1))
+                             + (nt + 1.0) * std::log(nm1 / nk1)
+                             + (k + 0.5) * std::log((q * nk1) / (w * kp1));
+          ok = lhs <= bound + fc;
+        }
+      }
+    }
+    if (flip) k = nt - k;
+    if (ok) out[j] = static_cast<std::uint32_t>(k);
+    else    miss[r++] = static_cast<std::uint32_t>(j);
+  }
+  return r;
+}
+
+PoissonFn poisson_kernel() noexcept {
+  static const PoissonFn k = kernel_for_tier(&poisson_scalar, &poisson_avx2, &poisson_avx512);
+  return k;
+}
+
+BinomialFn binomial_kernel() noexcept {
+  static const BinomialFn k = kernel_for_tier(&binomial_scalar, &binomial_avx2, &binomial_avx512);
+  return k;
+}
+
+} // namespace ua::detail
@@ -0,0 +1,266 @@
+#include "ua/ua_distributions.h"
+#include "ua_math_avx2.h"
+#include "ua_math_consts.h"
+#include <immintrin.h>
+#include <bit>
+
+namespace ua::detail {
+
+namespace {
+
+using namespace math_c;
+
+// Lane masks are all-ones / all-zero doubles: a masked add adds (mask & 1),
+// a masked move is a blend. Two vectors per iteration, so the inversion
+// searches (a multiply and an add per step, on every lane) run as two chains.
+
+inline __m256d set(double x) noexcept { return _mm256_set1_pd(x); }
+
+inline __m256d floor_pd(__m256d x) noexcept { return _mm256_round_pd(x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+
+inline __m256d abs_pd(__m256d x) noexcept { return _mm256_andnot_pd(set(-0.0), x); }
+
+inline bool any(__m256d m) noexcept { return _mm256_movemask_pd(m) != 0; }
+
+// a <Op> b on the lanes of m
+template<int Op>
+inline __m256d cmp_in(__m256d m, __m256d a, __m256d b) noexcept { return _mm256_and_pd(m, _mm256_cmp_pd(a, b, Op)); }
+
+// fc(k) given ik = 1 / (k + 1), k >= 0 integral: table below 10, series above
+inline __m256d stirling_fc(__m256d k, __m256d ik) noexcept {
+  const __m256d ik2 = _mm256_mul_pd(ik, ik);
+  const __m256d t = _mm256_sub_pd(set(1.0 / 360), _mm256_mul_pd(ik2, set(1.0 / 1260)));
+  const __m256d series = _mm256_mul_pd(_mm256_sub_pd(set(1.0 / 12), _mm256_mul_pd(t, ik2)), ik);
+  const __m128i i = _mm256_cvttpd_epi32(_mm256_min_pd(k, set(9.0)));
+  return _mm256_blendv_pd(series, _mm256_i32gather_pd(STIRLING_FC, i, 8), _mm256_cmp_pd(k, set(10.0), _CMP_LT_OQ));
+}
+
+inline __m256d live_mask(std::size_t n, std::size_t j) noexcept {
+  const long long left = j >= n ? 0 : static_cast<long long>(n - j);
+  return _mm256_castsi256_pd(_mm256_cmpgt_epi64(_mm256_set1_epi64x(left), _mm256_setr_epi64x(0, 1, 2, 3)));
+}
+
+// 4-bit lane mask -> 32-bit lanes for maskload / maskstore_epi32
+inline __m128i mask32(int m) noexcept {
+  const __m128i bits = _mm_setr_epi32(1, 2, 4, 8);
+  return _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(m), bits), bits);
+}
+
+// counts below 2^32 (as doubles) into the lanes of m, through the signed
+// conversion biased by 2^31
+inline void store_counts(std::uint32_t* out, int m, __m256d k) noexcept {
+  const __m128i s = _mm256_cvttpd_epi32(_mm256_sub_pd(k, set(0x1p31)));
+  _mm_maskstore_epi32(reinterpret_cast<int*>(out), mask32(m), _mm_xor_si128(s, _mm_set1_epi32(INT32_MIN)));
+}
+
+inline std::size_t push_misses(std::uint32_t* miss, std::size_t r, std::size_t base, unsigned m) noexcept {
+  for (; m; m &= m - 1) miss[r++] = static_cast<std::uint32_t>(base + std::countr_zero(m));
+  return r;
+}
+
+// ---------------------------------- Poisson ----------------------------------
+
+struct PoissonLanes {
+  __m256d lam, u, live, small;
+  __m256d k = _mm256_setzero_pd();
+  __m256d bad = _mm256_setzero_pd();
+};
+
+inline PoissonLanes poisson_load(const double* lam, const double* u, std::size_t n, std::size_t j) noexcept {
+  PoissonLanes x;
+  x.live  = live_mask(n, j);
+  x.lam   = _mm256_maskload_pd(lam + j, _mm256_castpd_si256(x.live));
+  x.u     = _mm256_maskload_pd(u + j, _mm256_castpd_si256(x.live));
+  x.small = cmp_in<_CMP_LT_OQ>(x.live, x.lam, set(DISC_INV_MEAN));
+  return x;
+}
+
+// sequential search on the small-mean lanes of two vectors; every searching
+// lane of a vector is at the same k
+inline void poisson_invert(PoissonLanes& x, PoissonLanes& y) noexcept {
+  const __m256d one = set(1.0);
+  __m256d px = ua_exp_pd(_mm256_sub_pd(_mm256_setzero_pd(), x.lam)), Fx = px;
+  __m256d py = ua_exp_pd(_mm256_sub_pd(_mm256_setzero_pd(), y.lam)), Fy = py;
+  __m256d tx = cmp_in<_CMP_GE_OQ>(x.small, x.u, Fx);
+  __m256d ty = cmp_in<_CMP_GE_OQ>(y.small, y.u, Fy);
+  for (int i = 1; any(_mm256_or_pd(tx, ty)) && i <= DISC_INV_KMAX; ++i) {
+    const __m256d inv = set(1.0 / i);
+    px = _mm256_mul_pd(px, _mm256_mul_pd(x.lam, inv));
+    py = _mm256_mul_pd(py, _mm256_mul_pd(y.lam, inv));
+    Fx = _mm256_add_pd(Fx, px);
+    Fy = _mm256_add_pd(Fy, py);
+    x.k = _mm256_add_pd(x.k, _mm256_and_pd(tx, one));
+    y.k = _mm256_add_pd(y.k, _mm256_and_pd(ty, one));
+    tx = cmp_in<_CMP_GE_OQ>(tx, x.u, Fx);
+    ty = cmp_in<_CMP_GE_OQ>(ty, y.u, Fy);
+  }
+  x.bad = tx; y.bad = ty;
+}
+
+// PTRS on the lanes of big, v the second uniforms
+inline void poisson_ptrs(PoissonLanes& x, __m256d big, const double* vp) noexcept {
+  const __m256d one = set(1.0);
+  const __m256d l  = _mm256_blendv_pd(set(DISC_INV_MEAN), x.lam, big);   // ln / sqrt of the PTRS lanes only
+  const __m256d b  = _mm256_add_pd(_mm256_mul_pd(set(2.53), _mm256_sqrt_pd(l)), set(0.931));
+  const __m256d a  = _mm256_sub_pd(_mm256_mul_pd(set(0.02483), b), set(0.059));
+  const __m256d U  = _mm256_sub_pd(x.u, set(0.5));
+  const __m256d V  = _mm256_sub_pd(one, _mm256_maskload_pd(vp, _mm256_castpd_si256(big)));
+  const __m256d us = _mm256_sub_pd(set(0.5), abs_pd(U));
+  const __m256d kk = floor_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_add_pd(_mm256_div_pd(_mm256_add_pd(a, a), us), b), U), l), set(0.43)));
+  // V <= 0.9277 - 3.6224 / (b - 2), b > 8
+  __m256d acc = cmp_in<_CMP_LE_OQ>(cmp_in<_CMP_GE_OQ>(big, us, set(0.07)),
+                                   _mm256_mul_pd(_mm256_sub_pd(V, set(0.9277)), _mm256_sub_pd(b, set(2.0))), set(-3.6224));
+  const __m256d rej = _mm256_or_pd(cmp_in<_CMP_LT_OQ>(big, kk, _mm256_setzero_pd()),
+                                   cmp_in<_CMP_GT_OQ>(cmp_in<_CMP_LT_OQ>(big, us, set(0.013)), V, us));
+  const __m256d rest = _mm256_andnot_pd(_mm256_or_pd(acc, rej), big);
+  if (any(rest)) {
+    // ln(V inva / (a / us^2 + b)) <= k ln lam - lam - ln k!, inva = 1.1239 + 1.1328 / (b - 3.4),
+    // one division for the left side and 1 / (k + 1)
+    const __m256d kr  = _mm256_and_pd(rest, kk);
+    const __m256d kp1 = _mm256_add_pd(kr, one);
+    const __m256d b34 = _mm256_sub_pd(b, set(3.4));
+    const __m256d us2 = _mm256_mul_pd(us, us);
+    const __m256d num = _mm256_mul_pd(_mm256_mul_pd(V, us2), _mm256_add_pd(_mm256_mul_pd(set(1.1239), b34), set(1.1328)));
+    const __m256d den = _mm256_mul_pd(b34, _mm256_add_pd(a, _mm256_mul_pd(b, us2)));
+    const __m256d R   = _mm256_div_pd(one, _mm256_mul_pd(den, kp1));
+    const __m256d lkf = _mm256_add_pd(_mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(_mm256_add_pd(kr, set(0.5)), ua_log_rr_pd(kp1)), kp1),
+                                                    set(HALF_LN_2PI)), stirling_fc(kr, _mm256_mul_pd(den, R)));
+    const __m256d rhs = _mm256_sub_pd(_mm256_sub_pd(_mm256_mul_pd(kr, ua_log_rr_pd(l)), l), lkf);
+    const __m256d lhs = ua_log_rr_pd(_mm256_mul_pd(_mm256_mul_pd(num, kp1), R));
+    acc = _mm256_or_pd(acc, cmp_in<_CMP_LE_OQ>(rest, lhs, rhs));
+  }
+  x.bad = _mm256_or_pd(x.bad, _mm256_andnot_pd(acc, big));
+  x.k = _mm256_blendv_pd(x.k, kk, _mm256_and_pd(big, acc));
+}
+
+// --------------------------------- binomial ---------------------------------
+
+struct BinomialLanes {
+  __m256d nt, q, u, live, small, flip;
+  __m256d k = _mm256_setzero_pd();
+  __m256d bad = _mm256_setzero_pd();
+};
+
+// q = min(p, 1 - p); the mean n q picks the method. u32 trials -> double
+// through the signed conversion, biased by 2^31
+inline BinomialLanes binomial_load(const std::uint32_t* trials, const double* p, const double* u, std::size_t n, std::size_t j) noexcept {
+  BinomialLanes x;
+  x.live  = live_mask(n, j);
+  const __m128i t32 = _mm_maskload_epi32(reinterpret_cast<const int*>(trials + j), mask32(_mm256_movemask_pd(x.live)));
+  x.nt    = _mm256_add_pd(_mm256_cvtepi32_pd(_mm_xor_si128(t32, _mm_set1_epi32(INT32_MIN))), set(0x1p31));
+  const __m256d pv = _mm256_maskload_pd(p + j, _mm256_castpd_si256(x.live));
+  x.flip  = _mm256_cmp_pd(pv, set(0.5), _CMP_GT_OQ);
+  x.q     = _mm256_blendv_pd(pv, _mm256_sub_pd(set(1.0), pv), x.flip);
+  x.u     = _mm256_maskload_pd(u + j, _mm256_castpd_si256(x.live));
+  x.small = cmp_in<_CMP_LT_OQ>(x.live, _mm256_mul_pd(x.nt, x.q), set(DISC_INV_MEAN));
+  return x;
+}
+
+// f(0) = (1 - q)^n, f(k) = f(k - 1) ((n + 1) s / k - s), s = q / (1 - q),
+// ln(1 - q) from the rounded 1 - q and its rounding error; stops at k = n
+inline void binomial_invert(BinomialLanes& x, BinomialLanes& y) noexcept {
+  const __m256d one = set(1.0);
+  const __m256d wx = _mm256_sub_pd(one, x.q), wy = _mm256_sub_pd(one, y.q);
+  const __m256d sx = _mm256_div_pd(x.q, wx), sy = _mm256_div_pd(y.q, wy);
+  const __m256d ax = _mm256_mul_pd(_mm256_add_pd(x.nt, one), sx), ay = _mm256_mul_pd(_mm256_add_pd(y.nt, one), sy);
+  const __m256d lx = _mm256_sub_pd(ua_log_rr_pd(wx), _mm256_div_pd(_mm256_add_pd(_mm256_sub_pd(wx, one), x.q), wx));
+  const __m256d ly = _mm256_sub_pd(ua_log_rr_pd(wy), _mm256_div_pd(_mm256_add_pd(_mm256_sub_pd(wy, one), y.q), wy));
+  __m256d fx = ua_exp_pd(_mm256_mul_pd(x.nt, lx)), Fx = fx;
+  __m256d fy = ua_exp_pd(_mm256_mul_pd(y.nt, ly)), Fy = fy;
+  __m256d tx = cmp_in<_CMP_LT_OQ>(cmp_in<_CMP_GE_OQ>(x.small, x.u, Fx), x.k, x.nt);
+  __m256d ty = cmp_in<_CMP_LT_OQ>(cmp_in<_CMP_GE_OQ>(y.small, y.u, Fy), y.k, y.nt);
+  for (int i = 1; any(_mm256_or_pd(tx, ty)) && i <= DISC_INV_KMAX; ++i) {
+    const __m256d inv = set(1.0 / i);
+    fx = _mm256_mul_pd(fx, _mm256_sub_pd(_mm256_mul_pd(ax, inv), sx));
+    fy = _mm256_mul_pd(fy, _mm256_sub_pd(_mm256_mul_pd(ay, inv), sy));
+    Fx = _mm256_add_pd(Fx, fx);
+    Fy = _mm256_add_pd(Fy, fy);
+    x.k = _mm256_add_pd(x.k, _mm256_and_pd(tx, one));
+    y.k = _mm256_add_pd(y.k, _mm256_and_pd(ty, one));
+    tx = cmp_in<_CMP_LT_OQ>(cmp_in<_CMP_GE_OQ>(tx, x.u, Fx), x.k, x.nt);
+    ty = cmp_in<_CMP_LT_OQ>(cmp_in<_CMP_GE_OQ>(ty, y.u, Fy), y.k, y.nt);
+  }
+  x.bad = tx; y.bad = ty;
+}
+
+// BTRS on the lanes of big
+inline void binomial_btrs(BinomialLanes& x, __m256d big, const double* vp) noexcept {
+  const __m256d one = set(1.0);
+  const __m256d nt = x.nt, q = x.q, w = _mm256_sub_pd(one, q);
+  const __m256d spq = _mm256_sqrt_pd(_mm256_mul_pd(_mm256_mul_pd(nt, q), w));
+  const __m256d b  = _mm256_add_pd(_mm256_mul_pd(set(2.53), spq), set(1.15));
+  const __m256d a  = _mm256_sub_pd(_mm256_add_pd(_mm256_mul_pd(set(0.0248), b), _mm256_mul_pd(set(0.01), q)), set(0.0873));
+  const __m256d c  = _mm256_add_pd(_mm256_mul_pd(nt, q), set(0.5));
+  const __m256d U  = _mm256_sub_pd(x.u, set(0.5));
+  const __m256d V  = _mm256_sub_pd(one, _mm256_maskload_pd(vp, _mm256_castpd_si256(big)));
+  const __m256d us = _mm256_sub_pd(set(0.5), abs_pd(U));
+  const __m256d kk = floor_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_add_pd(_mm256_div_pd(_mm256_add_pd(a, a), us), b), U), c));
+  // V <= 0.92 - 4.2 / b, b > 0
+  __m256d acc = cmp_in<_CMP_LE_OQ>(cmp_in<_CMP_GE_OQ>(big, us, set(0.07)),
+                                   _mm256_mul_pd(_mm256_sub_pd(V, set(0.92)), b), set(-4.2));
+  const __m256d rej = _mm256_or_pd(cmp_in<_CMP_LT_OQ>(big, kk, _mm256_setzero_pd()), cmp_in<_CMP_GT_OQ>(big, kk, nt));
+  const __m256d rest = _mm256_andnot_pd(_mm256_or_pd(acc, rej), big);
+  if (any(rest)) {
+    // ln(V alpha / (a / us^2 + b)) <= the bound, alpha = (2.83 + 5.1 / b) sqrt(n q (1 - q));
+    // the four fc arguments share one division
+    const __m256d kr  = _mm256_and_pd(rest, kk);
+    const __m256d m   = floor_pd(_mm256_mul_pd(_mm256_add_pd(nt, one), q));
+    const __m256d mp1 = _mm256_add_pd(m, one), kp1 = _mm256_add_pd(kr, one);
+    const __m256d nm1 = _mm256_add_pd(_mm256_sub_pd(nt, m), one), nk1 = _mm256_add_pd(_mm256_sub_pd(nt, kr), one);
+    const __m256d us2 = _mm256_mul_pd(us, us);
+    const __m256d lhs = ua_log_rr_pd(_mm256_div_pd(_mm256_mul_pd(_mm256_mul_pd(V, us2), _mm256_mul_pd(_mm256_add_pd(_mm256_mul_pd(set(2.83), b), set(5.1)), spq)),
+                                                   _mm256_mul_pd(b, _mm256_add_pd(a, _mm256_mul_pd(b, us2)))));
+    const __m256d g12 = _mm256_mul_pd(mp1, nm1), g34 = _mm256_mul_pd(kp1, nk1);
+    const __m256d R   = _mm256_div_pd(one, _mm256_mul_pd(g12, g34));
+    const __m256d fc  = _mm256_sub_pd(_mm256_add_pd(stirling_fc(m, _mm256_mul_pd(_mm256_mul_pd(nm1, g34), R)),
+                                                    stirling_fc(_mm256_sub_pd(nt, m), _mm256_mul_pd(_mm256_mul_pd(mp1, g34), R))),
+                                      _mm256_add_pd(stirling_fc(kr, _mm256_mul_pd(_mm256_mul_pd(nk1, g12), R)),
+                                                    stirling_fc(_mm256_sub_pd(nt, kr), _mm256_mul_pd(_mm256_mul_pd(kp1, g12), R))));
+    // lanes outside `rest` may feed meaningless values to ln; their compare is masked off
+    __m256d bound = _mm256_mul_pd(_mm256_add_pd(m, set(0.5)), ua_log_rr_pd(_mm256_div_pd(_mm256_mul_pd(mp1, w), _mm256_mul_pd(q, nm1))));
+    bound = _mm256_add_pd(bound, _mm256_mul_pd(_mm256_add_pd(nt, one), ua_log_rr_pd(_mm256_div_pd(nm1, nk1))));
+    bound = _mm256_add_pd(bound, _mm256_mul_pd(_mm256_add_pd(kr, set(0.5)), ua_log_rr_pd(_mm256_div_pd(_mm256_mul_pd(q, nk1), _mm256_mul_pd(w, kp1)))));
+    acc = _mm256_or_pd(acc, cmp_in<_CMP_LE_OQ>(rest, lhs, _mm256_add_pd(bound, fc)));
+  }
+  x.bad = _mm256_or_pd(x.bad, _mm256_andnot_pd(acc, big));
+  x.k = _mm256_blendv_pd(x.k, kk, _mm256_and_pd(big, acc));
+}
+
+inline std::size_t finish(std::uint32_t* out, std::uint32_t* miss, std::size_t r, std::size_t j,
+                          __m256d live, __m256d bad, __m256d k) noexcept {
+  const int mb = _mm256_movemask_pd(bad);
+  store_counts(out + j, _mm256_movemask_pd(live) & ~mb, k);
+  return push_misses(miss, r, j, static_cast<unsigned>(mb));
+}
+
+} // namespace
+
+std::size_t poisson_avx2(const double* lam, const double* u, const double* v, std::size_t n,
+                         std::uint32_t* out, std::uint32_t* miss) noexcept {
+  std::size_t r = 0;
+  for (std::size_t j = 0; j < n; j += 8) {
+    PoissonLanes x = poisson_load(lam, u, n, j), y = poisson_load(lam, u, n, j + 4);
+    if (any(_mm256_or_pd(x.small, y.small))) poisson_invert(x, y);
+    if (const __m256d big = _mm256_andnot_pd(x.small, x.live); any(big)) poisson_ptrs(x, big, v + j);
+    if (const __m256d big = _mm256_andnot_pd(y.small, y.live); any(big)) poisson_ptrs(y, big, v + j + 4);
+    r = finish(out, miss, r, j, x.live, x.bad, x.k);
+    r = finish(out, miss, r, j + 4, y.live, y.bad, y.k);
+  }
+  return r;
+}
+
+std::size_t binomial_avx2(const std::uint32_t* trials, const double* p, const double* u, const double* v,
+                          std::size_t n, std::uint32_t* out, std::uint32_t* miss) noexcept {
+  std::size_t r = 0;
+  for (std::size_t j = 0; j < n; j += 8) {
+    BinomialLanes x = binomial_load(trials, p, u, n, j), y = binomial_load(trials, p, u, n, j + 4);
+    if (any(_mm256_or_pd(x.small, y.small))) binomial_invert(x, y);
+    if (const __m256d big = _mm256_andnot_pd(x.small, x.live); any(big)) binomial_btrs(x, big, v + j);
+    if (const __m256d big = _mm256_andnot_pd(y.small, y.live); any(big)) binomial_btrs(y, big, v + j + 4);
+    r = finish(out, miss, r, j, x.live, x.bad, _mm256_blendv_pd(x.k, _mm256_sub_pd(x.nt, x.k), x.flip));
+    r = finish(out, miss, r, j + 4, y.live, y.bad, _mm256_blendv_pd(y.k, _mm256_sub_pd(y.nt, y.k), y.flip));
+  }
+  return r;
+}
+
+} // namespace ua::detail
@@ -0,0 +1,248 @@
+#include "ua/ua_distributions.h"
+#include "ua_math_avx512.h"
+#include "ua_math_consts.h"
+#include <immintrin.h>
+#include <bit>
+
+namespace ua::detail {
+
+namespace {
+
+using namespace math_c;
+
+// the AVX2 kernels (discrete_avx2.cpp) on 8 lanes, step for step; two
+// vectors per iteration so the inversion searches run as two chains
+
+inline __m512d set(double x) noexcept { return _mm512_set1_pd(x); }
+
+inline __m512d floor_pd(__m512d x) noexcept { return _mm512_roundscale_pd(x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+
+// fc(k) given ik = 1 / (k + 1), k >= 0 integral: table below 10, series above
+inline __m512d stirling_fc(__m512d k, __m512d ik) noexcept {
+  const __m512d ik2 = _mm512_mul_pd(ik, ik);
+  const __m512d t = _mm512_sub_pd(set(1.0 / 360), _mm512_mul_pd(ik2, set(1.0 / 1260)));
+  const __m512d series = _mm512_mul_pd(_mm512_sub_pd(set(1.0 / 12), _mm512_mul_pd(t, ik2)), ik);
+  const __m256i i = _mm512_cvttpd_epi32(_mm512_min_pd(k, set(9.0)));
+  return _mm512_mask_mov_pd(series, _mm512_cmp_pd_mask(k, set(10.0), _CMP_LT_OQ), _mm512_i32gather_pd(i, STIRLING_FC, 8));
+}
+
+inline __mmask8 live_mask(std::size_t n, std::size_t j) noexcept {
+  return j >= n ? __mmask8(0) : n - j >= 8 ? __mmask8(0xFF) : __mmask8((1u << (n - j)) - 1);
+}
+
+// counts (as doubles) into the lanes of m
+inline void store_counts(std::uint32_t* out, __mmask8 m, __m512d k) noexcept {
+  _mm512_mask_storeu_epi32(out, __mmask16(m), _mm512_castsi256_si512(_mm512_cvttpd_epu32(k)));
+}
+
+inline std::size_t push_misses(std::uint32_t* miss, std::size_t r, std::size_t base, unsigned m) noexcept {
+  for (; m; m &= m - 1) miss[r++] = static_cast<std::uint32_t>(base + std::countr_zero(m));
+  return r;
+}
+
+// ---------------------------------- Poisson ----------------------------------
+
+struct PoissonLanes {
+  __m512d lam, u;
+  __mmask8 live, small;
+  __m512d k = _mm512_setzero_pd();
+  __mmask8 bad = 0;
+};
+
+inline PoissonLanes poisson_load(const double* lam, const double* u, std::size_t n, std::size_t j) noexcept {
+  PoissonLanes x;
+  x.live  = live_mask(n, j);
+  x.lam   = _mm512_maskz_loadu_pd(x.live, lam + j);
+  x.u     = _mm512_maskz_loadu_pd(x.live, u + j);
+  x.small = _mm512_mask_cmp_pd_mask(x.live, x.lam, set(DISC_INV_MEAN), _CMP_LT_OQ);
+  return x;
+}
+
+// sequential search on the small-mean lanes of two vectors; every searching
+// lane of a vector is at the same k
+inline void poisson_invert(PoissonLanes& x, PoissonLanes& y) noexcept {
+  const __m512d one = set(1.0);
+  __m512d px = ua_exp_pd(_mm512_sub_pd(_mm512_setzero_pd(), x.lam)), Fx = px;
+  __m512d py = ua_exp_pd(_mm512_sub_pd(_mm512_setzero_pd(), y.lam)), Fy = py;
+  __mmask8 tx = _mm512_mask_cmp_pd_mask(x.small, x.u, Fx, _CMP_GE_OQ);
+  __mmask8 ty = _mm512_mask_cmp_pd_mask(y.small, y.u, Fy, _CMP_GE_OQ);
+  for (int i = 1; (tx | ty) && i <= DISC_INV_KMAX; ++i) {
+    const __m512d inv = set(1.0 / i);
+    px = _mm512_mul_pd(px, _mm512_mul_pd(x.lam, inv));
+    py = _mm512_mul_pd(py, _mm512_mul_pd(y.lam, inv));
+    Fx = _mm512_add_pd(Fx, px);
+    Fy = _mm512_add_pd(Fy, py);
+    x.k = _mm512_mask_add_pd(x.k, tx, x.k, one);
+    y.k = _mm512_mask_add_pd(y.k, ty, y.k, one);
+    tx = _mm512_mask_cmp_pd_mask(tx, x.u, Fx, _CMP_GE_OQ);
+    ty = _mm512_mask_cmp_pd_mask(ty, y.u, Fy, _CMP_GE_OQ);
+  }
+  x.bad = tx; y.bad = ty;
+}
+
+// PTRS on the lanes of big, v the second uniforms
+inline void poisson_ptrs(PoissonLanes& x, __mmask8 big, const double* vp) noexcept {
+  const __m512d one = set(1.0);
+  const __m512d l  = _mm512_mask_mov_pd(set(DISC_INV_MEAN), big, x.lam);   // ln / sqrt of the PTRS lanes only
+  const __m512d b  = _mm512_add_pd(_mm512_mul_pd(set(2.53), _mm512_sqrt_pd(l)), set(0.931));
+  const __m512d a  = _mm512_sub_pd(_mm512_mul_pd(set(0.02483), b), set(0.059));
+  const __m512d U  = _mm512_sub_pd(x.u, set(0.5));
+  const __m512d V  = _mm512_sub_pd(one, _mm512_maskz_loadu_pd(big, vp));
+  const __m512d us = _mm512_sub_pd(set(0.5), _mm512_abs_pd(U));
+  const __m512d kk = floor_pd(_mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(_mm512_add_pd(_mm512_div_pd(_mm512_add_pd(a, a), us), b), U), l), set(0.43)));
+  // V <= 0.9277 - 3.6224 / (b - 2), b > 8
+  __mmask8 acc = _mm512_mask_cmp_pd_mask(_mm512_mask_cmp_pd_mask(big, us, set(0.07), _CMP_GE_OQ),
+                                         _mm512_mul_pd(_mm512_sub_pd(V, set(0.9277)), _mm512_sub_pd(b, set(2.0))), set(-3.6224), _CMP_LE_OQ);
+  const __mmask8 rej = _mm512_mask_cmp_pd_mask(big, kk, _mm512_setzero_pd(), _CMP_LT_OQ)
+                     | _mm512_mask_cmp_pd_mask(_mm512_mask_cmp_pd_mask(big, us, set(0.013), _CMP_LT_OQ), V, us, _CMP_GT_OQ);
+  const __mmask8 rest = big & ~acc & ~rej;
+  if (rest) {
+    // ln(V inva / (a / us^2 + b)) <= k ln lam - lam - ln k!, inva = 1.1239 + 1.1328 / (b - 3.4),
+    // one division for the left side and 1 / (k + 1)
+    const __m512d kr  = _mm512_maskz_mov_pd(rest, kk);
+    const __m512d kp1 = _mm512_add_pd(kr, one);
+    const __m512d b34 = _mm512_sub_pd(b, set(3.4));
+    const __m512d us2 = _mm512_mul_pd(us, us);
+    const __m512d num = _mm512_mul_pd(_mm512_mul_pd(V, us2), _mm512_add_pd(_mm512_mul_pd(set(1.1239), b34), set(1.1328)));
+    const __m512d den = _mm512_mul_pd(b34, _mm512_add_pd(a, _mm512_mul_pd(b, us2)));
+    const __m512d R   = _mm512_div_pd(one, _mm512_mul_pd(den, kp1));
+    const __m512d lkf = _mm512_add_pd(_mm512_add_pd(_mm512_sub_pd(_mm512_mul_pd(_mm512_add_pd(kr, set(0.5)), ua_log_rr_pd(kp1)), kp1),
+                                                    set(HALF_LN_2PI)), stirling_fc(kr, _mm512_mul_pd(den, R)));
+    const __m512d rhs = _mm512_sub_pd(_mm512_sub_pd(_mm512_mul_pd(kr, ua_log_rr_pd(l)), l), lkf);
+    const __m512d lhs = ua_log_rr_pd(_mm512_mul_pd(_mm512_mul_pd(num, kp1), R));
+    acc |= _mm512_mask_cmp_pd_mask(rest, lhs, rhs, _CMP_LE_OQ);
+  }
+  x.bad |= big & ~acc;
+  x.k = _mm512_mask_mov_pd(x.k, big & acc, kk);
+}
+
+// --------------------------------- binomial ---------------------------------
+
+struct BinomialLanes {
+  __m512d nt, q, u;
+  __mmask8 live, small, flip;
+  __m512d k = _mm512_setzero_pd();
+  __mmask8 bad = 0;
+};
+
+// q = min(p, 1 - p); the mean n q picks the method
+inline BinomialLanes binomial_load(const std::uint32_t* trials, const double* p, const double* u, std::size_t n, std::size_t j) noexcept {
+  BinomialLanes x;
+  x.live  = live_mask(n, j);
+  x.nt    = _mm512_cvtepu32_pd(_mm512_castsi512_si256(_mm512_maskz_loadu_epi32(__mmask16(x.live), trials + j)));
+  const __m512d pv = _mm512_maskz_loadu_pd(x.live, p + j);
+  x.flip  = _mm512_cmp_pd_mask(pv, set(0.5), _CMP_GT_OQ);
+  x.q     = _mm512_mask_sub_pd(pv, x.flip, set(1.0), pv);
+  x.u     = _mm512_maskz_loadu_pd(x.live, u + j);
+  x.small = _mm512_mask_cmp_pd_mask(x.live, _mm512_mul_pd(x.nt, x.q), set(DISC_INV_MEAN), _CMP_LT_OQ);
+  return x;
+}
+
+// f(0) = (1 - q)^n, f(k) = f(k - 1) ((n + 1) s / k - s), s = q / (1 - q),
+// ln(1 - q) from the rounded 1 - q and its rounding error; stops at k = n
+inline void binomial_invert(BinomialLanes& x, BinomialLanes& y) noexcept {
+  const __m512d one = set(1.0);
+  const __m512d wx = _mm512_sub_pd(one, x.q), wy = _mm512_sub_pd(one, y.q);
+  const __m512d sx = _mm512_div_pd(x.q, wx), sy = _mm512_div_pd(y.q, wy);
+  const __m512d ax = _mm512_mul_pd(_mm512_add_pd(x.nt, one), sx), ay = _mm512_mul_pd(_mm512_add_pd(y.nt, one), sy);
+  const __m512d lx = _mm512_sub_pd(ua_log_rr_pd(wx), _mm512_div_pd(_mm512_add_pd(_mm512_sub_pd(wx, one), x.q), wx));
+  const __m512d ly = _mm512_sub_pd(ua_log_rr_pd(wy), _mm512_div_pd(_mm512_add_pd(_mm512_sub_pd(wy, one), y.q), wy));
+  __m512d fx = ua_exp_pd(_mm512_mul_pd(x.nt, lx)), Fx = fx;
+  __m512d fy = ua_exp_pd(_mm512_mul_pd(y.nt, ly)), Fy = fy;
+  __mmask8 tx = _mm512_mask_cmp_pd_mask(_mm512_mask_cmp_pd_mask(x.small, x.u, Fx, _CMP_GE_OQ), x.k, x.nt, _CMP_LT_OQ);
+  __mmask8 ty = _mm512_mask_cmp_pd_mask(_mm512_mask_cmp_pd_mask(y.small, y.u, Fy, _CMP_GE_OQ), y.k, y.nt, _CMP_LT_OQ);
+  for (int i = 1; (tx | ty) && i <= DISC_INV_KMAX; ++i) {
+    const __m512d inv = set(1.0 / i);
+    fx = _mm512_mul_pd(fx, _mm512_sub_pd(_mm512_mul_pd(ax, inv), sx));
+    fy = _mm512_mul_pd(fy, _mm512_sub_pd(_mm512_mul_pd(ay, inv), sy));
+    Fx = _mm512_add_pd(Fx, fx);
+    Fy = _mm512_add_pd(Fy, fy);
+    x.k = _mm512_mask_add_pd(x.k, tx, x.k, one);
+    y.k = _mm512_mask_add_pd(y.k, ty, y.k, one);
+    tx = _mm512_mask_cmp_pd_mask(_mm512_mask_cmp_pd_mask(tx, x.u, Fx, _CMP_GE_OQ), x.k, x.nt, _CMP_LT_OQ);
+    ty = _mm512_mask_cmp_pd_mask(_mm512_mask_cmp_pd_mask(ty, y.u, Fy, _CMP_GE_OQ), y.k, y.nt, _CMP_LT_OQ);
+  }
+  x.bad = tx; y.bad = ty;
+}
+
+// BTRS on the lanes of big
+inline void binomial_btrs(BinomialLanes& x, __mmask8 big, const double* vp) noexcept {
+  const __m512d one = set(1.0);
+  const __m512d nt = x.nt, q = x.q, w = _mm512_sub_pd(one, q);
+  const __m512d spq = _mm512_sqrt_pd(_mm512_mul_pd(_mm512_mul_pd(nt, q), w));
+  const __m512d b  = _mm512_add_pd(_mm512_mul_pd(set(2.53), spq), set(1.15));
+  const __m512d a  = _mm512_sub_pd(_mm512_add_pd(_mm512_mul_pd(set(0.0248), b), _mm512_mul_pd(set(0.01), q)), set(0.0873));
+  const __m512d c  = _mm512_add_pd(_mm512_mul_pd(nt, q), set(0.5));
+  const __m512d U  = _mm512_sub_pd(x.u, set(0.5));
+  const __m512d V  = _mm512_sub_pd(one, _mm512_maskz_loadu_pd(big, vp));
+  const __m512d us = _mm512_sub_pd(set(0.5), _mm512_abs_pd(U));
+  const __m512d kk = floor_pd(_mm512_add_pd(_mm512_mul_pd(_mm512_add_pd(_mm512_div_pd(_mm512_add_pd(a, a), us), b), U), c));
+  // V <= 0.92 - 4.2 / b, b > 0
+  __mmask8 acc = _mm512_mask_cmp_pd_mask(_mm512_mask_cmp_pd_mask(big, us, set(0.07), _CMP_GE_OQ),
+                                         _mm512_mul_pd(_mm512_sub_pd(V, set(0.92)), b), set(-4.2), _CMP_LE_OQ);
+  const __mmask8 rej = _mm512_mask_cmp_pd_mask(big, kk, _mm512_setzero_pd(), _CMP_LT_OQ)
+                     | _mm512_mask_cmp_pd_mask(big, kk, nt, _CMP_GT_OQ);
+  const __mmask8 rest = big & ~acc & ~rej;
+  if (rest) {
+    // ln(V alpha / (a / us^2 + b)) <= the bound, alpha = (2.83 + 5.1 / b) sqrt(n q (1 - q));
+    // the four fc arguments share one division
+    const __m512d kr  = _mm512_maskz_mov_pd(rest, kk);
+    const __m512d m   = floor_pd(_mm512_mul_pd(_mm512_add_pd(nt, one), q));
+    const __m512d mp1 = _mm512_add_pd(m, one), kp1 = _mm512_add_pd(kr, one);
+    const __m512d nm1 = _mm512_add_pd(_mm512_sub_pd(nt, m), one), nk1 = _mm512_add_pd(_mm512_sub_pd(nt, kr), one);
+    const __m512d us2 = _mm512_mul_pd(us, us);
+    const __m512d lhs = ua_log_rr_pd(_mm512_div_pd(_mm512_mul_pd(_mm512_mul_pd(V, us2), _mm512_mul_pd(_mm512_add_pd(_mm512_mul_pd(set(2.83), b), set(5.1)), spq)),
+                                                   _mm512_mul_pd(b, _mm512_add_pd(a, _mm512_mul_pd(b, us2)))));
+    const __m512d g12 = _mm512_mul_pd(mp1, nm1), g34 = _mm512_mul_pd(kp1, nk1);
+    const __m512d R   = _mm512_div_pd(one, _mm512_mul_pd(g12, g34));
+    const __m512d fc  = _mm512_sub_pd(_mm512_add_pd(stirling_fc(m, _mm512_mul_pd(_mm512_mul_pd(nm1, g34), R)),
+                                                    stirling_fc(_mm512_sub_pd(nt, m), _mm512_mul_pd(_mm512_mul_pd(mp1, g34), R))),
+                                      _mm512_add_pd(stirling_fc(kr, _mm512_mul_pd(_mm512_mul_pd(nk1, g12), R)),
+                                                    stirling_fc(_mm512_sub_pd(nt, kr), _mm512_mul_pd(_mm512_mul_pd(kp1, g12), R))));
+    // lanes outside `rest` may feed meaningless values to ln; their compare is masked off
+    __m512d bound = _mm512_mul_pd(_mm512_add_pd(m, set(0.5)), ua_log_rr_pd(_mm512_div_pd(_mm512_mul_pd(mp1, w), _mm512_mul_pd(q, nm1))));
+    bound = _mm512_add_pd(bound, _mm512_mul_pd(_mm512_add_pd(nt, one), ua_log_rr_pd(_mm512_div_pd(nm1, nk1))));
+    bound = _mm512_add_pd(bound, _mm512_mul_pd(_mm512_add_pd(kr, set(0.5)), ua_log_rr_pd(_mm512_div_pd(_mm512_mul_pd(q, nk1), _mm512_mul_pd(w, kp1)))));
+    acc |= _mm512_mask_cmp_pd_mask(rest, lhs, _mm512_add_pd(bound, fc), _CMP_LE_OQ);
+  }
+  x.bad |= big & ~acc;
+  x.k = _mm512_mask_mov_pd(x.k, big & acc, kk);
+}
+
+} // namespace
+
+std::size_t poisson_avx512(const double* lam, const double* u, const double* v, std::size_t n,
+                           std::uint32_t* out, std::uint32_t* miss) noexcept {
+  std::size_t r = 0;
+  for (std::size_t j = 0; j < n; j += 16) {
+    PoissonLanes x = poisson_load(lam, u, n, j), y = poisson_load(lam, u, n, j + 8);
+    if (x.small | y.small) poisson_invert(x, y);
+    if (const __mmask8 big = x.live & ~x.small; big) poisson_ptrs(x, big, v + j);
+    if (const __mmask8 big = y.live & ~y.small; big) poisson_ptrs(y, big, v + j + 8);
+    store_counts(out + j, x.live & ~x.bad, x.k);
+    store_counts(out + j + 8, y.live & ~y.bad, y.k);
+    r = push_misses(miss, r, j, x.bad);
+    r = push_misses(miss, r, j + 8, y.bad);
+  }
+  return r;
+}
+
+std::size_t binomial_avx512(const std::uint32_t* trials, const double* p, const double* u, const double* v,
+                            std::size_t n, std::uint32_t* out, std::uint32_t* miss) noexcept {
+  std::size_t r = 0;
+  for (std::size_t j = 0; j < n; j += 16) {
+    BinomialLanes x = binomial_load(trials, p, u, n, j), y = binomial_load(trials, p, u, n, j + 8);
+    if (x.small | y.small) binomial_invert(x, y);
+    if (const __mmask8 big = x.live & ~x.small; big) binomial_btrs(x, big, v + j);
+    if (const __mmask8 big = y.live & ~y.small; big) binomial_btrs(y, big, v + j + 8);
+    x.k = _mm512_mask_sub_pd(x.k, x.flip, x.nt, x.k);
+    y.k = _mm512_mask_sub_pd(y.k, y.flip, y.nt, y.k);
+    store_counts(out + j, x.live & ~x.bad, x.k);
+    store_counts(out + j + 8, y.live & ~y.bad, y.k);
+    r = push_misses(miss, r, j, x.bad);
+    r = push_misses(miss, r, j + 8, y.bad);
+  }
+  return r;
+}
+
+} // namespace ua::detail
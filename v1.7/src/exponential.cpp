@@ -0,0 +1,12 @@
+// Portable (no ISA flags): scalar exponential kernel.
+#include "ua/ua_exponential.h"
+#include <cmath>
+
+namespace ua::detail {
+
+void exponential_scalar(const double* u, std::size_t n, double scale, double* out) noexcept {
+  const double ns = -scale;
+  for (std::size_t j = 0; j < n; ++j) out[j] = std::log(u[j]) * ns;
+}
+
+} // namespace ua::detail
@@ -0,0 +1,31 @@
+#include "ua/ua_exponential.h"
+#include "ua_math_avx2.h"
+#include <immintrin.h>
+
+namespace ua::detail {
+
+void exponential_avx2(const double* u, std::size_t n, double scale, double* out) noexcept {
+  const __m256d ns = _mm256_set1_pd(-scale);
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    // two independent vectors per step: the ln divides overlap
+    const __m256d x0 = _mm256_mul_pd(ua_log_rr_pd(_mm256_loadu_pd(u + j)), ns);
+    const __m256d x1 = _mm256_mul_pd(ua_log_rr_pd(_mm256_loadu_pd(u + j + 4)), ns);
+    _mm256_storeu_pd(out + j,     x0);
+    _mm256_storeu_pd(out + j + 4, x1);
+  }
+  if (j + 4 <= n) {
+    _mm256_storeu_pd(out + j, _mm256_mul_pd(ua_log_rr_pd(_mm256_loadu_pd(u + j)), ns));
+    j += 4;
+  }
+  if (j < n) {
+    // 1..3 left: dead lanes take ln(1) and are not stored
+    const __m256i live = _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(n - j)),
+                                            _mm256_setr_epi64x(0, 1, 2, 3));
+    const __m256d x = _mm256_blendv_pd(_mm256_set1_pd(1.0), _mm256_maskload_pd(u + j, live),
+                                       _mm256_castsi256_pd(live));
+    _mm256_maskstore_pd(out + j, live, _mm256_mul_pd(ua_log_rr_pd(x), ns));
+  }
+}
+
+} // namespace ua::detail
@@ -0,0 +1,24 @@
+#include "ua/ua_exponential.h"
+#include "ua_math_avx512.h"
+#include <immintrin.h>
+
+namespace ua::detail {
+
+void exponential_avx512(const double* u, std::size_t n, double scale, double* out) noexcept {
+  const __m512d ns = _mm512_set1_pd(-scale);
+  std::size_t j = 0;
+  for (; j + 16 <= n; j += 16) {
+    const __m512d x0 = _mm512_mul_pd(ua_log_rr_pd(_mm512_loadu_pd(u + j)), ns);
+    const __m512d x1 = _mm512_mul_pd(ua_log_rr_pd(_mm512_loadu_pd(u + j + 8)), ns);
+    _mm512_storeu_pd(out + j,     x0);
+    _mm512_storeu_pd(out + j + 8, x1);
+  }
+  for (; j < n; j += 8) {
+    // masked tail: dead lanes take ln(1)
+    const __mmask8 live = (n - j >= 8) ? __mmask8(0xFF) : __mmask8((1u << (n - j)) - 1);
+    const __m512d x = _mm512_mask_loadu_pd(_mm512_set1_pd(1.0), live, u + j);
+    _mm512_mask_storeu_pd(out + j, live, _mm512_mul_pd(ua_log_rr_pd(x), ns));
+  }
+}
+
+} // namespace ua::detail
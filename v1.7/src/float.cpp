@@ -0,0 +1,62 @@
+// Portable (no ISA flags): scalar unit-float and Box–Muller float kernels.
+#include "ua/ua_float.h"
+#include "ua_math_consts.h"
+#include <bit>
+#include <cmath>
+
+namespace ua::detail {
+
+namespace {
+
+inline float unit(std::uint32_t h) noexcept { return static_cast<float>(h >> 8) * 0x1p-24f; }
+
+// ua_log_ps (ua_math_avx2.h) without FMA
+inline float log_f(float x) noexcept {
+  using namespace math_c;
+  const std::uint32_t hx = std::bit_cast<std::uint32_t>(x) + (0x3f800000u - 0x3f3504f3u);
+  const float k = static_cast<float>(static_cast<std::int32_t>(hx >> 23) - 127);
+  const float f = std::bit_cast<float>((hx & 0x007fffffu) + 0x3f3504f3u) - 1.0f;
+  const float z = f * f;
+  float p = LOGF_P[0];
+  for (int i = 1; i < 9; ++i) p = p * f + LOGF_P[i];
+  const float y = (k * LN2F_LO + p * f * z) - 0.5f * z;
+  return k * LN2F_HI + (f + y);
+}
+
+} // namespace
+
+void unit_float_scalar(const std::uint64_t* x, std::size_t n, float* out) noexcept {
+  std::size_t j = 0;
+  for (; j + 2 <= n; j += 2) {
+    out[j]     = unit(static_cast<std::uint32_t>(x[j / 2]));
+    out[j + 1] = unit(static_cast<std::uint32_t>(x[j / 2] >> 32));
+  }
+  if (j < n) out[j] = unit(static_cast<std::uint32_t>(x[j / 2]));
+}
+
+// the SIMD kernels' float polynomials without FMA (2 pi r split in double
+// instead), ~25x faster than libm's double ln / sin / cos here
+void normal_float_scalar(const std::uint64_t* x, std::size_t n, float* out) noexcept {
+  using namespace math_c;
+  for (std::size_t i = 0; i < (n + 1) / 2; ++i) {
+    const float u = static_cast<float>(static_cast<std::int32_t>((static_cast<std::uint32_t>(x[i]) >> 1) | 1u)) * 0x1p-31f;
+    const float v = unit(static_cast<std::uint32_t>(x[i] >> 32));
+    const float r = std::sqrt(-2.0f * log_f(u));
+    const float t = v * 4.0f + TO_INT_F;                   // round(4v) + TO_INT_F
+    const int q = static_cast<int>(t - TO_INT_F);
+    const double xd = TWO_PI_HI * double(v - 0.25f * static_cast<float>(q));
+    const float a = static_cast<float>(xd), b = static_cast<float>(xd - double(a));
+    const float z = a * a;
+    const float sn = a + (z * a * ((SF3 * z + SF2) * z + SF1) + b);
+    const float hz = 0.5f * z, w = 1.0f - hz;
+    const float cs = w + (((1.0f - w) - hz) + (z * z * ((CF3 * z + CF2) * z + CF1) - a * b));
+    float s = (q & 1) ? cs : sn;
+    float c = (q & 1) ? sn : cs;
+    if (q & 2)       s = -s;
+    if ((q + 1) & 2) c = -c;
+    out[2 * i] = r * c;
+    if (2 * i + 1 < n) out[2 * i + 1] = r * s;
+  }
+}
+
+} // namespace ua::detail
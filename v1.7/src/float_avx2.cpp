@@ -0,0 +1,66 @@
+#include "ua/ua_float.h"
+#include "ua_math_avx2.h"
+#include <immintrin.h>
+
+namespace ua::detail {
+
+namespace {
+
+// top 24 bits of each 32-bit lane times 2^-24, exact
+inline __m256 unit8(__m256i v) noexcept {
+  return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(v, 8)), _mm256_set1_ps(0x1p-24f));
+}
+
+// 8 words x[0..7] -> out[0..15]. The blends pair word k with word 4 + k in
+// 32-bit lanes 2k, 2k + 1 (low halves in one vector, high halves in the
+// other) and the same blends put (cos, sin) back as one 64-bit lane per word.
+inline void normal16(const std::uint64_t* x, float* out) noexcept {
+  const __m256i a  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x));
+  const __m256i b  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + 4));
+  const __m256i lo = _mm256_blend_epi32(a, _mm256_slli_epi64(b, 32), 0xAA);
+  const __m256i hi = _mm256_blend_epi32(_mm256_srli_epi64(a, 32), b, 0xAA);
+  const __m256 u = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_or_si256(_mm256_srli_epi32(lo, 1), _mm256_set1_epi32(1))),
+                                 _mm256_set1_ps(0x1p-31f));
+  const __m256 r = _mm256_sqrt_ps(_mm256_mul_ps(_mm256_set1_ps(-2.0f), ua_log_ps(u)));
+  __m256 s, c;
+  ua_sincos2pi_ps(unit8(hi), s, c);
+  const __m256i z0 = _mm256_castps_si256(_mm256_mul_ps(r, c));
+  const __m256i z1 = _mm256_castps_si256(_mm256_mul_ps(r, s));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),     _mm256_blend_epi32(z0, _mm256_slli_epi64(z1, 32), 0xAA));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 8), _mm256_blend_epi32(_mm256_srli_epi64(z0, 32), z1, 0xAA));
+}
+
+} // namespace
+
+void unit_float_avx2(const std::uint64_t* x, std::size_t n, float* out) noexcept {
+  std::size_t j = 0;
+  for (; j + 16 <= n; j += 16) {
+    const __m256 f0 = unit8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + j / 2)));
+    const __m256 f1 = unit8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + j / 2 + 4)));
+    _mm256_storeu_ps(out + j,     f0);
+    _mm256_storeu_ps(out + j + 8, f1);
+  }
+  for (; j < n; j += 8) {
+    // masked tail: the u32 halves that feed live floats only
+    const __m256i live = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(n - j < 8 ? n - j : 8)),
+                                            _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    const __m256 f = unit8(_mm256_maskload_epi32(reinterpret_cast<const int*>(x + j / 2), live));
+    _mm256_maskstore_ps(out + j, live, f);
+  }
+}
+
+void normal_float_avx2(const std::uint64_t* x, std::size_t n, float* out) noexcept {
+  std::size_t j = 0;
+  for (; j + 16 <= n; j += 16) normal16(x + j / 2, out + j);
+  if (j < n) {
+    // 1..15 floats left: run their words through a zero-padded block
+    const std::size_t m = n - j;
+    alignas(32) std::uint64_t t[8] = {};
+    alignas(32) float z[16];
+    for (std::size_t k = 0; k < (m + 1) / 2; ++k) t[k] = x[j / 2 + k];
+    normal16(t, z);
+    for (std::size_t k = 0; k < m; ++k) out[j + k] = z[k];
+  }
+}
+
+} // namespace ua::detail
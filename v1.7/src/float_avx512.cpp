@@ -0,0 +1,56 @@
+#include "ua/ua_float.h"
+#include "ua_math_avx512.h"
+#include <immintrin.h>
+
+namespace ua::detail {
+
+namespace {
+
+inline __m512 unit16(__m512i v) noexcept {
+  return _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_srli_epi32(v, 8)), _mm512_set1_ps(0x1p-24f));
+}
+
+// 16 words x[0..15] -> out[0..31], the AVX2 normal16 pairing on 16 lanes.
+// `live` masks the 32 floats on the last call; a word is read whole if its
+// cosine is live (the sine needs no more of it).
+inline void normal32(const std::uint64_t* x, float* out, std::uint32_t live) noexcept {
+  const std::uint32_t words = live | ((live << 1) & 0xAAAAAAAAu);
+  const __mmask16 la = __mmask16(live), lb = __mmask16(live >> 16);
+  const __m512i a  = _mm512_maskz_loadu_epi32(__mmask16(words), x);
+  const __m512i b  = _mm512_maskz_loadu_epi32(__mmask16(words >> 16), x + 8);
+  const __m512i lo = _mm512_mask_blend_epi32(0xAAAA, a, _mm512_slli_epi64(b, 32));
+  const __m512i hi = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(a, 32), b);
+  const __m512 u = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_or_si512(_mm512_srli_epi32(lo, 1), _mm512_set1_epi32(1))),
+                                 _mm512_set1_ps(0x1p-31f));
+  const __m512 r = _mm512_sqrt_ps(_mm512_mul_ps(_mm512_set1_ps(-2.0f), ua_log_ps(u)));
+  __m512 s, c;
+  ua_sincos2pi_ps(unit16(hi), s, c);
+  const __m512i z0 = _mm512_castps_si512(_mm512_mul_ps(r, c));
+  const __m512i z1 = _mm512_castps_si512(_mm512_mul_ps(r, s));
+  _mm512_mask_storeu_epi32(out,      la, _mm512_mask_blend_epi32(0xAAAA, z0, _mm512_slli_epi64(z1, 32)));
+  _mm512_mask_storeu_epi32(out + 16, lb, _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(z0, 32), z1));
+}
+
+} // namespace
+
+void unit_float_avx512(const std::uint64_t* x, std::size_t n, float* out) noexcept {
+  std::size_t j = 0;
+  for (; j + 32 <= n; j += 32) {
+    const __m512 f0 = unit16(_mm512_loadu_si512(x + j / 2));
+    const __m512 f1 = unit16(_mm512_loadu_si512(x + j / 2 + 8));
+    _mm512_storeu_ps(out + j,      f0);
+    _mm512_storeu_ps(out + j + 16, f1);
+  }
+  for (; j < n; j += 16) {
+    const __mmask16 live = n - j >= 16 ? __mmask16(0xFFFF) : __mmask16((1u << (n - j)) - 1);
+    _mm512_mask_storeu_ps(out + j, live, unit16(_mm512_maskz_loadu_epi32(live, x + j / 2)));
+  }
+}
+
+void normal_float_avx512(const std::uint64_t* x, std::size_t n, float* out) noexcept {
+  std::size_t j = 0;
+  for (; j + 32 <= n; j += 32) normal32(x + j / 2, out + j, 0xFFFFFFFFu);
+  if (j < n) normal32(x + j / 2, out + j, std::uint32_t((std::uint64_t(1) << (n - j)) - 1));
+}
+
+} // namespace ua::detail
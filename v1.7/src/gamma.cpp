@@ -0,0 +1,36 @@
+// Portable (no ISA flags): scalar Marsaglia–Tsang and boost kernels and the
+// kernel choice for ua::GammaGenerator.
+#include "ua/ua_distributions.h"
+#include "ua_kernel_tier.h"
+#include <cmath>
+
+namespace ua::detail {
+
+std::size_t gamma_mt_scalar(const double* z, const double* u, std::size_t n, double d, double c, double* out) noexcept {
+  std::size_t w = 0;
+  for (std::size_t j = 0; j < n; ++j) {
+    const double x = z[j], t = 1.0 + c * x;
+    if (!(t > 0.0)) continue;
+    const double v = t * t * t, x2 = x * x, uu = 1.0 - u[j];
+    if (uu < 1.0 - 0.0331 * x2 * x2 ||
+        std::log(uu) < 0.5 * x2 + d * (1.0 - v + std::log(v)))
+      out[w++] = d * v;
+  }
+  return w;
+}
+
+void gamma_boost_scalar(const double* u, std::size_t n, double inv_shape, double* x) noexcept {
+  for (std::size_t j = 0; j < n; ++j) x[j] *= std::exp(inv_shape * std::log(1.0 - u[j]));
+}
+
+GammaFn gamma_mt_kernel() noexcept {
+  static const GammaFn k = kernel_for_tier(&gamma_mt_scalar, &gamma_mt_avx2, &gamma_mt_avx512);
+  return k;
+}
+
+GammaBoostFn gamma_boost_kernel() noexcept {
+  static const GammaBoostFn k = kernel_for_tier(&gamma_boost_scalar, &gamma_boost_avx2, &gamma_boost_avx512);
+  return k;
+}
+
+} // namespace ua::detail
@@ -0,0 +1,82 @@
+#include "ua/ua_distributions.h"
+#include "ua_math_avx2.h"
+#include <immintrin.h>
+#include <bit>
+#include <cstdint>
+
+namespace ua::detail {
+
+namespace {
+
+// Left-pack for _mm256_permutevar8x32_ps (64-bit lanes as 32-bit pairs),
+// indexed by the 4-bit accept mask
+struct PackLut { std::int32_t p[16][8]; };
+
+constexpr PackLut make_pack_lut() {
+  PackLut t{};
+  for (int m = 0; m < 16; ++m) {
+    int o = 0;
+    for (int lane = 0; lane < 4; ++lane)
+      if (m & (1 << lane)) { t.p[m][o++] = 2*lane; t.p[m][o++] = 2*lane + 1; }
+  }
+  return t;
+}
+
+alignas(32) constexpr PackLut pack_lut = make_pack_lut();
+
+// 4 candidates -> the accepted d v at out[0..), count returned; always
+// stores 4 doubles
+inline std::size_t mt4(__m256d z, __m256d u, __m256d d, __m256d c, double* out) noexcept {
+  const __m256d one = _mm256_set1_pd(1.0);
+  const __m256d t   = _mm256_fmadd_pd(c, z, one);
+  const __m256d pos = _mm256_cmp_pd(t, _mm256_setzero_pd(), _CMP_GT_OQ);
+  const __m256d v   = _mm256_mul_pd(_mm256_mul_pd(t, t), t);
+  const __m256d x2  = _mm256_mul_pd(z, z);
+  const __m256d w   = _mm256_sub_pd(one, u);
+  const __m256d sq  = _mm256_cmp_pd(w, _mm256_fnmadd_pd(_mm256_mul_pd(_mm256_set1_pd(0.0331), x2), x2, one), _CMP_LT_OQ);
+  __m256d ok = _mm256_and_pd(pos, sq);
+  const __m256d rest = _mm256_andnot_pd(sq, pos);
+  if (_mm256_movemask_pd(rest)) {
+    // v = 1 where t <= 0 so ln never sees 0 or a negative
+    const __m256d vs  = _mm256_blendv_pd(one, v, pos);
+    const __m256d rhs = _mm256_fmadd_pd(_mm256_set1_pd(0.5), x2,
+                                        _mm256_mul_pd(d, _mm256_add_pd(_mm256_sub_pd(one, vs), ua_log_rr_pd(vs))));
+    ok = _mm256_or_pd(ok, _mm256_and_pd(rest, _mm256_cmp_pd(ua_log_rr_pd(w), rhs, _CMP_LT_OQ)));
+  }
+  const int m = _mm256_movemask_pd(ok);
+  const __m256i perm = _mm256_load_si256(reinterpret_cast<const __m256i*>(pack_lut.p[m]));
+  _mm256_storeu_pd(out, _mm256_castps_pd(_mm256_permutevar8x32_ps(_mm256_castpd_ps(_mm256_mul_pd(d, v)), perm)));
+  return static_cast<std::size_t>(std::popcount(static_cast<unsigned>(m)));
+}
+
+} // namespace
+
+std::size_t gamma_mt_avx2(const double* z, const double* u, std::size_t n, double d, double c, double* out) noexcept {
+  const __m256d vd = _mm256_set1_pd(d), vc = _mm256_set1_pd(c);
+  std::size_t j = 0, w = 0;
+  for (; j + 4 <= n; j += 4) w += mt4(_mm256_loadu_pd(z + j), _mm256_loadu_pd(u + j), vd, vc, out + w);
+  if (j < n) {
+    // dead lanes: z = 0, u = 0 gives w = 1, never below the squeeze or ln bound
+    const __m256i live = _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(n - j)),
+                                            _mm256_setr_epi64x(0, 1, 2, 3));
+    w += mt4(_mm256_maskload_pd(z + j, live), _mm256_maskload_pd(u + j, live), vd, vc, out + w);
+  }
+  return w;
+}
+
+void gamma_boost_avx2(const double* u, std::size_t n, double inv_shape, double* x) noexcept {
+  const __m256d one = _mm256_set1_pd(1.0), a = _mm256_set1_pd(inv_shape);
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    const __m256d f = ua_exp_pd(_mm256_mul_pd(a, ua_log_rr_pd(_mm256_sub_pd(one, _mm256_loadu_pd(u + j)))));
+    _mm256_storeu_pd(x + j, _mm256_mul_pd(_mm256_loadu_pd(x + j), f));
+  }
+  if (j < n) {
+    const __m256i live = _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(n - j)),
+                                            _mm256_setr_epi64x(0, 1, 2, 3));
+    const __m256d f = ua_exp_pd(_mm256_mul_pd(a, ua_log_rr_pd(_mm256_sub_pd(one, _mm256_maskload_pd(u + j, live)))));
+    _mm256_maskstore_pd(x + j, live, _mm256_mul_pd(_mm256_maskload_pd(x + j, live), f));
+  }
+}
+
+} // namespace ua::detail
@@ -0,0 +1,52 @@
+#include "ua/ua_distributions.h"
+#include "ua_math_avx512.h"
+#include <immintrin.h>
+#include <bit>
+
+namespace ua::detail {
+
+namespace {
+
+// the AVX2 mt4 (gamma_avx2.cpp) on 8 lanes, step for step; `live` masks
+// the last call
+inline std::size_t mt8(const double* zp, const double* up, __mmask8 live, __m512d d, __m512d c, double* out) noexcept {
+  const __m512d one = _mm512_set1_pd(1.0);
+  const __m512d z   = _mm512_maskz_loadu_pd(live, zp);
+  const __m512d t   = _mm512_fmadd_pd(c, z, one);
+  const __mmask8 pos = _mm512_mask_cmp_pd_mask(live, t, _mm512_setzero_pd(), _CMP_GT_OQ);
+  const __m512d v   = _mm512_mul_pd(_mm512_mul_pd(t, t), t);
+  const __m512d x2  = _mm512_mul_pd(z, z);
+  const __m512d w   = _mm512_sub_pd(one, _mm512_maskz_loadu_pd(live, up));
+  const __mmask8 sq = _mm512_cmp_pd_mask(w, _mm512_fnmadd_pd(_mm512_mul_pd(_mm512_set1_pd(0.0331), x2), x2, one), _CMP_LT_OQ);
+  __mmask8 ok = pos & sq;
+  const __mmask8 rest = pos & ~sq;
+  if (rest) {
+    const __m512d vs  = _mm512_mask_mov_pd(one, pos, v);
+    const __m512d rhs = _mm512_fmadd_pd(_mm512_set1_pd(0.5), x2,
+                                        _mm512_mul_pd(d, _mm512_add_pd(_mm512_sub_pd(one, vs), ua_log_rr_pd(vs))));
+    ok |= _mm512_mask_cmp_pd_mask(rest, ua_log_rr_pd(w), rhs, _CMP_LT_OQ);
+  }
+  _mm512_storeu_pd(out, _mm512_maskz_compress_pd(ok, _mm512_mul_pd(d, v)));
+  return static_cast<std::size_t>(std::popcount(static_cast<unsigned>(ok)));
+}
+
+} // namespace
+
+std::size_t gamma_mt_avx512(const double* z, const double* u, std::size_t n, double d, double c, double* out) noexcept {
+  const __m512d vd = _mm512_set1_pd(d), vc = _mm512_set1_pd(c);
+  std::size_t j = 0, w = 0;
+  for (; j + 8 <= n; j += 8) w += mt8(z + j, u + j, 0xFF, vd, vc, out + w);
+  if (j < n) w += mt8(z + j, u + j, __mmask8((1u << (n - j)) - 1), vd, vc, out + w);
+  return w;
+}
+
+void gamma_boost_avx512(const double* u, std::size_t n, double inv_shape, double* x) noexcept {
+  const __m512d one = _mm512_set1_pd(1.0), a = _mm512_set1_pd(inv_shape);
+  for (std::size_t j = 0; j < n; j += 8) {
+    const __mmask8 live = (n - j >= 8) ? __mmask8(0xFF) : __mmask8((1u << (n - j)) - 1);
+    const __m512d f = ua_exp_pd(_mm512_mul_pd(a, ua_log_rr_pd(_mm512_sub_pd(one, _mm512_maskz_loadu_pd(live, u + j)))));
+    _mm512_mask_storeu_pd(x + j, live, _mm512_mul_pd(_mm512_maskz_loadu_pd(live, x + j), f));
+  }
+}
+
+} // namespace ua::detail
@@ -0,0 +1,46 @@
+// Portable (no ISA flags): scalar AS241 inverse normal CDF and the kernel
+// choice for ua::normal_icdf / Rng::generate_normal_icdf.
+#include "ua/ua_normal_icdf.h"
+#include "ua_kernel_tier.h"
+#include "ua_math_consts.h"
+#include <cmath>
+#include <limits>
+
+namespace ua::detail {
+
+namespace {
+
+inline double horner(double x, const double (&c)[8]) noexcept {
+  double r = c[7];
+  for (int k = 6; k >= 0; --k) r = r * x + c[k];
+  return r;
+}
+
+} // namespace
+
+void normal_icdf_scalar(const double* u, std::size_t n, double* out) noexcept {
+  using namespace math_c;
+  for (std::size_t j = 0; j < n; ++j) {
+    const double p = u[j], q = p - 0.5;
+    double x;
+    if (std::fabs(q) <= ICDF_SPLIT1) {
+      const double r = ICDF_CONST1 - q * q;
+      x = q * horner(r, ICDF_A) / horner(r, ICDF_B);
+    } else if (p == 0.0 || p == 1.0) {
+      x = std::copysign(std::numeric_limits<double>::infinity(), q);
+    } else {
+      const double r = std::sqrt(-std::log(q < 0 ? p : 1.0 - p));   // 1 - p is exact for p > 1/2
+      x = r <= ICDF_SPLIT2 ? horner(r - ICDF_CONST2, ICDF_C) / horner(r - ICDF_CONST2, ICDF_D)
+                           : horner(r - ICDF_SPLIT2, ICDF_E) / horner(r - ICDF_SPLIT2, ICDF_F);
+      x = std::copysign(x, q);   // NaN input falls through the compares to here
+    }
+    out[j] = x;
+  }
+}
+
+NormalIcdfFn normal_icdf_kernel() noexcept {
+  static const NormalIcdfFn k = kernel_for_tier(&normal_icdf_scalar, &normal_icdf_avx2, &normal_icdf_avx512);
+  return k;
+}
+
+} // namespace ua::detail
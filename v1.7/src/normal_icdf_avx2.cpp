@@ -0,0 +1,73 @@
+#include "ua/ua_normal_icdf.h"
+#include "ua_math_avx2.h"
+#include <immintrin.h>
+
+namespace ua::detail {
+
+namespace {
+
+inline __m256d horner(__m256d x, const double (&c)[8]) noexcept {
+  __m256d r = _mm256_set1_pd(c[7]);
+  for (int k = 6; k >= 0; --k) r = _mm256_fmadd_pd(r, x, _mm256_set1_pd(c[k]));
+  return r;
+}
+
+// the same, coefficients b where far is set, else a
+inline __m256d horner2(__m256d x, const double (&a)[8], const double (&b)[8], __m256d far) noexcept {
+  __m256d r = _mm256_blendv_pd(_mm256_set1_pd(a[7]), _mm256_set1_pd(b[7]), far);
+  for (int k = 6; k >= 0; --k)
+    r = _mm256_fmadd_pd(r, x, _mm256_blendv_pd(_mm256_set1_pd(a[k]), _mm256_set1_pd(b[k]), far));
+  return r;
+}
+
+// central and tail rationals share one division: the tail lanes blend
+// their numerator / denominator over the central ones first
+inline __m256d icdf4(__m256d p) noexcept {
+  using namespace math_c;
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  const __m256d q = _mm256_sub_pd(p, _mm256_set1_pd(0.5));
+  const __m256d r = _mm256_fnmadd_pd(q, q, _mm256_set1_pd(ICDF_CONST1));
+  __m256d num = _mm256_mul_pd(q, horner(r, ICDF_A));
+  __m256d den = horner(r, ICDF_B);
+
+  const __m256d tail = _mm256_cmp_pd(_mm256_andnot_pd(sign, q), _mm256_set1_pd(ICDF_SPLIT1), _CMP_GT_OQ);
+  if (!_mm256_movemask_pd(tail)) return _mm256_div_pd(num, den);
+
+  // min(p, 1 - p): 1 - p is exact for p > 1/2; central lanes stay >= 0.075
+  const __m256d pm  = _mm256_min_pd(p, _mm256_sub_pd(_mm256_set1_pd(1.0), p));
+  const __m256d rt  = _mm256_sqrt_pd(_mm256_sub_pd(_mm256_setzero_pd(), ua_log_rr_pd(pm)));
+  const __m256d far = _mm256_cmp_pd(rt, _mm256_set1_pd(ICDF_SPLIT2), _CMP_GT_OQ);
+  const __m256d t   = _mm256_sub_pd(rt, _mm256_blendv_pd(_mm256_set1_pd(ICDF_CONST2),
+                                                         _mm256_set1_pd(ICDF_SPLIT2), far));
+  const __m256d qs  = _mm256_and_pd(sign, q);
+  num = _mm256_blendv_pd(num, _mm256_or_pd(horner2(t, ICDF_C, ICDF_E, far), qs), tail);
+  den = _mm256_blendv_pd(den, horner2(t, ICDF_D, ICDF_F, far), tail);
+  // u = 0 / 1: ln is unspecified at 0, put the infinity in directly
+  const __m256d edge = _mm256_cmp_pd(pm, _mm256_setzero_pd(), _CMP_EQ_OQ);
+  return _mm256_blendv_pd(_mm256_div_pd(num, den), _mm256_or_pd(_mm256_set1_pd(INFINITY), qs), edge);
+}
+
+} // namespace
+
+void normal_icdf_avx2(const double* u, std::size_t n, double* out) noexcept {
+  std::size_t j = 0;
+  for (; j + 8 <= n; j += 8) {
+    // two independent vectors per step: the divides and the tail's ln overlap
+    const __m256d x0 = icdf4(_mm256_loadu_pd(u + j));
+    const __m256d x1 = icdf4(_mm256_loadu_pd(u + j + 4));
+    _mm256_storeu_pd(out + j,     x0);
+    _mm256_storeu_pd(out + j + 4, x1);
+  }
+  if (j + 4 <= n) {
+    _mm256_storeu_pd(out + j, icdf4(_mm256_loadu_pd(u + j)));
+    j += 4;
+  }
+  if (j < n) {
+    // 1..3 left: masked load / store, dead lanes read 0 (-inf, discarded)
+    const __m256i live = _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(n - j)),
+                                            _mm256_setr_epi64x(0, 1, 2, 3));
+    _mm256_maskstore_pd(out + j, live, icdf4(_mm256_maskload_pd(u + j, live)));
+  }
+}
+
+} // namespace ua::detail
@@ -0,0 +1,65 @@
+#include "ua/ua_normal_icdf.h"
+#include "ua_math_avx512.h"
+#include <immintrin.h>
+
+namespace ua::detail {
+
+namespace {
+
+inline __m512d horner(__m512d x, const double (&c)[8]) noexcept {
+  __m512d r = _mm512_set1_pd(c[7]);
+  for (int k = 6; k >= 0; --k) r = _mm512_fmadd_pd(r, x, _mm512_set1_pd(c[k]));
+  return r;
+}
+
+// the same, coefficients b in the far lanes, else a
+inline __m512d horner2(__m512d x, const double (&a)[8], const double (&b)[8], __mmask8 far) noexcept {
+  __m512d r = _mm512_mask_blend_pd(far, _mm512_set1_pd(a[7]), _mm512_set1_pd(b[7]));
+  for (int k = 6; k >= 0; --k)
+    r = _mm512_fmadd_pd(r, x, _mm512_mask_blend_pd(far, _mm512_set1_pd(a[k]), _mm512_set1_pd(b[k])));
+  return r;
+}
+
+// the AVX2 icdf4 (normal_icdf_avx2.cpp) on 8 lanes, step for step
+inline __m512d icdf8(__m512d p) noexcept {
+  using namespace math_c;
+  const __m512i sign = _mm512_set1_epi64(static_cast<long long>(0x8000000000000000ull));
+  const __m512d q = _mm512_sub_pd(p, _mm512_set1_pd(0.5));
+  const __m512d r = _mm512_fnmadd_pd(q, q, _mm512_set1_pd(ICDF_CONST1));
+  __m512d num = _mm512_mul_pd(q, horner(r, ICDF_A));
+  __m512d den = horner(r, ICDF_B);
+
+  const __mmask8 tail = _mm512_cmp_pd_mask(_mm512_abs_pd(q), _mm512_set1_pd(ICDF_SPLIT1), _CMP_GT_OQ);
+  if (!tail) return _mm512_div_pd(num, den);
+
+  const __m512d pm  = _mm512_min_pd(p, _mm512_sub_pd(_mm512_set1_pd(1.0), p));
+  const __m512d rt  = _mm512_sqrt_pd(_mm512_sub_pd(_mm512_setzero_pd(), ua_log_rr_pd(pm)));
+  const __mmask8 far = _mm512_cmp_pd_mask(rt, _mm512_set1_pd(ICDF_SPLIT2), _CMP_GT_OQ);
+  const __m512d t   = _mm512_sub_pd(rt, _mm512_mask_blend_pd(far, _mm512_set1_pd(ICDF_CONST2),
+                                                             _mm512_set1_pd(ICDF_SPLIT2)));
+  const __m512i qs  = _mm512_and_si512(sign, _mm512_castpd_si512(q));
+  const __m512d nt  = _mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(horner2(t, ICDF_C, ICDF_E, far)), qs));
+  num = _mm512_mask_mov_pd(num, tail, nt);
+  den = _mm512_mask_mov_pd(den, tail, horner2(t, ICDF_D, ICDF_F, far));
+  const __mmask8 edge = _mm512_cmp_pd_mask(pm, _mm512_setzero_pd(), _CMP_EQ_OQ);
+  const __m512d inf = _mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(_mm512_set1_pd(INFINITY)), qs));
+  return _mm512_mask_mov_pd(_mm512_div_pd(num, den), edge, inf);
+}
+
+} // namespace
+
+void normal_icdf_avx512(const double* u, std::size_t n, double* out) noexcept {
+  std::size_t j = 0;
+  for (; j + 16 <= n; j += 16) {
+    const __m512d x0 = icdf8(_mm512_loadu_pd(u + j));
+    const __m512d x1 = icdf8(_mm512_loadu_pd(u + j + 8));
+    _mm512_storeu_pd(out + j,     x0);
+    _mm512_storeu_pd(out + j + 8, x1);
+  }
+  for (; j < n; j += 8) {
+    const __mmask8 live = (n - j >= 8) ? __mmask8(0xFF) : __mmask8((1u << (n - j)) - 1);
+    _mm512_mask_storeu_pd(out + j, live, icdf8(_mm512_maskz_loadu_pd(live, u + j)));
+  }
+}
+
+} // namespace ua::detail
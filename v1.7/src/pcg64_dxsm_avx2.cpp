@@ -0,0 +1,149 @@
+#include "ua/ua_pcg64_dxsm.h"
+#include "ua_math_avx2.h"
+
+namespace ua::detail {
+
+// ----------------------------------------
+// helpers
+// ----------------------------------------
+namespace {
+
+constexpr int L = Pcg64DxsmAVX2::LANES;
+constexpr std::size_t CHUNK = 256;   // u64 scratch for double / normal
+
+// low 64 bits of a*b per lane, from three 32x32 partial products
+inline __m256i mullo64(__m256i a, __m256i b) noexcept {
+  const __m256i lo   = _mm256_mul_epu32(a, b);
+  const __m256i mid1 = _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32));
+  const __m256i mid2 = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b);
+  return _mm256_add_epi64(lo, _mm256_slli_epi64(_mm256_add_epi64(mid1, mid2), 32));
+}
+
+// full 64x64 -> 128 per lane (same carry scheme as pcg_mul64)
+inline void mul64x64(__m256i a, __m256i b, __m256i& hi, __m256i& lo) noexcept {
+  const __m256i m32 = _mm256_set1_epi64x(0xffffffffll);
+  const __m256i a1 = _mm256_srli_epi64(a, 32), b1 = _mm256_srli_epi64(b, 32);
+  const __m256i p00 = _mm256_mul_epu32(a, b),  p01 = _mm256_mul_epu32(a, b1);
+  const __m256i p10 = _mm256_mul_epu32(a1, b), p11 = _mm256_mul_epu32(a1, b1);
+  const __m256i mid = _mm256_add_epi64(_mm256_add_epi64(_mm256_srli_epi64(p00, 32), _mm256_and_si256(p01, m32)),
+                                       _mm256_and_si256(p10, m32));
+  lo = _mm256_or_si256(_mm256_and_si256(p00, m32), _mm256_slli_epi64(mid, 32));
+  hi = _mm256_add_epi64(_mm256_add_epi64(p11, _mm256_srli_epi64(p01, 32)),
+                        _mm256_add_epi64(_mm256_srli_epi64(p10, 32), _mm256_srli_epi64(mid, 32)));
+}
+
+// s = s*A + C mod 2^128 on every lane
+inline void lcg_step(__m256i& sh, __m256i& sl, __m256i ah, __m256i al, __m256i ch, __m256i cl) noexcept {
+  const __m256i sign = _mm256_set1_epi64x((long long)0x8000000000000000ull);
+  __m256i h, l;
+  mul64x64(sl, al, h, l);
+  h = _mm256_add_epi64(h, _mm256_add_epi64(mullo64(sh, al), mullo64(sl, ah)));
+  const __m256i nl = _mm256_add_epi64(l, cl);
+  // unsigned nl < cl -> carry (all-ones lane, so subtract)
+  const __m256i carry = _mm256_cmpgt_epi64(_mm256_xor_si256(cl, sign), _mm256_xor_si256(nl, sign));
+  sh = _mm256_sub_epi64(_mm256_add_epi64(h, ch), carry);
+  sl = nl;
+}
+
+inline __m256i dxsm(__m256i sh, __m256i sl) noexcept {
+  __m256i hi = _mm256_xor_si256(sh, _mm256_srli_epi64(sh, 32));
+  hi = mullo64(hi, _mm256_set1_epi64x((long long)PCG_CHEAP_MULT));
+  hi = _mm256_xor_si256(hi, _mm256_srli_epi64(hi, 48));
+  return mullo64(hi, _mm256_or_si256(sl, _mm256_set1_epi64x(1)));
+}
+
+// (x >> 11) * 2^-53 without AVX-512DQ: split the 53 bits 21 / 32 and build
+// both halves with the 2^84 / 2^52 exponent trick; the sum is exact
+inline __m256d to_unit53(__m256i x) noexcept {
+  const __m256i v = _mm256_srli_epi64(x, 11);
+  const __m256d lo = _mm256_sub_pd(
+      _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(v, _mm256_set1_epi64x(0xffffffffll)),
+                                          _mm256_set1_epi64x(0x4330000000000000ll))),
+      _mm256_set1_pd(4503599627370496.0));            // 2^52
+  const __m256d hi = _mm256_sub_pd(
+      _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(v, 32), _mm256_set1_epi64x(0x4530000000000000ll))),
+      _mm256_set1_pd(19342813113834066795298816.0));  // 2^84
+  return _mm256_mul_pd(_mm256_add_pd(hi, lo), _mm256_set1_pd(1.0 / 9007199254740992.0));
+}
+
+// one cheap-multiplier step, scalar (seeding and tails)
+inline void step1(std::uint64_t& sh, std::uint64_t& sl, std::uint64_t ih, std::uint64_t il) noexcept {
+  std::uint64_t h, l;
+  pcg_mul64(sl, PCG_CHEAP_MULT, h, l);
+  sh = h + sh * PCG_CHEAP_MULT; sl = l;
+  pcg_add128(sh, sl, ih, il);
+}
+
+} // namespace
+
+// ----------------------------------------
+// state & core PRNG
+// ----------------------------------------
+Pcg64DxsmAVX2::Pcg64DxsmAVX2(std::uint64_t seed) noexcept {
+  std::uint64_t sh, sl;
+  pcg64_numpy_seed(seed, sh, sl, inc_hi, inc_lo);
+  for (int j = 0; j < L; ++j) { s_hi[j] = sh; s_lo[j] = sl; step1(sh, sl, inc_hi, inc_lo); }
+  pcg_lcg_advance(L, 0, 0, PCG_CHEAP_MULT, inc_hi, inc_lo, a_hi, a_lo, c_hi, c_lo);
+}
+
+void Pcg64DxsmAVX2::advance(std::uint64_t lo, std::uint64_t hi) noexcept {
+  std::uint64_t mh, ml, ph, pl;
+  pcg_lcg_advance(lo, hi, 0, PCG_CHEAP_MULT, inc_hi, inc_lo, mh, ml, ph, pl);
+  for (int j = 0; j < L; ++j) {
+    pcg_mul128(s_hi[j], s_lo[j], mh, ml, s_hi[j], s_lo[j]);
+    pcg_add128(s_hi[j], s_lo[j], ph, pl);
+  }
+}
+void Pcg64DxsmAVX2::jump() noexcept      { advance(PCG_JUMP_LO, PCG_JUMP_HI); }
+void Pcg64DxsmAVX2::long_jump() noexcept { advance(PCG_JUMP_LO << 32, (PCG_JUMP_HI << 32) | (PCG_JUMP_LO >> 32)); }
+
+// ----------------------------------------
+// bulk generators
+// ----------------------------------------
+void Pcg64DxsmAVX2::generate_u64(std::uint64_t* out, std::size_t n) noexcept {
+  const __m256i ah = _mm256_set1_epi64x((long long)a_hi), al = _mm256_set1_epi64x((long long)a_lo);
+  const __m256i ch = _mm256_set1_epi64x((long long)c_hi), cl = _mm256_set1_epi64x((long long)c_lo);
+  __m256i sh = _mm256_load_si256(reinterpret_cast<const __m256i*>(s_hi));
+  __m256i sl = _mm256_load_si256(reinterpret_cast<const __m256i*>(s_lo));
+  std::size_t i = 0;
+  for (; i + L <= n; i += L) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), dxsm(sh, sl));
+    lcg_step(sh, sl, ah, al, ch, cl);
+  }
+  _mm256_store_si256(reinterpret_cast<__m256i*>(s_hi), sh);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(s_lo), sl);
+  if (i < n) {
+    // r outputs from lanes 0..r-1, then every lane moves r positions on
+    const std::size_t r = n - i;
+    for (std::size_t j = 0; j < r; ++j) out[i + j] = pcg_dxsm(s_hi[j], s_lo[j]);
+    for (int j = 0; j < L; ++j)
+      for (std::size_t k = 0; k < r; ++k) step1(s_hi[j], s_lo[j], inc_hi, inc_lo);
+  }
+}
+
+void Pcg64DxsmAVX2::generate_double(double* out, std::size_t n) noexcept {
+  alignas(32) std::uint64_t tmp[CHUNK];
+  for (std::size_t i = 0; i < n;) {
+    const std::size_t m = (n - i < CHUNK) ? n - i : CHUNK;
+    generate_u64(tmp, m);
+    std::size_t j = 0;
+    for (; j + 4 <= m; j += 4)
+      _mm256_storeu_pd(out + i + j, to_unit53(_mm256_load_si256(reinterpret_cast<const __m256i*>(tmp + j))));
+    for (; j < m; ++j) out[i + j] = double(tmp[j] >> 11) * (1.0 / 9007199254740992.0);
+    i += m;
+  }
+}
+
+// vectorized polar over 256-u64 chunks
+void Pcg64DxsmAVX2::generate_normal(double* out, std::size_t n) noexcept {
+  alignas(32) std::uint64_t tmp[CHUNK];
+  std::size_t i = 0;
+  while (i < n) {
+    generate_u64(tmp, CHUNK);
+    const __m256i* t = reinterpret_cast<const __m256i*>(tmp);
+    for (std::size_t j = 0; j < CHUNK / 4 && i < n; j += 2)
+      ua_polar_emit_pd(_mm256_load_si256(t + j), _mm256_load_si256(t + j + 1), out, i, n);
+  }
+}
+
+} // namespace ua::detail
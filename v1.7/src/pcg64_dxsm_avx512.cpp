@@ -0,0 +1,147 @@
+#include "ua/ua_pcg64_dxsm.h"
+#include "ua_math_avx512.h"
+
+namespace ua::detail {
+
+// ----------------------------------------
+// helpers
+// ----------------------------------------
+namespace {
+
+constexpr int L = Pcg64DxsmAVX512::LANES;
+constexpr std::size_t CHUNK = 256;   // u64 scratch for double / normal
+
+// low 64 bits of a*b per lane, from three 32x32 partial products (vpmullq
+// is AVX-512DQ)
+inline __m512i mullo64(__m512i a, __m512i b) noexcept {
+  const __m512i lo   = _mm512_mul_epu32(a, b);
+  const __m512i mid1 = _mm512_mul_epu32(a, _mm512_srli_epi64(b, 32));
+  const __m512i mid2 = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), b);
+  return _mm512_add_epi64(lo, _mm512_slli_epi64(_mm512_add_epi64(mid1, mid2), 32));
+}
+
+// high 64 bits of a*b per lane (AVX-512 has no vpmulhuq)
+inline __m512i mulhi64(__m512i a, __m512i b) noexcept {
+  const __m512i m32 = _mm512_set1_epi64(0xffffffffll);
+  const __m512i a1 = _mm512_srli_epi64(a, 32), b1 = _mm512_srli_epi64(b, 32);
+  const __m512i p00 = _mm512_mul_epu32(a, b),  p01 = _mm512_mul_epu32(a, b1);
+  const __m512i p10 = _mm512_mul_epu32(a1, b), p11 = _mm512_mul_epu32(a1, b1);
+  const __m512i mid = _mm512_add_epi64(_mm512_add_epi64(_mm512_srli_epi64(p00, 32), _mm512_and_si512(p01, m32)),
+                                       _mm512_and_si512(p10, m32));
+  return _mm512_add_epi64(_mm512_add_epi64(p11, _mm512_srli_epi64(p01, 32)),
+                          _mm512_add_epi64(_mm512_srli_epi64(p10, 32), _mm512_srli_epi64(mid, 32)));
+}
+
+// s = s*A + C mod 2^128 on every lane
+inline void lcg_step(__m512i& sh, __m512i& sl, __m512i ah, __m512i al, __m512i ch, __m512i cl) noexcept {
+  const __m512i h = _mm512_add_epi64(mulhi64(sl, al),
+                                     _mm512_add_epi64(mullo64(sh, al), mullo64(sl, ah)));
+  const __m512i nl = _mm512_add_epi64(mullo64(sl, al), cl);
+  const __mmask8 carry = _mm512_cmplt_epu64_mask(nl, cl);
+  const __m512i t = _mm512_add_epi64(h, ch);
+  sh = _mm512_mask_add_epi64(t, carry, t, _mm512_set1_epi64(1));
+  sl = nl;
+}
+
+inline __m512i dxsm(__m512i sh, __m512i sl) noexcept {
+  __m512i hi = _mm512_xor_si512(sh, _mm512_srli_epi64(sh, 32));
+  hi = mullo64(hi, _mm512_set1_epi64((long long)PCG_CHEAP_MULT));
+  hi = _mm512_xor_si512(hi, _mm512_srli_epi64(hi, 48));
+  return mullo64(hi, _mm512_or_si512(sl, _mm512_set1_epi64(1)));
+}
+
+// (x >> 11) * 2^-53 without vcvtuqq2pd (AVX-512DQ): the 21 / 32 bit split of
+// the AVX2 backend, both halves by the 2^84 / 2^52 exponent trick; exact
+inline __m512d to_unit53(__m512i x) noexcept {
+  const __m512i v = _mm512_srli_epi64(x, 11);
+  const __m512d lo = _mm512_sub_pd(
+      _mm512_castsi512_pd(_mm512_or_si512(_mm512_and_si512(v, _mm512_set1_epi64(0xffffffffll)),
+                                          _mm512_set1_epi64(0x4330000000000000ll))),
+      _mm512_set1_pd(4503599627370496.0));            // 2^52
+  const __m512d hi = _mm512_sub_pd(
+      _mm512_castsi512_pd(_mm512_or_si512(_mm512_srli_epi64(v, 32), _mm512_set1_epi64(0x4530000000000000ll))),
+      _mm512_set1_pd(19342813113834066795298816.0));  // 2^84
+  return _mm512_mul_pd(_mm512_add_pd(hi, lo), _mm512_set1_pd(1.0 / 9007199254740992.0));
+}
+
+// one cheap-multiplier step, scalar (seeding and tails)
+inline void step1(std::uint64_t& sh, std::uint64_t& sl, std::uint64_t ih, std::uint64_t il) noexcept {
+  std::uint64_t h, l;
+  pcg_mul64(sl, PCG_CHEAP_MULT, h, l);
+  sh = h + sh * PCG_CHEAP_MULT; sl = l;
+  pcg_add128(sh, sl, ih, il);
+}
+
+} // namespace
+
+// ----------------------------------------
+// state & core PRNG
+// ----------------------------------------
+Pcg64DxsmAVX512::Pcg64DxsmAVX512(std::uint64_t seed) noexcept {
+  std::uint64_t sh, sl;
+  pcg64_numpy_seed(seed, sh, sl, inc_hi, inc_lo);
+  for (int j = 0; j < L; ++j) { s_hi[j] = sh; s_lo[j] = sl; step1(sh, sl, inc_hi, inc_lo); }
+  pcg_lcg_advance(L, 0, 0, PCG_CHEAP_MULT, inc_hi, inc_lo, a_hi, a_lo, c_hi, c_lo);
+}
+
+void Pcg64DxsmAVX512::advance(std::uint64_t lo, std::uint64_t hi) noexcept {
+  std::uint64_t mh, ml, ph, pl;
+  pcg_lcg_advance(lo, hi, 0, PCG_CHEAP_MULT, inc_hi, inc_lo, mh, ml, ph, pl);
+  for (int j = 0; j < L; ++j) {
+    pcg_mul128(s_hi[j], s_lo[j], mh, ml, s_hi[j], s_lo[j]);
+    pcg_add128(s_hi[j], s_lo[j], ph, pl);
+  }
+}
+void Pcg64DxsmAVX512::jump() noexcept      { advance(PCG_JUMP_LO, PCG_JUMP_HI); }
+void Pcg64DxsmAVX512::long_jump() noexcept { advance(PCG_JUMP_LO << 32, (PCG_JUMP_HI << 32) | (PCG_JUMP_LO >> 32)); }
+
+// ----------------------------------------
+// bulk generators
+// ----------------------------------------
+void Pcg64DxsmAVX512::generate_u64(std::uint64_t* out, std::size_t n) noexcept {
+  const __m512i ah = _mm512_set1_epi64((long long)a_hi), al = _mm512_set1_epi64((long long)a_lo);
+  const __m512i ch = _mm512_set1_epi64((long long)c_hi), cl = _mm512_set1_epi64((long long)c_lo);
+  __m512i sh = _mm512_load_si512(reinterpret_cast<const void*>(s_hi));
+  __m512i sl = _mm512_load_si512(reinterpret_cast<const void*>(s_lo));
+  std::size_t i = 0;
+  for (; i + L <= n; i += L) {
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + i), dxsm(sh, sl));
+    lcg_step(sh, sl, ah, al, ch, cl);
+  }
+  _mm512_store_si512(reinterpret_cast<void*>(s_hi), sh);
+  _mm512_store_si512(reinterpret_cast<void*>(s_lo), sl);
+  if (i < n) {
+    // r outputs from lanes 0..r-1, then every lane moves r positions on
+    const std::size_t r = n - i;
+    for (std::size_t j = 0; j < r; ++j) out[i + j] = pcg_dxsm(s_hi[j], s_lo[j]);
+    for (int j = 0; j < L; ++j)
+      for (std::size_t k = 0; k < r; ++k) step1(s_hi[j], s_lo[j], inc_hi, inc_lo);
+  }
+}
+
+void Pcg64DxsmAVX512::generate_double(double* out, std::size_t n) noexcept {
+  alignas(64) std::uint64_t tmp[CHUNK];
+  for (std::size_t i = 0; i < n;) {
+    const std::size_t m = (n - i < CHUNK) ? n - i : CHUNK;
+    generate_u64(tmp, m);
+    std::size_t j = 0;
+    for (; j + 8 <= m; j += 8)
+      _mm512_storeu_pd(out + i + j, to_unit53(_mm512_load_si512(reinterpret_cast<const void*>(tmp + j))));
+    for (; j < m; ++j) out[i + j] = double(tmp[j] >> 11) * (1.0 / 9007199254740992.0);
+    i += m;
+  }
+}
+
+// vectorized polar over 256-u64 chunks
+void Pcg64DxsmAVX512::generate_normal(double* out, std::size_t n) noexcept {
+  alignas(64) std::uint64_t tmp[CHUNK];
+  std::size_t i = 0;
+  while (i < n) {
+    generate_u64(tmp, CHUNK);
+    for (std::size_t j = 0; j < CHUNK && i < n; j += 16)
+      ua_polar_emit_pd(_mm512_load_si512(reinterpret_cast<const void*>(tmp + j)),
+                       _mm512_load_si512(reinterpret_cast<const void*>(tmp + j + 8)), out, i, n);
+  }
+}
+
+} // namespace ua::detail
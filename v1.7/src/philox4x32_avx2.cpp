@@ -0,0 +1,15 @@
+#include "ua/ua_philox4x32_avx2_engine.h"
+#include "ua/ua_philox4x32_avx2.h"
+
+namespace ua::detail {
+
+Philox4x32AVX2Engine::Philox4x32AVX2Engine(std::uint64_t seed) : g(new Philox4x32AVX2(seed)) {}
+Philox4x32AVX2Engine::~Philox4x32AVX2Engine() { delete g; }
+
+void Philox4x32AVX2Engine::generate_u64(std::uint64_t* out, std::size_t n) noexcept { g->generate_u64(out, n); }
+void Philox4x32AVX2Engine::generate_double(double* out, std::size_t n) noexcept { g->generate_double(out, n); }
+void Philox4x32AVX2Engine::jump() noexcept { g->jump(); }
+void Philox4x32AVX2Engine::long_jump() noexcept { g->long_jump(); }
+void Philox4x32AVX2Engine::skip_ahead(std::uint64_t lo, std::uint64_t hi) noexcept { g->skip_ahead_blocks(lo, hi); }
+
+} // namespace ua::detail
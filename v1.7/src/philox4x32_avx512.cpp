@@ -0,0 +1,161 @@
+#include "ua/ua_philox4x32_avx512.h"
+#include "ua/ua_philox4x32_scalar.h"
+
+namespace ua::detail {
+
+// ----------------------------------------
+// helpers
+// ----------------------------------------
+
+// 32x32 -> 64 products of all 16 lanes with two _mm512_mul_epu32 (even and
+// odd dwords), split back into lo/hi words with mask blends. Cheaper than
+// _mm512_mullo_epi32 (2 uops, 10c) plus a separate high product.
+static inline void mulhilo32(__m512i x, __m512i M, __m512i& lo, __m512i& hi) noexcept {
+  const __m512i even = _mm512_mul_epu32(x, M);
+  const __m512i odd  = _mm512_mul_epu32(_mm512_srli_epi64(x, 32), M);
+  lo = _mm512_mask_blend_epi32(0xAAAA, even, _mm512_slli_epi64(odd, 32));
+  hi = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 32), odd);
+}
+
+// x += n + carry-in; returns carry-out per 32-bit lane
+static inline __mmask16 adc32(__m512i& x, __m512i n, __mmask16 cin) noexcept {
+  const __m512i s = _mm512_add_epi32(x, n);
+  __mmask16 c = _mm512_cmplt_epu32_mask(s, x);
+  const __m512i s2 = _mm512_mask_add_epi32(s, cin, s, _mm512_set1_epi32(1));
+  c |= cin & _mm512_cmpeq_epi32_mask(s2, _mm512_setzero_si512());
+  x = s2;
+  return c;
+}
+
+// u64 -> [0,1) via the exponent trick: (u >> 12) | 1.0, minus 1.0
+static inline __m512d to_unit_pd(__m512i u) noexcept {
+  const __m512i bits = _mm512_or_epi64(_mm512_srli_epi64(u, 12), _mm512_set1_epi64((long long)(0x3FFull << 52)));
+  return _mm512_sub_pd(_mm512_castsi512_pd(bits), _mm512_set1_pd(1.0));
+}
+
+// ----------------------------------------
+// state & core PRNG
+// ----------------------------------------
+Philox4x32AVX512::Philox4x32AVX512(std::uint64_t seed) noexcept {
+  // same key derivation as Philox4x32Scalar; kept local so no inline scalar
+  // code gets emitted from this AVX-512 TU
+  auto sm64 = [](std::uint64_t& v) {
+    v += 0x9e3779b97f4a7c15ull;
+    std::uint64_t z = v;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  };
+  std::uint64_t z = seed;
+  k0 = _mm512_set1_epi32((int)(std::uint32_t)sm64(z));
+  k1 = _mm512_set1_epi32((int)(std::uint32_t)sm64(z));
+  c0 = _mm512_set_epi32(15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0);
+  c1 = _mm512_setzero_si512(); c2 = _mm512_setzero_si512(); c3 = _mm512_setzero_si512();
+}
+
+void Philox4x32AVX512::add128(std::uint64_t lo, std::uint64_t hi) noexcept {
+  __mmask16 cy = 0;
+  cy = adc32(c0, _mm512_set1_epi32((int)(std::uint32_t)lo),         cy);
+  cy = adc32(c1, _mm512_set1_epi32((int)(std::uint32_t)(lo >> 32)), cy);
+  cy = adc32(c2, _mm512_set1_epi32((int)(std::uint32_t)hi),         cy);
+  (void)adc32(c3, _mm512_set1_epi32((int)(std::uint32_t)(hi >> 32)), cy);
+}
+
+void Philox4x32AVX512::skip_ahead_blocks(std::uint64_t lo, std::uint64_t hi) noexcept {
+  std::size_t off;
+  const std::uint64_t back = tail.rewind(off);
+  add128(lo - back, hi - (lo < back ? 1 : 0));
+  if (off) { refill(); tail.pos = off; }
+}
+void Philox4x32AVX512::jump() noexcept      { skip_ahead_blocks(0, 1); }
+void Philox4x32AVX512::long_jump() noexcept { skip_ahead_blocks(0, 1ull << 32); }
+
+void Philox4x32AVX512::key(std::uint32_t out[2]) const noexcept {
+  out[0] = (std::uint32_t)_mm_cvtsi128_si32(_mm512_castsi512_si128(k0));
+  out[1] = (std::uint32_t)_mm_cvtsi128_si32(_mm512_castsi512_si128(k1));
+}
+
+void Philox4x32AVX512::block_at(std::uint64_t lo, std::uint64_t hi, std::uint32_t out[4]) const noexcept {
+  std::uint32_t k[2]; key(k);
+  const std::uint32_t ctr[4] = { (std::uint32_t)lo, (std::uint32_t)(lo >> 32), (std::uint32_t)hi, (std::uint32_t)(hi >> 32) };
+  philox4x32_10(ctr, k, out);
+}
+
+void Philox4x32AVX512::next_vec4(__m512i& o0, __m512i& o1, __m512i& o2, __m512i& o3) noexcept {
+  const __m512i M0  = _mm512_set1_epi32((int)PH_M0);
+  const __m512i M1  = _mm512_set1_epi32((int)PH_M1);
+  const __m512i W0v = _mm512_set1_epi32((int)PH_W0);
+  const __m512i W1v = _mm512_set1_epi32((int)PH_W1);
+
+  __m512i x0 = c0, x1 = c1, x2 = c2, x3 = c3, kk0 = k0, kk1 = k1;
+  for (int r = 0; r < 10; ++r) {
+    __m512i lo0, hi0, lo1, hi1;
+    mulhilo32(x0, M0, lo0, hi0);
+    mulhilo32(x2, M1, lo1, hi1);
+    // hi ^ x ^ k in one ternarylogic (0x96 = A ^ B ^ C)
+    x0 = _mm512_ternarylogic_epi32(hi1, x1, kk0, 0x96);
+    x2 = _mm512_ternarylogic_epi32(hi0, x3, kk1, 0x96);
+    x1 = lo1; x3 = lo0;
+    kk0 = _mm512_add_epi32(kk0, W0v); kk1 = _mm512_add_epi32(kk1, W1v);
+  }
+  add128((std::uint64_t)LANES, 0);
+
+  // 4x32 transpose: per 128-bit lane, P/Q/R/S hold whole blocks 4j..4j+3
+  const __m512i lo01 = _mm512_unpacklo_epi32(x0, x1);
+  const __m512i hi01 = _mm512_unpackhi_epi32(x0, x1);
+  const __m512i lo23 = _mm512_unpacklo_epi32(x2, x3);
+  const __m512i hi23 = _mm512_unpackhi_epi32(x2, x3);
+  const __m512i P = _mm512_unpacklo_epi64(lo01, lo23);  // b0  | b4 | b8  | b12
+  const __m512i Q = _mm512_unpackhi_epi64(lo01, lo23);  // b1  | b5 | b9  | b13
+  const __m512i R = _mm512_unpacklo_epi64(hi01, hi23);  // b2  | b6 | b10 | b14
+  const __m512i S = _mm512_unpackhi_epi64(hi01, hi23);  // b3  | b7 | b11 | b15
+  // then gather the 128-bit blocks back into counter order
+  const __m512i T0 = _mm512_shuffle_i64x2(P, Q, 0x44);  // b0 b4  b1 b5
+  const __m512i T1 = _mm512_shuffle_i64x2(R, S, 0x44);  // b2 b6  b3 b7
+  const __m512i T2 = _mm512_shuffle_i64x2(P, Q, 0xEE);  // b8 b12 b9 b13
+  const __m512i T3 = _mm512_shuffle_i64x2(R, S, 0xEE);  // b10 b14 b11 b15
+  o0 = _mm512_shuffle_i64x2(T0, T1, 0x88);              // b0  .. b3
+  o1 = _mm512_shuffle_i64x2(T0, T1, 0xDD);              // b4  .. b7
+  o2 = _mm512_shuffle_i64x2(T2, T3, 0x88);              // b8  .. b11
+  o3 = _mm512_shuffle_i64x2(T2, T3, 0xDD);              // b12 .. b15
+}
+
+// ----------------------------------------
+// bulk generators
+// ----------------------------------------
+void Philox4x32AVX512::refill() noexcept {
+  __m512i a, b, c, d; next_vec4(a, b, c, d);
+  _mm512_store_si512(reinterpret_cast<void*>(tail.buf +  0), a);
+  _mm512_store_si512(reinterpret_cast<void*>(tail.buf +  8), b);
+  _mm512_store_si512(reinterpret_cast<void*>(tail.buf + 16), c);
+  _mm512_store_si512(reinterpret_cast<void*>(tail.buf + 24), d);
+  tail.pos = 0;
+}
+
+void Philox4x32AVX512::generate_u64(std::uint64_t* out, std::size_t n) noexcept {
+  std::size_t i = tail.take(out, n);
+  while (i + 32 <= n) {
+    __m512i a, b, c, d; next_vec4(a, b, c, d);
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + i +  0), a);
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + i +  8), b);
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + i + 16), c);
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + i + 24), d);
+    i += 32;
+  }
+  if (i < n) { refill(); tail.take(out + i, n - i); }
+}
+
+void Philox4x32AVX512::generate_double(double* out, std::size_t n) noexcept {
+  std::size_t i = tail.take(out, n);
+  while (i + 32 <= n) {
+    __m512i a, b, c, d; next_vec4(a, b, c, d);
+    _mm512_storeu_pd(out + i +  0, to_unit_pd(a));
+    _mm512_storeu_pd(out + i +  8, to_unit_pd(b));
+    _mm512_storeu_pd(out + i + 16, to_unit_pd(c));
+    _mm512_storeu_pd(out + i + 24, to_unit_pd(d));
+    i += 32;
+  }
+  if (i < n) { refill(); tail.take(out + i, n - i); }
+}
+
+} // namespace ua::detail
@@ -0,0 +1,28 @@
+// Portable (no ISA flags): scalar polar kernel and the kernel choice for
+// ua::PolarNormal.
+#include "ua/ua_normal_polar.h"
+#include "ua_kernel_tier.h"
+#include <cmath>
+
+namespace ua::detail {
+
+std::size_t polar_scalar(const double* u, std::size_t pairs, double* out) noexcept {
+  std::size_t w = 0;
+  for (std::size_t j = 0; j < pairs; ++j) {
+    const double a = (u[2*j] + u[2*j]) - 1.0;
+    const double b = (u[2*j + 1] + u[2*j + 1]) - 1.0;
+    const double s = a * a + b * b;
+    if (!(s > 0.0 && s < 1.0)) continue;
+    const double f = std::sqrt(-2.0 * std::log(s) / s);
+    out[w++] = a * f;
+    out[w++] = b * f;
+  }
+  return w;
+}
+
+PolarFn polar_kernel() noexcept {
+  static const PolarFn k = kernel_for_tier(&polar_scalar, &polar_avx2, &polar_avx512);
+  return k;
+}
+
+} // namespace ua::detail
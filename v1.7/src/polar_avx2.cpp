@@ -0,0 +1,80 @@
+#include "ua/ua_normal_polar.h"
+#include "ua_math_avx2.h"
+#include <immintrin.h>
+#include <bit>
+#include <cstdint>
+
+namespace ua::detail {
+
+namespace {
+
+// Left-pack for _mm256_permutevar8x32_ps (64-bit lanes as 32-bit pairs),
+// indexed by the 4-bit accept mask. The unpack below leaves pairs 0, 2, 1, 3
+// in lanes 0..3; each entry lists the accepted lanes back in pair order.
+struct PackLut { std::int32_t p[16][8]; };
+
+constexpr PackLut make_pack_lut() {
+  constexpr int lane_of_pair[4] = { 0, 2, 1, 3 };
+  PackLut t{};
+  for (int m = 0; m < 16; ++m) {
+    int o = 0;
+    for (int p = 0; p < 4; ++p) {
+      const int lane = lane_of_pair[p];
+      if (m & (1 << lane)) { t.p[m][o++] = 2*lane; t.p[m][o++] = 2*lane + 1; }
+    }
+  }
+  return t;
+}
+
+alignas(32) constexpr PackLut pack_lut = make_pack_lut();
+
+inline __m256d left_pack(__m256d z, const __m256i perm) noexcept {
+  return _mm256_castps_pd(_mm256_permutevar8x32_ps(_mm256_castpd_ps(z), perm));
+}
+
+// 4 pairs u[0..7] -> the accepted pairs' normals at out[0..), count
+// returned; always stores 8 doubles
+inline std::size_t pairs4(const double* u, double* out) noexcept {
+  const __m256d one = _mm256_set1_pd(1.0);
+  const __m256d a  = _mm256_loadu_pd(u);
+  const __m256d b  = _mm256_loadu_pd(u + 4);
+  const __m256d x  = _mm256_unpacklo_pd(a, b);
+  const __m256d y  = _mm256_unpackhi_pd(a, b);
+  const __m256d uu = _mm256_sub_pd(_mm256_add_pd(x, x), one);
+  const __m256d vv = _mm256_sub_pd(_mm256_add_pd(y, y), one);
+  const __m256d s  = _mm256_add_pd(_mm256_mul_pd(uu, uu), _mm256_mul_pd(vv, vv));
+
+  const __m256d ok = _mm256_and_pd(_mm256_cmp_pd(s, _mm256_setzero_pd(), _CMP_GT_OQ),
+                                   _mm256_cmp_pd(s, one, _CMP_LT_OQ));
+  const int m = _mm256_movemask_pd(ok);
+
+  // rejected lanes get s = 1/2 so ln never sees 0
+  const __m256d ss = _mm256_blendv_pd(_mm256_set1_pd(0.5), s, ok);
+  const __m256d f  = _mm256_sqrt_pd(_mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(-2.0), ua_log_rr_pd(ss)), ss));
+
+  const __m256i perm = _mm256_load_si256(reinterpret_cast<const __m256i*>(pack_lut.p[m]));
+  const __m256d cu = left_pack(_mm256_mul_pd(uu, f), perm);
+  const __m256d cv = left_pack(_mm256_mul_pd(vv, f), perm);
+  // (cu0 cv0 cu1 cv1) (cu2 cv2 cu3 cv3)
+  const __m256d lo = _mm256_unpacklo_pd(cu, cv);
+  const __m256d hi = _mm256_unpackhi_pd(cu, cv);
+  _mm256_storeu_pd(out,     _mm256_permute2f128_pd(lo, hi, 0x20));
+  _mm256_storeu_pd(out + 4, _mm256_permute2f128_pd(lo, hi, 0x31));
+  return 2 * static_cast<std::size_t>(std::popcount(static_cast<unsigned>(m)));
+}
+
+} // namespace
+
+std::size_t polar_avx2(const double* u, std::size_t pairs, double* out) noexcept {
+  std::size_t j = 0, w = 0;
+  for (; j + 4 <= pairs; j += 4) w += pairs4(u + 2*j, out + w);
+  if (j < pairs) {
+    // zero padding: u = v = -1, s = 2, rejected
+    alignas(32) double t[8] = {};
+    for (std::size_t k = 0; k < 2 * (pairs - j); ++k) t[k] = u[2*j + k];
+    w += pairs4(t, out + w);
+  }
+  return w;
+}
+
+} // namespace ua::detail
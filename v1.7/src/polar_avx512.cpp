@@ -0,0 +1,44 @@
+#include "ua/ua_normal_polar.h"
+#include "ua_math_avx512.h"
+#include <immintrin.h>
+#include <bit>
+
+namespace ua::detail {
+
+namespace {
+
+// 8 pairs u[0..15] -> the accepted pairs' normals at out[0..), count
+// returned; always stores 16 doubles. `live` masks the loads on the last
+// call (dead lanes load 0: u = v = -1, s = 2, rejected).
+inline std::size_t pairs8(const double* u, double* out, __mmask16 live) noexcept {
+  const __m512d one = _mm512_set1_pd(1.0);
+  const __m512d a  = _mm512_maskz_loadu_pd(__mmask8(live), u);
+  const __m512d b  = _mm512_maskz_loadu_pd(__mmask8(live >> 8), u + 8);
+  const __m512d x  = _mm512_permutex2var_pd(a, _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14), b);
+  const __m512d y  = _mm512_permutex2var_pd(a, _mm512_setr_epi64(1, 3, 5, 7, 9, 11, 13, 15), b);
+  const __m512d uu = _mm512_sub_pd(_mm512_add_pd(x, x), one);
+  const __m512d vv = _mm512_sub_pd(_mm512_add_pd(y, y), one);
+  const __m512d s  = _mm512_add_pd(_mm512_mul_pd(uu, uu), _mm512_mul_pd(vv, vv));
+
+  const __mmask8 ok = _mm512_cmp_pd_mask(s, _mm512_setzero_pd(), _CMP_GT_OQ)
+                    & _mm512_cmp_pd_mask(s, one, _CMP_LT_OQ);
+  const __m512d ss = _mm512_mask_mov_pd(_mm512_set1_pd(0.5), ok, s);
+  const __m512d f  = _mm512_sqrt_pd(_mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(-2.0), ua_log_rr_pd(ss)), ss));
+
+  const __m512d cu = _mm512_maskz_compress_pd(ok, _mm512_mul_pd(uu, f));
+  const __m512d cv = _mm512_maskz_compress_pd(ok, _mm512_mul_pd(vv, f));
+  _mm512_storeu_pd(out,     _mm512_permutex2var_pd(cu, _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11), cv));
+  _mm512_storeu_pd(out + 8, _mm512_permutex2var_pd(cu, _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15), cv));
+  return 2 * static_cast<std::size_t>(std::popcount(static_cast<unsigned>(ok)));
+}
+
+} // namespace
+
+std::size_t polar_avx512(const double* u, std::size_t pairs, double* out) noexcept {
+  std::size_t j = 0, w = 0;
+  for (; j + 8 <= pairs; j += 8) w += pairs8(u + 2*j, out + w, 0xFFFF);
+  if (j < pairs) w += pairs8(u + 2*j, out + w, __mmask16((1u << (2 * (pairs - j))) - 1));
+  return w;
+}
+
+} // namespace ua::detail
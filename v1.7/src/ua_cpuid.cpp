@@ -43,10 +43,14 @@ CpuFeatures query_cpu_features() noexcept {
   // Basic leaf
   cpuid_ex(0, 0, r);
   unsigned int max_leaf = r[0];
+  // "GenuineIntel" in EBX, EDX, ECX
+  const bool intel = r[1] == 0x756e6547u && r[3] == 0x49656e69u && r[2] == 0x6c65746eu;
   if (max_leaf < 1) return f;
 
-  // Leaf 1: SSE2/OSXSAVE/AVX/FMA
+  // Leaf 1: SSE2/OSXSAVE/AVX/FMA/AES, family/model
   cpuid_ex(1, 0, r);
+  const unsigned family = (r[0] >> 8) & 0xFu;
+  const unsigned model  = ((r[0] >> 4) & 0xFu) | (((r[0] >> 16) & 0xFu) << 4);
   const unsigned ecx = r[2];
   const unsigned edx = r[3];
   const bool osxsave = (ecx & (1u << 27)) != 0;
@@ -55,6 +59,7 @@ CpuFeatures query_cpu_features() noexcept {
   f.sse2  = (edx & (1u << 26)) != 0;
   f.ssse3 = (ecx & (1u <<  9)) != 0;
   f.fma   = (ecx & (1u << 12)) != 0;
+  f.aes   = (ecx & (1u << 25)) != 0;
 
   bool os_avx_ok = false;
   bool os_avx512_ok = false;
@@ -66,17 +71,31 @@ CpuFeatures query_cpu_features() noexcept {
     os_avx512_ok = ( (xcr0 & 0xE6ull) == 0xE6ull );
   }
 
-  // Leaf 7: AVX2/AVX512F
+  // Leaf 7: AVX2/AVX512F/DQ/IFMA/VL/VAES
   if (max_leaf >= 7) {
     cpuid_ex(7, 0, r);
     const unsigned ebx = r[1];
+    const unsigned ecx7 = r[2];
     const bool avx2_bit    = (ebx & (1u << 5))  != 0;
     const bool avx512f_bit = (ebx & (1u << 16)) != 0;
+    const bool dq_bit      = (ebx & (1u << 17)) != 0;
+    const bool ifma_bit    = (ebx & (1u << 21)) != 0;
+    const bool vl_bit      = (ebx & (1u << 31)) != 0;
+    const bool vaes_bit    = (ecx7 & (1u << 9)) != 0;
 
     if (avx_bit && os_avx_ok) {
       f.avx = true;
       if (avx2_bit)    f.avx2    = true;
-      if (avx512f_bit && os_avx512_ok) f.avx512f = true;
+      if (avx512f_bit && os_avx512_ok) {
+        f.avx512f    = true;
+        f.avx512dq   = dq_bit;
+        f.avx512ifma = ifma_bit;
+        f.avx512vl   = vl_bit;
+        // family 6 model 0x55: Skylake-SP/X, Cascade Lake, Cooper Lake;
+        // sustained zmm integer work drops these cores to the AVX-512 licence
+        f.avx512_zmm_slow = intel && family == 6 && model == 0x55;
+      }
+      if (vaes_bit && f.aes) f.vaes = true;
     }
   }
 
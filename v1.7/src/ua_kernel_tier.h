@@ -0,0 +1,24 @@
+// Kernel choice for the generators that are not bound to a ua::Rng
+// (NormalGenerator, PolarNormal, GammaGenerator, AliasSampler, ...): the
+// tier ua::Rng picks for a default Init, so UA_FORCE_BACKEND and
+// avx512_zmm_slow apply to them too (not installed). ISA-free.
+#pragma once
+#include "ua/ua_rng.h"
+
+namespace ua::detail {
+
+// resolved once, on first use (ua_rng.cpp)
+SimdTier kernel_tier() noexcept;
+
+// the kernel for kernel_tier(); AVX512VL runs the AVX2 kernels, as in ua::Rng
+template<class Fn>
+Fn kernel_for_tier(Fn scalar, Fn avx2, Fn avx512) noexcept {
+  switch (kernel_tier()) {
+  case SimdTier::AVX512F:  return avx512;
+  case SimdTier::AVX2:
+  case SimdTier::AVX512VL: return avx2;
+  default:                 return scalar;
+  }
+}
+
+} // namespace ua::detail
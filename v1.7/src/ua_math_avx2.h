@@ -0,0 +1,251 @@
+// Internal AVX2 math shared by the AVX2 backend TUs (not installed).
+// Include only from TUs compiled with UA_AVX2_FLAGS; everything here is
+// static inline so each TU keeps its own copy.
+#pragma once
+#include <immintrin.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "ua_math_consts.h"
+
+namespace ua::detail {
+
+// ln(x) for finite x > 0 (subnormals included), fdlibm's method on 4 lanes:
+// x = 2^k (1 + f) with 1 + f in [sqrt(2)/2, sqrt(2)), s = f / (2 + f),
+// ln(1 + f) = f - (f^2/2 - s (f^2/2 + R(s^2))), degree-14 R.
+// Max error 0.75 ulp against long double over 2^24 random positive doubles
+// and 2^24 k / 2^53 in (0, 1]. x <= 0, inf and NaN give unspecified values.
+static inline __m256d ua_log_rr_pd(__m256d x) noexcept {
+  using namespace math_c;
+  // subnormals: scale by 2^54 first, take 54 back off the exponent
+  const __m256d sub = _mm256_cmp_pd(x, _mm256_set1_pd(0x1p-1022), _CMP_LT_OQ);
+  x = _mm256_blendv_pd(x, _mm256_mul_pd(x, _mm256_set1_pd(0x1p54)), sub);
+  const __m256d kadj = _mm256_and_pd(sub, _mm256_set1_pd(54.0));
+
+  // move the exponent boundary so 1 + f lands in [sqrt(2)/2, sqrt(2))
+  __m256i hx = _mm256_add_epi64(_mm256_castpd_si256(x),
+                                _mm256_set1_epi64x((0x3ff00000LL - 0x3fe6a09eLL) << 32));
+  // biased exponent to double: OR it under 2^52, subtract 2^52 + 1023
+  const __m256d eb = _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(hx, 52),
+                                                         _mm256_set1_epi64x(0x4330000000000000LL)));
+  const __m256d k  = _mm256_sub_pd(_mm256_sub_pd(eb, _mm256_set1_pd(4503599627370496.0 + 1023.0)), kadj);
+  hx = _mm256_add_epi64(_mm256_and_si256(hx, _mm256_set1_epi64x(0x000fffffffffffffLL)),
+                        _mm256_set1_epi64x(0x3fe6a09eLL << 32));
+  const __m256d f = _mm256_sub_pd(_mm256_castsi256_pd(hx), _mm256_set1_pd(1.0));
+
+  const __m256d s = _mm256_div_pd(f, _mm256_add_pd(_mm256_set1_pd(2.0), f));
+  const __m256d z = _mm256_mul_pd(s, s);
+  const __m256d w = _mm256_mul_pd(z, z);
+  // R = z (LG1 + w (LG3 + w (LG5 + w LG7))) + w (LG2 + w (LG4 + w LG6))
+  __m256d t1 = _mm256_fmadd_pd(w, _mm256_set1_pd(LG6), _mm256_set1_pd(LG4));
+  t1 = _mm256_mul_pd(w, _mm256_fmadd_pd(w, t1, _mm256_set1_pd(LG2)));
+  __m256d t2 = _mm256_fmadd_pd(w, _mm256_set1_pd(LG7), _mm256_set1_pd(LG5));
+  t2 = _mm256_fmadd_pd(w, t2, _mm256_set1_pd(LG3));
+  t2 = _mm256_mul_pd(z, _mm256_fmadd_pd(w, t2, _mm256_set1_pd(LG1)));
+  const __m256d R    = _mm256_add_pd(t2, t1);
+  const __m256d hfsq = _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(0.5), f), f);
+  // k ln2_hi - ((hfsq - (s (hfsq + R) + k ln2_lo)) - f)
+  const __m256d lo = _mm256_fmadd_pd(s, _mm256_add_pd(hfsq, R), _mm256_mul_pd(k, _mm256_set1_pd(LN2_LO)));
+  return _mm256_fmsub_pd(k, _mm256_set1_pd(LN2_HI), _mm256_sub_pd(_mm256_sub_pd(hfsq, lo), f));
+}
+
+// e^x on 4 lanes, fdlibm's method: x = k ln2 + r with |r| <= ln2/2, r
+// carried as hi - lo; e^r = 1 - ((lo - r c / (2 - c)) - hi), c = r - r^2 P(r^2).
+// 2^k is applied in two halves so subnormal results come out too. x is
+// clamped to [-746, 710]: 0 below, inf above 709.78. Max error < 1 ulp for
+// normal results; NaN gives unspecified values.
+static inline __m256d ua_exp_pd(__m256d x) noexcept {
+  using namespace math_c;
+  x = _mm256_max_pd(_mm256_min_pd(x, _mm256_set1_pd(710.0)), _mm256_set1_pd(-746.0));
+  const __m256d k  = _mm256_sub_pd(_mm256_fmadd_pd(x, _mm256_set1_pd(INV_LN2), _mm256_set1_pd(TO_INT)),
+                                   _mm256_set1_pd(TO_INT));
+  const __m256d hi = _mm256_fnmadd_pd(k, _mm256_set1_pd(LN2_HI), x);   // exact: LN2_HI has 32 bits
+  const __m256d lo = _mm256_mul_pd(k, _mm256_set1_pd(LN2_LO));
+  const __m256d r  = _mm256_sub_pd(hi, lo);
+  const __m256d rr = _mm256_mul_pd(r, r);
+  __m256d p = _mm256_fmadd_pd(rr, _mm256_set1_pd(EP5), _mm256_set1_pd(EP4));
+  p = _mm256_fmadd_pd(rr, p, _mm256_set1_pd(EP3));
+  p = _mm256_fmadd_pd(rr, p, _mm256_set1_pd(EP2));
+  p = _mm256_fmadd_pd(rr, p, _mm256_set1_pd(EP1));
+  const __m256d c = _mm256_fnmadd_pd(rr, p, r);
+  const __m256d y = _mm256_sub_pd(_mm256_set1_pd(1.0),
+      _mm256_sub_pd(_mm256_sub_pd(lo, _mm256_div_pd(_mm256_mul_pd(r, c), _mm256_sub_pd(_mm256_set1_pd(2.0), c))), hi));
+
+  // 2^k = 2^k1 2^k2, k1 = round(k/2): both halves within [-539, 513]. The
+  // integer sits in the low bits of k + TO_INT; rebias it under the exponent.
+  const __m256d t1 = _mm256_fmadd_pd(k, _mm256_set1_pd(0.5), _mm256_set1_pd(TO_INT));
+  const __m256d t2 = _mm256_add_pd(_mm256_sub_pd(k, _mm256_sub_pd(t1, _mm256_set1_pd(TO_INT))), _mm256_set1_pd(TO_INT));
+  const __m256i rebias = _mm256_set1_epi64x(0x4338000000000000LL - 1023);
+  const __m256d s1 = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_sub_epi64(_mm256_castpd_si256(t1), rebias), 52));
+  const __m256d s2 = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_sub_epi64(_mm256_castpd_si256(t2), rebias), 52));
+  return _mm256_mul_pd(_mm256_mul_pd(y, s1), s2);
+}
+
+// sin(2 pi u) and cos(2 pi u) on 4 lanes, |u| < 2^50. The reduction is in
+// turns, u = q/4 + r with |r| <= 1/8, and exact; the only rounding before
+// the kernels is 2 pi r, carried as x + y. fdlibm's sin / cos kernels on
+// [-pi/4, pi/4], then the quadrant q picks swap and signs.
+// Max error 0.79 ulp (sin and cos) against long double over 2^24
+// uniforms in [0, 1); exact at the multiples of 1/8.
+static inline void ua_sincos2pi_pd(__m256d u, __m256d& s_out, __m256d& c_out) noexcept {
+  using namespace math_c;
+  const __m256d t = _mm256_fmadd_pd(u, _mm256_set1_pd(4.0), _mm256_set1_pd(TO_INT));
+  const __m256i q = _mm256_castpd_si256(t);   // round(4u) in the low mantissa bits
+  const __m256d r = _mm256_fnmadd_pd(_mm256_sub_pd(t, _mm256_set1_pd(TO_INT)), _mm256_set1_pd(0.25), u);
+  const __m256d x = _mm256_mul_pd(r, _mm256_set1_pd(TWO_PI_HI));
+  const __m256d y = _mm256_fmadd_pd(r, _mm256_set1_pd(TWO_PI_LO), _mm256_fmsub_pd(r, _mm256_set1_pd(TWO_PI_HI), x));
+  const __m256d z = _mm256_mul_pd(x, x);
+  const __m256d v = _mm256_mul_pd(z, x);
+  const __m256d hy = _mm256_mul_pd(_mm256_set1_pd(0.5), y);
+
+  // sin = x - ((z (y/2 - v rs) - y) - v S1), rs = S2 + z (S3 + ... z S6)
+  __m256d rs = _mm256_fmadd_pd(z, _mm256_set1_pd(S6), _mm256_set1_pd(S5));
+  rs = _mm256_fmadd_pd(z, rs, _mm256_set1_pd(S4));
+  rs = _mm256_fmadd_pd(z, rs, _mm256_set1_pd(S3));
+  rs = _mm256_fmadd_pd(z, rs, _mm256_set1_pd(S2));
+  const __m256d sa = _mm256_fmsub_pd(z, _mm256_fnmadd_pd(v, rs, hy), y);
+  const __m256d sn = _mm256_sub_pd(x, _mm256_fnmadd_pd(v, _mm256_set1_pd(S1), sa));
+
+  // cos = w + (((1 - w) - z/2) + (z rc - x y)), w = 1 - z/2, rc = z (C1 + ... z^5 C6)
+  __m256d rc = _mm256_fmadd_pd(z, _mm256_set1_pd(C6), _mm256_set1_pd(C5));
+  rc = _mm256_fmadd_pd(z, rc, _mm256_set1_pd(C4));
+  rc = _mm256_fmadd_pd(z, rc, _mm256_set1_pd(C3));
+  rc = _mm256_fmadd_pd(z, rc, _mm256_set1_pd(C2));
+  rc = _mm256_mul_pd(z, _mm256_fmadd_pd(z, rc, _mm256_set1_pd(C1)));
+  const __m256d one = _mm256_set1_pd(1.0);
+  const __m256d hz  = _mm256_mul_pd(_mm256_set1_pd(0.5), z);
+  const __m256d w   = _mm256_sub_pd(one, hz);
+  const __m256d cs  = _mm256_add_pd(w, _mm256_add_pd(_mm256_sub_pd(_mm256_sub_pd(one, w), hz),
+                                                     _mm256_fmsub_pd(z, rc, _mm256_mul_pd(x, y))));
+
+  // odd q swaps sin / cos (blendv reads bit 63); q & 2 negates sin,
+  // (q + 1) & 2 negates cos
+  const __m256d swap = _mm256_castsi256_pd(_mm256_slli_epi64(q, 63));
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  const __m256d ns = _mm256_and_pd(_mm256_castsi256_pd(_mm256_slli_epi64(q, 62)), sign);
+  const __m256d nc = _mm256_and_pd(_mm256_castsi256_pd(
+      _mm256_slli_epi64(_mm256_add_epi64(q, _mm256_set1_epi64x(1)), 62)), sign);
+  s_out = _mm256_xor_pd(_mm256_blendv_pd(sn, cs, swap), ns);
+  c_out = _mm256_xor_pd(_mm256_blendv_pd(cs, sn, swap), nc);
+}
+
+// ln(x) on 8 floats for normal x > 0, Cephes logf: x = 2^k (1 + f) with
+// 1 + f in [sqrt(2)/2, sqrt(2)) by the same exponent shift as ua_log_rr_pd,
+// ln(1 + f) = f - f^2/2 + f^3 P(f), degree-8 P. Max error 0.82 ulp against
+// double over every float in [2^-31, 1] (the float kernels' domain).
+// Subnormals, x <= 0, inf and NaN give unspecified values.
+static inline __m256 ua_log_ps(__m256 x) noexcept {
+  using namespace math_c;
+  __m256i hx = _mm256_add_epi32(_mm256_castps_si256(x), _mm256_set1_epi32(0x3f800000 - 0x3f3504f3));
+  const __m256 k = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(hx, 23), _mm256_set1_epi32(127)));
+  hx = _mm256_add_epi32(_mm256_and_si256(hx, _mm256_set1_epi32(0x007fffff)), _mm256_set1_epi32(0x3f3504f3));
+  const __m256 f = _mm256_sub_ps(_mm256_castsi256_ps(hx), _mm256_set1_ps(1.0f));
+  const __m256 z = _mm256_mul_ps(f, f);
+  __m256 p = _mm256_set1_ps(LOGF_P[0]);
+  for (int i = 1; i < 9; ++i) p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(LOGF_P[i]));
+  // f + (f^3 P - z/2 + k ln2_lo) + k ln2_hi
+  __m256 y = _mm256_fmadd_ps(k, _mm256_set1_ps(LN2F_LO), _mm256_mul_ps(_mm256_mul_ps(p, f), z));
+  y = _mm256_fnmadd_ps(_mm256_set1_ps(0.5f), z, y);
+  return _mm256_fmadd_ps(k, _mm256_set1_ps(LN2F_HI), _mm256_add_ps(f, y));
+}
+
+// sin(2 pi u) and cos(2 pi u) on 8 floats, |u| < 2^20: ua_sincos2pi_pd's
+// exact reduction in turns, u = q/4 + r, 2 pi r carried as x + y, Cephes
+// sinf / cosf on [-pi/4, pi/4] with fdlibm's correction terms. Max error
+// 0.97 ulp (sin and cos) against long double over the 2^24 grid of [0, 1);
+// exact at the multiples of 1/4.
+static inline void ua_sincos2pi_ps(__m256 u, __m256& s_out, __m256& c_out) noexcept {
+  using namespace math_c;
+  const __m256 t = _mm256_fmadd_ps(u, _mm256_set1_ps(4.0f), _mm256_set1_ps(TO_INT_F));
+  const __m256i q = _mm256_castps_si256(t);   // round(4u) in the low mantissa bits
+  const __m256 r = _mm256_fnmadd_ps(_mm256_sub_ps(t, _mm256_set1_ps(TO_INT_F)), _mm256_set1_ps(0.25f), u);
+  const __m256 x = _mm256_mul_ps(r, _mm256_set1_ps(TWO_PI_F));
+  const __m256 y = _mm256_fmadd_ps(r, _mm256_set1_ps(TWO_PI_FLO), _mm256_fmsub_ps(r, _mm256_set1_ps(TWO_PI_F), x));
+  const __m256 z = _mm256_mul_ps(x, x);
+  const __m256 ps = _mm256_fmadd_ps(_mm256_fmadd_ps(_mm256_set1_ps(SF3), z, _mm256_set1_ps(SF2)), z, _mm256_set1_ps(SF1));
+  const __m256 pc = _mm256_fmadd_ps(_mm256_fmadd_ps(_mm256_set1_ps(CF3), z, _mm256_set1_ps(CF2)), z, _mm256_set1_ps(CF1));
+  // sin = x + (x z P + y), cos = w + (((1 - w) - z/2) + (z^2 Q - x y)), w = 1 - z/2
+  const __m256 sn = _mm256_add_ps(x, _mm256_fmadd_ps(_mm256_mul_ps(z, x), ps, y));
+  const __m256 hz = _mm256_mul_ps(_mm256_set1_ps(0.5f), z);
+  const __m256 w  = _mm256_sub_ps(_mm256_set1_ps(1.0f), hz);
+  const __m256 cs = _mm256_add_ps(w, _mm256_add_ps(_mm256_sub_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), w), hz),
+                                                   _mm256_fnmadd_ps(x, y, _mm256_mul_ps(_mm256_mul_ps(z, z), pc))));
+
+  // as in ua_sincos2pi_pd, on bit 31 / 30
+  const __m256 swap = _mm256_castsi256_ps(_mm256_slli_epi32(q, 31));
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  const __m256 ns = _mm256_and_ps(_mm256_castsi256_ps(_mm256_slli_epi32(q, 30)), sign);
+  const __m256 nc = _mm256_and_ps(_mm256_castsi256_ps(
+      _mm256_slli_epi32(_mm256_add_epi32(q, _mm256_set1_epi32(1)), 30)), sign);
+  s_out = _mm256_xor_ps(_mm256_blendv_ps(sn, cs, swap), ns);
+  c_out = _mm256_xor_ps(_mm256_blendv_ps(cs, sn, swap), nc);
+}
+
+static inline __m256d ua_sqrt_pd_safe(__m256d x) noexcept {
+  // native double sqrt: robust and still fast
+  return _mm256_sqrt_pd(x);
+}
+
+// One Marsaglia polar step on 4 lanes: two vectors of raw u64 -> up to 8
+// normals appended at out[i..n). Rejected lanes are skipped, leftovers dropped.
+static inline void ua_polar_emit_pd(__m256i uu_raw, __m256i vv_raw,
+                                    double* out, std::size_t& i, std::size_t n) noexcept {
+  const __m256d one   = _mm256_set1_pd(1.0);
+  const __m256d zero  = _mm256_set1_pd(0.0);
+  const __m256i EXP   = _mm256_set1_epi64x(0x3FFull << 52);
+  const __m256d s_min = _mm256_set1_pd(1e-300); // reject ultra-tiny s
+
+  // two uniforms in (-1,1) via bit tricks (no divides)
+  __m256i uu = _mm256_srli_epi64(uu_raw, 12);
+  __m256i vv = _mm256_srli_epi64(vv_raw, 12);
+  __m256d a  = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(uu, EXP)), one);
+  __m256d b  = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(vv, EXP)), one);
+  __m256d u  = _mm256_sub_pd(_mm256_add_pd(a, a), one);
+  __m256d v  = _mm256_sub_pd(_mm256_add_pd(b, b), one);
+
+  // s = u^2 + v^2
+  __m256d s  = _mm256_add_pd(_mm256_mul_pd(u,u), _mm256_mul_pd(v,v));
+
+  // accept mask: 0 < s < 1 and s >= s_min
+  __m256d m_gt0   = _mm256_cmp_pd(s, zero,  _CMP_GT_OQ);
+  __m256d m_lt1   = _mm256_cmp_pd(s, one,   _CMP_LT_OQ);
+  __m256d m_geMin = _mm256_cmp_pd(s, s_min, _CMP_GT_OQ);
+  __m256d m_ok    = _mm256_and_pd(_mm256_and_pd(m_gt0, m_lt1), m_geMin);
+  int mask        = _mm256_movemask_pd(m_ok);
+  if (mask == 0) return;
+
+  // safe s (avoid log(0) and division by 0 in rejected lanes)
+  __m256d s_safe  = _mm256_blendv_pd(one, s, m_ok);
+
+  // k = sqrt( -2*ln(s) / s ) with robust ln + clamping to avoid NaNs/Infs
+  __m256d num     = _mm256_mul_pd(_mm256_set1_pd(-2.0), ua_log_rr_pd(s_safe));
+  __m256d frac    = _mm256_div_pd(num, s_safe);
+  __m256d fracpos = _mm256_max_pd(frac, _mm256_set1_pd(0.0));
+  __m256d fraccl  = _mm256_min_pd(fracpos, _mm256_set1_pd(1e300));
+  __m256d k       = ua_sqrt_pd_safe(fraccl);
+
+  // z = u*k , v*k
+  __m256d zu_vec = _mm256_mul_pd(u, k);
+  __m256d zv_vec = _mm256_mul_pd(v, k);
+
+  // sanitize (zero non-finite lanes), then store to stack
+  __m256d ord_u = _mm256_cmp_pd(zu_vec, zu_vec, _CMP_ORD_Q);
+  __m256d ord_v = _mm256_cmp_pd(zv_vec, zv_vec, _CMP_ORD_Q);
+  zu_vec = _mm256_blendv_pd(_mm256_set1_pd(0.0), zu_vec, ord_u);
+  zv_vec = _mm256_blendv_pd(_mm256_set1_pd(0.0), zv_vec, ord_v);
+
+  alignas(32) double zu[4], zv[4];
+  _mm256_store_pd(zu, zu_vec);
+  _mm256_store_pd(zv, zv_vec);
+
+  // compact accepted lanes into the output
+  for (int lane = 0; lane < 4 && i < n; ++lane) {
+    if ((mask >> lane) & 1) {
+      out[i++] = zu[lane];
+      if (i < n) out[i++] = zv[lane];
+    }
+  }
+}
+
+} // namespace ua::detail
@@ -0,0 +1,219 @@
+// Internal AVX-512 math shared by the AVX-512 backend TUs (not installed).
+// Include only from TUs compiled with UA_AVX512_FLAGS; everything here is
+// static inline so each TU keeps its own copy.
+#pragma once
+#include <immintrin.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "ua_math_consts.h"
+
+namespace ua::detail {
+
+// ln(x) on 8 lanes: the AVX2 ua_log_rr_pd (ua_math_avx2.h) step for step,
+// so both tiers return the same bits (max error 0.75 ulp).
+static inline __m512d ua_log_rr_pd(__m512d x) noexcept {
+  using namespace math_c;
+  const __mmask8 sub = _mm512_cmp_pd_mask(x, _mm512_set1_pd(0x1p-1022), _CMP_LT_OQ);
+  x = _mm512_mask_mul_pd(x, sub, x, _mm512_set1_pd(0x1p54));
+  const __m512d kadj = _mm512_maskz_mov_pd(sub, _mm512_set1_pd(54.0));
+
+  __m512i hx = _mm512_add_epi64(_mm512_castpd_si512(x),
+                                _mm512_set1_epi64((0x3ff00000LL - 0x3fe6a09eLL) << 32));
+  // exponent to double without AVX512DQ's vcvtqq2pd
+  const __m512d eb = _mm512_castsi512_pd(_mm512_or_si512(_mm512_srli_epi64(hx, 52),
+                                                         _mm512_set1_epi64(0x4330000000000000LL)));
+  const __m512d k  = _mm512_sub_pd(_mm512_sub_pd(eb, _mm512_set1_pd(4503599627370496.0 + 1023.0)), kadj);
+  hx = _mm512_add_epi64(_mm512_and_si512(hx, _mm512_set1_epi64(0x000fffffffffffffLL)),
+                        _mm512_set1_epi64(0x3fe6a09eLL << 32));
+  const __m512d f = _mm512_sub_pd(_mm512_castsi512_pd(hx), _mm512_set1_pd(1.0));
+
+  const __m512d s = _mm512_div_pd(f, _mm512_add_pd(_mm512_set1_pd(2.0), f));
+  const __m512d z = _mm512_mul_pd(s, s);
+  const __m512d w = _mm512_mul_pd(z, z);
+  __m512d t1 = _mm512_fmadd_pd(w, _mm512_set1_pd(LG6), _mm512_set1_pd(LG4));
+  t1 = _mm512_mul_pd(w, _mm512_fmadd_pd(w, t1, _mm512_set1_pd(LG2)));
+  __m512d t2 = _mm512_fmadd_pd(w, _mm512_set1_pd(LG7), _mm512_set1_pd(LG5));
+  t2 = _mm512_fmadd_pd(w, t2, _mm512_set1_pd(LG3));
+  t2 = _mm512_mul_pd(z, _mm512_fmadd_pd(w, t2, _mm512_set1_pd(LG1)));
+  const __m512d R    = _mm512_add_pd(t2, t1);
+  const __m512d hfsq = _mm512_mul_pd(_mm512_mul_pd(_mm512_set1_pd(0.5), f), f);
+  const __m512d lo = _mm512_fmadd_pd(s, _mm512_add_pd(hfsq, R), _mm512_mul_pd(k, _mm512_set1_pd(LN2_LO)));
+  return _mm512_fmsub_pd(k, _mm512_set1_pd(LN2_HI), _mm512_sub_pd(_mm512_sub_pd(hfsq, lo), f));
+}
+
+// e^x on 8 lanes: the AVX2 ua_exp_pd step for step (same bits; max error
+// < 1 ulp for normal results, x clamped to [-746, 710]).
+static inline __m512d ua_exp_pd(__m512d x) noexcept {
+  using namespace math_c;
+  x = _mm512_max_pd(_mm512_min_pd(x, _mm512_set1_pd(710.0)), _mm512_set1_pd(-746.0));
+  const __m512d k  = _mm512_sub_pd(_mm512_fmadd_pd(x, _mm512_set1_pd(INV_LN2), _mm512_set1_pd(TO_INT)),
+                                   _mm512_set1_pd(TO_INT));
+  const __m512d hi = _mm512_fnmadd_pd(k, _mm512_set1_pd(LN2_HI), x);
+  const __m512d lo = _mm512_mul_pd(k, _mm512_set1_pd(LN2_LO));
+  const __m512d r  = _mm512_sub_pd(hi, lo);
+  const __m512d rr = _mm512_mul_pd(r, r);
+  __m512d p = _mm512_fmadd_pd(rr, _mm512_set1_pd(EP5), _mm512_set1_pd(EP4));
+  p = _mm512_fmadd_pd(rr, p, _mm512_set1_pd(EP3));
+  p = _mm512_fmadd_pd(rr, p, _mm512_set1_pd(EP2));
+  p = _mm512_fmadd_pd(rr, p, _mm512_set1_pd(EP1));
+  const __m512d c = _mm512_fnmadd_pd(rr, p, r);
+  const __m512d y = _mm512_sub_pd(_mm512_set1_pd(1.0),
+      _mm512_sub_pd(_mm512_sub_pd(lo, _mm512_div_pd(_mm512_mul_pd(r, c), _mm512_sub_pd(_mm512_set1_pd(2.0), c))), hi));
+
+  const __m512d t1 = _mm512_fmadd_pd(k, _mm512_set1_pd(0.5), _mm512_set1_pd(TO_INT));
+  const __m512d t2 = _mm512_add_pd(_mm512_sub_pd(k, _mm512_sub_pd(t1, _mm512_set1_pd(TO_INT))), _mm512_set1_pd(TO_INT));
+  const __m512i rebias = _mm512_set1_epi64(0x4338000000000000LL - 1023);
+  const __m512d s1 = _mm512_castsi512_pd(_mm512_slli_epi64(_mm512_sub_epi64(_mm512_castpd_si512(t1), rebias), 52));
+  const __m512d s2 = _mm512_castsi512_pd(_mm512_slli_epi64(_mm512_sub_epi64(_mm512_castpd_si512(t2), rebias), 52));
+  return _mm512_mul_pd(_mm512_mul_pd(y, s1), s2);
+}
+
+// sin(2 pi u) and cos(2 pi u) on 8 lanes, |u| < 2^50: the AVX2
+// ua_sincos2pi_pd step for step, quadrant fix-up with mask registers
+// (max error 0.79 ulp).
+static inline void ua_sincos2pi_pd(__m512d u, __m512d& s_out, __m512d& c_out) noexcept {
+  using namespace math_c;
+  const __m512d t = _mm512_fmadd_pd(u, _mm512_set1_pd(4.0), _mm512_set1_pd(TO_INT));
+  const __m512i q = _mm512_castpd_si512(t);
+  const __m512d r = _mm512_fnmadd_pd(_mm512_sub_pd(t, _mm512_set1_pd(TO_INT)), _mm512_set1_pd(0.25), u);
+  const __m512d x = _mm512_mul_pd(r, _mm512_set1_pd(TWO_PI_HI));
+  const __m512d y = _mm512_fmadd_pd(r, _mm512_set1_pd(TWO_PI_LO), _mm512_fmsub_pd(r, _mm512_set1_pd(TWO_PI_HI), x));
+  const __m512d z = _mm512_mul_pd(x, x);
+  const __m512d v = _mm512_mul_pd(z, x);
+  const __m512d hy = _mm512_mul_pd(_mm512_set1_pd(0.5), y);
+
+  __m512d rs = _mm512_fmadd_pd(z, _mm512_set1_pd(S6), _mm512_set1_pd(S5));
+  rs = _mm512_fmadd_pd(z, rs, _mm512_set1_pd(S4));
+  rs = _mm512_fmadd_pd(z, rs, _mm512_set1_pd(S3));
+  rs = _mm512_fmadd_pd(z, rs, _mm512_set1_pd(S2));
+  const __m512d sa = _mm512_fmsub_pd(z, _mm512_fnmadd_pd(v, rs, hy), y);
+  const __m512d sn = _mm512_sub_pd(x, _mm512_fnmadd_pd(v, _mm512_set1_pd(S1), sa));
+
+  __m512d rc = _mm512_fmadd_pd(z, _mm512_set1_pd(C6), _mm512_set1_pd(C5));
+  rc = _mm512_fmadd_pd(z, rc, _mm512_set1_pd(C4));
+  rc = _mm512_fmadd_pd(z, rc, _mm512_set1_pd(C3));
+  rc = _mm512_fmadd_pd(z, rc, _mm512_set1_pd(C2));
+  rc = _mm512_mul_pd(z, _mm512_fmadd_pd(z, rc, _mm512_set1_pd(C1)));
+  const __m512d one = _mm512_set1_pd(1.0);
+  const __m512d hz  = _mm512_mul_pd(_mm512_set1_pd(0.5), z);
+  const __m512d w   = _mm512_sub_pd(one, hz);
+  const __m512d cs  = _mm512_add_pd(w, _mm512_add_pd(_mm512_sub_pd(_mm512_sub_pd(one, w), hz),
+                                                     _mm512_fmsub_pd(z, rc, _mm512_mul_pd(x, y))));
+
+  const __mmask8 swap = _mm512_test_epi64_mask(q, _mm512_set1_epi64(1));
+  const __m512i sign  = _mm512_set1_epi64(static_cast<long long>(0x8000000000000000ull));
+  const __m512i ns = _mm512_and_si512(_mm512_slli_epi64(q, 62), sign);
+  const __m512i nc = _mm512_and_si512(_mm512_slli_epi64(_mm512_add_epi64(q, _mm512_set1_epi64(1)), 62), sign);
+  s_out = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(_mm512_mask_blend_pd(swap, sn, cs)), ns));
+  c_out = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(_mm512_mask_blend_pd(swap, cs, sn)), nc));
+}
+
+// ln(x) on 16 floats for normal x > 0: the AVX2 ua_log_ps step for step
+// (max error 0.82 ulp over [2^-31, 1])
+static inline __m512 ua_log_ps(__m512 x) noexcept {
+  using namespace math_c;
+  __m512i hx = _mm512_add_epi32(_mm512_castps_si512(x), _mm512_set1_epi32(0x3f800000 - 0x3f3504f3));
+  const __m512 k = _mm512_cvtepi32_ps(_mm512_sub_epi32(_mm512_srli_epi32(hx, 23), _mm512_set1_epi32(127)));
+  hx = _mm512_add_epi32(_mm512_and_si512(hx, _mm512_set1_epi32(0x007fffff)), _mm512_set1_epi32(0x3f3504f3));
+  const __m512 f = _mm512_sub_ps(_mm512_castsi512_ps(hx), _mm512_set1_ps(1.0f));
+  const __m512 z = _mm512_mul_ps(f, f);
+  __m512 p = _mm512_set1_ps(LOGF_P[0]);
+  for (int i = 1; i < 9; ++i) p = _mm512_fmadd_ps(p, f, _mm512_set1_ps(LOGF_P[i]));
+  __m512 y = _mm512_fmadd_ps(k, _mm512_set1_ps(LN2F_LO), _mm512_mul_ps(_mm512_mul_ps(p, f), z));
+  y = _mm512_fnmadd_ps(_mm512_set1_ps(0.5f), z, y);
+  return _mm512_fmadd_ps(k, _mm512_set1_ps(LN2F_HI), _mm512_add_ps(f, y));
+}
+
+// sin(2 pi u) and cos(2 pi u) on 16 floats, |u| < 2^20: the AVX2
+// ua_sincos2pi_ps step for step, quadrant fix-up with mask registers
+// (max error 0.97 ulp)
+static inline void ua_sincos2pi_ps(__m512 u, __m512& s_out, __m512& c_out) noexcept {
+  using namespace math_c;
+  const __m512 t = _mm512_fmadd_ps(u, _mm512_set1_ps(4.0f), _mm512_set1_ps(TO_INT_F));
+  const __m512i q = _mm512_castps_si512(t);
+  const __m512 r = _mm512_fnmadd_ps(_mm512_sub_ps(t, _mm512_set1_ps(TO_INT_F)), _mm512_set1_ps(0.25f), u);
+  const __m512 x = _mm512_mul_ps(r, _mm512_set1_ps(TWO_PI_F));
+  const __m512 y = _mm512_fmadd_ps(r, _mm512_set1_ps(TWO_PI_FLO), _mm512_fmsub_ps(r, _mm512_set1_ps(TWO_PI_F), x));
+  const __m512 z = _mm512_mul_ps(x, x);
+  const __m512 ps = _mm512_fmadd_ps(_mm512_fmadd_ps(_mm512_set1_ps(SF3), z, _mm512_set1_ps(SF2)), z, _mm512_set1_ps(SF1));
+  const __m512 pc = _mm512_fmadd_ps(_mm512_fmadd_ps(_mm512_set1_ps(CF3), z, _mm512_set1_ps(CF2)), z, _mm512_set1_ps(CF1));
+  const __m512 sn = _mm512_add_ps(x, _mm512_fmadd_ps(_mm512_mul_ps(z, x), ps, y));
+  const __m512 hz = _mm512_mul_ps(_mm512_set1_ps(0.5f), z);
+  const __m512 w  = _mm512_sub_ps(_mm512_set1_ps(1.0f), hz);
+  const __m512 cs = _mm512_add_ps(w, _mm512_add_ps(_mm512_sub_ps(_mm512_sub_ps(_mm512_set1_ps(1.0f), w), hz),
+                                                   _mm512_fnmadd_ps(x, y, _mm512_mul_ps(_mm512_mul_ps(z, z), pc))));
+
+  const __mmask16 swap = _mm512_test_epi32_mask(q, _mm512_set1_epi32(1));
+  const __m512i sign = _mm512_set1_epi32(INT32_MIN);
+  const __m512i ns = _mm512_and_si512(_mm512_slli_epi32(q, 30), sign);
+  const __m512i nc = _mm512_and_si512(_mm512_slli_epi32(_mm512_add_epi32(q, _mm512_set1_epi32(1)), 30), sign);
+  s_out = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(_mm512_mask_blend_ps(swap, sn, cs)), ns));
+  c_out = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(_mm512_mask_blend_ps(swap, cs, sn)), nc));
+}
+
+static inline __m512d ua_sqrt_pd_safe(__m512d x) noexcept {
+  return _mm512_sqrt_pd(x);
+}
+
+// One Marsaglia polar step on 8 lanes: two vectors of raw u64 -> up to 16
+// normals appended at out[i..n). Rejected lanes are skipped, leftovers dropped.
+static inline void ua_polar_emit_pd(__m512i uu_raw, __m512i vv_raw,
+                                    double* out, std::size_t& i, std::size_t n) noexcept {
+  const __m512d one   = _mm512_set1_pd(1.0);
+  const __m512d zero  = _mm512_set1_pd(0.0);
+  const __m512i EXP   = _mm512_set1_epi64((long long)(0x3FFull << 52));
+  const __m512d s_min = _mm512_set1_pd(1e-300); // reject ultra-tiny s
+
+  // two uniforms in (-1,1) via bit tricks (no divides)
+  __m512i uu = _mm512_srli_epi64(uu_raw, 12);
+  __m512i vv = _mm512_srli_epi64(vv_raw, 12);
+  __m512d a  = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_epi64(uu, EXP)), one);
+  __m512d b  = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_epi64(vv, EXP)), one);
+  __m512d u  = _mm512_sub_pd(_mm512_add_pd(a, a), one);
+  __m512d v  = _mm512_sub_pd(_mm512_add_pd(b, b), one);
+
+  // s = u^2 + v^2
+  __m512d s  = _mm512_add_pd(_mm512_mul_pd(u,u), _mm512_mul_pd(v,v));
+
+  // accept mask: 0 < s < 1 and s >= s_min
+  __mmask8 m_ok = _mm512_kand(
+      _mm512_kand(_mm512_cmp_pd_mask(s, zero, _CMP_GT_OQ),
+                  _mm512_cmp_pd_mask(s, one,  _CMP_LT_OQ)),
+      _mm512_cmp_pd_mask(s, s_min, _CMP_GT_OQ));
+
+  if (m_ok == 0) return;
+
+  // safe s for rejected lanes
+  __m512d s_safe = _mm512_mask_mov_pd(one, m_ok, s);
+
+  // k = sqrt( -2*ln(s) / s ) with robust ln + clamping
+  __m512d num     = _mm512_mul_pd(_mm512_set1_pd(-2.0), ua_log_rr_pd(s_safe));
+  __m512d frac    = _mm512_div_pd(num, s_safe);
+  __m512d fracpos = _mm512_max_pd(frac, _mm512_set1_pd(0.0));
+  __m512d fraccl  = _mm512_min_pd(fracpos, _mm512_set1_pd(1e300));
+  __m512d k       = ua_sqrt_pd_safe(fraccl);
+
+  __m512d zu_vec = _mm512_mul_pd(u, k);
+  __m512d zv_vec = _mm512_mul_pd(v, k);
+
+  // sanitize (zero non-finite lanes), then store to stack
+  __mmask8 ord_u = _mm512_cmp_pd_mask(zu_vec, zu_vec, _CMP_ORD_Q);
+  __mmask8 ord_v = _mm512_cmp_pd_mask(zv_vec, zv_vec, _CMP_ORD_Q);
+  zu_vec = _mm512_mask_mov_pd(_mm512_set1_pd(0.0), ord_u, zu_vec);
+  zv_vec = _mm512_mask_mov_pd(_mm512_set1_pd(0.0), ord_v, zv_vec);
+
+  alignas(64) double zu[8], zv[8];
+  _mm512_store_pd(zu, zu_vec);
+  _mm512_store_pd(zv, zv_vec);
+
+  for (int lane = 0; lane < 8 && i < n; ++lane) {
+    if ((m_ok >> lane) & 1) {
+      out[i++] = zu[lane];
+      if (i < n) out[i++] = zv[lane];
+    }
+  }
+}
+
+} // namespace ua::detail
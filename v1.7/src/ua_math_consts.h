@@ -0,0 +1,87 @@
+// Internal constants for the SIMD math kernels in ua_math_avx2.h and
+// ua_math_avx512.h (not installed). ISA-free.
+#pragma once
+
+namespace ua::detail::math_c {
+
+// fdlibm e_log.c
+constexpr double LN2_HI = 6.93147180369123816490e-01;   // upper 32 bits of ln2
+constexpr double LN2_LO = 1.90821492927058770002e-10;
+constexpr double LG1 = 6.666666666666735130e-01, LG2 = 3.999999999940941908e-01,
+                 LG3 = 2.857142874366239149e-01, LG4 = 2.222219843214978396e-01,
+                 LG5 = 1.818357216161805012e-01, LG6 = 1.531383769920937332e-01,
+                 LG7 = 1.479819860511658591e-01;
+
+// fdlibm k_sin.c / k_cos.c, minimax on [-pi/4, pi/4]
+constexpr double S1 = -1.66666666666666324348e-01, S2 =  8.33333333332248946124e-03,
+                 S3 = -1.98412698298579493134e-04, S4 =  2.75573137070700676789e-06,
+                 S5 = -2.50507602534068634195e-08, S6 =  1.58969099521155010221e-10;
+constexpr double C1 =  4.16666666666666019037e-02, C2 = -1.38888888888741095749e-03,
+                 C3 =  2.48015872894767294178e-05, C4 = -2.75573143513906633035e-07,
+                 C5 =  2.08757232129817482790e-09, C6 = -1.13596475577881948265e-11;
+
+// fdlibm e_exp.c, minimax for r c / (2 - c) on [-ln2/2, ln2/2]
+constexpr double INV_LN2 = 1.44269504088896338700e+00;
+constexpr double EP1 =  1.66666666666666019037e-01, EP2 = -2.77777777770155933842e-03,
+                 EP3 =  6.61375632143793436117e-05, EP4 = -1.65339022054652515390e-06,
+                 EP5 =  4.13813679705723846039e-08;
+
+constexpr double TWO_PI_HI = 6.28318530717958623200e+00;   // 2pi = HI + LO to ~2^-106
+constexpr double TWO_PI_LO = 2.44929359829470635445e-16;
+constexpr double TO_INT    = 6755399441055744.0;           // 1.5 * 2^52: x + TO_INT rounds x to an integer
+
+// Cephes logf / sinf / cosf, single-precision minimax for the float kernels:
+// ln(1 + f) = f - f^2/2 + f^3 P(f) on [sqrt(2)/2 - 1, sqrt(2) - 1] (P highest
+// degree first, ln2 split so k LN2F_HI is exact), sin / cos on [-pi/4, pi/4]
+constexpr float LN2F_HI = 0.693359375f, LN2F_LO = -2.12194440e-4f;
+constexpr float LOGF_P[9] = { 7.0376836292e-2f, -1.1514610310e-1f, 1.1676998740e-1f,
+                              -1.2420140846e-1f, 1.4249322787e-1f, -1.6668057665e-1f,
+                              2.0000714765e-1f, -2.4999993993e-1f, 3.3333331174e-1f };
+constexpr float SF1 = -1.6666654611e-1f, SF2 = 8.3321608736e-3f, SF3 = -1.9515295891e-4f;
+constexpr float CF1 = 4.166664568298827e-2f, CF2 = -1.388731625493765e-3f, CF3 = 2.443315711809948e-5f;
+constexpr float TWO_PI_F = 6.28318530717958647692f, TWO_PI_FLO = -1.7484555e-07f;   // 2pi = F + FLO to ~1e-14
+constexpr float TO_INT_F = 12582912.0f;   // 1.5 * 2^23: x + TO_INT_F rounds x to an integer
+
+// Wichura, AS241 PPND16 (Appl. Statist. 37, 1988): numerator / denominator
+// coefficients, lowest degree first; the denominators' constant term is 1
+constexpr double ICDF_SPLIT1 = 0.425, ICDF_CONST1 = 0.180625;   // central: r = CONST1 - q^2
+constexpr double ICDF_SPLIT2 = 5.0,   ICDF_CONST2 = 1.6;        // tails: r <= SPLIT2 -> r - CONST2
+constexpr double ICDF_A[8] = { 3.3871328727963666080e0,  1.3314166789178437745e+2,
+                               1.9715909503065514427e+3, 1.3731693765509461125e+4,
+                               4.5921953931549871457e+4, 6.7265770927008700853e+4,
+                               3.3430575583588128105e+4, 2.5090809287301226727e+3 };
+constexpr double ICDF_B[8] = { 1.0,                      4.2313330701600911252e+1,
+                               6.8718700749205790830e+2, 5.3941960214247511077e+3,
+                               2.1213794301586595867e+4, 3.9307895800092710610e+4,
+                               2.8729085735721942674e+4, 5.2264952788528545610e+3 };
+constexpr double ICDF_C[8] = { 1.42343711074968357734e0,  4.63033784615654529590e0,
+                               5.76949722146069140550e0,  3.64784832476320460504e0,
+                               1.27045825245236838258e0,  2.41780725177450611770e-1,
+                               2.27238449892691845833e-2, 7.74545014278341407640e-4 };
+constexpr double ICDF_D[8] = { 1.0,                       2.05319162663775882187e0,
+                               1.67638483018380384940e0,  6.89767334985100004550e-1,
+                               1.48103976427480074590e-1, 1.51986665636164571966e-2,
+                               5.47593808499534494600e-4, 1.05075007164441684324e-9 };
+constexpr double ICDF_E[8] = { 6.65790464350110377720e0,  5.46378491116411436990e0,
+                               1.78482653991729133580e0,  2.96560571828504891230e-1,
+                               2.65321895265761230930e-2, 1.24266094738807843860e-3,
+                               2.71155556874348757815e-5, 2.01033439929228813265e-7 };
+constexpr double ICDF_F[8] = { 1.0,                       5.99832206555887937690e-1,
+                               1.36929880922735805310e-1, 1.48753612908506148525e-2,
+                               7.86869131145613259100e-4, 1.84631831751005468180e-5,
+                               1.42151175831644588870e-7, 2.04426310338993978564e-15 };
+
+// Discrete samplers (ua_distributions.h): means below DISC_INV_MEAN are
+// drawn by sequential inversion, stopped after DISC_INV_KMAX steps; fc(k) =
+// ln k! - (k + 1/2) ln(k + 1) + (k + 1) - HALF_LN_2PI for k < 10 (Hörmann's
+// Stirling correction; a series above)
+constexpr double DISC_INV_MEAN = 10.0;
+constexpr int    DISC_INV_KMAX = 64;
+constexpr double HALF_LN_2PI   = 9.18938533204672741780e-01;
+constexpr double STIRLING_FC[10] = { 8.10614667953272582197e-02, 4.13406959554092940539e-02,
+                                     2.76779256849983391702e-02, 2.07906721037650930937e-02,
+                                     1.66446911898211920007e-02, 1.38761288230707477312e-02,
+                                     1.18967099458917701239e-02, 1.04112652619720967985e-02,
+                                     9.25546218271273171642e-03, 8.33056343336287225638e-03 };
+
+} // namespace ua::detail::math_c
@@ -2,17 +2,56 @@
 #include "ua/ua_cpuid.h"
 #include "ua/ua_xoshiro256ss_avx2.h"
 #include "ua/ua_xoshiro256ss_avx512.h"
+#include "ua/ua_xoshiro256ss_avx512vl.h"
 // scalar backend: header-only in this project
 #include "ua/ua_xoshiro256ss_scalar.h"
+#include "ua/ua_philox4x32_avx2_engine.h"
+#include "ua/ua_philox4x32_avx512.h"
+#include "ua/ua_philox4x32_scalar.h"
+#include "ua/ua_xoroshiro128pp.h"
+#include "ua/ua_xoroshiro128pp_avx2.h"
+#include "ua/ua_xoroshiro128pp_avx512.h"
+#include "ua/ua_chacha_avx2.h"
+#include "ua/ua_chacha_avx512.h"
+#include "ua/ua_chacha_scalar.h"
+#include "ua/ua_ars4x32.h"
+#include "ua/ua_pcg64_dxsm.h"
+#include "ua/ua_normal_ziggurat.h"
+#include "ua/ua_normal_icdf.h"
+#include "ua/ua_exponential.h"
+#include "ua/ua_distributions.h"
+#include "ua/ua_uniform_int.h"
+#include "ua/ua_float.h"
+#include "ua_kernel_tier.h"
 
+#include <bit>
 #include <cstdlib>
 #include <cstring>
+#include <type_traits>
 
 namespace ua {
 
 using ua::detail::Xoshiro256ssAVX2;
 using ua::detail::Xoshiro256ssAVX512;
+using ua::detail::Xoshiro256ssAVX512VL;
+using ua::detail::Xoshiro256ssAVX2Interleaved;
+using ua::detail::Xoshiro256ssAVX512Interleaved;
 using ua::detail::Xoshiro256ssScalar;
+using ua::detail::Philox4x32AVX2Engine;
+using ua::detail::Philox4x32AVX512;
+using ua::detail::Philox4x32Scalar;
+using ua::detail::Xoroshiro128ppAVX2;
+using ua::detail::Xoroshiro128ppAVX512;
+using ua::detail::ChaChaAVX2;
+using ua::detail::ChaChaAVX512;
+using ua::detail::ChaChaScalar;
+using ua::detail::Ars4x32AESNI;
+using ua::detail::Ars4x32AVX2;
+using ua::detail::Ars4x32AVX512;
+using ua::detail::Ars4x32Scalar;
+using ua::detail::Pcg64DxsmAVX2;
+using ua::detail::Pcg64DxsmAVX512;
+using ua::detail::Pcg64DxsmScalar;
 
 // ---------------------------
 // Small helpers
@@ -30,81 +69,387 @@ static inline bool eq_ci(const char* a, const char* b) {
 }
 
 // ---------------------------
-// Backend adaptors (Scalar)
+// Backend adaptors: one Vtbl per (backend type, tier). Every backend exposes
+// generate_u64/double, jump, long_jump and skip_ahead(lo, hi); normals go
+// through the Ziggurat below.
 // ---------------------------
-struct ScalarState { Xoshiro256ssScalar prng; explicit ScalarState(std::uint64_t s): prng(s){} };
+// k jump()s in one O(log k) step, for Init::stream. The counter engines'
+// jump() is 2^64 blocks and xoroshiro128++'s 2^64 steps, i.e. skip_ahead(0,
+// k); PCG's is an advance by NumPy's jump constant J, so k of them advance
+// k J mod 2^128; xoshiro256**'s 2^128 steps are past skip_ahead's 128-bit
+// distance, so the polynomial x^(k 2^128) goes to jump_with.
+template<class B> constexpr bool kXoshiro = false;
+template<> constexpr bool kXoshiro<Xoshiro256ssScalar> = true;
+template<> constexpr bool kXoshiro<Xoshiro256ssAVX2> = true;
+template<> constexpr bool kXoshiro<Xoshiro256ssAVX512> = true;
+template<> constexpr bool kXoshiro<Xoshiro256ssAVX512VL> = true;
+template<int K> constexpr bool kXoshiro<Xoshiro256ssAVX2Interleaved<K>> = true;
+template<int K> constexpr bool kXoshiro<Xoshiro256ssAVX512Interleaved<K>> = true;
 
-static void scalar_gen_u64(void* p, std::uint64_t* out, std::size_t n) noexcept {
-    auto* s = static_cast<ScalarState*>(p);
-    s->prng.generate_u64(out, n);
-}
-static void scalar_gen_double(void* p, double* out, std::size_t n) noexcept {
-    auto* s = static_cast<ScalarState*>(p);
-    s->prng.generate_double(out, n);
-}
-static void scalar_gen_normal(void* p, double* out, std::size_t n) noexcept {
-    auto* s = static_cast<ScalarState*>(p);
-    s->prng.generate_normal(out, n);
+template<class B>
+static void jump_times(B& g, std::uint64_t k) noexcept {
+    if constexpr (kXoshiro<B>) {
+        std::uint64_t poly[4];
+        ua::detail::xoshiro256_jumps_poly(k, poly);
+        g.jump_with(poly);
+    } else if constexpr (std::is_same_v<B, Pcg64DxsmScalar> || std::is_same_v<B, Pcg64DxsmAVX2> ||
+                         std::is_same_v<B, Pcg64DxsmAVX512>) {
+        std::uint64_t hi, lo;
+        pcg_mul128(0, k, PCG_JUMP_HI, PCG_JUMP_LO, hi, lo);
+        g.skip_ahead(lo, hi);
+    } else {
+        g.skip_ahead(0, k);
+    }
 }
-static void scalar_jump(void* p) noexcept { (void)p; /* optional */ }
-static void scalar_destroy(void* p) noexcept { delete static_cast<ScalarState*>(p); }
+
+template<class B>
+struct Adaptor {
+    static void gen_u64(void* p, std::uint64_t* out, std::size_t n) noexcept { static_cast<B*>(p)->generate_u64(out, n); }
+    static void gen_double(void* p, double* out, std::size_t n) noexcept    { static_cast<B*>(p)->generate_double(out, n); }
+    static void jump(void* p) noexcept                                      { static_cast<B*>(p)->jump(); }
+    static void long_jump(void* p) noexcept                                 { static_cast<B*>(p)->long_jump(); }
+    static void jumps(void* p, std::uint64_t k) noexcept                    { jump_times(*static_cast<B*>(p), k); }
+    static void skip(void* p, std::uint64_t lo, std::uint64_t hi) noexcept  { static_cast<B*>(p)->skip_ahead(lo, hi); }
+    static void destroy(void* p) noexcept                                   { delete static_cast<B*>(p); }
+};
 
 // ---------------------------
-// Backend adaptors (AVX2)
+// Ziggurat normals over any backend: one u64 candidate per output. The
+// tier's rectangle pass fills a chunk in place and lists the misses, which
+// ZigguratNormal::finish completes with fresh u64 from the same backend.
 // ---------------------------
-static void avx2_gen_u64(void* p, std::uint64_t* out, std::size_t n) noexcept {
-    static_cast<Xoshiro256ssAVX2*>(p)->generate_u64(out, n);
+using ZigRectFn = std::size_t (*)(const std::uint64_t*, std::size_t, double*, std::uint32_t*) noexcept;
+
+static std::size_t ziggurat_rect_scalar(const std::uint64_t* u, std::size_t n, double* out, std::uint32_t* rare) noexcept {
+    std::size_t nr = 0;
+    for (std::size_t j = 0; j < n; ++j)
+        if (!ZigguratNormal::rect(u[j], out[j])) rare[nr++] = std::uint32_t(j);
+    return nr;
 }
-static void avx2_gen_double(void* p, double* out, std::size_t n) noexcept {
-    static_cast<Xoshiro256ssAVX2*>(p)->generate_double(out, n);
+
+template<class B, ZigRectFn Rect>
+static void gen_normal_zig(void* p, double* out, std::size_t n) noexcept {
+    constexpr std::size_t CHUNK = 512, EXTRA = 32;
+    B& g = *static_cast<B*>(p);
+    alignas(64) std::uint64_t u[CHUNK];
+    std::uint32_t rare[CHUNK + 8];
+    std::uint64_t extra[EXTRA];
+    std::size_t xpos = EXTRA;
+    auto next = [&]() {
+        if (xpos == EXTRA) { g.generate_u64(extra, EXTRA); xpos = 0; }
+        return extra[xpos++];
+    };
+    for (std::size_t i = 0; i < n;) {
+        const std::size_t m = n - i < CHUNK ? n - i : CHUNK;
+        g.generate_u64(u, m);
+        const std::size_t nr = Rect(u, m, out + i, rare);
+        for (std::size_t k = 0; k < nr; ++k) out[i + rare[k]] = ZigguratNormal::finish(u[rare[k]], next);
+        i += m;
+    }
 }
-static void avx2_gen_normal(void* p, double* out, std::size_t n) noexcept {
-    static_cast<Xoshiro256ssAVX2*>(p)->generate_normal(out, n);
+
+// Normal kernel per tier. The Ziggurat beat every backend's vectorized
+// polar on every tier in ua_rng_bench (x1.4 scalar, x1.6 AVX2, x2.4
+// AVX-512F), so the backends' generate_normal is no longer dispatched; the
+// only caller left is that comparison (bench_polar, xoshiro256** AVX2 /
+// AVX-512F). The counter engines no longer have one.
+template<class B>
+static void (*normal_for(SimdTier tier))(void*, double*, std::size_t) noexcept {
+    switch (tier) {
+    case SimdTier::AVX512F:  return &gen_normal_zig<B, &ua::detail::ziggurat_rect_avx512>;
+    case SimdTier::AVX2:
+    case SimdTier::AVX512VL: return &gen_normal_zig<B, &ua::detail::ziggurat_rect_avx2>;
+    default:                 return &gen_normal_zig<B, &ziggurat_rect_scalar>;
+    }
 }
-static void avx2_jump(void* p) noexcept { (void)p; /* optional */ }
-static void avx2_destroy(void* p) noexcept { delete static_cast<Xoshiro256ssAVX2*>(p); }
 
 // ---------------------------
-// Backend adaptors (AVX-512F)
+// Inversion samplers (inverse-CDF normals, exponentials): each u64 becomes
+// the grid midpoint (2k + 1) 2^-53, k its top 52 bits, strictly inside
+// (0, 1) so no output is infinite, and the tier's kernel maps the chunk in
+// place. One u64 per output and no rejection: output j depends only on u64 j.
 // ---------------------------
-static void avx512_gen_u64(void* p, std::uint64_t* out, std::size_t n) noexcept {
-    static_cast<Xoshiro256ssAVX512*>(p)->generate_u64(out, n);
+constexpr std::size_t INV_CHUNK = 512;
+
+template<class B>
+static void open_uniforms(B& g, double* out, std::size_t m) noexcept {
+    alignas(64) std::uint64_t u[INV_CHUNK];
+    g.generate_u64(u, m);
+    // 1 + k 2^-52 minus (1 - 2^-53): exact by Sterbenz
+    for (std::size_t j = 0; j < m; ++j)
+        out[j] = std::bit_cast<double>((u[j] >> 12) | 0x3FF0000000000000ull) - (1.0 - 0x1p-53);
+}
+
+template<class B, ua::detail::NormalIcdfFn Icdf>
+static void gen_normal_icdf(void* p, double* out, std::size_t n) noexcept {
+    B& g = *static_cast<B*>(p);
+    for (std::size_t i = 0; i < n;) {
+        const std::size_t m = n - i < INV_CHUNK ? n - i : INV_CHUNK;
+        open_uniforms(g, out + i, m);
+        Icdf(out + i, m, out + i);
+        i += m;
+    }
+}
+
+template<class B, ua::detail::ExponentialFn Exp>
+static void gen_exponential(void* p, double* out, std::size_t n, double rate) noexcept {
+    B& g = *static_cast<B*>(p);
+    const double scale = 1.0 / rate;
+    for (std::size_t i = 0; i < n;) {
+        const std::size_t m = n - i < INV_CHUNK ? n - i : INV_CHUNK;
+        open_uniforms(g, out + i, m);
+        Exp(out + i, m, scale, out + i);
+        i += m;
+    }
+}
+
+template<class B>
+static void (*normal_icdf_for(SimdTier tier))(void*, double*, std::size_t) noexcept {
+    switch (tier) {
+    case SimdTier::AVX512F:  return &gen_normal_icdf<B, &ua::detail::normal_icdf_avx512>;
+    case SimdTier::AVX2:
+    case SimdTier::AVX512VL: return &gen_normal_icdf<B, &ua::detail::normal_icdf_avx2>;
+    default:                 return &gen_normal_icdf<B, &ua::detail::normal_icdf_scalar>;
+    }
 }
-static void avx512_gen_double(void* p, double* out, std::size_t n) noexcept {
-    static_cast<Xoshiro256ssAVX512*>(p)->generate_double(out, n);
+
+template<class B>
+static void (*exponential_for(SimdTier tier))(void*, double*, std::size_t, double) noexcept {
+    switch (tier) {
+    case SimdTier::AVX512F:  return &gen_exponential<B, &ua::detail::exponential_avx512>;
+    case SimdTier::AVX2:
+    case SimdTier::AVX512VL: return &gen_exponential<B, &ua::detail::exponential_avx2>;
+    default:                 return &gen_exponential<B, &ua::detail::exponential_scalar>;
+    }
+}
+
+// Discrete samplers run the ua_distributions.h generators over the Rng
+// itself, on the kernel of its tier
+static ua::detail::PoissonFn poisson_for(SimdTier tier) noexcept {
+    switch (tier) {
+    case SimdTier::AVX512F:  return &ua::detail::poisson_avx512;
+    case SimdTier::AVX2:
+    case SimdTier::AVX512VL: return &ua::detail::poisson_avx2;
+    default:                 return &ua::detail::poisson_scalar;
+    }
 }
-static void avx512_gen_normal(void* p, double* out, std::size_t n) noexcept {
-    static_cast<Xoshiro256ssAVX512*>(p)->generate_normal(out, n);
+
+static ua::detail::BinomialFn binomial_for(SimdTier tier) noexcept {
+    switch (tier) {
+    case SimdTier::AVX512F:  return &ua::detail::binomial_avx512;
+    case SimdTier::AVX2:
+    case SimdTier::AVX512VL: return &ua::detail::binomial_avx2;
+    default:                 return &ua::detail::binomial_scalar;
+    }
+}
+
+// Bounded integers: u64 words in INV_CHUNK blocks through the tier's Lemire
+// kernel; the missed values are redrawn together on fresh words, the index
+// list compacted each round, until none is left (each value misses with
+// probability below s / 2^w).
+template<class T, class Fn>
+static void gen_bounded(Rng& g, Fn kernel, T lo, T s, T* out, std::size_t n) noexcept {
+    constexpr std::size_t PER = sizeof(std::uint64_t) / sizeof(T), CHUNK = INV_CHUNK * PER;
+    alignas(64) std::uint64_t u[INV_CHUNK];
+    alignas(64) T redo[CHUNK];
+    std::uint32_t idx[CHUNK], miss[CHUNK];
+    for (std::size_t i = 0; i < n;) {
+        const std::size_t m = n - i < CHUNK ? n - i : CHUNK;
+        g.generate_u64(u, (m + PER - 1) / PER);
+        std::size_t r = kernel(u, m, lo, s, out + i, idx);
+        while (r) {
+            g.generate_u64(u, (r + PER - 1) / PER);
+            const std::size_t r2 = kernel(u, r, lo, s, redo, miss);
+            for (std::size_t t = 0; t < r; ++t) out[i + idx[t]] = redo[t];
+            for (std::size_t t = 0; t < r2; ++t) idx[t] = idx[miss[t]];
+            r = r2;
+        }
+        i += m;
+    }
+}
+
+static ua::detail::UniformU32Fn uniform_u32_for(SimdTier tier) noexcept {
+    switch (tier) {
+    case SimdTier::AVX512F:  return &ua::detail::uniform_u32_avx512;
+    case SimdTier::AVX2:
+    case SimdTier::AVX512VL: return &ua::detail::uniform_u32_avx2;
+    default:                 return &ua::detail::uniform_u32_scalar;
+    }
+}
+
+static ua::detail::UniformU64Fn uniform_u64_for(SimdTier tier) noexcept {
+    switch (tier) {
+    case SimdTier::AVX512F:  return &ua::detail::uniform_u64_avx512;
+    case SimdTier::AVX2:
+    case SimdTier::AVX512VL: return &ua::detail::uniform_u64_avx2;
+    default:                 return &ua::detail::uniform_u64_scalar;
+    }
+}
+
+// Float outputs: u64 words in INV_CHUNK blocks, two floats per word; the
+// block holds an even number of floats, so float j depends on word j / 2
+// alone whatever the request sizes.
+template<class Fn>
+static void gen_float(Rng& rng, Fn kernel, float* out, std::size_t n) noexcept {
+    alignas(64) std::uint64_t u[INV_CHUNK];
+    for (std::size_t i = 0; i < n;) {
+        const std::size_t m = n - i < 2 * INV_CHUNK ? n - i : 2 * INV_CHUNK;
+        rng.generate_u64(u, (m + 1) / 2);
+        kernel(u, m, out + i);
+        i += m;
+    }
+}
+
+static ua::detail::UnitFloatFn unit_float_for(SimdTier tier) noexcept {
+    switch (tier) {
+    case SimdTier::AVX512F:  return &ua::detail::unit_float_avx512;
+    case SimdTier::AVX2:
+    case SimdTier::AVX512VL: return &ua::detail::unit_float_avx2;
+    default:                 return &ua::detail::unit_float_scalar;
+    }
+}
+
+static ua::detail::NormalFloatFn normal_float_for(SimdTier tier) noexcept {
+    switch (tier) {
+    case SimdTier::AVX512F:  return &ua::detail::normal_float_avx512;
+    case SimdTier::AVX2:
+    case SimdTier::AVX512VL: return &ua::detail::normal_float_avx2;
+    default:                 return &ua::detail::normal_float_scalar;
+    }
+}
+
+static ua::detail::AliasFn alias_for(SimdTier tier) noexcept {
+    switch (tier) {
+    case SimdTier::AVX512F:  return &ua::detail::alias_avx512;
+    case SimdTier::AVX2:
+    case SimdTier::AVX512VL: return &ua::detail::alias_avx2;
+    default:                 return &ua::detail::alias_scalar;
+    }
+}
+
+ua::detail::UniformBoundsFn Rng::uniform_bounds_for_tier() const noexcept {
+    switch (tier_) {
+    case SimdTier::AVX512F:  return &ua::detail::uniform_bounds_avx512;
+    case SimdTier::AVX2:
+    case SimdTier::AVX512VL: return &ua::detail::uniform_bounds_avx2;
+    default:                 return &ua::detail::uniform_bounds_scalar;
+    }
+}
+
+template<class B, class... Args>
+void Rng::bind(SimdTier tier, Args... args) {
+    using A = Adaptor<B>;
+    auto make = [](SimdTier t) {
+        return Vtbl{ &A::gen_u64, &A::gen_double, normal_for<B>(t), normal_icdf_for<B>(t),
+                     exponential_for<B>(t), &A::jump, &A::long_jump, &A::jumps, &A::skip, &A::destroy };
+    };
+    static const Vtbl v[4] = { make(SimdTier::Scalar), make(SimdTier::AVX2), make(SimdTier::AVX512F), make(SimdTier::AVX512VL) };
+    vt_ = &v[unsigned(tier)]; tier_ = tier;
+    state_ = new B(args...);
 }
-static void avx512_jump(void* p) noexcept { (void)p; /* optional */ }
-static void avx512_destroy(void* p) noexcept { delete static_cast<Xoshiro256ssAVX512*>(p); }
 
 // ---------------------------
-// Rng: ctor / dtor / moves
+// Tier selection: UA_FORCE_BACKEND=scalar|avx2|avx512|avx512vl, else CPUID.
+// AVX512VL (ymm) replaces AVX512F where zmm is known to lower the clock, or
+// when Init::avx512_ymm asks for it.
 // ---------------------------
-Rng::Rng(std::uint64_t seed) {
-    // UA_FORCE_BACKEND=scalar|avx2|avx512
+static SimdTier pick_tier(const Init& init) {
     const char* env = std::getenv("UA_FORCE_BACKEND");
     CpuFeatures f = query_cpu_features();
 
-    if ((env && eq_ci(env,"avx512")) || (!env && f.avx512f)) {
-        static const Vtbl v{ &avx512_gen_u64, &avx512_gen_double, &avx512_gen_normal, &avx512_jump, &avx512_destroy };
-        vt_ = &v; tier_ = SimdTier::AVX512F;
-        state_ = new Xoshiro256ssAVX512(seed);
-        return;
+    if (env) {
+        if (eq_ci(env,"avx512vl")) return SimdTier::AVX512VL;
+        if (eq_ci(env,"avx512"))   return SimdTier::AVX512F;
+        if (eq_ci(env,"avx2"))     return SimdTier::AVX2;
+        return SimdTier::Scalar;
     }
-    if ((env && eq_ci(env,"avx2")) || (!env && f.avx2)) {
-        static const Vtbl v{ &avx2_gen_u64, &avx2_gen_double, &avx2_gen_normal, &avx2_jump, &avx2_destroy };
-        vt_ = &v; tier_ = SimdTier::AVX2;
-        state_ = new Xoshiro256ssAVX2(seed);
-        return;
+    if (avx512_ok(f) && (init.avx512_ymm || f.avx512_zmm_slow)) return SimdTier::AVX512VL;
+    if (avx512_ok(f)) return SimdTier::AVX512F;
+    if (f.avx2)    return SimdTier::AVX2;
+    return SimdTier::Scalar;
+}
+
+SimdTier detail::kernel_tier() noexcept {
+    static const SimdTier t = pick_tier(Init{});
+    return t;
+}
+
+// ---------------------------
+// Rng: ctor / dtor / moves
+// ---------------------------
+Rng::Rng(std::uint64_t seed) : Rng(Init{ Algorithm::Xoshiro256ss, seed, 0 }) {}
+
+Rng::Rng(std::uint64_t seed, Algorithm algo) : Rng(Init{ algo, seed, 0 }) {}
+
+// every (algorithm, tier) pair maps to one backend
+Rng::Rng(const Init& init) : algo_(init.algo) {
+    const SimdTier tier = pick_tier(init);
+    // only xoshiro256** has an AVX512VL kernel; the rest run their ymm (AVX2) backend there
+    const SimdTier t = tier == SimdTier::AVX512VL ? SimdTier::AVX2 : tier;
+
+    switch (init.algo) {
+    case Algorithm::Philox4x32_10:
+        if (t == SimdTier::AVX512F)   bind<Philox4x32AVX512>(t, init.seed);
+        else if (t == SimdTier::AVX2) bind<Philox4x32AVX2Engine>(t, init.seed);
+        else                          bind<Philox4x32Scalar>(t, init.seed);
+        break;
+    case Algorithm::Xoroshiro128pp:
+        if (t == SimdTier::AVX512F)   bind<Xoroshiro128ppAVX512>(t, init.seed);
+        else if (t == SimdTier::AVX2) bind<Xoroshiro128ppAVX2>(t, init.seed);
+        else                          bind<Xoroshiro128ppScalar>(t, init.seed);
+        break;
+    case Algorithm::ChaCha20:
+    case Algorithm::ChaCha12:
+    case Algorithm::ChaCha8: {
+        const int rounds = init.algo == Algorithm::ChaCha20 ? 20 : init.algo == Algorithm::ChaCha12 ? 12 : 8;
+        std::uint32_t key[8];
+        if (init.key) std::memcpy(key, init.key, sizeof(key));
+        else          chacha_key_from_seed(init.seed, key);
+        const std::uint32_t* k = key;
+        if (t == SimdTier::AVX512F)   bind<ChaChaAVX512>(t, k, rounds);
+        else if (t == SimdTier::AVX2) bind<ChaChaAVX2>(t, k, rounds);
+        else                          bind<ChaChaScalar>(t, k, rounds);
+        break;
+    }
+    case Algorithm::Ars4x32_7: {
+        // wide VAES at the SIMD tiers, else 128-bit AES-NI, else the table fallback
+        const CpuFeatures f = query_cpu_features();
+        if (t == SimdTier::AVX512F && f.vaes)   bind<Ars4x32AVX512>(t, init.seed);
+        else if (t == SimdTier::AVX2 && f.vaes) bind<Ars4x32AVX2>(t, init.seed);
+        else if (f.aes)                         bind<Ars4x32AESNI>(SimdTier::Scalar, init.seed);
+        else                                    bind<Ars4x32Scalar>(SimdTier::Scalar, init.seed);
+        break;
     }
-    // Fallback: scalar
-    {
-        static const Vtbl v{ &scalar_gen_u64, &scalar_gen_double, &scalar_gen_normal, &scalar_jump, &scalar_destroy };
-        vt_ = &v; tier_ = SimdTier::Scalar;
-        state_ = new ScalarState(seed);
+    case Algorithm::Pcg64Dxsm:
+        if (t == SimdTier::AVX512F)   bind<Pcg64DxsmAVX512>(t, init.seed);
+        else if (t == SimdTier::AVX2) bind<Pcg64DxsmAVX2>(t, init.seed);
+        else                          bind<Pcg64DxsmScalar>(t, init.seed);
+        break;
+    case Algorithm::Xoshiro256ss:
+    default: {
+        algo_ = Algorithm::Xoshiro256ss;
+        // Init::interleave picks the K-register-set kernel on the AVX2 / AVX512F tiers
+        const unsigned k = init.interleave > 4 ? 4 : init.interleave;
+        if (tier == SimdTier::AVX512VL) {
+            bind<Xoshiro256ssAVX512VL>(tier, init.seed);
+        } else if (t == SimdTier::AVX512F) {
+            if (k == 4)      bind<Xoshiro256ssAVX512Interleaved<4>>(t, init.seed);
+            else if (k == 3) bind<Xoshiro256ssAVX512Interleaved<3>>(t, init.seed);
+            else if (k == 2) bind<Xoshiro256ssAVX512Interleaved<2>>(t, init.seed);
+            else             bind<Xoshiro256ssAVX512>(t, init.seed);
+        } else if (t == SimdTier::AVX2) {
+            if (k == 4)      bind<Xoshiro256ssAVX2Interleaved<4>>(t, init.seed);
+            else if (k == 3) bind<Xoshiro256ssAVX2Interleaved<3>>(t, init.seed);
+            else if (k == 2) bind<Xoshiro256ssAVX2Interleaved<2>>(t, init.seed);
+            else             bind<Xoshiro256ssAVX2>(t, init.seed);
+        } else {
+            bind<Xoshiro256ssScalar>(t, init.seed);
+        }
+        break;
     }
+    }
+
+    if (init.stream) vt_->jumps(state_, init.stream);
 }
 
 Rng::~Rng() {
@@ -116,6 +461,7 @@ Rng::Rng(Rng&& o) noexcept {
     vt_ = o.vt_; o.vt_ = nullptr;
     state_ = o.state_; o.state_ = nullptr;
     tier_ = o.tier_;
+    algo_ = o.algo_;
 }
 
 Rng& Rng::operator=(Rng&& o) noexcept {
@@ -124,6 +470,7 @@ Rng& Rng::operator=(Rng&& o) noexcept {
         vt_ = o.vt_; o.vt_ = nullptr;
         state_ = o.state_; o.state_ = nullptr;
         tier_ = o.tier_;
+        algo_ = o.algo_;
     }
     return *this;
 }
@@ -134,6 +481,48 @@ Rng& Rng::operator=(Rng&& o) noexcept {
 void Rng::generate_u64(std::uint64_t* out, std::size_t n) noexcept { vt_->gen_u64(state_, out, n); }
 void Rng::generate_double(double* out, std::size_t n) noexcept      { vt_->gen_double(state_, out, n); }
 void Rng::generate_normal(double* out, std::size_t n) noexcept      { vt_->gen_normal(state_, out, n); }
+void Rng::generate_float(float* out, std::size_t n) noexcept        { gen_float(*this, unit_float_for(tier_), out, n); }
+void Rng::generate_normal_float(float* out, std::size_t n) noexcept { gen_float(*this, normal_float_for(tier_), out, n); }
+void Rng::generate_normal_icdf(double* out, std::size_t n) noexcept { vt_->gen_normal_icdf(state_, out, n); }
+void Rng::generate_exponential(double* out, std::size_t n, double rate) noexcept { vt_->gen_exponential(state_, out, n, rate); }
+void Rng::generate_poisson(const double* lam, std::uint32_t* out, std::size_t n) noexcept {
+    PoissonGenerator<Rng> g(*this);
+    g.kernel = poisson_for(tier_);
+    g.generate(lam, out, n);
+}
+void Rng::generate_binomial(const std::uint32_t* trials, const double* p, std::uint32_t* out, std::size_t n) noexcept {
+    BinomialGenerator<Rng> g(*this);
+    g.kernel = binomial_for(tier_);
+    g.generate(trials, p, out, n);
+}
+void Rng::generate_uniform_int(std::uint64_t lo, std::uint64_t hi, std::uint32_t* out, std::size_t n) noexcept {
+    if (lo > hi || hi >> 32) return;   // not a u32 range: out untouched
+    const std::uint64_t s = hi - lo + 1;
+    if (s == std::uint64_t(1) << 32) {   // [0, 2^32 - 1]: the u64 stream as u32 halves, low half first
+        alignas(64) std::uint64_t u[INV_CHUNK];
+        for (std::size_t i = 0; i < n;) {
+            const std::size_t m = n - i < 2 * INV_CHUNK ? n - i : 2 * INV_CHUNK;
+            generate_u64(u, (m + 1) / 2);
+            for (std::size_t j = 0; j < m; ++j) out[i + j] = std::uint32_t(u[j / 2] >> (32 * (j & 1)));
+            i += m;
+        }
+        return;
+    }
+    gen_bounded<std::uint32_t>(*this, uniform_u32_for(tier_), std::uint32_t(lo), std::uint32_t(s), out, n);
+}
+void Rng::generate_uniform_int(std::uint64_t lo, std::uint64_t hi, std::uint64_t* out, std::size_t n) noexcept {
+    if (lo > hi) return;   // empty range: out untouched
+    const std::uint64_t s = hi - lo + 1;
+    if (s == 0) { generate_u64(out, n); return; }   // [0, 2^64 - 1]
+    gen_bounded<std::uint64_t>(*this, uniform_u64_for(tier_), lo, s, out, n);
+}
+void Rng::generate_categorical(const AliasTable& t, std::uint32_t* out, std::size_t n) noexcept {
+    AliasSampler<Rng> g(*this);
+    g.kernel = alias_for(tier_);
+    g.generate(t, out, n);
+}
 void Rng::jump() noexcept                                           { vt_->jump(state_); }
+void Rng::long_jump() noexcept                                      { vt_->long_jump(state_); }
+void Rng::skip_ahead(std::uint64_t n_lo, std::uint64_t n_hi) noexcept { vt_->skip(state_, n_lo, n_hi); }
 
 } // namespace ua
@@ -0,0 +1,72 @@
+// Portable (no ISA flags): scalar Lemire kernels for Rng::generate_uniform_int
+// and ua::Shuffler, and the per-value bound kernel choice.
+#include "ua/ua_uniform_int.h"
+#include "ua_kernel_tier.h"
+
+namespace ua::detail {
+
+namespace {
+
+// high and low 64 bits of a * b from 32x32->64 partial products
+inline std::uint64_t mul_wide(std::uint64_t a, std::uint64_t b, std::uint64_t& lo) noexcept {
+  const std::uint64_t a0 = a & 0xffffffffu, a1 = a >> 32, b0 = b & 0xffffffffu, b1 = b >> 32;
+  const std::uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+  const std::uint64_t mid = (p00 >> 32) + (p01 & 0xffffffffu) + (p10 & 0xffffffffu);
+  lo = (p00 & 0xffffffffu) | (mid << 32);
+  return p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+}
+
+} // namespace
+
+std::size_t uniform_u32_scalar(const std::uint64_t* x, std::size_t n, std::uint32_t lo, std::uint32_t s,
+                               std::uint32_t* out, std::uint32_t* miss) noexcept {
+  std::uint32_t t = 0;
+  bool have_t = false;
+  std::size_t r = 0;
+  for (std::size_t j = 0; j < n; ++j) {
+    const std::uint64_t m = ((x[j / 2] >> (32 * (j & 1))) & 0xffffffffu) * s;
+    const std::uint32_t l = static_cast<std::uint32_t>(m);
+    if (l < s) {
+      if (!have_t) { t = (0u - s) % s; have_t = true; }
+      if (l < t) { miss[r++] = static_cast<std::uint32_t>(j); continue; }
+    }
+    out[j] = lo + static_cast<std::uint32_t>(m >> 32);
+  }
+  return r;
+}
+
+std::size_t uniform_u64_scalar(const std::uint64_t* x, std::size_t n, std::uint64_t lo, std::uint64_t s,
+                               std::uint64_t* out, std::uint32_t* miss) noexcept {
+  std::uint64_t t = 0;
+  bool have_t = false;
+  std::size_t r = 0;
+  for (std::size_t j = 0; j < n; ++j) {
+    std::uint64_t l;
+    const std::uint64_t h = mul_wide(x[j], s, l);
+    if (l < s) {
+      if (!have_t) { t = (0 - s) % s; have_t = true; }
+      if (l < t) { miss[r++] = static_cast<std::uint32_t>(j); continue; }
+    }
+    out[j] = lo + h;
+  }
+  return r;
+}
+
+std::size_t uniform_bounds_scalar(const std::uint64_t* x, const std::uint32_t* s, std::size_t n,
+                                  std::uint32_t* out, std::uint32_t* miss) noexcept {
+  std::size_t r = 0;
+  for (std::size_t j = 0; j < n; ++j) {
+    const std::uint64_t m = ((x[j / 2] >> (32 * (j & 1))) & 0xffffffffu) * s[j];
+    const std::uint32_t l = static_cast<std::uint32_t>(m);
+    if (l < s[j] && l < (0u - s[j]) % s[j]) { miss[r++] = static_cast<std::uint32_t>(j); continue; }
+    out[j] = static_cast<std::uint32_t>(m >> 32);
+  }
+  return r;
+}
+
+UniformBoundsFn uniform_bounds_kernel() noexcept {
+  static const UniformBoundsFn k = kernel_for_tier(&uniform_bounds_scalar, &uniform_bounds_avx2, &uniform_bounds_avx512);
+  return k;
+}
+
+} // namespace ua::detail
@@ -0,0 +1,141 @@
+#include "ua/ua_uniform_int.h"
+#include <immintrin.h>
+#include <bit>
+
+namespace ua::detail {
+
+namespace {
+
+inline std::size_t push_misses(std::uint32_t* miss, std::size_t r, std::size_t base, unsigned m) noexcept {
+  for (; m; m &= m - 1) miss[r++] = static_cast<std::uint32_t>(base + std::countr_zero(m));
+  return r;
+}
+
+// 32-bit lanes of a with a < b (unsigned), as a movemask_ps bit mask
+inline unsigned below_u32(__m256i a, __m256i b) noexcept {
+  const __m256i ge = _mm256_cmpeq_epi32(_mm256_max_epu32(a, b), a);
+  return ~static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(ge))) & 0xFFu;
+}
+
+// 64-bit lanes of a with a < b (unsigned), as a movemask_pd bit mask
+inline unsigned below_u64(__m256i a, __m256i b) noexcept {
+  const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+  const __m256i lt = _mm256_cmpgt_epi64(_mm256_xor_si256(b, sign), _mm256_xor_si256(a, sign));
+  return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(lt)));
+}
+
+// 8 u32 values from 4 words: the even / odd halves times s, high halves
+// interleaved back into word order; low halves the same way into `low`
+inline __m256i lemire32(__m256i v, __m256i vs, __m256i& low) noexcept {
+  const __m256i pe = _mm256_mul_epu32(v, vs), po = _mm256_mul_epu32(_mm256_srli_epi64(v, 32), vs);
+  low = _mm256_blend_epi32(pe, _mm256_slli_epi64(po, 32), 0xAA);
+  return _mm256_blend_epi32(_mm256_srli_epi64(pe, 32), po, 0xAA);
+}
+
+// high and low words of v s, s = (sh:sl) 32-bit halves; Wide = sh != 0
+template<bool Wide>
+inline __m256i lemire64(__m256i v, __m256i sl, __m256i sh, __m256i& low) noexcept {
+  const __m256i m32 = _mm256_set1_epi64x(0xffffffffll);
+  const __m256i vh = _mm256_srli_epi64(v, 32);
+  const __m256i ll = _mm256_mul_epu32(v, sl), hl = _mm256_mul_epu32(vh, sl);
+  if constexpr (Wide) {
+    const __m256i lh = _mm256_mul_epu32(v, sh), hh = _mm256_mul_epu32(vh, sh);
+    const __m256i mid = _mm256_add_epi64(_mm256_add_epi64(_mm256_srli_epi64(ll, 32), _mm256_and_si256(lh, m32)),
+                                         _mm256_and_si256(hl, m32));
+    low = _mm256_or_si256(_mm256_slli_epi64(mid, 32), _mm256_and_si256(ll, m32));
+    return _mm256_add_epi64(_mm256_add_epi64(hh, _mm256_srli_epi64(lh, 32)),
+                            _mm256_add_epi64(_mm256_srli_epi64(hl, 32), _mm256_srli_epi64(mid, 32)));
+  } else {
+    const __m256i mid = _mm256_add_epi64(_mm256_srli_epi64(ll, 32), _mm256_and_si256(hl, m32));
+    low = _mm256_or_si256(_mm256_slli_epi64(mid, 32), _mm256_and_si256(ll, m32));
+    return _mm256_add_epi64(_mm256_srli_epi64(hl, 32), _mm256_srli_epi64(mid, 32));
+  }
+}
+
+template<bool Wide>
+std::size_t u64_kernel(const std::uint64_t* x, std::size_t n, std::uint64_t lo, std::uint64_t s,
+                       std::uint64_t* out, std::uint32_t* miss) noexcept {
+  const __m256i sl = _mm256_set1_epi64x(static_cast<long long>(s & 0xffffffffu));
+  const __m256i sh = _mm256_set1_epi64x(static_cast<long long>(s >> 32));
+  const __m256i vs = _mm256_set1_epi64x(static_cast<long long>(s));
+  const __m256i vlo = _mm256_set1_epi64x(static_cast<long long>(lo));
+  __m256i vt = _mm256_setzero_si256();
+  bool have_t = false;
+  std::size_t r = 0;
+  for (std::size_t j = 0; j < n; j += 4) {
+    const unsigned live = n - j >= 4 ? 0xFu : (1u << (n - j)) - 1;
+    const __m256i lm = _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(n - j < 4 ? n - j : 4)),
+                                          _mm256_setr_epi64x(0, 1, 2, 3));
+    __m256i low;
+    const __m256i h = lemire64<Wide>(_mm256_maskload_epi64(reinterpret_cast<const long long*>(x + j), lm), sl, sh, low);
+    _mm256_maskstore_epi64(reinterpret_cast<long long*>(out + j), lm, _mm256_add_epi64(h, vlo));
+    if (below_u64(low, vs) & live) {
+      if (!have_t) { vt = _mm256_set1_epi64x(static_cast<long long>((0 - s) % s)); have_t = true; }
+      r = push_misses(miss, r, j, below_u64(low, vt) & live);
+    }
+  }
+  return r;
+}
+
+} // namespace
+
+std::size_t uniform_u32_avx2(const std::uint64_t* x, std::size_t n, std::uint32_t lo, std::uint32_t s,
+                             std::uint32_t* out, std::uint32_t* miss) noexcept {
+  const __m256i vs = _mm256_set1_epi32(static_cast<int>(s));
+  const __m256i vlo = _mm256_set1_epi32(static_cast<int>(lo));
+  __m256i vt = _mm256_setzero_si256();
+  bool have_t = false;
+  std::size_t r = 0;
+  for (std::size_t j = 0; j < n; j += 8) {
+    const std::size_t left = n - j < 8 ? n - j : 8;
+    const unsigned live = (1u << left) - 1;
+    const __m256i words = _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>((left + 1) / 2)),
+                                             _mm256_setr_epi64x(0, 1, 2, 3));
+    const __m256i lm = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(left)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256i low;
+    const __m256i h = lemire32(_mm256_maskload_epi64(reinterpret_cast<const long long*>(x + j / 2), words), vs, low);
+    _mm256_maskstore_epi32(reinterpret_cast<int*>(out + j), lm, _mm256_add_epi32(h, vlo));
+    if (below_u32(low, vs) & live) {
+      if (!have_t) { vt = _mm256_set1_epi32(static_cast<int>((0u - s) % s)); have_t = true; }
+      r = push_misses(miss, r, j, below_u32(low, vt) & live);
+    }
+  }
+  return r;
+}
+
+std::size_t uniform_bounds_avx2(const std::uint64_t* x, const std::uint32_t* s, std::size_t n,
+                                std::uint32_t* out, std::uint32_t* miss) noexcept {
+  const __m256i iota = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  std::size_t r = 0;
+  for (std::size_t j = 0; j < n; j += 8) {
+    const std::size_t left = n - j < 8 ? n - j : 8;
+    const unsigned live = (1u << left) - 1;
+    const __m256i words = _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>((left + 1) / 2)),
+                                             _mm256_setr_epi64x(0, 1, 2, 3));
+    const __m256i lm = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(left)), iota);
+    const __m256i vs = _mm256_maskload_epi32(reinterpret_cast<const int*>(s + j), lm);
+    const __m256i v = _mm256_maskload_epi64(reinterpret_cast<const long long*>(x + j / 2), words);
+    // lemire32 with per-lane bounds: odd values take the odd bounds
+    const __m256i pe = _mm256_mul_epu32(v, vs);
+    const __m256i po = _mm256_mul_epu32(_mm256_srli_epi64(v, 32), _mm256_srli_epi64(vs, 32));
+    const __m256i low = _mm256_blend_epi32(pe, _mm256_slli_epi64(po, 32), 0xAA);
+    _mm256_maskstore_epi32(reinterpret_cast<int*>(out + j), lm, _mm256_blend_epi32(_mm256_srli_epi64(pe, 32), po, 0xAA));
+    unsigned m = below_u32(low, vs) & live;
+    if (m) {
+      alignas(32) std::uint32_t l[8];
+      _mm256_store_si256(reinterpret_cast<__m256i*>(l), low);
+      for (; m; m &= m - 1) {
+        const unsigned k = static_cast<unsigned>(std::countr_zero(m));
+        if (l[k] < (0u - s[j + k]) % s[j + k]) miss[r++] = static_cast<std::uint32_t>(j + k);
+      }
+    }
+  }
+  return r;
+}
+
+std::size_t uniform_u64_avx2(const std::uint64_t* x, std::size_t n, std::uint64_t lo, std::uint64_t s,
+                             std::uint64_t* out, std::uint32_t* miss) noexcept {
+  return (s >> 32) ? u64_kernel<true>(x, n, lo, s, out, miss) : u64_kernel<false>(x, n, lo, s, out, miss);
+}
+
+} // namespace ua::detail
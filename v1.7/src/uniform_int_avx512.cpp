@@ -0,0 +1,121 @@
+#include "ua/ua_uniform_int.h"
+#include <immintrin.h>
+#include <bit>
+
+namespace ua::detail {
+
+namespace {
+
+// the AVX2 kernels (uniform_int_avx2.cpp) on 16 u32 / 8 u64 lanes
+
+// lane indices base + k of the set bits of m, packed by vpcompressd
+inline std::size_t push_misses(std::uint32_t* miss, std::size_t r, std::size_t base, __mmask16 m) noexcept {
+  const __m512i iota = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  _mm512_mask_compressstoreu_epi32(miss + r, m, _mm512_add_epi32(iota, _mm512_set1_epi32(static_cast<int>(base))));
+  return r + std::popcount(static_cast<unsigned>(m));
+}
+
+inline __m512i lemire32(__m512i v, __m512i vs, __m512i& low) noexcept {
+  const __m512i pe = _mm512_mul_epu32(v, vs), po = _mm512_mul_epu32(_mm512_srli_epi64(v, 32), vs);
+  low = _mm512_mask_blend_epi32(0xAAAA, pe, _mm512_slli_epi64(po, 32));
+  return _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(pe, 32), po);
+}
+
+template<bool Wide>
+inline __m512i lemire64(__m512i v, __m512i sl, __m512i sh, __m512i& low) noexcept {
+  const __m512i m32 = _mm512_set1_epi64(0xffffffffll);
+  const __m512i vh = _mm512_srli_epi64(v, 32);
+  const __m512i ll = _mm512_mul_epu32(v, sl), hl = _mm512_mul_epu32(vh, sl);
+  if constexpr (Wide) {
+    const __m512i lh = _mm512_mul_epu32(v, sh), hh = _mm512_mul_epu32(vh, sh);
+    const __m512i mid = _mm512_add_epi64(_mm512_add_epi64(_mm512_srli_epi64(ll, 32), _mm512_and_si512(lh, m32)),
+                                         _mm512_and_si512(hl, m32));
+    low = _mm512_or_si512(_mm512_slli_epi64(mid, 32), _mm512_and_si512(ll, m32));
+    return _mm512_add_epi64(_mm512_add_epi64(hh, _mm512_srli_epi64(lh, 32)),
+                            _mm512_add_epi64(_mm512_srli_epi64(hl, 32), _mm512_srli_epi64(mid, 32)));
+  } else {
+    const __m512i mid = _mm512_add_epi64(_mm512_srli_epi64(ll, 32), _mm512_and_si512(hl, m32));
+    low = _mm512_or_si512(_mm512_slli_epi64(mid, 32), _mm512_and_si512(ll, m32));
+    return _mm512_add_epi64(_mm512_srli_epi64(hl, 32), _mm512_srli_epi64(mid, 32));
+  }
+}
+
+template<bool Wide>
+std::size_t u64_kernel(const std::uint64_t* x, std::size_t n, std::uint64_t lo, std::uint64_t s,
+                       std::uint64_t* out, std::uint32_t* miss) noexcept {
+  const __m512i sl = _mm512_set1_epi64(static_cast<long long>(s & 0xffffffffu));
+  const __m512i sh = _mm512_set1_epi64(static_cast<long long>(s >> 32));
+  const __m512i vs = _mm512_set1_epi64(static_cast<long long>(s));
+  const __m512i vlo = _mm512_set1_epi64(static_cast<long long>(lo));
+  __m512i vt = _mm512_setzero_si512();
+  bool have_t = false;
+  std::size_t r = 0;
+  for (std::size_t j = 0; j < n; j += 8) {
+    const __mmask8 live = n - j >= 8 ? __mmask8(0xFF) : __mmask8((1u << (n - j)) - 1);
+    __m512i low;
+    const __m512i h = lemire64<Wide>(_mm512_maskz_loadu_epi64(live, x + j), sl, sh, low);
+    _mm512_mask_storeu_epi64(out + j, live, _mm512_add_epi64(h, vlo));
+    if (_mm512_mask_cmplt_epu64_mask(live, low, vs)) {
+      if (!have_t) { vt = _mm512_set1_epi64(static_cast<long long>((0 - s) % s)); have_t = true; }
+      r = push_misses(miss, r, j, _mm512_mask_cmplt_epu64_mask(live, low, vt));
+    }
+  }
+  return r;
+}
+
+} // namespace
+
+std::size_t uniform_u32_avx512(const std::uint64_t* x, std::size_t n, std::uint32_t lo, std::uint32_t s,
+                               std::uint32_t* out, std::uint32_t* miss) noexcept {
+  const __m512i vs = _mm512_set1_epi32(static_cast<int>(s));
+  const __m512i vlo = _mm512_set1_epi32(static_cast<int>(lo));
+  __m512i vt = _mm512_setzero_si512();
+  bool have_t = false;
+  std::size_t r = 0;
+  for (std::size_t j = 0; j < n; j += 16) {
+    const std::size_t left = n - j < 16 ? n - j : 16;
+    const __mmask16 live = __mmask16((1u << left) - 1);
+    const __mmask8 words = __mmask8((1u << ((left + 1) / 2)) - 1);
+    __m512i low;
+    const __m512i h = lemire32(_mm512_maskz_loadu_epi64(words, x + j / 2), vs, low);
+    _mm512_mask_storeu_epi32(out + j, live, _mm512_add_epi32(h, vlo));
+    if (_mm512_mask_cmplt_epu32_mask(live, low, vs)) {
+      if (!have_t) { vt = _mm512_set1_epi32(static_cast<int>((0u - s) % s)); have_t = true; }
+      r = push_misses(miss, r, j, _mm512_mask_cmplt_epu32_mask(live, low, vt));
+    }
+  }
+  return r;
+}
+
+std::size_t uniform_bounds_avx512(const std::uint64_t* x, const std::uint32_t* s, std::size_t n,
+                                  std::uint32_t* out, std::uint32_t* miss) noexcept {
+  std::size_t r = 0;
+  for (std::size_t j = 0; j < n; j += 16) {
+    const std::size_t left = n - j < 16 ? n - j : 16;
+    const __mmask16 live = __mmask16((1u << left) - 1);
+    const __mmask8 words = __mmask8((1u << ((left + 1) / 2)) - 1);
+    const __m512i vs = _mm512_maskz_loadu_epi32(live, s + j);
+    const __m512i v = _mm512_maskz_loadu_epi64(words, x + j / 2);
+    const __m512i pe = _mm512_mul_epu32(v, vs);
+    const __m512i po = _mm512_mul_epu32(_mm512_srli_epi64(v, 32), _mm512_srli_epi64(vs, 32));
+    const __m512i low = _mm512_mask_blend_epi32(0xAAAA, pe, _mm512_slli_epi64(po, 32));
+    _mm512_mask_storeu_epi32(out + j, live, _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(pe, 32), po));
+    unsigned m = _mm512_mask_cmplt_epu32_mask(live, low, vs);
+    if (m) {
+      alignas(64) std::uint32_t l[16];
+      _mm512_store_si512(l, low);
+      for (; m; m &= m - 1) {
+        const unsigned k = static_cast<unsigned>(std::countr_zero(m));
+        if (l[k] < (0u - s[j + k]) % s[j + k]) miss[r++] = static_cast<std::uint32_t>(j + k);
+      }
+    }
+  }
+  return r;
+}
+
+std::size_t uniform_u64_avx512(const std::uint64_t* x, std::size_t n, std::uint64_t lo, std::uint64_t s,
+                               std::uint64_t* out, std::uint32_t* miss) noexcept {
+  return (s >> 32) ? u64_kernel<true>(x, n, lo, s, out, miss) : u64_kernel<false>(x, n, lo, s, out, miss);
+}
+
+} // namespace ua::detail
@@ -0,0 +1,145 @@
+#include "ua/ua_xoroshiro128pp_avx2.h"
+#include "ua/ua_xoroshiro128pp.h"
+#include "ua/ua_xoroshiro128pp_jump.h"
+#include "ua_math_avx2.h"
+
+namespace ua::detail {
+
+// ----------------------------------------
+// helpers
+// ----------------------------------------
+static inline __m256i rotl64(__m256i x, int k) noexcept {
+  return _mm256_or_si256(_mm256_slli_epi64(x, k), _mm256_srli_epi64(x, 64 - k));
+}
+static inline __m256d to_unit_pd(__m256i v) noexcept {
+  const __m256i bits = _mm256_or_si256(_mm256_srli_epi64(v, 12), _mm256_set1_epi64x(0x3FF0000000000000LL));
+  return _mm256_sub_pd(_mm256_castsi256_pd(bits), _mm256_set1_pd(1.0));
+}
+
+// ----------------------------------------
+// state & core PRNG
+// ----------------------------------------
+Xoroshiro128ppAVX2::Xoroshiro128ppAVX2(std::uint64_t seed) noexcept {
+  auto sm64 = [](std::uint64_t& v) {
+    v += 0x9e3779b97f4a7c15ull;
+    std::uint64_t z = v;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  };
+  std::uint64_t x = seed;
+  alignas(32) std::uint64_t tmp[2 * LANES];
+  for (int lane = 0; lane < LANES; ++lane) {
+    tmp[lane]         = sm64(x);
+    tmp[lane + LANES] = sm64(x);
+  }
+  s0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(tmp));
+  s1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(tmp + LANES));
+}
+
+__m256i Xoroshiro128ppAVX2::next_u64_vec() noexcept {
+  const __m256i res = _mm256_add_epi64(rotl64(_mm256_add_epi64(s0, s1), 17), s0);
+  s1 = _mm256_xor_si256(s1, s0);
+  s0 = _mm256_xor_si256(_mm256_xor_si256(rotl64(s0, 49), s1), _mm256_slli_epi64(s1, 21));
+  s1 = rotl64(s1, 28);
+  return res;
+}
+
+// state transition only (no scrambler) for the jump loops
+void Xoroshiro128ppAVX2::advance_vec() noexcept {
+  s1 = _mm256_xor_si256(s1, s0);
+  s0 = _mm256_xor_si256(_mm256_xor_si256(rotl64(s0, 49), s1), _mm256_slli_epi64(s1, 21));
+  s1 = rotl64(s1, 28);
+}
+
+// Same polynomial on all lanes: uniform branch, vector XOR-accumulate.
+void Xoroshiro128ppAVX2::jump_with(const std::uint64_t (&poly)[2]) noexcept {
+  __m256i a0 = _mm256_setzero_si256(), a1 = _mm256_setzero_si256();
+  for (int i = 0; i < 2; ++i) {
+    for (int b = 0; b < 64; ++b) {
+      if (poly[i] & (1ull << b)) {
+        a0 = _mm256_xor_si256(a0, s0);
+        a1 = _mm256_xor_si256(a1, s1);
+      }
+      advance_vec();
+    }
+  }
+  s0 = a0; s1 = a1;
+}
+
+void Xoroshiro128ppAVX2::jump() noexcept      { jump_with(Xoroshiro128ppScalar::JUMP); }
+void Xoroshiro128ppAVX2::long_jump() noexcept { jump_with(Xoroshiro128ppScalar::LONG_JUMP); }
+
+void Xoroshiro128ppAVX2::skip_ahead(std::uint64_t lo, std::uint64_t hi) noexcept {
+  if (hi == 0 && lo < 128) { while (lo--) advance_vec(); return; }
+  std::uint64_t poly[2];
+  xoroshiro128_jump_poly(lo, hi, poly);
+  jump_with(poly);
+}
+
+void Xoroshiro128ppAVX2::lane_state(int lane, std::uint64_t st[2]) const noexcept {
+  alignas(32) std::uint64_t t[2][LANES];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(t[0]), s0);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(t[1]), s1);
+  st[0] = t[0][lane & (LANES - 1)];
+  st[1] = t[1][lane & (LANES - 1)];
+}
+
+// ----------------------------------------
+// bulk generators (unrolled 4x: 16 u64 per loop)
+// ----------------------------------------
+void Xoroshiro128ppAVX2::generate_u64(std::uint64_t* out, std::size_t n) noexcept {
+  std::size_t i = 0;
+  while (i + 4 * LANES <= n) {
+    const __m256i v0 = next_u64_vec(), v1 = next_u64_vec();
+    const __m256i v2 = next_u64_vec(), v3 = next_u64_vec();
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),             v0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + LANES),     v1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 2 * LANES), v2);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 3 * LANES), v3);
+    i += 4 * LANES;
+  }
+  while (i + LANES <= n) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), next_u64_vec());
+    i += LANES;
+  }
+  if (i < n) {
+    alignas(32) std::uint64_t tmp[LANES];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(tmp), next_u64_vec());
+    for (; i < n; ++i) out[i] = tmp[i & (LANES - 1)];
+  }
+}
+
+void Xoroshiro128ppAVX2::generate_double(double* out, std::size_t n) noexcept {
+  std::size_t i = 0;
+  while (i + 4 * LANES <= n) {
+    const __m256d d0 = to_unit_pd(next_u64_vec()), d1 = to_unit_pd(next_u64_vec());
+    const __m256d d2 = to_unit_pd(next_u64_vec()), d3 = to_unit_pd(next_u64_vec());
+    _mm256_storeu_pd(out + i,             d0);
+    _mm256_storeu_pd(out + i + LANES,     d1);
+    _mm256_storeu_pd(out + i + 2 * LANES, d2);
+    _mm256_storeu_pd(out + i + 3 * LANES, d3);
+    i += 4 * LANES;
+  }
+  while (i + LANES <= n) {
+    _mm256_storeu_pd(out + i, to_unit_pd(next_u64_vec()));
+    i += LANES;
+  }
+  if (i < n) {
+    alignas(32) double tmp[LANES];
+    _mm256_store_pd(tmp, to_unit_pd(next_u64_vec()));
+    for (; i < n; ++i) out[i] = tmp[i & (LANES - 1)];
+  }
+}
+
+// Fully vectorized Marsaglia polar (see ua_polar_emit_pd in ua_math_avx2.h).
+void Xoroshiro128ppAVX2::generate_normal(double* out, std::size_t n) noexcept {
+  std::size_t i = 0;
+  while (i < n) {
+    const __m256i uu = next_u64_vec();
+    const __m256i vv = next_u64_vec();
+    ua_polar_emit_pd(uu, vv, out, i, n);
+  }
+}
+
+} // namespace ua::detail
@@ -0,0 +1,145 @@
+#include "ua/ua_xoroshiro128pp_avx512.h"
+#include "ua/ua_xoroshiro128pp.h"
+#include "ua/ua_xoroshiro128pp_jump.h"
+#include "ua_math_avx512.h"
+
+namespace ua::detail {
+
+// ----------------------------------------
+// helpers
+// ----------------------------------------
+static inline __m512i rotl64(__m512i x, int k) noexcept {
+  return _mm512_or_si512(_mm512_slli_epi64(x, k), _mm512_srli_epi64(x, 64 - k));
+}
+static inline __m512d to_unit_pd(__m512i v) noexcept {
+  const __m512i bits = _mm512_or_si512(_mm512_srli_epi64(v, 12), _mm512_set1_epi64(0x3FF0000000000000LL));
+  return _mm512_sub_pd(_mm512_castsi512_pd(bits), _mm512_set1_pd(1.0));
+}
+
+// ----------------------------------------
+// state & core PRNG
+// ----------------------------------------
+Xoroshiro128ppAVX512::Xoroshiro128ppAVX512(std::uint64_t seed) noexcept {
+  auto sm64 = [](std::uint64_t& v) {
+    v += 0x9e3779b97f4a7c15ull;
+    std::uint64_t z = v;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  };
+  std::uint64_t x = seed;
+  alignas(64) std::uint64_t tmp[2 * LANES];
+  for (int lane = 0; lane < LANES; ++lane) {
+    tmp[lane]         = sm64(x);
+    tmp[lane + LANES] = sm64(x);
+  }
+  s0 = _mm512_load_si512(reinterpret_cast<const void*>(tmp));
+  s1 = _mm512_load_si512(reinterpret_cast<const void*>(tmp + LANES));
+}
+
+__m512i Xoroshiro128ppAVX512::next_u64_vec() noexcept {
+  const __m512i res = _mm512_add_epi64(rotl64(_mm512_add_epi64(s0, s1), 17), s0);
+  s1 = _mm512_xor_si512(s1, s0);
+  s0 = _mm512_xor_si512(_mm512_xor_si512(rotl64(s0, 49), s1), _mm512_slli_epi64(s1, 21));
+  s1 = rotl64(s1, 28);
+  return res;
+}
+
+// state transition only (no scrambler) for the jump loops
+void Xoroshiro128ppAVX512::advance_vec() noexcept {
+  s1 = _mm512_xor_si512(s1, s0);
+  s0 = _mm512_xor_si512(_mm512_xor_si512(rotl64(s0, 49), s1), _mm512_slli_epi64(s1, 21));
+  s1 = rotl64(s1, 28);
+}
+
+// Same polynomial on all lanes: uniform branch, vector XOR-accumulate.
+void Xoroshiro128ppAVX512::jump_with(const std::uint64_t (&poly)[2]) noexcept {
+  __m512i a0 = _mm512_setzero_si512(), a1 = _mm512_setzero_si512();
+  for (int i = 0; i < 2; ++i) {
+    for (int b = 0; b < 64; ++b) {
+      if (poly[i] & (1ull << b)) {
+        a0 = _mm512_xor_si512(a0, s0);
+        a1 = _mm512_xor_si512(a1, s1);
+      }
+      advance_vec();
+    }
+  }
+  s0 = a0; s1 = a1;
+}
+
+void Xoroshiro128ppAVX512::jump() noexcept      { jump_with(Xoroshiro128ppScalar::JUMP); }
+void Xoroshiro128ppAVX512::long_jump() noexcept { jump_with(Xoroshiro128ppScalar::LONG_JUMP); }
+
+void Xoroshiro128ppAVX512::skip_ahead(std::uint64_t lo, std::uint64_t hi) noexcept {
+  if (hi == 0 && lo < 128) { while (lo--) advance_vec(); return; }
+  std::uint64_t poly[2];
+  xoroshiro128_jump_poly(lo, hi, poly);
+  jump_with(poly);
+}
+
+void Xoroshiro128ppAVX512::lane_state(int lane, std::uint64_t st[2]) const noexcept {
+  alignas(64) std::uint64_t t[2][LANES];
+  _mm512_store_si512(reinterpret_cast<void*>(t[0]), s0);
+  _mm512_store_si512(reinterpret_cast<void*>(t[1]), s1);
+  st[0] = t[0][lane & (LANES - 1)];
+  st[1] = t[1][lane & (LANES - 1)];
+}
+
+// ----------------------------------------
+// bulk generators (unrolled 4x: 32 u64 per loop)
+// ----------------------------------------
+void Xoroshiro128ppAVX512::generate_u64(std::uint64_t* out, std::size_t n) noexcept {
+  std::size_t i = 0;
+  while (i + 4 * LANES <= n) {
+    const __m512i v0 = next_u64_vec(), v1 = next_u64_vec();
+    const __m512i v2 = next_u64_vec(), v3 = next_u64_vec();
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + i),             v0);
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + i + LANES),     v1);
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + i + 2 * LANES), v2);
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + i + 3 * LANES), v3);
+    i += 4 * LANES;
+  }
+  while (i + LANES <= n) {
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + i), next_u64_vec());
+    i += LANES;
+  }
+  if (i < n) {
+    alignas(64) std::uint64_t tmp[LANES];
+    _mm512_store_si512(reinterpret_cast<void*>(tmp), next_u64_vec());
+    for (; i < n; ++i) out[i] = tmp[i & (LANES - 1)];
+  }
+}
+
+void Xoroshiro128ppAVX512::generate_double(double* out, std::size_t n) noexcept {
+  std::size_t i = 0;
+  while (i + 4 * LANES <= n) {
+    const __m512d d0 = to_unit_pd(next_u64_vec()), d1 = to_unit_pd(next_u64_vec());
+    const __m512d d2 = to_unit_pd(next_u64_vec()), d3 = to_unit_pd(next_u64_vec());
+    _mm512_storeu_pd(out + i,             d0);
+    _mm512_storeu_pd(out + i + LANES,     d1);
+    _mm512_storeu_pd(out + i + 2 * LANES, d2);
+    _mm512_storeu_pd(out + i + 3 * LANES, d3);
+    i += 4 * LANES;
+  }
+  while (i + LANES <= n) {
+    _mm512_storeu_pd(out + i, to_unit_pd(next_u64_vec()));
+    i += LANES;
+  }
+  if (i < n) {
+    alignas(64) double tmp[LANES];
+    _mm512_store_pd(tmp, to_unit_pd(next_u64_vec()));
+    for (; i < n; ++i) out[i] = tmp[i & (LANES - 1)];
+  }
+}
+
+// Fully vectorized Marsaglia polar (see ua_polar_emit_pd in ua_math_avx512.h).
+void Xoroshiro128ppAVX512::generate_normal(double* out, std::size_t n) noexcept {
+  std::size_t i = 0;
+  while (i < n) {
+    const __m512i uu = next_u64_vec();
+    const __m512i vv = next_u64_vec();
+    ua_polar_emit_pd(uu, vv, out, i, n);
+  }
+}
+
+} // namespace ua::detail
@@ -0,0 +1,82 @@
+// Portable (no ISA flags): shared by every xoroshiro128++ backend.
+#include "ua/ua_xoroshiro128pp_jump.h"
+
+namespace ua::detail {
+
+// P(x) = x^128 + PLOW(x); derived with Berlekamp–Massey from the linear
+// engine and checked against the reference tables:
+// x^(2^64) mod P == JUMP, x^(2^96) mod P == LONG_JUMP.
+static constexpr std::uint64_t PLOW[2] = {
+  0x8dae70779760b081ULL, 0x0031bcf2f855d6e5ULL
+};
+
+// 64x64 -> 128 carry-less multiply (portable shift/xor)
+static inline void clmul64(std::uint64_t a, std::uint64_t b,
+                           std::uint64_t& lo, std::uint64_t& hi) noexcept {
+  std::uint64_t l = 0, h = 0;
+  for (int i = 0; i < 64; ++i) {
+    if ((b >> i) & 1u) {
+      l ^= a << i;
+      if (i) h ^= a >> (64 - i);
+    }
+  }
+  lo = l; hi = h;
+}
+
+// r = a*b mod P over GF(2); r may alias a or b
+static void mulmod(const std::uint64_t a[2], const std::uint64_t b[2], std::uint64_t r[2]) noexcept {
+  std::uint64_t t[4] = {0,0,0,0};
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      std::uint64_t lo, hi;
+      clmul64(a[i], b[j], lo, hi);
+      t[i + j]     ^= lo;
+      t[i + j + 1] ^= hi;
+    }
+  }
+  // fold x^k (k >= 128) into x^(k-128) * PLOW, top bit first
+  for (int k = 255; k >= 128; --k) {
+    if (!((t[k >> 6] >> (k & 63)) & 1u)) continue;
+    t[k >> 6] ^= 1ull << (k & 63);
+    const int sh = k - 128, ws = sh >> 6, bs = sh & 63;
+    for (int w = 0; w < 2; ++w) {
+      t[w + ws] ^= PLOW[w] << bs;
+      if (bs) t[w + ws + 1] ^= PLOW[w] >> (64 - bs);
+    }
+  }
+  r[0] = t[0]; r[1] = t[1];
+}
+
+namespace {
+
+// x^(2^k) mod P for k = 0..127, built once (thread-safe static init);
+// TU-local so the per-engine tables cannot collide at link time
+struct Pow2Table {
+  std::uint64_t p[128][2];
+  Pow2Table() noexcept {
+    std::uint64_t x[2] = {2u, 0u}; // x^1
+    for (int k = 0; k < 128; ++k) {
+      p[k][0] = x[0]; p[k][1] = x[1];
+      mulmod(x, x, x);
+    }
+  }
+};
+
+} // namespace
+
+static const Pow2Table& pow2_table() noexcept {
+  static const Pow2Table t;
+  return t;
+}
+
+void xoroshiro128_jump_poly(std::uint64_t lo, std::uint64_t hi, std::uint64_t poly[2]) noexcept {
+  const Pow2Table& t = pow2_table();
+  std::uint64_t r[2] = {1u, 0u}; // x^0
+  for (int k = 0; k < 64; ++k)
+    if ((lo >> k) & 1u) mulmod(r, t.p[k], r);
+  for (int k = 0; k < 64; ++k)
+    if ((hi >> k) & 1u) mulmod(r, t.p[64 + k], r);
+  poly[0] = r[0]; poly[1] = r[1];
+}
+
+} // namespace ua::detail
@@ -1,7 +1,11 @@
 // D:/code/Universal-Architecture-RNG-Lib/v1.7/src/xoshiro256ss_avx2.cpp
 #include "ua/ua_xoshiro256ss_avx2.h"
+#include "ua/ua_xoshiro256ss_scalar.h"
+#include "ua/ua_xoshiro256ss_jump.h"
+#include "ua_math_avx2.h"
 #include <cmath>
 #include <cstring>
+#include <utility>
 
 namespace ua::detail {
 
@@ -25,87 +29,28 @@ static inline __m256i mullo64(__m256i a, std::uint64_t c) noexcept {
   return _mm256_add_epi64(lo, mid_shift);
 }
 
-// int64 -> double (vectorized), AVX2-only (no AVX-512VL)
-static inline __m256d cvtepi64_pd_avx2(__m256i v64) noexcept {
-  alignas(32) long long ei64[4];
-  _mm256_store_si256(reinterpret_cast<__m256i*>(ei64), v64);
-  int ei32[4] = {
-    static_cast<int>(ei64[0]),
-    static_cast<int>(ei64[1]),
-    static_cast<int>(ei64[2]),
-    static_cast<int>(ei64[3])
-  };
-  __m128i v01 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&ei32[0])); // 2x i32
-  __m128i v23 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&ei32[2])); // 2x i32
-  __m128d d01 = _mm_cvtepi32_pd(v01); // -> 2x double
-  __m128d d23 = _mm_cvtepi32_pd(v23);
-  return _mm256_set_m128d(d23, d01); // [d23 | d01]
-}
-
-// range-reduced ln(x): x = m * 2^e, m in [1,2); ln(x) = ln(m) + e*ln2
-// ln(m) via 5th-order polynomial around 1: y=m-1 in [0,1)
-// range-reduced ln(x): robust to subnormals.
-// Normal path: bit-decompose x = m*2^e with m in [1,2), ln(x)=ln(m)+e*ln2
-// Subnormal path: fallback to scalar std::log for those lanes only.
-static inline __m256d ua_log_rr_pd(__m256d x) noexcept {
-  const __m256i mant_mask = _mm256_set1_epi64x(0x000FFFFFFFFFFFFFULL);
-  const __m256i exp_mask  = _mm256_set1_epi64x(0x7FF);
-  const __m256i exp_1023  = _mm256_set1_epi64x(1023LL);
-  const __m256i exp_1023_bits = _mm256_slli_epi64(_mm256_set1_epi64x(1023LL), 52);
-  const __m256d one = _mm256_set1_pd(1.0);
-  const __m256d ln2 = _mm256_set1_pd(0.693147180559945309417232121458176568);
-
-  __m256i ibits   = _mm256_castpd_si256(x);
-  __m256i exp_raw = _mm256_and_si256(_mm256_srli_epi64(ibits, 52), exp_mask);
-  __m256i is_sub  = _mm256_cmpeq_epi64(exp_raw, _mm256_setzero_si256()); // subnormal if exp==0
-
-  // normal (non-subnormal) lane math
-  __m256i e_i64      = _mm256_sub_epi64(exp_raw, exp_1023); // e = exp - 1023
-  __m256i mant_bits  = _mm256_or_si256(_mm256_and_si256(ibits, mant_mask), exp_1023_bits);
-  __m256d m          = _mm256_castsi256_pd(mant_bits);      // m in [1,2)
-  __m256d y          = _mm256_sub_pd(m, one);
-  __m256d y2         = _mm256_mul_pd(y, y);
-  __m256d y3         = _mm256_mul_pd(y2, y);
-  __m256d y4         = _mm256_mul_pd(y2, y2);
-  __m256d y5         = _mm256_mul_pd(y4, y);
-  __m256d ln_m_poly  = _mm256_add_pd(y,
-                        _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(-0.5), y2),
-                        _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd( 1.0/3.0), y3),
-                        _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(-0.25   ), y4),
-                                      _mm256_mul_pd(_mm256_set1_pd( 0.2     ), y5)))));
-
-  // convert e_i64 -> double (AVX2-safe helper from earlier)
-  __m256d e = cvtepi64_pd_avx2(e_i64);
-  __m256d ln_norm = _mm256_add_pd(ln_m_poly, _mm256_mul_pd(e, ln2));
-
-  // subnormal fallback (scalar std::log for those lanes)
-  int submask = _mm256_movemask_pd(_mm256_castsi256_pd(is_sub));
-  if (submask != 0) {
-    alignas(32) double xv[4], lv[4];
-    _mm256_store_pd(xv, x);
-    // initialize lv with normal result, then patch sub lanes
-    _mm256_store_pd(lv, ln_norm);
-    for (int lane = 0; lane < 4; ++lane) {
-      if ((submask >> lane) & 1) {
-        lv[lane] = std::log(xv[lane]);
-      }
-    }
-    ln_norm = _mm256_load_pd(lv);
+// rotl(s1*5, 7)*9 with the chosen multiply kernel
+template<XoshiroScrambler S>
+static inline __m256i scramble(__m256i s1) noexcept {
+  if constexpr (S == XoshiroScrambler::Emulated) {
+    return mullo64(rotl64(mullo64(s1, 5u), 7), 9u);
+  } else {
+    const __m256i t = _mm256_add_epi64(_mm256_slli_epi64(s1, 2), s1);
+    const __m256i r = rotl64(t, 7);
+    return _mm256_add_epi64(_mm256_slli_epi64(r, 3), r);
   }
-
-  return ln_norm;
 }
 
-// add near other helpers at file top (inside the same namespace scope as other helpers)
-static inline __m256d ua_sqrt_pd_safe(__m256d x) noexcept {
-  // native double sqrt: robust and still fast
-  return _mm256_sqrt_pd(x);
+// no vpmullq on ymm without AVX-512VL/DQ in this TU: shift-add everywhere
+static inline XoshiroScrambler resolve_scrambler(XoshiroScrambler s) noexcept {
+  return s == XoshiroScrambler::Emulated ? s : XoshiroScrambler::ShiftAdd;
 }
 
 // ----------------------------------------
 // state & core PRNG
 // ----------------------------------------
-Xoshiro256ssAVX2::Xoshiro256ssAVX2(std::uint64_t seed) noexcept {
+Xoshiro256ssAVX2::Xoshiro256ssAVX2(std::uint64_t seed, XoshiroScrambler scr) noexcept
+  : scr_(resolve_scrambler(scr)) {
   auto sm64 = [](std::uint64_t& v) {
     v += 0x9e3779b97f4a7c15ull;
     std::uint64_t z = v;
@@ -127,9 +72,9 @@ Xoshiro256ssAVX2::Xoshiro256ssAVX2(std::uint64_t seed) noexcept {
   s3 = _mm256_set_epi64x(tmp[15], tmp[11], tmp[7], tmp[3]);
 }
 
+template<XoshiroScrambler S>
 __m256i Xoshiro256ssAVX2::next_u64_vec() noexcept {
-  __m256i t1 = mullo64(s1, 5u);
-  __m256i res = mullo64(rotl64(t1, 7), 9u);
+  __m256i res = scramble<S>(s1);
   __m256i t = _mm256_slli_epi64(s1, 17);
   s2 = _mm256_xor_si256(s2, s0);
   s3 = _mm256_xor_si256(s3, s1);
@@ -140,25 +85,76 @@ __m256i Xoshiro256ssAVX2::next_u64_vec() noexcept {
   return res;
 }
 
-void Xoshiro256ssAVX2::generate_u64(std::uint64_t* out, std::size_t n) noexcept {
+// state transition only (no scrambler) for the jump loops
+void Xoshiro256ssAVX2::advance_vec() noexcept {
+  __m256i t = _mm256_slli_epi64(s1, 17);
+  s2 = _mm256_xor_si256(s2, s0);
+  s3 = _mm256_xor_si256(s3, s1);
+  s1 = _mm256_xor_si256(s1, s2);
+  s0 = _mm256_xor_si256(s0, s3);
+  s2 = _mm256_xor_si256(s2, t);
+  s3 = rotl64(s3, 45);
+}
+
+// The jump polynomial is identical for every lane, so the bit test is a
+// uniform branch and all 4 lanes are accumulated with plain vector XORs.
+void Xoshiro256ssAVX2::jump_with(const std::uint64_t (&poly)[4]) noexcept {
+  __m256i a0 = _mm256_setzero_si256(), a1 = _mm256_setzero_si256();
+  __m256i a2 = _mm256_setzero_si256(), a3 = _mm256_setzero_si256();
+  for (int i = 0; i < 4; ++i) {
+    for (int b = 0; b < 64; ++b) {
+      if (poly[i] & (1ull << b)) {
+        a0 = _mm256_xor_si256(a0, s0);
+        a1 = _mm256_xor_si256(a1, s1);
+        a2 = _mm256_xor_si256(a2, s2);
+        a3 = _mm256_xor_si256(a3, s3);
+      }
+      advance_vec();
+    }
+  }
+  s0 = a0; s1 = a1; s2 = a2; s3 = a3;
+}
+
+void Xoshiro256ssAVX2::jump() noexcept      { jump_with(Xoshiro256ssScalar::JUMP); }
+void Xoshiro256ssAVX2::long_jump() noexcept { jump_with(Xoshiro256ssScalar::LONG_JUMP); }
+
+void Xoshiro256ssAVX2::skip_ahead(std::uint64_t lo, std::uint64_t hi) noexcept {
+  if (hi == 0 && lo < 256) { while (lo--) advance_vec(); return; }
+  std::uint64_t poly[4];
+  xoshiro256_jump_poly(lo, hi, poly);
+  jump_with(poly);
+}
+
+void Xoshiro256ssAVX2::lane_state(int lane, std::uint64_t st[4]) const noexcept {
+  alignas(32) std::uint64_t t[4][4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(t[0]), s0);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(t[1]), s1);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(t[2]), s2);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(t[3]), s3);
+  for (int w = 0; w < 4; ++w) st[w] = t[w][lane & 3];
+}
+
+template<XoshiroScrambler S>
+void Xoshiro256ssAVX2::u64_impl(std::uint64_t* out, std::size_t n) noexcept {
   std::size_t i = 0;
   while (i + 4 <= n) {
-    __m256i v = next_u64_vec();
+    __m256i v = next_u64_vec<S>();
     _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
     i += 4;
   }
   if (i < n) {
     alignas(32) std::uint64_t tmp[4];
-    _mm256_store_si256(reinterpret_cast<__m256i*>(tmp), next_u64_vec());
+    _mm256_store_si256(reinterpret_cast<__m256i*>(tmp), next_u64_vec<S>());
     for (; i < n; ++i) out[i] = tmp[i & 3];
   }
 }
 
-void Xoshiro256ssAVX2::generate_double(double* out, std::size_t n) noexcept {
+template<XoshiroScrambler S>
+void Xoshiro256ssAVX2::double_impl(double* out, std::size_t n) noexcept {
   constexpr std::uint64_t EXP = 0x3FFull << 52;
   std::size_t i = 0;
   while (i + 4 <= n) {
-    __m256i u = _mm256_srli_epi64(next_u64_vec(), 12);
+    __m256i u = _mm256_srli_epi64(next_u64_vec<S>(), 12);
     __m256i bits = _mm256_or_si256(u, _mm256_set1_epi64x(EXP));
     __m256d d = _mm256_sub_pd(_mm256_castsi256_pd(bits), _mm256_set1_pd(1.0));
     _mm256_storeu_pd(out + i, d);
@@ -166,7 +162,7 @@ void Xoshiro256ssAVX2::generate_double(double* out, std::size_t n) noexcept {
   }
   if (i < n) {
     alignas(32) double tmp[4];
-    __m256i u = _mm256_srli_epi64(next_u64_vec(), 12);
+    __m256i u = _mm256_srli_epi64(next_u64_vec<S>(), 12);
     __m256i bits = _mm256_or_si256(u, _mm256_set1_epi64x(EXP));
     __m256d d = _mm256_sub_pd(_mm256_castsi256_pd(bits), _mm256_set1_pd(1.0));
     _mm256_store_pd(tmp, d);
@@ -174,83 +170,203 @@ void Xoshiro256ssAVX2::generate_double(double* out, std::size_t n) noexcept {
   }
 }
 
-// Fully vectorized Marsaglia polar with masked-accept compaction.
-// Uses range-reduced ln(s) and NR sqrt for speed & accuracy.
-// REPLACE the whole function with this
-// k = sqrt( -2*ln(s) / s ) with robust ln + clamping
-// REPLACE the whole function with this exact version
-void Xoshiro256ssAVX2::generate_normal(double* out, std::size_t n) noexcept {
+// Fully vectorized Marsaglia polar (see ua_polar_emit_pd in ua_math_avx2.h).
+template<XoshiroScrambler S>
+void Xoshiro256ssAVX2::normal_impl(double* out, std::size_t n) noexcept {
   std::size_t i = 0;
-
-  const __m256d one   = _mm256_set1_pd(1.0);
-  const __m256d zero  = _mm256_set1_pd(0.0);
-  const __m256i EXP   = _mm256_set1_epi64x(0x3FFull << 52);
-  const __m256d s_min = _mm256_set1_pd(1e-300); // reject ultra-tiny s
-
-  alignas(32) double zu[4], zv[4];
-
   while (i < n) {
-    // two uniforms in (-1,1) via bit tricks (no divides)
-    __m256i uu = _mm256_srli_epi64(next_u64_vec(), 12);
-    __m256i vv = _mm256_srli_epi64(next_u64_vec(), 12);
-    __m256d a  = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(uu, EXP)), one);
-    __m256d b  = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(vv, EXP)), one);
-    __m256d u  = _mm256_sub_pd(_mm256_add_pd(a, a), one);
-    __m256d v  = _mm256_sub_pd(_mm256_add_pd(b, b), one);
-
-    // s = u^2 + v^2
-    __m256d s  = _mm256_add_pd(_mm256_mul_pd(u,u), _mm256_mul_pd(v,v));
-
-    // accept mask: 0 < s < 1 and s >= s_min
-    __m256d m_gt0   = _mm256_cmp_pd(s, zero,  _CMP_GT_OQ);
-    __m256d m_lt1   = _mm256_cmp_pd(s, one,   _CMP_LT_OQ);
-    __m256d m_geMin = _mm256_cmp_pd(s, s_min, _CMP_GT_OQ);
-    __m256d m_ok    = _mm256_and_pd(_mm256_and_pd(m_gt0, m_lt1), m_geMin);
-    int mask        = _mm256_movemask_pd(m_ok);
-    if (mask == 0) continue;
-
-    // safe s (avoid log(0) and division by 0 in rejected lanes)
-    __m256d s_safe  = _mm256_blendv_pd(one, s, m_ok);
-
-    // k = sqrt( -2*ln(s) / s ) with robust ln + clamping to avoid NaNs/Infs
-    __m256d num     = _mm256_mul_pd(_mm256_set1_pd(-2.0), ua_log_rr_pd(s_safe));
-    __m256d frac    = _mm256_div_pd(num, s_safe);
-    __m256d fracpos = _mm256_max_pd(frac, _mm256_set1_pd(0.0));
-    __m256d fraccl  = _mm256_min_pd(fracpos, _mm256_set1_pd(1e300));
-    __m256d k       = ua_sqrt_pd_safe(fraccl);
-
-    // z = u*k , v*k
-    __m256d zu_vec = _mm256_mul_pd(u, k);
-    __m256d zv_vec = _mm256_mul_pd(v, k);
-
-    // sanitize (zero non-finite lanes), then store to stack
-    __m256d ord_u = _mm256_cmp_pd(zu_vec, zu_vec, _CMP_ORD_Q);
-    __m256d ord_v = _mm256_cmp_pd(zv_vec, zv_vec, _CMP_ORD_Q);
-    zu_vec = _mm256_blendv_pd(_mm256_set1_pd(0.0), zu_vec, ord_u);
-    zv_vec = _mm256_blendv_pd(_mm256_set1_pd(0.0), zv_vec, ord_v);
-
-    _mm256_store_pd(zu, zu_vec);
-    _mm256_store_pd(zv, zv_vec);
-
-  // compact accepted lanes into the output (no per-sample scalar isfinite)
-// we already sanitized zu_vec/zv_vec with vector ORD mask prior to _mm256_store_pd
-for (int lane = 0; lane < 4 && i < n; ++lane) {
-  if ((mask >> lane) & 1) {
-    out[i++] = zu[lane];
-    if (i < n) out[i++] = zv[lane];
+    __m256i uu = next_u64_vec<S>();
+    __m256i vv = next_u64_vec<S>();
+    ua_polar_emit_pd(uu, vv, out, i, n);
   }
 }
 
+// one switch per call; the loops themselves are specialized per kernel
+void Xoshiro256ssAVX2::generate_u64(std::uint64_t* out, std::size_t n) noexcept {
+  switch (scr_) {
+    case XoshiroScrambler::Emulated: u64_impl<XoshiroScrambler::Emulated>(out, n); break;
+    default:                         u64_impl<XoshiroScrambler::ShiftAdd>(out, n); break;
+  }
 }
-
+void Xoshiro256ssAVX2::generate_double(double* out, std::size_t n) noexcept {
+  switch (scr_) {
+    case XoshiroScrambler::Emulated: double_impl<XoshiroScrambler::Emulated>(out, n); break;
+    default:                         double_impl<XoshiroScrambler::ShiftAdd>(out, n); break;
+  }
+}
+void Xoshiro256ssAVX2::generate_normal(double* out, std::size_t n) noexcept {
+  switch (scr_) {
+    case XoshiroScrambler::Emulated: normal_impl<XoshiroScrambler::Emulated>(out, n); break;
+    default:                         normal_impl<XoshiroScrambler::ShiftAdd>(out, n); break;
+  }
 }
 
 double Xoshiro256ssAVX2::uniform_scalar() noexcept {
   constexpr std::uint64_t EXP = 0x3FFull << 52;
   alignas(32) std::uint64_t tmp[4];
-  _mm256_store_si256(reinterpret_cast<__m256i*>(tmp), _mm256_srli_epi64(next_u64_vec(), 12));
+  _mm256_store_si256(reinterpret_cast<__m256i*>(tmp), _mm256_srli_epi64(next_u64_vec<XoshiroScrambler::ShiftAdd>(), 12));
   std::uint64_t bits = tmp[0] | EXP;
   double d; std::memcpy(&d, &bits, sizeof(d)); return d - 1.0;
 }
 
+// ----------------------------------------
+// interleaved register sets
+// ----------------------------------------
+namespace {
+
+// one xoshiro256** step on one register set
+inline __m256i step_set(__m256i& s0, __m256i& s1, __m256i& s2, __m256i& s3) noexcept {
+  const __m256i res = scramble<XoshiroScrambler::ShiftAdd>(s1);
+  const __m256i t = _mm256_slli_epi64(s1, 17);
+  s2 = _mm256_xor_si256(s2, s0);
+  s3 = _mm256_xor_si256(s3, s1);
+  s1 = _mm256_xor_si256(s1, s2);
+  s0 = _mm256_xor_si256(s0, s3);
+  s2 = _mm256_xor_si256(s2, t);
+  s3 = rotl64(s3, 45);
+  return res;
+}
+
+inline void advance_set(__m256i& s0, __m256i& s1, __m256i& s2, __m256i& s3) noexcept {
+  const __m256i t = _mm256_slli_epi64(s1, 17);
+  s2 = _mm256_xor_si256(s2, s0);
+  s3 = _mm256_xor_si256(s3, s1);
+  s1 = _mm256_xor_si256(s1, s2);
+  s0 = _mm256_xor_si256(s0, s3);
+  s2 = _mm256_xor_si256(s2, t);
+  s3 = rotl64(s3, 45);
+}
+
+inline __m256d to_unit_pd(__m256i v) noexcept {
+  const __m256i bits = _mm256_or_si256(_mm256_srli_epi64(v, 12), _mm256_set1_epi64x(0x3FF0000000000000LL));
+  return _mm256_sub_pd(_mm256_castsi256_pd(bits), _mm256_set1_pd(1.0));
+}
+
+// f(0), f(1), ..., f(K-1), expanded at compile time so the sets stay in registers
+template<int K, class F>
+inline void for_each_set(F&& f) noexcept {
+  [&]<int... J>(std::integer_sequence<int, J...>) { (f(J), ...); }(std::make_integer_sequence<int, K>{});
+}
+
+} // namespace
+
+template<int K>
+Xoshiro256ssAVX2Interleaved<K>::Xoshiro256ssAVX2Interleaved(std::uint64_t seed) noexcept {
+  auto sm64 = [](std::uint64_t& v) {
+    v += 0x9e3779b97f4a7c15ull;
+    std::uint64_t z = v;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  };
+  std::uint64_t x = seed;
+  alignas(32) std::uint64_t tmp[4][LANES];   // word w of global lane g
+  for (int g = 0; g < LANES; ++g)
+    for (int w = 0; w < 4; ++w) tmp[w][g] = sm64(x);
+  for (int j = 0; j < K; ++j) {
+    s0[j] = _mm256_load_si256(reinterpret_cast<const __m256i*>(tmp[0] + 4 * j));
+    s1[j] = _mm256_load_si256(reinterpret_cast<const __m256i*>(tmp[1] + 4 * j));
+    s2[j] = _mm256_load_si256(reinterpret_cast<const __m256i*>(tmp[2] + 4 * j));
+    s3[j] = _mm256_load_si256(reinterpret_cast<const __m256i*>(tmp[3] + 4 * j));
+  }
+}
+
+template<int K>
+void Xoshiro256ssAVX2Interleaved<K>::jump_with(const std::uint64_t (&poly)[4]) noexcept {
+  __m256i a0[K], a1[K], a2[K], a3[K];
+  for (int j = 0; j < K; ++j) a0[j] = a1[j] = a2[j] = a3[j] = _mm256_setzero_si256();
+  for (int i = 0; i < 4; ++i) {
+    for (int b = 0; b < 64; ++b) {
+      const bool take = (poly[i] >> b) & 1u;
+      for_each_set<K>([&](int j) {
+        if (take) {
+          a0[j] = _mm256_xor_si256(a0[j], s0[j]);
+          a1[j] = _mm256_xor_si256(a1[j], s1[j]);
+          a2[j] = _mm256_xor_si256(a2[j], s2[j]);
+          a3[j] = _mm256_xor_si256(a3[j], s3[j]);
+        }
+        advance_set(s0[j], s1[j], s2[j], s3[j]);
+      });
+    }
+  }
+  for (int j = 0; j < K; ++j) { s0[j] = a0[j]; s1[j] = a1[j]; s2[j] = a2[j]; s3[j] = a3[j]; }
+}
+
+template<int K> void Xoshiro256ssAVX2Interleaved<K>::jump() noexcept      { jump_with(Xoshiro256ssScalar::JUMP); }
+template<int K> void Xoshiro256ssAVX2Interleaved<K>::long_jump() noexcept { jump_with(Xoshiro256ssScalar::LONG_JUMP); }
+
+template<int K>
+void Xoshiro256ssAVX2Interleaved<K>::skip_ahead(std::uint64_t lo, std::uint64_t hi) noexcept {
+  if (hi == 0 && lo < 256) {
+    while (lo--) for_each_set<K>([&](int j) { advance_set(s0[j], s1[j], s2[j], s3[j]); });
+    return;
+  }
+  std::uint64_t poly[4];
+  xoshiro256_jump_poly(lo, hi, poly);
+  jump_with(poly);
+}
+
+template<int K>
+void Xoshiro256ssAVX2Interleaved<K>::lane_state(int lane, std::uint64_t st[4]) const noexcept {
+  const int j = (lane / 4) % K, k = lane % 4;
+  alignas(32) std::uint64_t t[4][4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(t[0]), s0[j]);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(t[1]), s1[j]);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(t[2]), s2[j]);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(t[3]), s3[j]);
+  for (int w = 0; w < 4; ++w) st[w] = t[w][k];
+}
+
+// Each step issues K independent xoshiro updates back to back; the state is
+// copied to locals so the K sets live in registers for the whole loop.
+template<int K>
+void Xoshiro256ssAVX2Interleaved<K>::generate_u64(std::uint64_t* out, std::size_t n) noexcept {
+  __m256i a[K], b[K], c[K], d[K];
+  for (int j = 0; j < K; ++j) { a[j] = s0[j]; b[j] = s1[j]; c[j] = s2[j]; d[j] = s3[j]; }
+  std::size_t i = 0;
+  for (; i + LANES <= n; i += LANES)
+    for_each_set<K>([&](int j) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 4 * j), step_set(a[j], b[j], c[j], d[j])); });
+  if (i < n) {
+    alignas(32) std::uint64_t tmp[LANES];
+    for_each_set<K>([&](int j) { _mm256_store_si256(reinterpret_cast<__m256i*>(tmp + 4 * j), step_set(a[j], b[j], c[j], d[j])); });
+    for (std::size_t t = 0; i < n; ++i, ++t) out[i] = tmp[t];
+  }
+  for (int j = 0; j < K; ++j) { s0[j] = a[j]; s1[j] = b[j]; s2[j] = c[j]; s3[j] = d[j]; }
+}
+
+template<int K>
+void Xoshiro256ssAVX2Interleaved<K>::generate_double(double* out, std::size_t n) noexcept {
+  __m256i a[K], b[K], c[K], d[K];
+  for (int j = 0; j < K; ++j) { a[j] = s0[j]; b[j] = s1[j]; c[j] = s2[j]; d[j] = s3[j]; }
+  std::size_t i = 0;
+  for (; i + LANES <= n; i += LANES)
+    for_each_set<K>([&](int j) { _mm256_storeu_pd(out + i + 4 * j, to_unit_pd(step_set(a[j], b[j], c[j], d[j]))); });
+  if (i < n) {
+    alignas(32) double tmp[LANES];
+    for_each_set<K>([&](int j) { _mm256_store_pd(tmp + 4 * j, to_unit_pd(step_set(a[j], b[j], c[j], d[j]))); });
+    for (std::size_t t = 0; i < n; ++i, ++t) out[i] = tmp[t];
+  }
+  for (int j = 0; j < K; ++j) { s0[j] = a[j]; s1[j] = b[j]; s2[j] = c[j]; s3[j] = d[j]; }
+}
+
+// polar pairs: set j supplies (u, v) from two consecutive draws; sets are
+// drawn together and emitted in order 0..K-1
+template<int K>
+void Xoshiro256ssAVX2Interleaved<K>::generate_normal(double* out, std::size_t n) noexcept {
+  __m256i a[K], b[K], c[K], d[K];
+  for (int j = 0; j < K; ++j) { a[j] = s0[j]; b[j] = s1[j]; c[j] = s2[j]; d[j] = s3[j]; }
+  std::size_t i = 0;
+  while (i < n) {
+    __m256i uu[K], vv[K];
+    for_each_set<K>([&](int j) { uu[j] = step_set(a[j], b[j], c[j], d[j]); });
+    for_each_set<K>([&](int j) { vv[j] = step_set(a[j], b[j], c[j], d[j]); });
+    for (int j = 0; j < K; ++j) ua_polar_emit_pd(uu[j], vv[j], out, i, n);
+  }
+  for (int j = 0; j < K; ++j) { s0[j] = a[j]; s1[j] = b[j]; s2[j] = c[j]; s3[j] = d[j]; }
+}
+
+template struct Xoshiro256ssAVX2Interleaved<2>;
+template struct Xoshiro256ssAVX2Interleaved<3>;
+template struct Xoshiro256ssAVX2Interleaved<4>;
+
 } // namespace ua::detail
@@ -1,79 +1,58 @@
 // D:/code/Universal-Architecture-RNG-Lib/v1.7/src/xoshiro256ss_avx512.cpp
 #include "ua/ua_xoshiro256ss_avx512.h"
+#include "ua/ua_xoshiro256ss_scalar.h"
+#include "ua/ua_xoshiro256ss_jump.h"
+#include "ua_math_avx512.h"
 #include <cmath>
 #include <cstring>
+#include <utility>
 
 namespace ua::detail {
 
 // ----------------------------------------
 // helpers
 // ----------------------------------------
-static inline __m512i rotl64(__m512i x, int k) noexcept {
-  return _mm512_ternarylogic_epi64(
-    _mm512_slli_epi64(x, k),
-    _mm512_srli_epi64(x, 64 - k),
-    _mm512_setzero_si512(),
-    0xF8
-  );
+// native vprolq; the count is an immediate, so it is a template argument
+template<int K>
+static inline __m512i rotl64(__m512i x) noexcept {
+  return _mm512_rol_epi64(x, K);
 }
 static inline __m512i mullo64(__m512i a, std::uint64_t c) noexcept {
   return _mm512_mullo_epi64(a, _mm512_set1_epi64((long long)c));
 }
+// AVX-512F only: low 64 bits from three 32x32 partial products
+static inline __m512i mullo64_emul(__m512i a, std::uint64_t c) noexcept {
+  const __m512i clo = _mm512_set1_epi64((long long)(c & 0xFFFFFFFFu));
+  const __m512i chi = _mm512_set1_epi64((long long)(c >> 32));
+  const __m512i lo  = _mm512_mul_epu32(a, clo);
+  const __m512i mid = _mm512_add_epi64(_mm512_mul_epu32(a, chi), _mm512_mul_epu32(_mm512_srli_epi64(a, 32), clo));
+  return _mm512_add_epi64(lo, _mm512_slli_epi64(mid, 32));
+}
 
-// range-reduced ln(x): x = m * 2^e, m in [1,2); ln(x) = ln(m) + e*ln2
-static inline __m512d ua_log_rr_pd(__m512d x) noexcept {
-  const __m512i mant_mask = _mm512_set1_epi64((long long)0x000FFFFFFFFFFFFFULL);
-  const __m512i exp_mask  = _mm512_set1_epi64(0x7FF);
-  const __m512i exp_1023  = _mm512_set1_epi64(1023);
-  const __m512i exp_1023_bits = _mm512_slli_epi64(_mm512_set1_epi64(1023), 52);
-  const __m512d one = _mm512_set1_pd(1.0);
-  const __m512d ln2 = _mm512_set1_pd(0.693147180559945309417232121458176568);
-
-  __m512i ibits   = _mm512_castpd_si512(x);
-  __m512i exp_raw = _mm512_and_si512(_mm512_srli_epi64(ibits, 52), exp_mask);
-  __mmask8 m_sub  = _mm512_cmpeq_epi64_mask(exp_raw, _mm512_setzero_si512());
-
-  __m512i e_i64     = _mm512_sub_epi64(exp_raw, exp_1023);
-  __m512i mant_bits = _mm512_or_si512(_mm512_and_si512(ibits, mant_mask), exp_1023_bits);
-  __m512d m         = _mm512_castsi512_pd(mant_bits);
-  __m512d y         = _mm512_sub_pd(m, one);
-  __m512d y2        = _mm512_mul_pd(y, y);
-  __m512d y3        = _mm512_mul_pd(y2, y);
-  __m512d y4        = _mm512_mul_pd(y2, y2);
-  __m512d y5        = _mm512_mul_pd(y4, y);
-  __m512d ln_m_poly = _mm512_add_pd(y,
-                         _mm512_add_pd(_mm512_mul_pd(_mm512_set1_pd(-0.5), y2),
-                         _mm512_add_pd(_mm512_mul_pd(_mm512_set1_pd( 1.0/3.0), y3),
-                         _mm512_add_pd(_mm512_mul_pd(_mm512_set1_pd(-0.25   ), y4),
-                                       _mm512_mul_pd(_mm512_set1_pd( 0.2     ), y5)))));
-
-  __m512d e      = _mm512_cvtepi64_pd(e_i64);
-  __m512d ln_norm = _mm512_add_pd(ln_m_poly, _mm512_mul_pd(e, ln2));
-
-  if (m_sub) {
-    alignas(64) double xv[8], lv[8];
-    _mm512_store_pd(xv, x);
-    _mm512_store_pd(lv, ln_norm);
-    for (int lane = 0; lane < 8; ++lane) {
-      if ((m_sub >> lane) & 1) {
-        lv[lane] = std::log(xv[lane]);
-      }
-    }
-    ln_norm = _mm512_load_pd(lv);
+// rotl(s1*5, 7)*9 with the chosen multiply kernel
+template<XoshiroScrambler S>
+static inline __m512i scramble(__m512i s1) noexcept {
+  if constexpr (S == XoshiroScrambler::Mullo) {
+    return mullo64(rotl64<7>(mullo64(s1, 5u)), 9u);
+  } else if constexpr (S == XoshiroScrambler::Emulated) {
+    return mullo64_emul(rotl64<7>(mullo64_emul(s1, 5u)), 9u);
+  } else {
+    const __m512i t = _mm512_add_epi64(_mm512_slli_epi64(s1, 2), s1);
+    const __m512i r = rotl64<7>(t);
+    return _mm512_add_epi64(_mm512_slli_epi64(r, 3), r);
   }
-
-  return ln_norm;
 }
 
-// add near other helpers at file top (inside same namespace scope)
-static inline __m512d ua_sqrt_pd_safe(__m512d x) noexcept {
-  return _mm512_sqrt_pd(x);
+// the AVX512F tier requires AVX-512DQ (avx512_ok), so vpmullq is always there
+static inline XoshiroScrambler resolve_scrambler(XoshiroScrambler s) noexcept {
+  return s == XoshiroScrambler::Auto ? XoshiroScrambler::Mullo : s;
 }
 
 // ----------------------------------------
 // state & core PRNG
 // ----------------------------------------
-Xoshiro256ssAVX512::Xoshiro256ssAVX512(std::uint64_t seed) noexcept {
+Xoshiro256ssAVX512::Xoshiro256ssAVX512(std::uint64_t seed, XoshiroScrambler scr) noexcept
+  : scr_(resolve_scrambler(scr)) {
   auto sm64 = [](std::uint64_t& v) {
     v += 0x9e3779b97f4a7c15ull;
     std::uint64_t z = v;
@@ -95,125 +74,306 @@ Xoshiro256ssAVX512::Xoshiro256ssAVX512(std::uint64_t seed) noexcept {
   s3 = _mm512_set_epi64(tmp[30],tmp[22],tmp[14],tmp[6], tmp[31],tmp[23],tmp[15],tmp[7]);
 }
 
+template<XoshiroScrambler S>
 __m512i Xoshiro256ssAVX512::next_u64_vec() noexcept {
-  __m512i t1 = mullo64(s1, 5u);
-  __m512i res = mullo64(rotl64(t1, 7), 9u);
+  __m512i res = scramble<S>(s1);
   __m512i t = _mm512_slli_epi64(s1, 17);
   s2 = _mm512_xor_si512(s2, s0);
   s3 = _mm512_xor_si512(s3, s1);
   s1 = _mm512_xor_si512(s1, s2);
   s0 = _mm512_xor_si512(s0, s3);
   s2 = _mm512_xor_si512(s2, t);
-  s3 = rotl64(s3, 45);
+  s3 = rotl64<45>(s3);
   return res;
 }
 
-void Xoshiro256ssAVX512::generate_u64(std::uint64_t* out, std::size_t n) noexcept {
-  std::size_t i = 0;
-  while (i + 8 <= n) {
-    __m512i v = next_u64_vec();
-    _mm512_storeu_si512(reinterpret_cast<void*>(out + i), v);
-    i += 8;
-  }
-  if (i < n) {
-    alignas(64) std::uint64_t tmp[8];
-    _mm512_store_si512(reinterpret_cast<void*>(tmp), next_u64_vec());
-    for (; i < n; ++i) out[i] = tmp[i & 7];
+// state transition only (no scrambler) for the jump loops
+void Xoshiro256ssAVX512::advance_vec() noexcept {
+  __m512i t = _mm512_slli_epi64(s1, 17);
+  s2 = _mm512_xor_si512(s2, s0);
+  s3 = _mm512_xor_si512(s3, s1);
+  s1 = _mm512_xor_si512(s1, s2);
+  s0 = _mm512_xor_si512(s0, s3);
+  s2 = _mm512_xor_si512(s2, t);
+  s3 = rotl64<45>(s3);
+}
+
+// Same polynomial on all 8 lanes: uniform branch, vector XOR-accumulate.
+void Xoshiro256ssAVX512::jump_with(const std::uint64_t (&poly)[4]) noexcept {
+  __m512i a0 = _mm512_setzero_si512(), a1 = _mm512_setzero_si512();
+  __m512i a2 = _mm512_setzero_si512(), a3 = _mm512_setzero_si512();
+  for (int i = 0; i < 4; ++i) {
+    for (int b = 0; b < 64; ++b) {
+      if (poly[i] & (1ull << b)) {
+        a0 = _mm512_xor_si512(a0, s0);
+        a1 = _mm512_xor_si512(a1, s1);
+        a2 = _mm512_xor_si512(a2, s2);
+        a3 = _mm512_xor_si512(a3, s3);
+      }
+      advance_vec();
+    }
   }
+  s0 = a0; s1 = a1; s2 = a2; s3 = a3;
 }
 
-void Xoshiro256ssAVX512::generate_double(double* out, std::size_t n) noexcept {
-  constexpr std::uint64_t EXP = 0x3FFull << 52;
+void Xoshiro256ssAVX512::jump() noexcept      { jump_with(Xoshiro256ssScalar::JUMP); }
+void Xoshiro256ssAVX512::long_jump() noexcept { jump_with(Xoshiro256ssScalar::LONG_JUMP); }
+
+void Xoshiro256ssAVX512::skip_ahead(std::uint64_t lo, std::uint64_t hi) noexcept {
+  if (hi == 0 && lo < 256) { while (lo--) advance_vec(); return; }
+  std::uint64_t poly[4];
+  xoshiro256_jump_poly(lo, hi, poly);
+  jump_with(poly);
+}
+
+void Xoshiro256ssAVX512::lane_state(int lane, std::uint64_t st[4]) const noexcept {
+  alignas(64) std::uint64_t t[4][8];
+  _mm512_store_si512(reinterpret_cast<void*>(t[0]), s0);
+  _mm512_store_si512(reinterpret_cast<void*>(t[1]), s1);
+  _mm512_store_si512(reinterpret_cast<void*>(t[2]), s2);
+  _mm512_store_si512(reinterpret_cast<void*>(t[3]), s3);
+  for (int w = 0; w < 4; ++w) st[w] = t[w][lane & 7];
+}
+
+// first r (< 8) lanes, for the masked tail stores
+static inline __mmask8 tail_mask(std::size_t r) noexcept {
+  return (__mmask8)((1u << r) - 1u);
+}
+static inline __m512d to_unit_pd(__m512i v) noexcept {
+  const __m512i bits = _mm512_or_epi64(_mm512_srli_epi64(v, 12), _mm512_set1_epi64((long long)(0x3FFull << 52)));
+  return _mm512_sub_pd(_mm512_castsi512_pd(bits), _mm512_set1_pd(1.0));
+}
+
+// 4 vectors (32 u64) per iteration, then single vectors, then one masked
+// store for n % 8: no scalar tail loop
+template<XoshiroScrambler S>
+void Xoshiro256ssAVX512::u64_impl(std::uint64_t* out, std::size_t n) noexcept {
   std::size_t i = 0;
-  while (i + 8 <= n) {
-    __m512i u    = _mm512_srli_epi64(next_u64_vec(), 12);
-    __m512i bits = _mm512_or_epi64(u, _mm512_set1_epi64((long long)EXP));
-    __m512d d    = _mm512_sub_pd(_mm512_castsi512_pd(bits), _mm512_set1_pd(1.0));
-    _mm512_storeu_pd(out + i, d);
-    i += 8;
-  }
-  if (i < n) {
-    alignas(64) double tmp[8];
-    __m512i u    = _mm512_srli_epi64(next_u64_vec(), 12);
-    __m512i bits = _mm512_or_epi64(u, _mm512_set1_epi64((long long)EXP));
-    __m512d d    = _mm512_sub_pd(_mm512_castsi512_pd(bits), _mm512_set1_pd(1.0));
-    _mm512_store_pd(tmp, d);
-    for (; i < n; ++i) out[i] = tmp[i & 7];
+  for (; i + 32 <= n; i += 32) {
+    const __m512i v0 = next_u64_vec<S>(), v1 = next_u64_vec<S>();
+    const __m512i v2 = next_u64_vec<S>(), v3 = next_u64_vec<S>();
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + i),      v0);
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + i + 8),  v1);
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + i + 16), v2);
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + i + 24), v3);
   }
+  for (; i + 8 <= n; i += 8)
+    _mm512_storeu_si512(reinterpret_cast<void*>(out + i), next_u64_vec<S>());
+  if (i < n) _mm512_mask_storeu_epi64(out + i, tail_mask(n - i), next_u64_vec<S>());
 }
 
-// Fully vectorized Marsaglia polar with masked-accept + range-reduced log & NR sqrt.
-// REPLACE the whole function with this
-// REPLACE the whole function with this exact version
-void Xoshiro256ssAVX512::generate_normal(double* out, std::size_t n) noexcept {
+template<XoshiroScrambler S>
+void Xoshiro256ssAVX512::double_impl(double* out, std::size_t n) noexcept {
   std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m512d d0 = to_unit_pd(next_u64_vec<S>()), d1 = to_unit_pd(next_u64_vec<S>());
+    const __m512d d2 = to_unit_pd(next_u64_vec<S>()), d3 = to_unit_pd(next_u64_vec<S>());
+    _mm512_storeu_pd(out + i,      d0);
+    _mm512_storeu_pd(out + i + 8,  d1);
+    _mm512_storeu_pd(out + i + 16, d2);
+    _mm512_storeu_pd(out + i + 24, d3);
+  }
+  for (; i + 8 <= n; i += 8)
+    _mm512_storeu_pd(out + i, to_unit_pd(next_u64_vec<S>()));
+  if (i < n) _mm512_mask_storeu_pd(out + i, tail_mask(n - i), to_unit_pd(next_u64_vec<S>()));
+}
 
-  const __m512d one   = _mm512_set1_pd(1.0);
-  const __m512d zero  = _mm512_set1_pd(0.0);
-  const __m512i EXP   = _mm512_set1_epi64((long long)(0x3FFull << 52));
-  const __m512d s_min = _mm512_set1_pd(1e-300); // reject ultra-tiny s
-
-  alignas(64) double zu[8], zv[8];
+// Fully vectorized Marsaglia polar (see ua_polar_emit_pd in ua_math_avx512.h).
+template<XoshiroScrambler S>
+void Xoshiro256ssAVX512::normal_impl(double* out, std::size_t n) noexcept {
+  std::size_t i = 0;
 
   while (i < n) {
-    // two uniforms in (-1,1) via bit tricks (no divides)
-    __m512i uu = _mm512_srli_epi64(next_u64_vec(), 12);
-    __m512i vv = _mm512_srli_epi64(next_u64_vec(), 12);
-    __m512d a  = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_epi64(uu, EXP)), one);
-    __m512d b  = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_epi64(vv, EXP)), one);
-    __m512d u  = _mm512_sub_pd(_mm512_add_pd(a, a), one);
-    __m512d v  = _mm512_sub_pd(_mm512_add_pd(b, b), one);
-
-    // s = u^2 + v^2
-    __m512d s  = _mm512_add_pd(_mm512_mul_pd(u,u), _mm512_mul_pd(v,v));
-
-    // accept mask: 0 < s < 1 and s >= s_min
-    __mmask8 m_ok = _mm512_kand(
-        _mm512_kand(_mm512_cmp_pd_mask(s, zero, _CMP_GT_OQ),
-                    _mm512_cmp_pd_mask(s, one,  _CMP_LT_OQ)),
-        _mm512_cmp_pd_mask(s, s_min, _CMP_GT_OQ));
-
-    if (m_ok == 0) continue;
-
-    // safe s for rejected lanes
-    __m512d s_safe = _mm512_mask_mov_pd(one, m_ok, s);
-
-    // k = sqrt( -2*ln(s) / s ) with robust ln + clamping
-    __m512d num     = _mm512_mul_pd(_mm512_set1_pd(-2.0), ua_log_rr_pd(s_safe));
-    __m512d frac    = _mm512_div_pd(num, s_safe);
-    __m512d fracpos = _mm512_max_pd(frac, _mm512_set1_pd(0.0));
-    __m512d fraccl  = _mm512_min_pd(fracpos, _mm512_set1_pd(1e300));
-    __m512d k       = ua_sqrt_pd_safe(fraccl);
-
-    __m512d zu_vec = _mm512_mul_pd(u, k);
-    __m512d zv_vec = _mm512_mul_pd(v, k);
-
-    // sanitize (zero non-finite lanes), then store to stack
-    __mmask8 ord_u = _mm512_cmp_pd_mask(zu_vec, zu_vec, _CMP_ORD_Q);
-    __mmask8 ord_v = _mm512_cmp_pd_mask(zv_vec, zv_vec, _CMP_ORD_Q);
-    zu_vec = _mm512_mask_mov_pd(_mm512_set1_pd(0.0), ord_u, zu_vec);
-    zv_vec = _mm512_mask_mov_pd(_mm512_set1_pd(0.0), ord_v, zv_vec);
-
-    _mm512_store_pd(zu, zu_vec);
-    _mm512_store_pd(zv, zv_vec);
-
-for (int lane = 0; lane < 8 && i < n; ++lane) {
-  if ((m_ok >> lane) & 1) {
-    out[i++] = zu[lane];
-    if (i < n) out[i++] = zv[lane];
+    __m512i uu = next_u64_vec<S>();
+    __m512i vv = next_u64_vec<S>();
+    ua_polar_emit_pd(uu, vv, out, i, n);
   }
 }
 
+// one switch per call; the loops themselves are specialized per kernel
+void Xoshiro256ssAVX512::generate_u64(std::uint64_t* out, std::size_t n) noexcept {
+  switch (scr_) {
+    case XoshiroScrambler::Mullo:    u64_impl<XoshiroScrambler::Mullo>(out, n); break;
+    case XoshiroScrambler::Emulated: u64_impl<XoshiroScrambler::Emulated>(out, n); break;
+    default:                         u64_impl<XoshiroScrambler::ShiftAdd>(out, n); break;
+  }
 }
-
+void Xoshiro256ssAVX512::generate_double(double* out, std::size_t n) noexcept {
+  switch (scr_) {
+    case XoshiroScrambler::Mullo:    double_impl<XoshiroScrambler::Mullo>(out, n); break;
+    case XoshiroScrambler::Emulated: double_impl<XoshiroScrambler::Emulated>(out, n); break;
+    default:                         double_impl<XoshiroScrambler::ShiftAdd>(out, n); break;
+  }
+}
+void Xoshiro256ssAVX512::generate_normal(double* out, std::size_t n) noexcept {
+  switch (scr_) {
+    case XoshiroScrambler::Mullo:    normal_impl<XoshiroScrambler::Mullo>(out, n); break;
+    case XoshiroScrambler::Emulated: normal_impl<XoshiroScrambler::Emulated>(out, n); break;
+    default:                         normal_impl<XoshiroScrambler::ShiftAdd>(out, n); break;
+  }
 }
 
 double Xoshiro256ssAVX512::uniform_scalar() noexcept {
   constexpr std::uint64_t EXP = 0x3FFull << 52;
   alignas(64) std::uint64_t tmp[8];
-  _mm512_store_si512(reinterpret_cast<void*>(tmp), _mm512_srli_epi64(next_u64_vec(), 12));
+  _mm512_store_si512(reinterpret_cast<void*>(tmp), _mm512_srli_epi64(next_u64_vec<XoshiroScrambler::ShiftAdd>(), 12));
   std::uint64_t bits = tmp[0] | EXP;
   double d; std::memcpy(&d, &bits, sizeof(d)); return d - 1.0;
 }
 
+// ----------------------------------------
+// interleaved register sets
+// ----------------------------------------
+namespace {
+
+// one xoshiro256** step on one register set
+inline __m512i step_set(__m512i& s0, __m512i& s1, __m512i& s2, __m512i& s3) noexcept {
+  const __m512i res = scramble<XoshiroScrambler::ShiftAdd>(s1);
+  const __m512i t = _mm512_slli_epi64(s1, 17);
+  s2 = _mm512_xor_si512(s2, s0);
+  s3 = _mm512_xor_si512(s3, s1);
+  s1 = _mm512_xor_si512(s1, s2);
+  s0 = _mm512_xor_si512(s0, s3);
+  s2 = _mm512_xor_si512(s2, t);
+  s3 = rotl64<45>(s3);
+  return res;
+}
+
+inline void advance_set(__m512i& s0, __m512i& s1, __m512i& s2, __m512i& s3) noexcept {
+  const __m512i t = _mm512_slli_epi64(s1, 17);
+  s2 = _mm512_xor_si512(s2, s0);
+  s3 = _mm512_xor_si512(s3, s1);
+  s1 = _mm512_xor_si512(s1, s2);
+  s0 = _mm512_xor_si512(s0, s3);
+  s2 = _mm512_xor_si512(s2, t);
+  s3 = rotl64<45>(s3);
+}
+
+// f(0), f(1), ..., f(K-1), expanded at compile time so the sets stay in registers
+template<int K, class F>
+inline void for_each_set(F&& f) noexcept {
+  [&]<int... J>(std::integer_sequence<int, J...>) { (f(J), ...); }(std::make_integer_sequence<int, K>{});
+}
+
+} // namespace
+
+template<int K>
+Xoshiro256ssAVX512Interleaved<K>::Xoshiro256ssAVX512Interleaved(std::uint64_t seed) noexcept {
+  auto sm64 = [](std::uint64_t& v) {
+    v += 0x9e3779b97f4a7c15ull;
+    std::uint64_t z = v;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  };
+  std::uint64_t x = seed;
+  alignas(64) std::uint64_t tmp[4][LANES];   // word w of global lane g
+  for (int g = 0; g < LANES; ++g)
+    for (int w = 0; w < 4; ++w) tmp[w][g] = sm64(x);
+  for (int j = 0; j < K; ++j) {
+    s0[j] = _mm512_load_si512(reinterpret_cast<const void*>(tmp[0] + 8 * j));
+    s1[j] = _mm512_load_si512(reinterpret_cast<const void*>(tmp[1] + 8 * j));
+    s2[j] = _mm512_load_si512(reinterpret_cast<const void*>(tmp[2] + 8 * j));
+    s3[j] = _mm512_load_si512(reinterpret_cast<const void*>(tmp[3] + 8 * j));
+  }
+}
+
+template<int K>
+void Xoshiro256ssAVX512Interleaved<K>::jump_with(const std::uint64_t (&poly)[4]) noexcept {
+  __m512i a0[K], a1[K], a2[K], a3[K];
+  for (int j = 0; j < K; ++j) a0[j] = a1[j] = a2[j] = a3[j] = _mm512_setzero_si512();
+  for (int i = 0; i < 4; ++i) {
+    for (int b = 0; b < 64; ++b) {
+      const bool take = (poly[i] >> b) & 1u;
+      for_each_set<K>([&](int j) {
+        if (take) {
+          a0[j] = _mm512_xor_si512(a0[j], s0[j]);
+          a1[j] = _mm512_xor_si512(a1[j], s1[j]);
+          a2[j] = _mm512_xor_si512(a2[j], s2[j]);
+          a3[j] = _mm512_xor_si512(a3[j], s3[j]);
+        }
+        advance_set(s0[j], s1[j], s2[j], s3[j]);
+      });
+    }
+  }
+  for (int j = 0; j < K; ++j) { s0[j] = a0[j]; s1[j] = a1[j]; s2[j] = a2[j]; s3[j] = a3[j]; }
+}
+
+template<int K> void Xoshiro256ssAVX512Interleaved<K>::jump() noexcept      { jump_with(Xoshiro256ssScalar::JUMP); }
+template<int K> void Xoshiro256ssAVX512Interleaved<K>::long_jump() noexcept { jump_with(Xoshiro256ssScalar::LONG_JUMP); }
+
+template<int K>
+void Xoshiro256ssAVX512Interleaved<K>::skip_ahead(std::uint64_t lo, std::uint64_t hi) noexcept {
+  if (hi == 0 && lo < 256) {
+    while (lo--) for_each_set<K>([&](int j) { advance_set(s0[j], s1[j], s2[j], s3[j]); });
+    return;
+  }
+  std::uint64_t poly[4];
+  xoshiro256_jump_poly(lo, hi, poly);
+  jump_with(poly);
+}
+
+template<int K>
+void Xoshiro256ssAVX512Interleaved<K>::lane_state(int lane, std::uint64_t st[4]) const noexcept {
+  const int j = (lane / 8) % K, k = lane % 8;
+  alignas(64) std::uint64_t t[4][8];
+  _mm512_store_si512(reinterpret_cast<void*>(t[0]), s0[j]);
+  _mm512_store_si512(reinterpret_cast<void*>(t[1]), s1[j]);
+  _mm512_store_si512(reinterpret_cast<void*>(t[2]), s2[j]);
+  _mm512_store_si512(reinterpret_cast<void*>(t[3]), s3[j]);
+  for (int w = 0; w < 4; ++w) st[w] = t[w][k];
+}
+
+// Each step issues K independent xoshiro updates back to back; the state is
+// copied to locals so the K sets live in registers for the whole loop.
+template<int K>
+void Xoshiro256ssAVX512Interleaved<K>::generate_u64(std::uint64_t* out, std::size_t n) noexcept {
+  __m512i a[K], b[K], c[K], d[K];
+  for (int j = 0; j < K; ++j) { a[j] = s0[j]; b[j] = s1[j]; c[j] = s2[j]; d[j] = s3[j]; }
+  std::size_t i = 0;
+  for (; i + LANES <= n; i += LANES)
+    for_each_set<K>([&](int j) { _mm512_storeu_si512(reinterpret_cast<void*>(out + i + 8 * j), step_set(a[j], b[j], c[j], d[j])); });
+  if (i < n) {
+    alignas(64) std::uint64_t tmp[LANES];
+    for_each_set<K>([&](int j) { _mm512_store_si512(reinterpret_cast<void*>(tmp + 8 * j), step_set(a[j], b[j], c[j], d[j])); });
+    for (std::size_t t = 0; i < n; ++i, ++t) out[i] = tmp[t];
+  }
+  for (int j = 0; j < K; ++j) { s0[j] = a[j]; s1[j] = b[j]; s2[j] = c[j]; s3[j] = d[j]; }
+}
+
+template<int K>
+void Xoshiro256ssAVX512Interleaved<K>::generate_double(double* out, std::size_t n) noexcept {
+  __m512i a[K], b[K], c[K], d[K];
+  for (int j = 0; j < K; ++j) { a[j] = s0[j]; b[j] = s1[j]; c[j] = s2[j]; d[j] = s3[j]; }
+  std::size_t i = 0;
+  for (; i + LANES <= n; i += LANES)
+    for_each_set<K>([&](int j) { _mm512_storeu_pd(out + i + 8 * j, to_unit_pd(step_set(a[j], b[j], c[j], d[j]))); });
+  if (i < n) {
+    alignas(64) double tmp[LANES];
+    for_each_set<K>([&](int j) { _mm512_store_pd(tmp + 8 * j, to_unit_pd(step_set(a[j], b[j], c[j], d[j]))); });
+    for (std::size_t t = 0; i < n; ++i, ++t) out[i] = tmp[t];
+  }
+  for (int j = 0; j < K; ++j) { s0[j] = a[j]; s1[j] = b[j]; s2[j] = c[j]; s3[j] = d[j]; }
+}
+
+// polar pairs: set j supplies (u, v) from two consecutive draws; sets are
+// drawn together and emitted in order 0..K-1
+template<int K>
+void Xoshiro256ssAVX512Interleaved<K>::generate_normal(double* out, std::size_t n) noexcept {
+  __m512i a[K], b[K], c[K], d[K];
+  for (int j = 0; j < K; ++j) { a[j] = s0[j]; b[j] = s1[j]; c[j] = s2[j]; d[j] = s3[j]; }
+  std::size_t i = 0;
+  while (i < n) {
+    __m512i uu[K], vv[K];
+    for_each_set<K>([&](int j) { uu[j] = step_set(a[j], b[j], c[j], d[j]); });
+    for_each_set<K>([&](int j) { vv[j] = step_set(a[j], b[j], c[j], d[j]); });
+    for (int j = 0; j < K; ++j) ua_polar_emit_pd(uu[j], vv[j], out, i, n);
+  }
+  for (int j = 0; j < K; ++j) { s0[j] = a[j]; s1[j] = b[j]; s2[j] = c[j]; s3[j] = d[j]; }
+}
+
+template struct Xoshiro256ssAVX512Interleaved<2>;
+template struct Xoshiro256ssAVX512Interleaved<3>;
+template struct Xoshiro256ssAVX512Interleaved<4>;
+
 } // namespace ua::detail
@@ -0,0 +1,136 @@
+#include "ua/ua_xoshiro256ss_avx512vl.h"
+#include "ua/ua_xoshiro256ss_scalar.h"
+#include "ua/ua_xoshiro256ss_jump.h"
+#include "ua_math_avx2.h"
+
+namespace ua::detail {
+
+// ----------------------------------------
+// helpers
+// ----------------------------------------
+static inline __m256i mullo64(__m256i a, std::uint64_t c) noexcept {
+  return _mm256_mullo_epi64(a, _mm256_set1_epi64x((long long)c));
+}
+static inline __m256d to_unit_pd(__m256i v) noexcept {
+  const __m256i bits = _mm256_or_si256(_mm256_srli_epi64(v, 12), _mm256_set1_epi64x(0x3FF0000000000000LL));
+  return _mm256_sub_pd(_mm256_castsi256_pd(bits), _mm256_set1_pd(1.0));
+}
+// first r (< 4) lanes
+static inline __mmask8 tail_mask(std::size_t r) noexcept {
+  return (__mmask8)((1u << r) - 1u);
+}
+
+// ----------------------------------------
+// state & core PRNG
+// ----------------------------------------
+Xoshiro256ssAVX512VL::Xoshiro256ssAVX512VL(std::uint64_t seed) noexcept {
+  auto sm64 = [](std::uint64_t& v) {
+    v += 0x9e3779b97f4a7c15ull;
+    std::uint64_t z = v;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  };
+  // same draws and lane placement as Xoshiro256ssAVX2
+  std::uint64_t x = seed;
+  alignas(32) std::uint64_t tmp[16];
+  for (int lane = 0; lane < 4; ++lane) {
+    tmp[lane + 0]  = sm64(x);
+    tmp[lane + 4]  = sm64(x);
+    tmp[lane + 8]  = sm64(x);
+    tmp[lane + 12] = sm64(x);
+  }
+  s0 = _mm256_set_epi64x(tmp[12], tmp[8], tmp[4], tmp[0]);
+  s1 = _mm256_set_epi64x(tmp[13], tmp[9], tmp[5], tmp[1]);
+  s2 = _mm256_set_epi64x(tmp[14], tmp[10], tmp[6], tmp[2]);
+  s3 = _mm256_set_epi64x(tmp[15], tmp[11], tmp[7], tmp[3]);
+}
+
+__m256i Xoshiro256ssAVX512VL::next_u64_vec() noexcept {
+  const __m256i res = mullo64(_mm256_rol_epi64(mullo64(s1, 5u), 7), 9u);
+  const __m256i t = _mm256_slli_epi64(s1, 17);
+  s2 = _mm256_xor_si256(s2, s0);
+  s3 = _mm256_xor_si256(s3, s1);
+  s1 = _mm256_xor_si256(s1, s2);
+  s0 = _mm256_xor_si256(s0, s3);
+  s2 = _mm256_xor_si256(s2, t);
+  s3 = _mm256_rol_epi64(s3, 45);
+  return res;
+}
+
+// state transition only (no scrambler) for the jump loops
+void Xoshiro256ssAVX512VL::advance_vec() noexcept {
+  const __m256i t = _mm256_slli_epi64(s1, 17);
+  s2 = _mm256_xor_si256(s2, s0);
+  s3 = _mm256_xor_si256(s3, s1);
+  s1 = _mm256_xor_si256(s1, s2);
+  s0 = _mm256_xor_si256(s0, s3);
+  s2 = _mm256_xor_si256(s2, t);
+  s3 = _mm256_rol_epi64(s3, 45);
+}
+
+// Same polynomial on all 4 lanes: uniform branch, vector XOR-accumulate.
+void Xoshiro256ssAVX512VL::jump_with(const std::uint64_t (&poly)[4]) noexcept {
+  __m256i a0 = _mm256_setzero_si256(), a1 = _mm256_setzero_si256();
+  __m256i a2 = _mm256_setzero_si256(), a3 = _mm256_setzero_si256();
+  for (int i = 0; i < 4; ++i) {
+    for (int b = 0; b < 64; ++b) {
+      if (poly[i] & (1ull << b)) {
+        a0 = _mm256_xor_si256(a0, s0);
+        a1 = _mm256_xor_si256(a1, s1);
+        a2 = _mm256_xor_si256(a2, s2);
+        a3 = _mm256_xor_si256(a3, s3);
+      }
+      advance_vec();
+    }
+  }
+  s0 = a0; s1 = a1; s2 = a2; s3 = a3;
+}
+
+void Xoshiro256ssAVX512VL::jump() noexcept      { jump_with(Xoshiro256ssScalar::JUMP); }
+void Xoshiro256ssAVX512VL::long_jump() noexcept { jump_with(Xoshiro256ssScalar::LONG_JUMP); }
+
+void Xoshiro256ssAVX512VL::skip_ahead(std::uint64_t lo, std::uint64_t hi) noexcept {
+  if (hi == 0 && lo < 256) { while (lo--) advance_vec(); return; }
+  std::uint64_t poly[4];
+  xoshiro256_jump_poly(lo, hi, poly);
+  jump_with(poly);
+}
+
+void Xoshiro256ssAVX512VL::lane_state(int lane, std::uint64_t st[4]) const noexcept {
+  alignas(32) std::uint64_t t[4][4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(t[0]), s0);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(t[1]), s1);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(t[2]), s2);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(t[3]), s3);
+  for (int w = 0; w < 4; ++w) st[w] = t[w][lane & 3];
+}
+
+// ----------------------------------------
+// bulk generators (masked store for the n % 4 tail)
+// ----------------------------------------
+void Xoshiro256ssAVX512VL::generate_u64(std::uint64_t* out, std::size_t n) noexcept {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), next_u64_vec());
+  if (i < n) _mm256_mask_storeu_epi64(out + i, tail_mask(n - i), next_u64_vec());
+}
+
+void Xoshiro256ssAVX512VL::generate_double(double* out, std::size_t n) noexcept {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm256_storeu_pd(out + i, to_unit_pd(next_u64_vec()));
+  if (i < n) _mm256_mask_storeu_pd(out + i, tail_mask(n - i), to_unit_pd(next_u64_vec()));
+}
+
+// Fully vectorized Marsaglia polar (see ua_polar_emit_pd in ua_math_avx2.h).
+void Xoshiro256ssAVX512VL::generate_normal(double* out, std::size_t n) noexcept {
+  std::size_t i = 0;
+  while (i < n) {
+    const __m256i uu = next_u64_vec();
+    const __m256i vv = next_u64_vec();
+    ua_polar_emit_pd(uu, vv, out, i, n);
+  }
+}
+
+} // namespace ua::detail
@@ -0,0 +1,93 @@
+// D:/code/Universal-Architecture-RNG-Lib/v1.7/src/xoshiro256ss_jump.cpp
+// Portable (no ISA flags): shared by the scalar, AVX2 and AVX-512F backends.
+#include "ua/ua_xoshiro256ss_jump.h"
+
+namespace ua::detail {
+
+// P(x) = x^256 + PLOW(x); derived with Berlekamp–Massey from the linear
+// engine and checked against the reference tables:
+// x^(2^128) mod P == JUMP, x^(2^192) mod P == LONG_JUMP.
+static constexpr std::uint64_t PLOW[4] = {
+  0x9d116f2bb0f0f001ULL, 0x0280002bcefd1a5eULL,
+  0x04b4edcf26259f85ULL, 0x0003c03c3f3ecb19ULL
+};
+
+// 64x64 -> 128 carry-less multiply (portable shift/xor)
+static inline void clmul64(std::uint64_t a, std::uint64_t b,
+                           std::uint64_t& lo, std::uint64_t& hi) noexcept {
+  std::uint64_t l = 0, h = 0;
+  for (int i = 0; i < 64; ++i) {
+    if ((b >> i) & 1u) {
+      l ^= a << i;
+      if (i) h ^= a >> (64 - i);
+    }
+  }
+  lo = l; hi = h;
+}
+
+// r = a*b mod P over GF(2); r may alias a or b
+static void mulmod(const std::uint64_t a[4], const std::uint64_t b[4], std::uint64_t r[4]) noexcept {
+  std::uint64_t t[8] = {0,0,0,0,0,0,0,0};
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      std::uint64_t lo, hi;
+      clmul64(a[i], b[j], lo, hi);
+      t[i + j]     ^= lo;
+      t[i + j + 1] ^= hi;
+    }
+  }
+  // fold x^k (k >= 256) into x^(k-256) * PLOW, top bit first;
+  // deg(PLOW) < 256 so every fold only touches lower bits
+  for (int k = 511; k >= 256; --k) {
+    if (!((t[k >> 6] >> (k & 63)) & 1u)) continue;
+    t[k >> 6] ^= 1ull << (k & 63);
+    const int sh = k - 256, ws = sh >> 6, bs = sh & 63;
+    for (int w = 0; w < 4; ++w) {
+      t[w + ws] ^= PLOW[w] << bs;
+      if (bs) t[w + ws + 1] ^= PLOW[w] >> (64 - bs);
+    }
+  }
+  r[0] = t[0]; r[1] = t[1]; r[2] = t[2]; r[3] = t[3];
+}
+
+namespace {
+
+// x^(2^k) mod P for k = 0..191, built once (thread-safe static init);
+// TU-local so the per-engine tables cannot collide at link time
+struct Pow2Table {
+  std::uint64_t p[192][4];
+  Pow2Table() noexcept {
+    std::uint64_t x[4] = {2u, 0u, 0u, 0u}; // x^1
+    for (int k = 0; k < 192; ++k) {
+      p[k][0] = x[0]; p[k][1] = x[1]; p[k][2] = x[2]; p[k][3] = x[3];
+      mulmod(x, x, x);
+    }
+  }
+};
+
+} // namespace
+
+static const Pow2Table& pow2_table() noexcept {
+  static const Pow2Table t;
+  return t;
+}
+
+void xoshiro256_jump_poly(std::uint64_t lo, std::uint64_t hi, std::uint64_t poly[4]) noexcept {
+  const Pow2Table& t = pow2_table();
+  std::uint64_t r[4] = {1u, 0u, 0u, 0u}; // x^0
+  for (int k = 0; k < 64; ++k)
+    if ((lo >> k) & 1u) mulmod(r, t.p[k], r);
+  for (int k = 0; k < 64; ++k)
+    if ((hi >> k) & 1u) mulmod(r, t.p[64 + k], r);
+  poly[0] = r[0]; poly[1] = r[1]; poly[2] = r[2]; poly[3] = r[3];
+}
+
+void xoshiro256_jumps_poly(std::uint64_t k, std::uint64_t poly[4]) noexcept {
+  const Pow2Table& t = pow2_table();
+  std::uint64_t r[4] = {1u, 0u, 0u, 0u};
+  for (int b = 0; b < 64; ++b)
+    if ((k >> b) & 1u) mulmod(r, t.p[128 + b], r);
+  poly[0] = r[0]; poly[1] = r[1]; poly[2] = r[2]; poly[3] = r[3];
+}
+
+} // namespace ua::detail
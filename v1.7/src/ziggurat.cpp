@@ -0,0 +1,132 @@
+#include "ua/ua_normal_ziggurat.h"
+
+namespace ua {
+
+// ----------------------------------------
+// double-double helpers (constant evaluation only)
+// ----------------------------------------
+// The layer recurrence is ill-conditioned near the top layer: in plain
+// doubles the tables drift ~1e-13 from the exact values over 255 steps.
+// With hi + lo pairs (~106 bits) each entry rounds correctly.
+namespace {
+
+struct dd { double hi, lo; };
+
+constexpr dd two_sum(double a, double b) noexcept {
+  const double s = a + b, bb = s - a;
+  return { s, (a - (s - bb)) + (b - bb) };
+}
+constexpr dd quick_sum(double a, double b) noexcept {
+  const double s = a + b;
+  return { s, b - (s - a) };
+}
+// Dekker product (no fma in constant evaluation)
+constexpr dd two_prod(double a, double b) noexcept {
+  const double ca = 134217729.0 * a, ah = ca - (ca - a), al = a - ah;
+  const double cb = 134217729.0 * b, bh = cb - (cb - b), bl = b - bh;
+  const double p = a * b;
+  return { p, ((ah * bh - p) + ah * bl + al * bh) + al * bl };
+}
+constexpr dd operator+(dd a, dd b) noexcept {
+  const dd s = two_sum(a.hi, b.hi), t = two_sum(a.lo, b.lo);
+  const dd u = quick_sum(s.hi, s.lo + t.hi);
+  return quick_sum(u.hi, u.lo + t.lo);
+}
+constexpr dd operator-(dd a) noexcept { return { -a.hi, -a.lo }; }
+constexpr dd operator-(dd a, dd b) noexcept { return a + (-b); }
+constexpr dd operator*(dd a, dd b) noexcept {
+  const dd p = two_prod(a.hi, b.hi);
+  return quick_sum(p.hi, p.lo + (a.hi * b.lo + a.lo * b.hi));
+}
+constexpr dd operator*(dd a, double b) noexcept {
+  const dd p = two_prod(a.hi, b);
+  return quick_sum(p.hi, p.lo + a.lo * b);
+}
+// long division, two correction steps
+constexpr dd operator/(dd a, dd b) noexcept {
+  const double q1 = a.hi / b.hi;
+  const dd r = a - b * q1;
+  const double q2 = r.hi / b.hi;
+  return two_sum(q1, q2) + dd{ (r - b * q2).hi / b.hi, 0.0 };
+}
+
+constexpr dd LN2 = { 6.931471805599452862e-01, 2.319046813846299558e-17 };
+
+// Newton from above in double, then one double-double correction
+constexpr dd dd_sqrt(dd a) noexcept {
+  double x = a.hi > 1.0 ? a.hi : 1.0;
+  for (;;) {
+    const double y = 0.5 * (x + a.hi / x);
+    if (y >= x) break;
+    x = y;
+  }
+  return dd{ x, 0.0 } + (a - two_prod(x, x)) / dd{ 2.0 * x, 0.0 };
+}
+
+// e^x = 2^k (e^(r/1024))^1024 with |r| <= ln2/2; after the scaling eight
+// Taylor terms reach 2^-110. 1/i in double only perturbs terms below 2^-70.
+constexpr dd dd_exp(dd x) noexcept {
+  const int k = int(x.hi * 1.4426950408889634 + (x.hi < 0 ? -0.5 : 0.5));
+  const dd r = (x - LN2 * double(k)) * (1.0 / 1024.0);
+  dd term = r, sum = { 1.0, 0.0 };
+  for (int i = 2; i <= 9; ++i) { sum = sum + term; term = term * r * (1.0 / i); }
+  for (int i = 0; i < 10; ++i) sum = sum * sum;
+  double p = 1.0;
+  for (int i = 0; i < (k >= 0 ? k : -k); ++i) p *= (k >= 0 ? 2.0 : 0.5);
+  return sum * p;
+}
+
+// double seed e ln2 + 2 atanh((m-1)/(m+1)), then one Newton step
+// y += x e^-y - 1 (quadratic: 2^-52 -> past 2^-104)
+constexpr dd dd_log(dd x) noexcept {
+  double m = x.hi;
+  int e = 0;
+  while (m > 1.4142135623730951) { m *= 0.5; ++e; }
+  while (m < 0.7071067811865476) { m *= 2.0; --e; }
+  const double s = (m - 1.0) / (m + 1.0), s2 = s * s;
+  double term = s, sum = 0.0;
+  for (int i = 1; i < 40; i += 2) { sum += term / i; term *= s2; }
+  const dd y = { 2.0 * sum + e * 0.6931471805599453, 0.0 };
+  return y + x * dd_exp(-y) - dd{ 1.0, 0.0 };
+}
+
+// f(x) = exp(-x^2 / 2)
+constexpr dd pdf(dd x) noexcept { return dd_exp(x * x * -0.5); }
+
+// trunc(q) for 0 <= q < 2^63
+constexpr std::uint64_t trunc_u64(dd q) noexcept {
+  std::uint64_t t = std::uint64_t(q.hi);
+  if (double(t) == q.hi && q.lo < 0) --t;   // hi rounded up onto an integer
+  return t;
+}
+
+constexpr ZigguratNormal::Tables make_tables() noexcept {
+  constexpr int N = ZigguratNormal::N;
+  constexpr double M = 4503599627370496.0;   // 2^52
+  const dd V = { ZigguratNormal::V, 0.0 };
+  ZigguratNormal::Tables t{};
+  dd x1 = { ZigguratNormal::R, 0.0 };
+  dd f1 = pdf(x1);
+  t.wi[N - 1] = x1.hi / M;
+  t.fi[N - 1] = f1.hi;
+  t.ki[0] = trunc_u64(x1 * f1 / V * M);
+  t.wi[0] = (V / f1).hi / M;
+  t.fi[0] = 1.0;
+  for (int i = N - 2; i >= 1; --i) {
+    // f(x) is the argument of f^-1 itself, no exp needed
+    f1 = V / x1 + f1;
+    const dd x = dd_sqrt(dd_log(f1) * -2.0);
+    t.ki[i + 1] = trunc_u64(x / x1 * M);
+    t.wi[i] = x.hi / M;
+    t.fi[i] = f1.hi;
+    x1 = x;
+  }
+  t.ki[1] = 0;   // the top layer is all wedge
+  return t;
+}
+
+} // namespace
+
+constinit const ZigguratNormal::Tables ZigguratNormal::tables = make_tables();
+
+} // namespace ua
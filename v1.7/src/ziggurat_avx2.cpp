@@ -0,0 +1,78 @@
+#include "ua/ua_normal_ziggurat.h"
+#include <immintrin.h>
+#include <bit>
+
+namespace ua::detail {
+
+// ----------------------------------------
+// helpers
+// ----------------------------------------
+namespace {
+
+// Left-pack for _mm_permutevar_ps, indexed by the 4-bit miss mask: moves
+// the missed lanes' positions to the front, in order.
+struct PackLut { std::int32_t p[16][4]; };
+
+constexpr PackLut make_pack_lut() {
+  PackLut t{};
+  for (int m = 0; m < 16; ++m) {
+    int o = 0;
+    for (int j = 0; j < 4; ++j)
+      if (m & (1 << j)) t.p[m][o++] = j;
+  }
+  return t;
+}
+
+alignas(16) constexpr PackLut pack_lut = make_pack_lut();
+
+// one vector of candidates -> rectangle values, miss mask (bit j = lane j)
+inline int rect4(__m256i u, __m256d& z) noexcept {
+  const ZigguratNormal::Tables& t = ZigguratNormal::tables;
+  const __m256i idx  = _mm256_and_si256(u, _mm256_set1_epi64x(0xff));
+  const __m256i rabs = _mm256_and_si256(_mm256_srli_epi64(u, 9), _mm256_set1_epi64x(0x000fffffffffffffll));
+  const __m256i sign = _mm256_slli_epi64(_mm256_srli_epi64(u, 8), 63);
+  const __m256i ki   = _mm256_i64gather_epi64(reinterpret_cast<const long long*>(t.ki), idx, 8);
+  const __m256d wi   = _mm256_i64gather_pd(t.wi, idx, 8);
+  // rabs < 2^52: exact as (2^52 + rabs) - 2^52
+  const __m256d rd = _mm256_sub_pd(
+      _mm256_castsi256_pd(_mm256_or_si256(rabs, _mm256_set1_epi64x(0x4330000000000000ll))),
+      _mm256_set1_pd(4503599627370496.0));
+  z = _mm256_castsi256_pd(_mm256_xor_si256(_mm256_castpd_si256(_mm256_mul_pd(rd, wi)), sign));
+  // both sides < 2^63, so the signed compare is the unsigned one
+  return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(ki, rabs))) ^ 0xf;
+}
+
+// append the positions base + j of the missed lanes to rare[nr..]
+inline std::size_t pack4(int miss, std::uint32_t base, std::uint32_t* rare, std::size_t nr) noexcept {
+  const __m128i pos = _mm_add_epi32(_mm_set1_epi32(int(base)), _mm_setr_epi32(0, 1, 2, 3));
+  const __m128i perm = _mm_load_si128(reinterpret_cast<const __m128i*>(pack_lut.p[miss]));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(rare + nr),
+                   _mm_castps_si128(_mm_permutevar_ps(_mm_castsi128_ps(pos), perm)));
+  return nr + std::size_t(std::popcount(unsigned(miss)));
+}
+
+} // namespace
+
+// ----------------------------------------
+// rectangle pass
+// ----------------------------------------
+std::size_t ziggurat_rect_avx2(const std::uint64_t* u, std::size_t n, double* out, std::uint32_t* rare) noexcept {
+  std::size_t i = 0, nr = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d z;
+    const int miss = rect4(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(u + i)), z);
+    _mm256_storeu_pd(out + i, z);
+    nr = pack4(miss, std::uint32_t(i), rare, nr);
+  }
+  if (i < n) {
+    const std::size_t r = n - i;
+    const __m256i live = _mm256_cmpgt_epi64(_mm256_set1_epi64x((long long)r), _mm256_setr_epi64x(0, 1, 2, 3));
+    __m256d z;
+    const int miss = rect4(_mm256_maskload_epi64(reinterpret_cast<const long long*>(u + i), live), z);
+    _mm256_maskstore_pd(out + i, live, z);
+    nr = pack4(miss & int((1u << r) - 1u), std::uint32_t(i), rare, nr);
+  }
+  return nr;
+}
+
+} // namespace ua::detail
@@ -0,0 +1,63 @@
+#include "ua/ua_normal_ziggurat.h"
+#include <immintrin.h>
+#include <bit>
+
+namespace ua::detail {
+
+// ----------------------------------------
+// helpers
+// ----------------------------------------
+namespace {
+
+// one vector of candidates -> rectangle values, miss mask
+inline __mmask8 rect8(__m512i u, __m512d& z) noexcept {
+  const ZigguratNormal::Tables& t = ZigguratNormal::tables;
+  const __m512i idx  = _mm512_and_si512(u, _mm512_set1_epi64(0xff));
+  const __m512i rabs = _mm512_and_si512(_mm512_srli_epi64(u, 9), _mm512_set1_epi64(0x000fffffffffffffll));
+  const __m512i sign = _mm512_slli_epi64(_mm512_srli_epi64(u, 8), 63);
+  const __m512i ki   = _mm512_i64gather_epi64(idx, t.ki, 8);
+  const __m512d wi   = _mm512_i64gather_pd(idx, t.wi, 8);
+  // rabs < 2^52: exact as (2^52 + rabs) - 2^52 (vcvtuqq2pd is AVX-512DQ)
+  const __m512d rd = _mm512_sub_pd(
+      _mm512_castsi512_pd(_mm512_or_si512(rabs, _mm512_set1_epi64(0x4330000000000000ll))),
+      _mm512_set1_pd(4503599627370496.0));
+  z = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(_mm512_mul_pd(rd, wi)), sign));
+  return _mm512_cmpge_epu64_mask(rabs, ki);
+}
+
+// first r (< 8) lanes
+inline __mmask8 tail_mask(std::size_t r) noexcept {
+  return (__mmask8)((1u << r) - 1u);
+}
+
+} // namespace
+
+// ----------------------------------------
+// rectangle pass
+// ----------------------------------------
+// register-form vpcompressd plus a full store: the memory form is
+// microcoded on Intel cores. The positions sit in the low half of a zmm
+// (the ymm form is AVX-512VL); the store keeps the low 8.
+std::size_t ziggurat_rect_avx512(const std::uint64_t* u, std::size_t n, double* out, std::uint32_t* rare) noexcept {
+  const __m512i step = _mm512_set1_epi32(8);
+  __m512i pos = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 0, 0, 0, 0, 0, 0, 0, 0);
+  std::size_t i = 0, nr = 0;
+  for (; i + 8 <= n; i += 8, pos = _mm512_add_epi32(pos, step)) {
+    __m512d z;
+    const __mmask8 miss = rect8(_mm512_loadu_si512(reinterpret_cast<const void*>(u + i)), z);
+    _mm512_storeu_pd(out + i, z);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(rare + nr), _mm512_castsi512_si256(_mm512_maskz_compress_epi32(miss, pos)));
+    nr += std::size_t(std::popcount(unsigned(miss)));
+  }
+  if (i < n) {
+    const __mmask8 live = tail_mask(n - i);
+    __m512d z;
+    const __mmask8 miss = rect8(_mm512_maskz_loadu_epi64(live, u + i), z) & live;
+    _mm512_mask_storeu_pd(out + i, live, z);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(rare + nr), _mm512_castsi512_si256(_mm512_maskz_compress_epi32(miss, pos)));
+    nr += std::size_t(std::popcount(unsigned(miss)));
+  }
+  return nr;
+}
+
+} // namespace ua::detail
@@ -0,0 +1,153 @@
+// ARS4x32-7 backends: known answers for the portable block function, and
+// AES-NI / VAES streams against the table-based scalar reference (including
+// a 2^64 counter carry inside a step, and odd split requests). Hardware
+// checks are skipped on CPUs without AES / VAES.
+#include <cstdio>
+#include <cstdint>
+
+#include "ua/ua_cpuid.h"
+#include "ua/ua_rng.h"
+#include "ua/ua_ars4x32.h"
+
+static int g_fail = 0;
+
+static void check_kat() {
+    struct Kat { std::uint64_t key[2], lo, hi, out[2]; };
+    static const Kat kats[] = {
+        { {0, 0}, 0, 0, {0xc45798f3dacf61ffull, 0x101e27f3113c7eebull} },
+        { {0x0123456789abcdefull, 0xfedcba9876543210ull}, 0xdeadbeefull, 0x1234ull,
+          {0x89e139e5c475a1fdull, 0xa0fe7c5eeddd297cull} },
+    };
+    for (const Kat& k : kats) {
+        std::uint64_t out[2];
+        ua::ars4x32_7(k.key, k.lo, k.hi, out);
+        if (out[0] != k.out[0] || out[1] != k.out[1]) { std::printf("FAIL ars4x32_7 KAT\n"); ++g_fail; return; }
+    }
+    std::printf("ok   ars4x32_7 known answers\n");
+}
+
+// 96 u64 after skipping to (lo, hi), then an odd tail, must match scalar
+template<class G>
+static bool matches_scalar(std::uint64_t lo, std::uint64_t hi) {
+    G g(2718);
+    ua::detail::Ars4x32Scalar ref(2718);
+    g.skip_ahead(lo, hi);
+    ref.skip_ahead(lo, hi);
+    std::uint64_t got[96], want[96];
+    g.generate_u64(got, 96);
+    ref.generate_u64(want, 96);
+    for (int i = 0; i < 96; ++i) if (got[i] != want[i]) return false;
+    double gd[64], wd[64];
+    g.generate_double(gd, 64);
+    ref.generate_double(wd, 64);
+    for (int i = 0; i < 64; ++i) if (gd[i] != wd[i]) return false;
+    return true;
+}
+
+template<class G>
+static void check_backend(const char* name) {
+    int fails = g_fail;
+    if (!matches_scalar<G>(0, 0)) { std::printf("FAIL %s stream\n", name); ++g_fail; }
+    // a few blocks before 2^64 so a step carries into the high word
+    if (!matches_scalar<G>(0xfffffffffffffffbull, 7)) { std::printf("FAIL %s carry\n", name); ++g_fail; }
+    {
+        // jump() == 2^64 blocks
+        G a(5), b(5);
+        a.jump();
+        b.skip_ahead(0, 1);
+        std::uint64_t x[64], y[64];
+        a.generate_u64(x, 64);
+        b.generate_u64(y, 64);
+        for (int i = 0; i < 64; ++i) if (x[i] != y[i]) { std::printf("FAIL %s jump\n", name); ++g_fail; break; }
+    }
+    if (fails == g_fail) std::printf("ok   ars %s == scalar (stream, carry, jump)\n", name);
+}
+
+// Odd, split requests: u64 and double calls of sizes that cut the step,
+// skip_ahead() and jump() from the middle of a block. The stream must still
+// be the blocks in counter order (ars4x32_7), whatever the backend's step.
+static const std::size_t kSplit[] = { 5, 8, 1, 3, 37, 2, 64, 13, 33, 31 };
+
+template<class G>
+static void check_split(const char* name) {
+    G g(42);
+    std::uint64_t key[2];
+    ua::ars_key_from_seed(42, key);
+    std::uint64_t pos = 0, bhi = 0;   // stream position: word pos of block row bhi*2^64
+    auto want = [&](std::uint64_t p) {
+        std::uint64_t o[2];
+        ua::ars4x32_7(key, p / 2, bhi, o);
+        return o[p & 1];
+    };
+    for (int round = 0; round < 3; ++round) {
+        for (std::size_t k = 0; k < sizeof(kSplit) / sizeof(kSplit[0]); ++k) {
+            const std::size_t n = kSplit[k];
+            std::uint64_t u[64];
+            double d[64];
+            if (k & 1) g.generate_double(d, n);
+            else       g.generate_u64(u, n);
+            for (std::size_t j = 0; j < n; ++j) {
+                const std::uint64_t w = want(pos + j);
+                const bool ok = k & 1 ? d[j] == double(w >> 12) * 0x1p-52 : u[j] == w;
+                if (!ok) { std::printf("FAIL ars %s split round %d call %zu word %zu\n", name, round, k, j); ++g_fail; return; }
+            }
+            pos += n;
+        }
+        if (round == 0) { g.skip_ahead(1001); pos += 2002; }
+        if (round == 1) { g.jump(); bhi = 1; }
+    }
+    std::printf("ok   ars %s split odd requests\n", name);
+}
+
+// the facade must give the scalar stream whatever backend it picked, also
+// when the requests cut its step
+static void check_facade() {
+    std::uint64_t got[128], want[128];
+    ua::Rng rng(1618, ua::Algorithm::Ars4x32_7);
+    ua::detail::Ars4x32Scalar ref(1618);
+    rng.skip_ahead(12345);
+    ref.skip_ahead(12345);
+    for (std::size_t i = 0, k = 0; i < 128; i += kSplit[k], ++k) {
+        const std::size_t n = 128 - i < kSplit[k] ? 128 - i : kSplit[k];
+        rng.generate_u64(got + i, n);
+    }
+    ref.generate_u64(want, 128);
+    for (int i = 0; i < 128; ++i) {
+        if (got[i] != want[i]) { std::printf("FAIL ua::Rng ars u64 %d\n", i); ++g_fail; return; }
+    }
+    double z[1024];
+    rng.generate_normal(z, 1024);
+    double m = 0;
+    for (double v : z) m += v;
+    if (m / 1024 > 0.2 || m / 1024 < -0.2) { std::printf("FAIL ua::Rng ars normal mean\n"); ++g_fail; return; }
+    std::printf("ok   ua::Rng ars (tier %d) matches scalar\n", int(rng.simd_tier()));
+}
+
+int main() {
+    check_kat();
+    check_backend<ua::detail::Ars4x32Scalar>("scalar");
+    check_split<ua::detail::Ars4x32Scalar>("scalar");
+    check_facade();
+
+    const ua::CpuFeatures f = ua::query_cpu_features();
+    if (f.aes) {
+        check_backend<ua::detail::Ars4x32AESNI>("aesni");
+        check_split<ua::detail::Ars4x32AESNI>("aesni");
+    }
+    else std::printf("skip aesni (cpu)\n");
+#if defined(UA_BUILD_WITH_AVX2)
+    if (f.avx2 && f.vaes) {
+        check_backend<ua::detail::Ars4x32AVX2>("vaes-avx2");
+        check_split<ua::detail::Ars4x32AVX2>("vaes-avx2");
+    }
+    else std::printf("skip vaes-avx2 (cpu)\n");
+#endif
+#if defined(UA_BUILD_WITH_AVX512)
+    if (ua::avx512_ok(f) && f.vaes) {
+        check_backend<ua::detail::Ars4x32AVX512>("vaes-avx512");
+        check_split<ua::detail::Ars4x32AVX512>("vaes-avx512");
+    }
+    else std::printf("skip vaes-avx512 (cpu)\n");
+#endif
+    return g_fail ? 1 : 0;
+}
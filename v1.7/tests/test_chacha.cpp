@@ -0,0 +1,185 @@
+// ChaCha backends: RFC 7539 / zero-key known answers, SIMD stream == scalar
+// stream for 8/12/20 rounds (including a 2^64 counter carry inside a vector
+// step), odd split requests on every tier, and the ua::Rng facade against the
+// scalar reference.
+#include <cstdio>
+#include <cstdint>
+
+#include "ua/ua_cpuid.h"
+#include "ua/ua_rng.h"
+#include "ua/ua_chacha_scalar.h"
+#include "ua/ua_chacha_avx2.h"
+#include "ua/ua_chacha_avx512.h"
+
+static int g_fail = 0;
+
+static void check_kat() {
+    // RFC 7539 2.3.2: key 00..1f, counter 1, nonce 00:00:00:09:00:00:00:4a:00:00:00:00
+    std::uint32_t key[8];
+    for (int i = 0; i < 8; ++i)
+        key[i] = std::uint32_t(4 * i) | std::uint32_t(4 * i + 1) << 8 | std::uint32_t(4 * i + 2) << 16 | std::uint32_t(4 * i + 3) << 24;
+    static const std::uint32_t rfc[16] = {
+        0xe4e7f110u, 0x15593bd1u, 0x1fdd0f50u, 0xc47120a3u, 0xc7f4d1c7u, 0x0368c033u, 0x9aaa2204u, 0x4e6cd4c3u,
+        0x466482d2u, 0x09aa9f07u, 0x05d7c214u, 0xa2028bd9u, 0xd19c12b5u, 0xb94e16deu, 0xe883d0cbu, 0x4e3c50a2u,
+    };
+    std::uint32_t out[16];
+    ua::chacha_block(key, 0x0900000000000001ull, 0x4a000000ull, 20, out);
+    for (int w = 0; w < 16; ++w) {
+        if (out[w] != rfc[w]) { std::printf("FAIL chacha20 RFC 7539 word %d\n", w); ++g_fail; return; }
+    }
+    // all-zero key and counter: first keystream word per round count
+    struct Kat { int rounds; std::uint32_t w0; };
+    static const Kat kats[] = { { 20, 0xade0b876u }, { 12, 0x6a9af49bu }, { 8, 0x2fef003eu } };
+    const std::uint32_t zero[8] = {};
+    for (const Kat& k : kats) {
+        ua::chacha_block(zero, 0, 0, k.rounds, out);
+        if (out[0] != k.w0) { std::printf("FAIL chacha%d zero-key\n", k.rounds); ++g_fail; return; }
+    }
+    std::printf("ok   chacha known answers\n");
+}
+
+// 256 u64 (two AVX-512 steps) after skipping to (lo, hi) must match scalar
+template<class G>
+static bool matches_scalar(int rounds, std::uint64_t lo, std::uint64_t hi) {
+    std::uint64_t got[256], want[256];
+    G g(99, rounds);
+    ua::detail::ChaChaScalar ref(99, rounds);
+    g.skip_ahead(lo, hi);
+    ref.skip_ahead(lo, hi);
+    g.generate_u64(got, 256);
+    ref.generate_u64(want, 256);
+    for (int i = 0; i < 256; ++i) if (got[i] != want[i]) return false;
+    double gd[128], wd[128];
+    g.generate_double(gd, 128);
+    ref.generate_double(wd, 128);
+    for (int i = 0; i < 128; ++i) if (gd[i] != wd[i]) return false;
+    return true;
+}
+
+template<class G>
+static void check_backend(const char* name) {
+    int fails = g_fail;
+    static const int kRounds[] = { 8, 12, 20 };
+    for (int r : kRounds) {
+        if (!matches_scalar<G>(r, 0, 0)) { std::printf("FAIL %s chacha%d stream\n", name, r); ++g_fail; }
+        // a few blocks before 2^64 so a vector step carries into the high word
+        if (!matches_scalar<G>(r, 0xfffffffffffffffbull, 0)) { std::printf("FAIL %s chacha%d carry\n", name, r); ++g_fail; }
+    }
+    {
+        // jump() == 2^64 blocks
+        G a(5, 20), b(5, 20);
+        a.jump();
+        b.skip_ahead(0, 1);
+        std::uint64_t x[128], y[128];
+        a.generate_u64(x, 128);
+        b.generate_u64(y, 128);
+        for (int i = 0; i < 128; ++i) if (x[i] != y[i]) { std::printf("FAIL %s jump\n", name); ++g_fail; break; }
+    }
+    if (fails == g_fail) std::printf("ok   chacha %s == scalar (8/12/20, carry, jump)\n", name);
+}
+
+// Odd, split requests: u64 and double calls of sizes that cut a block and the
+// step, skip_ahead() and jump() from the middle of a block. The stream must
+// still be the blocks in counter order, whatever the tier's step.
+static const std::size_t kSplit[] = { 5, 8, 1, 3, 37, 2, 64, 13, 33, 31, 129, 7 };
+
+template<class G>
+static void check_split(const char* name) {
+    G g(42, 8);
+    std::uint32_t key[8];
+    ua::chacha_key_from_seed(42, key);
+    std::uint64_t pos = 0, bhi = 0;   // stream position: word pos of block row bhi*2^64
+    auto want = [&](std::uint64_t p) {
+        std::uint32_t w[16];
+        ua::chacha_block(key, p / 8, bhi, 8, w);
+        const std::size_t j = p % 8;
+        return (std::uint64_t(w[2 * j + 1]) << 32) | w[2 * j];
+    };
+    for (int round = 0; round < 3; ++round) {
+        for (std::size_t k = 0; k < sizeof(kSplit) / sizeof(kSplit[0]); ++k) {
+            const std::size_t n = kSplit[k];
+            std::uint64_t u[160];
+            double d[160];
+            if (k & 1) g.generate_double(d, n);
+            else       g.generate_u64(u, n);
+            for (std::size_t j = 0; j < n; ++j) {
+                const std::uint64_t w = want(pos + j);
+                const bool ok = k & 1 ? d[j] == double(w >> 12) * 0x1p-52 : u[j] == w;
+                if (!ok) { std::printf("FAIL chacha %s split round %d call %zu word %zu\n", name, round, k, j); ++g_fail; return; }
+            }
+            pos += n;
+        }
+        if (round == 0) { g.skip_ahead(1001); pos += 8 * 1001; }
+        if (round == 1) { g.jump(); bhi = 1; }
+    }
+    std::printf("ok   chacha %s split odd requests\n", name);
+}
+
+// the facade must give the scalar u64/double stream whatever tier it picked,
+// also when the requests cut its step
+static void check_facade() {
+    const struct { ua::Algorithm a; int rounds; } algos[] = {
+        { ua::Algorithm::ChaCha20, 20 }, { ua::Algorithm::ChaCha12, 12 }, { ua::Algorithm::ChaCha8, 8 },
+    };
+    for (const auto& al : algos) {
+        std::uint64_t got[128], want[128];
+        ua::Rng rng(4242, al.a);
+        ua::detail::ChaChaScalar ref(4242, al.rounds);
+        for (std::size_t i = 0, k = 0; i < 128; i += kSplit[k], ++k) {
+            const std::size_t n = 128 - i < kSplit[k] ? 128 - i : kSplit[k];
+            rng.generate_u64(got + i, n);
+        }
+        ref.generate_u64(want, 128);
+        for (int i = 0; i < 128; ++i) {
+            if (got[i] != want[i]) { std::printf("FAIL ua::Rng chacha%d u64 %d\n", al.rounds, i); ++g_fail; return; }
+        }
+    }
+    {
+        // an explicit key overrides the seed
+        std::uint32_t key[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+        ua::Init init;
+        init.algo = ua::Algorithm::ChaCha20;
+        init.key = key;
+        ua::Rng rng(init);
+        ua::detail::ChaChaScalar ref(key, 20);
+        std::uint64_t got[128], want[128];
+        rng.skip_ahead(1000);
+        ref.skip_ahead(1000);
+        rng.generate_u64(got, 128);
+        ref.generate_u64(want, 128);
+        for (int i = 0; i < 128; ++i) {
+            if (got[i] != want[i]) { std::printf("FAIL ua::Rng chacha20 Init::key %d\n", i); ++g_fail; return; }
+        }
+    }
+    ua::Rng rng(7, ua::Algorithm::ChaCha8);
+    double z[1024];
+    rng.generate_normal(z, 1024);
+    double m = 0;
+    for (double v : z) m += v;
+    if (m / 1024 > 0.2 || m / 1024 < -0.2) { std::printf("FAIL ua::Rng chacha normal mean\n"); ++g_fail; return; }
+    std::printf("ok   ua::Rng chacha (tier %d) matches scalar\n", int(rng.simd_tier()));
+}
+
+int main() {
+    check_kat();
+    check_split<ua::detail::ChaChaScalar>("scalar");
+    check_facade();
+
+    const ua::CpuFeatures f = ua::query_cpu_features();
+#if defined(UA_BUILD_WITH_AVX2)
+    if (f.avx2) {
+        check_backend<ua::detail::ChaChaAVX2>("avx2");
+        check_split<ua::detail::ChaChaAVX2>("avx2");
+    }
+    else std::printf("skip avx2 (cpu)\n");
+#endif
+#if defined(UA_BUILD_WITH_AVX512)
+    if (ua::avx512_ok(f)) {
+        check_backend<ua::detail::ChaChaAVX512>("avx512");
+        check_split<ua::detail::ChaChaAVX512>("avx512");
+    }
+    else std::printf("skip avx512 (cpu)\n");
+#endif
+    (void)f;
+    return g_fail ? 1 : 0;
+}
@@ -0,0 +1,763 @@
+// Distributions beyond the normal: the SIMD kernels against the scalar
+// kernel (odd lengths, in place, nothing written past the end, AVX2 and
+// AVX-512 bit for bit) and each ua::Rng sampler's moments on whatever tier
+// it picked. Exponential: -ln(u) / rate. Gamma: the Marsaglia–Tsang and
+// boost kernels, GammaGenerator / BetaGenerator / DirichletGenerator
+// moments, tiny shapes included. Poisson / binomial: the kernels' counts
+// and misses, Rng::generate_poisson / generate_binomial moments and pmf.
+// Bounded integers: the Lemire kernels against a schoolbook reference,
+// Rng::generate_uniform_int bounds, moments, pmf and full ranges; the
+// per-value bound kernels, and Shuffler / Rng::shuffle permutations (both
+// the Fisher–Yates and the blocked path) uniform over orders and positions.
+// Alias tables: the gather kernels against the definition, Vose's masses
+// against the weights, AliasTable updates against fresh builds, and
+// Rng::generate_categorical's pmf, sharded or not.
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+
+#include "ua/ua_cpuid.h"
+#include "ua/ua_rng.h"
+#include "ua/ua_exponential.h"
+#include "ua/ua_distributions.h"
+#include "ua/ua_uniform_int.h"
+#include "ua/ua_shuffle.h"
+#include "ua/ua_alias.h"
+#include "ua/ua_normal_ziggurat.h"
+#include "ua/ua_xoshiro256ss_scalar.h"
+
+#include "test_kernels.h"
+
+static int g_fail = 0;
+
+// mean, variance and (cut >= 0) one tail mass against their exact values,
+// within 5 sd for the sample size; the variance's sd comes from the
+// sample's own fourth moment
+static void check_moments(const char* name, const double* x, std::size_t n,
+                          double mean, double var, double cut = -1.0, double tail = 0.0) {
+    double m = 0, t = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        m += x[i];
+        if (x[i] > cut) t += 1;
+    }
+    m /= double(n); t /= double(n);
+    double v = 0, m4 = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const double e = (x[i] - m) * (x[i] - m);
+        v += e; m4 += e * e;
+    }
+    v /= double(n); m4 /= double(n);
+    const double sd_m = std::sqrt(var / double(n)), sd_v = std::sqrt((m4 - v * v) / double(n));
+    if (!(std::fabs(m - mean) <= 5 * sd_m) || !(std::fabs(v - var) <= 5 * sd_v) ||
+        (cut >= 0 && !(std::fabs(t - tail) <= 5 * std::sqrt(tail * (1 - tail) / double(n))))) {
+        std::printf("FAIL %s mean %g (%g) var %g (%g) tail %g (%g)\n", name, m, mean, v, var, t, tail);
+        ++g_fail; return;
+    }
+    std::printf("ok   %s moments\n", name);
+}
+
+// -------------------------------- exponential --------------------------------
+
+static void check_exponential(const char* name, ua::detail::ExponentialFn fn,
+                              ua::detail::ExponentialFn ref, double tol_ulp) {
+    ua::detail::Xoshiro256ssScalar g(1917);
+    std::vector<double> u(kMaxLength);
+    g.generate_double(u.data(), u.size());
+    const double edges[] = { 0x1p-53, 1.0 - 0x1p-53, 0.5, 0x1p-1022, 0x1p-1074, 1e-300 };
+    std::copy(std::begin(edges), std::end(edges), u.begin());
+    for (double& v : u) if (v == 0.0) v = 0x1p-53;
+    auto rate = [](ua::detail::ExponentialFn f) {
+        return [f](const double* in, std::size_t n, double* out) { f(in, n, 0.25, out); return n; };
+    };
+    if (const std::size_t n = kernel_vs_ref(u.data(), 1, 0, rate(fn), rate(ref), tol_ulp)) {
+        std::printf("FAIL exponential %s n=%zu\n", name, n); ++g_fail; return;
+    }
+    std::printf("ok   exponential %s\n", name);
+}
+
+// generate_exponential = the kernel on (2k + 1) 2^-53 of the u64 that the
+// same generator returns for the same (512-chunked) requests
+static void check_exponential_facade() {
+    std::vector<double> x(1 << 20), want(1 << 20);
+    std::vector<std::uint64_t> w(1 << 20);
+    for (ua::Algorithm a : { ua::Algorithm::Xoshiro256ss, ua::Algorithm::Philox4x32_10 }) {
+        ua::Rng rng(5, a), twin(5, a);
+        std::size_t i = 0;
+        for (std::size_t step : { std::size_t(1), std::size_t(5), std::size_t(511), std::size_t(513), x.size() - 1030 }) {
+            rng.generate_exponential(x.data() + i, step, 2.0);
+            for (std::size_t k = 0; k < step; k += 512) twin.generate_u64(w.data() + i + k, std::min<std::size_t>(512, step - k));
+            i += step;
+        }
+        for (std::size_t j = 0; j < w.size(); ++j) want[j] = (double(w[j] >> 12) + 0.5) * 0x1p-52;
+        ua::detail::exponential_scalar(want.data(), want.size(), 0.5, want.data());
+        char name[64];
+        std::snprintf(name, sizeof(name), "generate_exponential algo %d tier %d", int(a), int(rng.simd_tier()));
+        for (std::size_t j = 0; j < x.size(); ++j)
+            if (!(x[j] > 0.0) || !close_ulp(x[j], want[j], 4.0)) {
+                std::printf("FAIL %s at %zu: %a vs %a\n", name, j, x[j], want[j]); ++g_fail; return;
+            }
+        // Exp(2): mean 1/2, variance 1/4, P(X > 1.5) = e^-3
+        check_moments(name, x.data(), x.size(), 0.5, 0.25, 1.5, std::exp(-3.0));
+    }
+}
+
+// ---------------------------------- gamma ----------------------------------
+
+// Marsaglia–Tsang kernel against a reference kernel (kernel_vs_ref: same
+// accepted count, in place over z, nothing written past n + GAMMA_SLACK)
+static void check_gamma_mt(const char* name, ua::detail::GammaFn fn, ua::detail::GammaFn ref, double tol_ulp) {
+    ua::detail::Xoshiro256ssScalar g(2718);
+    std::vector<double> z(kMaxLength), u(kMaxLength);
+    ua::ZigguratNormal::generate(g, z.data(), z.size());
+    g.generate_double(u.data(), u.size());
+    z[0] = -3.0; z[1] = -4.0; z[2] = 6.0;   // 1 + c z <= 0 for the small shapes, far tail
+    for (double shape : { 1.0, 1.3, 2.5, 50.0 }) {   // d from 2/3 (the boost's smallest) up
+        const double d = shape - 1.0 / 3.0, c = 1.0 / std::sqrt(9.0 * d);
+        auto mt = [&](ua::detail::GammaFn f) {
+            return [&, f](const double* in, std::size_t n, double* out) { return f(in, u.data(), n, d, c, out); };
+        };
+        // 1 + c z cancels near z = -1/c, where the SIMD fma and the scalar
+        // mul + add round differently: tolerance in ulps of |x| + d
+        if (const std::size_t n = kernel_vs_ref(z.data(), 1, ua::detail::GAMMA_SLACK, mt(fn), mt(ref), tol_ulp, d)) {
+            std::printf("FAIL gamma mt %s shape %g n=%zu\n", name, shape, n); ++g_fail; return;
+        }
+    }
+    std::printf("ok   gamma mt %s\n", name);
+}
+
+// boost kernel against a reference kernel. The ln error is scaled by
+// inv_shape ln(1 - u) in the exponent, so tol_ulp grows with it; results in
+// the subnormals (u near 1, large inv_shape) may differ by a few of their
+// own ulps.
+static void check_gamma_boost(const char* name, ua::detail::GammaBoostFn fn, ua::detail::GammaBoostFn ref, double tol_ulp) {
+    ua::detail::Xoshiro256ssScalar g(1414);
+    std::vector<double> u(1031), x0(1031);
+    g.generate_double(u.data(), u.size());
+    g.generate_double(x0.data(), x0.size());
+    u[0] = 0.0; u[1] = 1.0 - 0x1p-53; u[2] = 0.5;
+    for (double inv : { 1.0 / 0.9, 1.0 / 0.3, 1.0 / 0.05, 1.0 / 0.002 }) {
+        for (std::size_t n : { std::size_t(1), std::size_t(3), std::size_t(4), std::size_t(9), std::size_t(1031) }) {
+            std::vector<double> want(x0.begin(), x0.begin() + n), got(x0.begin(), x0.begin() + n + 1);
+            got[n] = -99.0;
+            ref(u.data(), n, inv, want.data());
+            fn(u.data(), n, inv, got.data());
+            bool ok = got[n] == -99.0;
+            for (std::size_t j = 0; ok && j < n; ++j) {
+                const double e = std::fabs(inv * std::log1p(-u[j]));
+                ok = std::fabs(got[j] - want[j]) <= tol_ulp * (1.0 + e) * std::fabs(want[j]) * 0x1p-52 + 0x1p-1072;
+            }
+            if (!ok) { std::printf("FAIL gamma boost %s 1/shape %g n=%zu\n", name, inv, n); ++g_fail; return; }
+        }
+    }
+    std::printf("ok   gamma boost %s\n", name);
+}
+
+static void check_gamma_generators() {
+    ua::Rng rng(8080);
+    std::vector<double> x((1 << 20) + 1, -99.0);
+    char name[80];
+    ua::GammaGenerator<ua::Rng> gamma(rng);
+    for (double shape : { 0.3, 1.0, 2.5, 40.0 }) {
+        // odd pieces: block tails and the boost's short batches
+        std::size_t i = 0;
+        for (std::size_t step : { std::size_t(1), std::size_t(7), std::size_t(1023), std::size_t(1025) }) {
+            gamma.generate(x.data() + i, step, shape, 2.0);
+            i += step;
+        }
+        gamma.generate(x.data() + i, x.size() - 1 - i, shape, 2.0);
+        if (x.back() != -99.0) { std::printf("FAIL GammaGenerator overrun\n"); ++g_fail; return; }
+        std::snprintf(name, sizeof(name), "Gamma(%g, 2) tier %d", shape, int(rng.simd_tier()));
+        // Gamma(1, 2) is Exp(1/2): P(X > 2) = e^-1
+        if (shape == 1.0) check_moments(name, x.data(), x.size() - 1, 2.0, 4.0, 2.0, std::exp(-1.0));
+        else              check_moments(name, x.data(), x.size() - 1, 2.0 * shape, 4.0 * shape);
+    }
+
+    ua::BetaGenerator<ua::Rng> beta(rng);
+    const struct { double a, b; } shapes[] = { { 2.0, 5.0 }, { 0.5, 0.5 }, { 1e-3, 1e-3 } };
+    for (const auto& [a, b] : shapes) {
+        beta.generate(x.data(), x.size() - 1, a, b);
+        bool in = true;
+        for (std::size_t j = 0; j + 1 < x.size(); ++j) in = in && x[j] >= 0.0 && x[j] <= 1.0;
+        std::snprintf(name, sizeof(name), "Beta(%g, %g)", a, b);
+        if (!in) { std::printf("FAIL %s outside [0, 1]\n", name); ++g_fail; continue; }
+        check_moments(name, x.data(), x.size() - 1, a / (a + b), a * b / ((a + b) * (a + b) * (a + b + 1)));
+    }
+
+    ua::DirichletGenerator<ua::Rng> dir(rng);
+    for (std::vector<double> alpha : { std::vector<double>{ 0.5, 1.0, 2.0, 3.5 }, std::vector<double>{ 1e-3, 1e-3, 1e-3 } }) {
+        const std::size_t k = alpha.size(), rows = (1 << 18) + 3;
+        std::vector<double> d(rows * k), col(rows);
+        dir.generate(alpha.data(), k, d.data(), rows);
+        double a0 = 0;
+        for (double a : alpha) a0 += a;
+        bool sums = true;
+        for (std::size_t r = 0; r < rows; ++r) {
+            double s = 0;
+            for (std::size_t c = 0; c < k; ++c) s += d[r * k + c];
+            sums = sums && std::fabs(s - 1.0) <= 1e-14;
+        }
+        std::snprintf(name, sizeof(name), "Dirichlet(%g, ...) rows", alpha[0]);
+        if (!sums) { std::printf("FAIL %s do not sum to 1\n", name); ++g_fail; continue; }
+        for (std::size_t c = 0; c < k; ++c) {
+            for (std::size_t r = 0; r < rows; ++r) col[r] = d[r * k + c];
+            std::snprintf(name, sizeof(name), "Dirichlet(%g, ...) component %zu", alpha[0], c);
+            check_moments(name, col.data(), rows, alpha[c] / a0, alpha[c] * (a0 - alpha[c]) / (a0 * a0 * (a0 + 1)));
+        }
+    }
+}
+
+// -------------------------------- discrete --------------------------------
+
+// counts and miss lists of a kernel against a reference kernel over means
+// on both sides of the inversion / rejection split; `mismatch` elements may
+// differ (the scalar kernel decides differently within an ulp of a bound)
+template<class Run>
+static void check_discrete(const char* name, Run run, std::size_t mismatch) {
+    ua::detail::Xoshiro256ssScalar g(4242);
+    std::vector<double> u(kMaxLength), v(kMaxLength);
+    g.generate_double(u.data(), u.size());
+    g.generate_double(v.data(), v.size());
+    u[0] = 0.0; u[1] = 1.0 - 0x1p-53; u[2] = 0.5; v[3] = 1.0 - 0x1p-53;
+    for (std::size_t n : kLengths) {
+        std::vector<std::uint32_t> want(n, 0), got(n + 1, 0), mw(n), mg(n);
+        got[n] = 0xDEADBEEF;
+        const auto [nw, ng] = run(u.data(), v.data(), n, want.data(), got.data(), mw.data(), mg.data());
+        std::size_t bad = got[n] != 0xDEADBEEF ? mismatch + 1 : 0;
+        std::vector<char> missed(n, 0);
+        for (std::size_t t = 0; t < nw; ++t) missed[mw[t]] |= 1;
+        for (std::size_t t = 0; t < ng; ++t) missed[mg[t]] |= 2;
+        for (std::size_t j = 0; j < n; ++j) bad += missed[j] == 1 || missed[j] == 2 || (!missed[j] && got[j] != want[j]);
+        if (bad > mismatch) { std::printf("FAIL %s n=%zu (%zu differ)\n", name, n, bad); ++g_fail; return; }
+    }
+    std::printf("ok   %s\n", name);
+}
+
+static void check_poisson(const char* name, ua::detail::PoissonFn fn, ua::detail::PoissonFn ref, std::size_t mismatch) {
+    const double means[] = { 0.0, 0.5, 3.0, 9.999, 10.0, 30.0, 1000.0, 1e6, 1e9, 2.0, 10.5 };
+    std::vector<double> lam(1031);
+    for (std::size_t j = 0; j < lam.size(); ++j) lam[j] = means[(j * 7) % 11];
+    char full[64];
+    std::snprintf(full, sizeof(full), "poisson %s", name);
+    check_discrete(full, [&](const double* u, const double* v, std::size_t n, std::uint32_t* want, std::uint32_t* got,
+                             std::uint32_t* mw, std::uint32_t* mg) {
+        return std::pair{ ref(lam.data(), u, v, n, want, mw), fn(lam.data(), u, v, n, got, mg) };
+    }, mismatch);
+}
+
+static void check_binomial(const char* name, ua::detail::BinomialFn fn, ua::detail::BinomialFn ref, std::size_t mismatch) {
+    const struct { std::uint32_t n; double p; } cases[] = {
+        { 0, 0.5 }, { 10, 0.0 }, { 10, 1.0 }, { 19, 0.5 }, { 20, 0.5 }, { 100, 0.3 }, { 100, 0.93 },
+        { 4000000000u, 1e-9 }, { 4000000000u, 0.5 }, { 4294967295u, 0.999 }, { 1000, 0.01 } };
+    std::vector<std::uint32_t> trials(1031);
+    std::vector<double> p(1031);
+    for (std::size_t j = 0; j < p.size(); ++j) { trials[j] = cases[(j * 7) % 11].n; p[j] = cases[(j * 7) % 11].p; }
+    char full[64];
+    std::snprintf(full, sizeof(full), "binomial %s", name);
+    check_discrete(full, [&](const double* u, const double* v, std::size_t n, std::uint32_t* want, std::uint32_t* got,
+                             std::uint32_t* mw, std::uint32_t* mg) {
+        return std::pair{ ref(trials.data(), p.data(), u, v, n, want, mw), fn(trials.data(), p.data(), u, v, n, got, mg) };
+    }, mismatch);
+}
+
+// chi-square of the counts against pmf(k), bins with 10+ expected (the
+// rest pooled), at most 5 sd high on the Wilson–Hilferty normal scale
+template<class Pmf>
+static void check_pmf(const char* name, const std::uint32_t* x, std::size_t n, std::uint32_t kmax, Pmf pmf) {
+    std::vector<double> seen(kmax + 2, 0.0);
+    for (std::size_t j = 0; j < n; ++j) seen[std::min(x[j], kmax + 1)] += 1;
+    double chi2 = 0, pool_seen = 0, pool_want = 0, rest = 1.0;
+    int df = -1;
+    for (std::uint32_t k = 0; k <= kmax; ++k) {
+        const double e = pmf(k) * double(n);
+        rest -= pmf(k);
+        if (e >= 10) { chi2 += (seen[k] - e) * (seen[k] - e) / e; ++df; }
+        else         { pool_seen += seen[k]; pool_want += e; }
+    }
+    pool_seen += seen[kmax + 1]; pool_want += std::max(rest, 0.0) * double(n);
+    if (pool_want >= 10) { chi2 += (pool_seen - pool_want) * (pool_seen - pool_want) / pool_want; ++df; }
+    const double s2 = 2.0 / (9.0 * df);
+    if (!(std::cbrt(chi2 / df) - (1.0 - s2) <= 5 * std::sqrt(s2))) {
+        std::printf("FAIL %s chi2 %g on %d df\n", name, chi2, df); ++g_fail; return;
+    }
+    std::printf("ok   %s pmf\n", name);
+}
+
+static void check_discrete_facade() {
+    ua::Rng rng(31337);
+    const std::size_t n = 1 << 20;
+    std::vector<std::uint32_t> k(n + 1, 0xDEADBEEF);
+    std::vector<double> lam(n), x(n);
+    std::vector<std::uint32_t> trials(n);
+    std::vector<double> p(n);
+    char name[80];
+    for (double l : { 0.0, 0.3, 4.0, 9.9, 10.0, 37.5, 2.5e5 }) {
+        std::fill(lam.begin(), lam.end(), l);
+        rng.generate_poisson(lam.data(), k.data(), n);
+        if (k[n] != 0xDEADBEEF) { std::printf("FAIL generate_poisson overrun\n"); ++g_fail; return; }
+        for (std::size_t j = 0; j < n; ++j) x[j] = k[j];
+        std::snprintf(name, sizeof(name), "Poisson(%g) tier %d", l, int(rng.simd_tier()));
+        if (l == 0.0) {
+            if (std::count(k.begin(), k.end() - 1, 0u) != std::ptrdiff_t(n)) { std::printf("FAIL %s not all 0\n", name); ++g_fail; }
+            continue;
+        }
+        check_moments(name, x.data(), n, l, l);
+        if (l < 100)
+            check_pmf(name, k.data(), n, std::uint32_t(4 * l + 20),
+                      [l](std::uint32_t j) { return std::exp(j * std::log(l) - l - std::lgamma(j + 1.0)); });
+    }
+    // one mean per element: alternating classes, each checked on its own
+    for (std::size_t j = 0; j < n; ++j) lam[j] = (j % 3) ? 2.5 : 120.0;
+    rng.generate_poisson(lam.data(), k.data(), n);
+    for (double l : { 2.5, 120.0 }) {
+        std::size_t m = 0;
+        for (std::size_t j = 0; j < n; ++j) if (lam[j] == l) x[m++] = k[j];
+        std::snprintf(name, sizeof(name), "Poisson mixed, mean %g", l);
+        check_moments(name, x.data(), m, l, l);
+    }
+
+    const struct { std::uint32_t t; double p; } cases[] = {
+        { 1, 0.5 }, { 19, 0.5 }, { 30, 0.7 }, { 100, 0.3 }, { 1000, 0.999 }, { 3000000000u, 0.25 }, { 50, 1.0 } };
+    for (const auto& [t, q] : cases) {
+        std::fill(trials.begin(), trials.end(), t);
+        std::fill(p.begin(), p.end(), q);
+        rng.generate_binomial(trials.data(), p.data(), k.data(), n);
+        if (k[n] != 0xDEADBEEF) { std::printf("FAIL generate_binomial overrun\n"); ++g_fail; return; }
+        bool in = true;
+        for (std::size_t j = 0; j < n; ++j) { in = in && k[j] <= t; x[j] = k[j]; }
+        std::snprintf(name, sizeof(name), "Binomial(%u, %g) tier %d", t, q, int(rng.simd_tier()));
+        if (!in) { std::printf("FAIL %s above n\n", name); ++g_fail; continue; }
+        if (q == 1.0) {
+            if (std::count(k.begin(), k.end() - 1, t) != std::ptrdiff_t(n)) { std::printf("FAIL %s not all n\n", name); ++g_fail; }
+            continue;
+        }
+        check_moments(name, x.data(), n, t * q, t * q * (1 - q));
+        if (t <= 1000)
+            check_pmf(name, k.data(), n, t, [t, q](std::uint32_t j) {
+                return std::exp(std::lgamma(t + 1.0) - std::lgamma(j + 1.0) - std::lgamma(t - j + 1.0)
+                                + j * std::log(q) + (t - j) * std::log1p(-q));
+            });
+    }
+}
+
+// ------------------------------ bounded ints ------------------------------
+
+// high / low words of x s from 16-bit digits, independent of the kernels
+static void mul_ref(std::uint64_t x, std::uint64_t s, std::uint64_t& hi, std::uint64_t& lo) {
+    std::uint32_t r[8] = {};
+    for (int i = 0; i < 4; ++i) {
+        std::uint64_t c = 0;
+        for (int j = 0; j < 4; ++j) {
+            c += std::uint64_t(r[i + j]) + ((x >> (16 * i)) & 0xffff) * ((s >> (16 * j)) & 0xffff);
+            r[i + j] = std::uint32_t(c & 0xffff); c >>= 16;
+        }
+        for (int k = i + 4; c; ++k) { c += r[k]; r[k] = std::uint32_t(c & 0xffff); c >>= 16; }
+    }
+    lo = hi = 0;
+    for (int i = 3; i >= 0; --i) { lo = lo << 16 | r[i]; hi = hi << 16 | r[i + 4]; }
+}
+
+// values and miss list of a kernel against the definition (u32: the
+// halves of x, low first), odd lengths, nothing written past n; word 0
+// (low product 0) misses for every s that does not divide 2^w
+template<class T, class Fn>
+static void check_uniform(const char* name, Fn fn, std::initializer_list<T> ranges) {
+    constexpr std::size_t PER = sizeof(std::uint64_t) / sizeof(T), W = 8 * sizeof(T);
+    ua::detail::Xoshiro256ssScalar g(777);
+    std::vector<std::uint64_t> x(1031);
+    g.generate_u64(x.data(), x.size());
+    x[0] = 0; x[1] = ~std::uint64_t(0); x[2] = std::uint64_t(1) << 63;
+    for (T s : ranges) {
+        const T lo = T(12345);
+        T t = 0;   // 2^w mod s
+        if constexpr (W == 32) t = T((std::uint64_t(1) << 32) % s);
+        else t = (T(0) - s) % s;
+        for (std::size_t n : { std::size_t(1), std::size_t(2), std::size_t(7), std::size_t(15), std::size_t(16),
+                               std::size_t(17), std::size_t(33), std::size_t(1031) }) {
+            std::vector<T> got(n + 1, T(0xDEADBEEF));
+            std::vector<std::uint32_t> miss(n);
+            const std::size_t r = fn(x.data(), n, lo, s, got.data(), miss.data());
+            std::size_t bad = got[n] != T(0xDEADBEEF), m = 0;
+            for (std::size_t j = 0; j < n; ++j) {
+                const std::uint64_t xj = W == 32 ? (x[j / PER] >> (32 * (j % PER))) & 0xffffffffu : x[j];
+                std::uint64_t h, l;
+                mul_ref(xj, s, h, l);
+                if constexpr (W == 32) { h = l >> 32; l &= 0xffffffffu; }
+                if (l < t) bad += m >= r || miss[m++] != j;
+                else       bad += got[j] != T(lo + h);
+            }
+            bad += m != r;
+            if (bad) { std::printf("FAIL uniform %s s=%llu n=%zu (%zu differ)\n", name, (unsigned long long)s, n, bad); ++g_fail; return; }
+        }
+    }
+    std::printf("ok   uniform %s\n", name);
+}
+
+static void check_uniform_facade() {
+    ua::Rng rng(2718);
+    const std::size_t n = 1 << 20;
+    std::vector<std::uint32_t> a(n + 1, 0xDEADBEEF), k(n);
+    std::vector<std::uint64_t> b(n + 1, 0xDEADBEEF);
+    std::vector<double> x(n);
+    char name[80];
+    // small ranges: pmf of v - lo
+    for (std::uint64_t lo : { std::uint64_t(0), std::uint64_t(5), std::uint64_t(1) << 40 }) {
+        const std::uint64_t hi = lo + 6;
+        std::snprintf(name, sizeof(name), "uniform_int u64 [%llu, %llu]", (unsigned long long)lo, (unsigned long long)hi);
+        rng.generate_uniform_int(lo, hi, b.data(), n);
+        for (std::size_t j = 0; j < n; ++j) k[j] = std::uint32_t(std::min<std::uint64_t>(b[j] - lo, 7));
+        check_pmf(name, k.data(), n, 6, [](std::uint32_t j) { return j <= 6 ? 1.0 / 7 : 0.0; });
+        if (lo >> 32) continue;
+        std::snprintf(name, sizeof(name), "uniform_int u32 [%llu, %llu]", (unsigned long long)lo, (unsigned long long)hi);
+        rng.generate_uniform_int(lo, hi, a.data(), n);
+        for (std::size_t j = 0; j < n; ++j) k[j] = std::min<std::uint32_t>(a[j] - std::uint32_t(lo), 7);
+        check_pmf(name, k.data(), n, 6, [](std::uint32_t j) { return j <= 6 ? 1.0 / 7 : 0.0; });
+    }
+    // wide ranges: bounds and moments; s = 2^31 + 1 rejects half the words
+    // and 2^31 + 2^30 would put a plain modulo's bias in the mean
+    const struct { std::uint64_t lo, hi; } r32[] = { { 0, 0x80000000u }, { 7, 0xC0000006u }, { 100, 100 }, { 1, 0xFFFFFFFFu } };
+    for (const auto& [lo, hi] : r32) {
+        rng.generate_uniform_int(lo, hi, a.data(), n);
+        bool in = a[n] == 0xDEADBEEF;
+        for (std::size_t j = 0; j < n; ++j) { in = in && a[j] >= lo && a[j] <= hi; x[j] = double(a[j]); }
+        std::snprintf(name, sizeof(name), "uniform_int u32 [%llu, %llu] tier %d", (unsigned long long)lo, (unsigned long long)hi, int(rng.simd_tier()));
+        if (!in) { std::printf("FAIL %s out of range\n", name); ++g_fail; continue; }
+        const double s = double(hi - lo) + 1;
+        if (lo == hi) { std::printf("ok   %s\n", name); continue; }
+        check_moments(name, x.data(), n, double(lo) + (s - 1) / 2, (s * s - 1) / 12);
+    }
+    const struct { std::uint64_t lo, hi; } r64[] = {
+        { 0, 0x8000000000000000ull }, { 1, 0xBFFFFFFFFFFFFFFFull }, { 3, 0x10000000002ull }, { 1, ~0ull } };
+    for (const auto& [lo, hi] : r64) {
+        rng.generate_uniform_int(lo, hi, b.data(), n);
+        bool in = b[n] == 0xDEADBEEF;
+        for (std::size_t j = 0; j < n; ++j) { in = in && b[j] >= lo && b[j] <= hi; x[j] = double(b[j] - lo); }
+        std::snprintf(name, sizeof(name), "uniform_int u64 [%llu, %llu] tier %d", (unsigned long long)lo, (unsigned long long)hi, int(rng.simd_tier()));
+        if (!in) { std::printf("FAIL %s out of range\n", name); ++g_fail; continue; }
+        const double s = double(hi - lo) + 1;
+        check_moments(name, x.data(), n, (s - 1) / 2, s * s / 12);
+    }
+    // full ranges are the u64 stream itself
+    ua::Rng p(99), q(99);
+    std::vector<std::uint64_t> raw(n / 2 + 1);
+    p.generate_uniform_int(0, 0xFFFFFFFFu, a.data(), 2 * (n / 4) + 1);
+    q.generate_u64(raw.data(), n / 4 + 1);
+    bool same = true;
+    for (std::size_t j = 0; j <= 2 * (n / 4); ++j) same = same && a[j] == std::uint32_t(raw[j / 2] >> (32 * (j & 1)));
+    p.generate_uniform_int(0, ~0ull, b.data(), 1000);
+    q.generate_u64(raw.data(), 1000);
+    for (std::size_t j = 0; j < 1000; ++j) same = same && b[j] == raw[j];
+    if (!same) { std::printf("FAIL uniform_int full range != u64 stream\n"); ++g_fail; }
+    else std::printf("ok   uniform_int full ranges\n");
+    // lo > hi, or hi past u32 for u32 out: out untouched; [5, 2^32 + 4] has
+    // s >> 32 set too, but is not the full u32 range
+    std::fill(a.begin(), a.begin() + 64, 0xDEADBEEF);
+    std::fill(b.begin(), b.begin() + 64, 0xDEADBEEF);
+    p.generate_uniform_int(5, 4, a.data(), 64);
+    p.generate_uniform_int(5, (std::uint64_t(1) << 32) + 4, a.data(), 64);
+    p.generate_uniform_int(0, std::uint64_t(1) << 32, a.data(), 64);
+    p.generate_uniform_int(~0ull, 0, b.data(), 64);
+    bool kept = true;
+    for (std::size_t j = 0; j < 64; ++j) kept = kept && a[j] == 0xDEADBEEF && b[j] == 0xDEADBEEF;
+    if (!kept) { std::printf("FAIL uniform_int wrote an invalid range\n"); ++g_fail; }
+    else std::printf("ok   uniform_int invalid ranges\n");
+}
+
+// per-value bounds: values and misses against the definition, the bounds
+// mixed from 1 to 2^32 - 1 (x[0] = 0 misses wherever s does not divide 2^32)
+static void check_uniform_bounds(const char* name, ua::detail::UniformBoundsFn fn) {
+    ua::detail::Xoshiro256ssScalar g(778);
+    std::vector<std::uint64_t> x(516);
+    std::vector<std::uint32_t> s(1031);
+    g.generate_u64(x.data(), x.size());
+    x[0] = 0;
+    const std::uint32_t pick[] = { 1u, 2u, 3u, 1000u, 1000000u, 0x80000001u, 0xC0000000u, 0xFFFFFFFFu };
+    for (std::size_t j = 0; j < s.size(); ++j) s[j] = j < 8 ? pick[j] : pick[(j * 5) % 8] - std::uint32_t(j % 3) * (pick[(j * 5) % 8] > 3);
+    for (std::size_t n : { std::size_t(1), std::size_t(7), std::size_t(16), std::size_t(17), std::size_t(1031) }) {
+        std::vector<std::uint32_t> got(n + 1, 0xDEADBEEF), miss(n);
+        const std::size_t r = fn(x.data(), s.data(), n, got.data(), miss.data());
+        std::size_t bad = got[n] != 0xDEADBEEF, m = 0;
+        for (std::size_t j = 0; j < n; ++j) {
+            const std::uint64_t p = ((x[j / 2] >> (32 * (j & 1))) & 0xffffffffu) * s[j];
+            if (std::uint32_t(p) < (std::uint64_t(1) << 32) % s[j]) bad += m >= r || miss[m++] != j;
+            else bad += got[j] != std::uint32_t(p >> 32);
+        }
+        bad += m != r;
+        if (bad) { std::printf("FAIL uniform bounds %s n=%zu (%zu differ)\n", name, n, bad); ++g_fail; return; }
+    }
+    std::printf("ok   uniform bounds %s\n", name);
+}
+
+// rank of a permutation of 0..k-1 (Lehmer code)
+static std::uint32_t perm_rank(const std::uint8_t* p, std::size_t k) {
+    std::uint32_t r = 0;
+    for (std::size_t i = 0; i < k; ++i) {
+        std::uint32_t less = 0;
+        for (std::size_t j = i + 1; j < k; ++j) less += p[j] < p[i];
+        r = r * std::uint32_t(k - i) + less;
+    }
+    return r;
+}
+
+static void check_shuffle() {
+    ua::Rng rng(4711);
+    char name[80];
+    // a permutation of the input, for short, odd, block-crossing and blocked sizes
+    for (std::size_t n : { std::size_t(0), std::size_t(1), std::size_t(2), std::size_t(513), std::size_t(100000),
+                           std::size_t(3) << 20 }) {
+        std::vector<std::uint32_t> a(n);
+        std::iota(a.begin(), a.end(), 0u);
+        rng.shuffle(a.data(), n);
+        std::size_t fixed = 0;
+        for (std::size_t j = 0; j < n; ++j) fixed += a[j] == j;
+        std::sort(a.begin(), a.end());
+        bool perm = true;
+        for (std::size_t j = 0; j < n; ++j) perm = perm && a[j] == j;
+        std::snprintf(name, sizeof(name), "shuffle n=%zu tier %d", n, int(rng.simd_tier()));
+        if (!perm || (n > 1000 && fixed > 20)) { std::printf("FAIL %s (%zu fixed)\n", name, fixed); ++g_fail; }
+        else std::printf("ok   %s\n", name);
+    }
+    // all 5! orders equally likely: Fisher–Yates, and the blocked path
+    // split down to single elements
+    const std::size_t trials = 240000;
+    std::vector<std::uint32_t> rank(trials);
+    for (std::size_t blocked : { std::size_t(1) << 20, std::size_t(0) }) {
+        ua::Shuffler<ua::Rng> sh(rng);
+        sh.blocked_bytes = blocked;
+        sh.group_bytes = 1;
+        for (std::size_t t = 0; t < trials; ++t) {
+            std::uint8_t p[5] = { 0, 1, 2, 3, 4 };
+            sh.shuffle(p, 5);
+            rank[t] = perm_rank(p, 5);
+        }
+        std::snprintf(name, sizeof(name), "shuffle 5! orders, blocked above %zu B", blocked);
+        check_pmf(name, rank.data(), trials, 119, [](std::uint32_t) { return 1.0 / 120; });
+    }
+    // blocked path on a large array: where element 0 and the last element
+    // land, over 64 position bands
+    {
+        ua::Shuffler<ua::Rng> sh(rng);
+        sh.blocked_bytes = 0;
+        sh.group_bytes = 4096;
+        const std::size_t n = 1 << 14, reps = 1500;
+        std::vector<std::uint32_t> a(n), band(2 * reps);
+        for (std::size_t t = 0; t < reps; ++t) {
+            std::iota(a.begin(), a.end(), 0u);
+            sh.shuffle(a.data(), n);
+            if (t == 0) {
+                std::vector<std::uint32_t> b(a);
+                std::sort(b.begin(), b.end());
+                for (std::size_t j = 0; j < n; ++j)
+                    if (b[j] != j) { std::printf("FAIL shuffle blocked: not a permutation\n"); ++g_fail; return; }
+            }
+            for (std::size_t j = 0; j < n; ++j) {
+                if (a[j] == 0)     band[2 * t] = std::uint32_t(j >> 8);
+                if (a[j] == n - 1) band[2 * t + 1] = std::uint32_t(j >> 8);
+            }
+        }
+        check_pmf("shuffle blocked positions", band.data(), band.size(), 63, [](std::uint32_t) { return 1.0 / 64; });
+    }
+}
+
+// ------------------------------- alias tables -------------------------------
+
+// values and miss list of a kernel against the definition, with and without
+// per-draw bases, odd lengths, nothing written past n (x[0] = 0 misses
+// wherever k does not divide 2^32)
+static void check_alias(const char* name, ua::detail::AliasFn fn) {
+    ua::detail::Xoshiro256ssScalar g(2024);
+    std::vector<std::uint64_t> x(1031);
+    g.generate_u64(x.data(), x.size());
+    x[0] = 0;
+    for (std::uint32_t k : { 1u, 3u, 7u, 1000u, 65537u }) {
+        const std::size_t cols = 4 * std::size_t(k);
+        std::vector<std::uint32_t> prob(cols), alias(cols), base(x.size());
+        for (std::size_t c = 0; c < cols; ++c) {
+            std::uint64_t r;
+            g.generate_u64(&r, 1);
+            prob[c] = c % 5 == 0 ? 0xFFFFFFFFu : c % 7 == 0 ? 0u : std::uint32_t(r);
+            alias[c] = std::uint32_t((r >> 32) % cols);
+        }
+        for (std::size_t j = 0; j < base.size(); ++j) base[j] = std::uint32_t(j % 4) * k;
+        for (bool based : { false, true })
+        for (std::size_t n : { std::size_t(1), std::size_t(7), std::size_t(16), std::size_t(17), std::size_t(1031) }) {
+            std::vector<std::uint32_t> got(n + 1, 0xDEADBEEF), miss(n);
+            const std::uint32_t t = std::uint32_t((std::uint64_t(1) << 32) % k);
+            const std::size_t r = fn(prob.data(), alias.data(), k, t, x.data(), based ? base.data() : nullptr, n, got.data(), miss.data());
+            std::size_t bad = got[n] != 0xDEADBEEF, m = 0;
+            for (std::size_t j = 0; j < n; ++j) {
+                const std::uint64_t p = (x[j] >> 32) * k;
+                if (std::uint32_t(p) < t) { bad += m >= r || miss[m++] != j; continue; }
+                const std::uint32_t c = std::uint32_t(p >> 32) + (based ? base[j] : 0);
+                bad += got[j] != (std::uint32_t(x[j]) < prob[c] ? c : alias[c]);
+            }
+            bad += m != r;
+            if (bad) { std::printf("FAIL alias %s k=%u n=%zu base=%d (%zu differ)\n", name, k, n, int(based), bad); ++g_fail; return; }
+        }
+    }
+    std::printf("ok   alias %s\n", name);
+}
+
+static void check_alias_table() {
+    // weights over four decades with zeros, one table and shards of 8
+    // (the last padded)
+    const std::size_t K = 50;
+    std::vector<double> w(K);
+    for (std::size_t i = 0; i < K; ++i) w[i] = i % 7 == 3 ? 0.0 : std::pow(10.0, double(i % 5) - 1.0) * double(1 + i % 3);
+    const double sum = std::accumulate(w.begin(), w.end(), 0.0);
+    char name[80];
+    ua::Rng rng(99991);
+    const std::size_t n = 1 << 20;
+    std::vector<std::uint32_t> x(n + 1, 0xDEADBEEF);
+    for (std::size_t shard : { std::size_t(0), std::size_t(8) }) {
+        ua::AliasTable t(w.data(), K, shard);
+        double total = 0, worst = 0;
+        for (std::size_t i = 0; i < K; ++i) {
+            const double p = t.probability(i), want = w[i] / sum;
+            total += p;
+            worst = std::max(worst, want > 0 ? std::fabs(p / want - 1) : p);
+        }
+        std::snprintf(name, sizeof(name), "alias table K=%zu shard=%zu", K, shard);
+        if (t.size() != K || t.shards() != (shard ? 7u : 1u) || std::fabs(total - 1) > 1e-12 || worst > 1e-6) {
+            std::printf("FAIL %s size %zu shards %zu sum %.17g worst %g\n", name, t.size(), t.shards(), total, worst); ++g_fail;
+        } else std::printf("ok   %s masses\n", name);
+        rng.generate_categorical(t, x.data(), n);
+        std::size_t zero = x[n] != 0xDEADBEEF;
+        for (std::size_t j = 0; j < n; ++j) zero += x[j] >= K || w[x[j]] == 0.0;
+        std::snprintf(name, sizeof(name), "categorical K=%zu shard=%zu tier %d", K, shard, int(rng.simd_tier()));
+        if (zero) { std::printf("FAIL %s: %zu draws of zero weight or past the end\n", name, zero); ++g_fail; }
+        check_pmf(name, x.data(), n, std::uint32_t(K - 1), [&](std::uint32_t i) { return t.probability(i); });
+    }
+    // update() and set_weights / rebuild_shard / commit against a fresh build
+    {
+        ua::AliasTable a(w.data(), K, 8), b(w.data(), K, 8);
+        std::vector<double> v(w);
+        const double nw[] = { 5.0, 0.0, 0.25, 40.0, 1e-3, 7.0, 0.0, 2.0, 3.0, 9.0, 1.0 };
+        std::copy(std::begin(nw), std::end(nw), v.begin() + 13);
+        const bool ok = a.update(13, nw, std::size(nw)) && b.set_weights(13, nw, std::size(nw));
+        for (std::size_t s = 13 / 8; s <= 23 / 8; ++s) b.rebuild_shard(s);
+        ua::AliasTable c(v.data(), K, 8);
+        std::size_t diff = !ok || !b.commit();
+        for (std::size_t i = 0; i < K; ++i) diff += a.probability(i) != c.probability(i) || b.probability(i) != c.probability(i);
+        if (diff) { std::printf("FAIL alias update vs build (%zu differ)\n", diff); ++g_fail; }
+        else std::printf("ok   alias update == build\n");
+    }
+    // invalid weights: build leaves the table empty (nothing drawn), update
+    // refuses and keeps the table
+    {
+        ua::AliasTable t(w.data(), K);
+        const double bad[] = { 1.0, -1.0 }, nan[] = { std::nan("") }, zeros[] = { 0.0, 0.0 }, inf[] = { HUGE_VAL };
+        const double p3 = t.probability(3), p4 = t.probability(4);
+        std::size_t fail = t.update(3, bad, 2) || t.update(K, bad, 1) || t.probability(3) != p3 || t.probability(4) != p4 || t.empty();
+        fail += t.build(nan, 1) || !t.empty() || t.size() != 0 || t.probability(0) != 0;
+        std::uint32_t y[4] = { 7, 7, 7, 7 };
+        rng.generate_categorical(t, y, 4);
+        fail += y[0] != 7 || y[3] != 7 || t.update(0, zeros, 1);
+        fail += t.build(zeros, 2) || t.build(inf, 1) || t.build(w.data(), 0) || !t.empty();
+        // valid weights each, but a zero or infinite sum: refused, table kept
+        // (one table and shards of 2)
+        const double w4[] = { 1.0, 2.0, 3.0, 4.0 }, z4[] = { 0.0, 0.0, 0.0, 0.0 }, big[] = { 1e308, 1e308 };
+        for (std::size_t shard : { std::size_t(0), std::size_t(2) }) {
+            fail += !t.build(w4, 4, shard);
+            const double q1 = t.probability(1);
+            fail += t.update(0, z4, 4) || t.set_weights(0, z4, 4) || t.update(0, big, 2) || t.update(1, big, 2);
+            fail += t.size() != 4 || t.probability(1) != q1;
+            fail += !t.update(0, z4, 3) || t.probability(3) != 1.0;   // one item left is fine
+        }
+        if (fail) { std::printf("FAIL alias invalid weights\n"); ++g_fail; }
+        else std::printf("ok   alias invalid weights\n");
+    }
+    // many shards of a large table: every shard's share
+    {
+        const std::size_t k = 100000, shard = 1024;
+        std::vector<double> v(k);
+        for (std::size_t i = 0; i < k; ++i) v[i] = double(1 + i % 97);
+        ua::AliasTable t(v.data(), k, shard);
+        rng.generate_categorical(t, x.data(), n);
+        std::vector<double> share(t.shards(), 0.0);
+        for (std::size_t i = 0; i < k; ++i) share[i / shard] += t.probability(i);
+        for (std::size_t j = 0; j < n; ++j) x[j] /= std::uint32_t(shard);
+        check_pmf("categorical K=1e5 shard=1024 shares", x.data(), n, std::uint32_t(t.shards() - 1),
+                  [&](std::uint32_t s) { return share[s]; });
+    }
+}
+
+int main() {
+    const ua::CpuFeatures f = ua::query_cpu_features();
+#if defined(UA_BUILD_WITH_AVX2)
+    if (f.avx2 && f.fma) check_exponential("avx2 ~ scalar", &ua::detail::exponential_avx2, &ua::detail::exponential_scalar, 4.0);
+#endif
+#if defined(UA_BUILD_WITH_AVX512)
+    if (ua::avx512_ok(f)) {
+        check_exponential("avx512 ~ scalar", &ua::detail::exponential_avx512, &ua::detail::exponential_scalar, 4.0);
+#if defined(UA_BUILD_WITH_AVX2)
+        check_exponential("avx512 == avx2", &ua::detail::exponential_avx512, &ua::detail::exponential_avx2, 0.0);
+#endif
+    }
+#endif
+#if defined(UA_BUILD_WITH_AVX2)
+    if (f.avx2 && f.fma) {
+        check_gamma_mt("avx2 ~ scalar", &ua::detail::gamma_mt_avx2, &ua::detail::gamma_mt_scalar, 4.0);
+        check_gamma_boost("avx2 ~ scalar", &ua::detail::gamma_boost_avx2, &ua::detail::gamma_boost_scalar, 4.0);
+    }
+#endif
+#if defined(UA_BUILD_WITH_AVX512)
+    if (ua::avx512_ok(f)) {
+        check_gamma_mt("avx512 ~ scalar", &ua::detail::gamma_mt_avx512, &ua::detail::gamma_mt_scalar, 4.0);
+        check_gamma_boost("avx512 ~ scalar", &ua::detail::gamma_boost_avx512, &ua::detail::gamma_boost_scalar, 4.0);
+#if defined(UA_BUILD_WITH_AVX2)
+        check_gamma_mt("avx512 == avx2", &ua::detail::gamma_mt_avx512, &ua::detail::gamma_mt_avx2, 0.0);
+        check_gamma_boost("avx512 == avx2", &ua::detail::gamma_boost_avx512, &ua::detail::gamma_boost_avx2, 0.0);
+#endif
+    }
+#endif
+#if defined(UA_BUILD_WITH_AVX2)
+    if (f.avx2 && f.fma) {
+        check_poisson("avx2 ~ scalar", &ua::detail::poisson_avx2, &ua::detail::poisson_scalar, 2);
+        check_binomial("avx2 ~ scalar", &ua::detail::binomial_avx2, &ua::detail::binomial_scalar, 2);
+    }
+#endif
+#if defined(UA_BUILD_WITH_AVX512)
+    if (ua::avx512_ok(f)) {
+        check_poisson("avx512 ~ scalar", &ua::detail::poisson_avx512, &ua::detail::poisson_scalar, 2);
+        check_binomial("avx512 ~ scalar", &ua::detail::binomial_avx512, &ua::detail::binomial_scalar, 2);
+#if defined(UA_BUILD_WITH_AVX2)
+        check_poisson("avx512 == avx2", &ua::detail::poisson_avx512, &ua::detail::poisson_avx2, 0);
+        check_binomial("avx512 == avx2", &ua::detail::binomial_avx512, &ua::detail::binomial_avx2, 0);
+#endif
+    }
+#endif
+    const std::initializer_list<std::uint32_t> s32 = { 1u, 3u, 7u, 1000000000u, 0x80000001u, 0xFFFFFFFFu };
+    const std::initializer_list<std::uint64_t> s64 = { 1ull, 3ull, 0x80000001ull, 1ull << 40, 0x8000000000000001ull, ~0ull };
+    check_uniform<std::uint32_t>("u32 scalar", &ua::detail::uniform_u32_scalar, s32);
+    check_uniform<std::uint64_t>("u64 scalar", &ua::detail::uniform_u64_scalar, s64);
+    check_uniform_bounds("scalar", &ua::detail::uniform_bounds_scalar);
+    check_alias("scalar", &ua::detail::alias_scalar);
+#if defined(UA_BUILD_WITH_AVX2)
+    if (f.avx2 && f.fma) {
+        check_uniform<std::uint32_t>("u32 avx2", &ua::detail::uniform_u32_avx2, s32);
+        check_uniform<std::uint64_t>("u64 avx2", &ua::detail::uniform_u64_avx2, s64);
+        check_uniform_bounds("avx2", &ua::detail::uniform_bounds_avx2);
+        check_alias("avx2", &ua::detail::alias_avx2);
+    }
+#endif
+#if defined(UA_BUILD_WITH_AVX512)
+    if (ua::avx512_ok(f)) {
+        check_uniform<std::uint32_t>("u32 avx512", &ua::detail::uniform_u32_avx512, s32);
+        check_uniform<std::uint64_t>("u64 avx512", &ua::detail::uniform_u64_avx512, s64);
+        check_uniform_bounds("avx512", &ua::detail::uniform_bounds_avx512);
+        check_alias("avx512", &ua::detail::alias_avx512);
+    }
+#endif
+    (void)f;
+    check_exponential_facade();
+    check_gamma_generators();
+    check_discrete_facade();
+    check_uniform_facade();
+    check_shuffle();
+    check_alias_table();
+    return g_fail ? 1 : 0;
+}
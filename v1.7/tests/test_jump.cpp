@@ -0,0 +1,480 @@
+// Per-lane jump()/long_jump()/skip_ahead() check: after j jumps, lane k of
+// every SIMD backend must produce exactly what the scalar reference produces
+// when it is started from lane k's state and jumped j times.
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "ua/ua_cpuid.h"
+#include "ua/ua_rng.h"
+#include "ua/ua_xoshiro256ss_scalar.h"
+#include "ua/ua_xoroshiro128pp.h"
+#if defined(UA_BUILD_WITH_AVX2)
+  #include "ua/ua_xoshiro256ss_avx2.h"
+  #include "ua/ua_xoroshiro128pp_avx2.h"
+#endif
+#if defined(UA_BUILD_WITH_AVX512)
+  #include "ua/ua_xoshiro256ss_avx512.h"
+  #include "ua/ua_xoroshiro128pp_avx512.h"
+  #include "ua/ua_xoshiro256ss_avx512vl.h"
+#endif
+
+using ua::detail::Xoshiro256ssScalar;
+using ua::Xoroshiro128ppScalar;
+
+static int g_fail = 0;
+
+// reference: scalar engine loaded with an explicit lane state
+static void load_ref(Xoshiro256ssScalar& r, const std::uint64_t st[4]) {
+    r.s0 = st[0]; r.s1 = st[1]; r.s2 = st[2]; r.s3 = st[3];
+}
+static void load_ref(Xoroshiro128ppScalar& r, const std::uint64_t st[2]) {
+    r.s0 = st[0]; r.s1 = st[1];
+}
+
+static bool lane_is(const Xoshiro256ssScalar& r, const std::uint64_t st[4]) {
+    return st[0] == r.s0 && st[1] == r.s1 && st[2] == r.s2 && st[3] == r.s3;
+}
+static bool lane_is(const Xoroshiro128ppScalar& r, const std::uint64_t st[2]) {
+    return st[0] == r.s0 && st[1] == r.s1;
+}
+
+static bool same_state(const Xoshiro256ssScalar& a, const Xoshiro256ssScalar& b) {
+    return a.s0 == b.s0 && a.s1 == b.s1 && a.s2 == b.s2 && a.s3 == b.s3;
+}
+
+// arbitrary-distance skip: against stepping, against jump(), and additivity
+static void check_scalar_skip() {
+    const std::uint64_t small[] = { 0, 1, 255, 256, 1000, 100003 };
+    for (std::uint64_t d : small) {
+        Xoshiro256ssScalar a(99), b(99);
+        a.skip_ahead(d);
+        for (std::uint64_t i = 0; i < d; ++i) (void)b.next_u64();
+        if (!same_state(a, b)) {
+            std::printf("FAIL scalar skip_ahead(%llu) != stepping\n", (unsigned long long)d);
+            ++g_fail;
+            return;
+        }
+    }
+
+    // 2^127 + 2^127 == 2^128 == jump()
+    Xoshiro256ssScalar j(5), k(5);
+    j.jump();
+    k.skip_ahead(0, 1ull << 63);
+    k.skip_ahead(0, 1ull << 63);
+    if (!same_state(j, k)) {
+        std::printf("FAIL scalar skip_ahead(2^127) x2 != jump()\n");
+        ++g_fail;
+        return;
+    }
+
+    // (2^64 - 1) + 1 + 0x1234*2^64 == 0x1235*2^64 (carry into hi)
+    Xoshiro256ssScalar x(11), y(11);
+    x.skip_ahead(~0ull, 0);
+    x.skip_ahead(1, 0x1234);
+    y.skip_ahead(0, 0x1235);
+    if (!same_state(x, y)) {
+        std::printf("FAIL scalar skip_ahead additivity\n");
+        ++g_fail;
+        return;
+    }
+    std::printf("ok   scalar skip_ahead\n");
+}
+
+template<class Backend, class Ref = Xoshiro256ssScalar>
+static void check_backend_skip(const char* name, int lanes) {
+    const std::uint64_t lo = 0x0123456789abcdefull, hi = 0xabcull;
+    Backend g(0xBADC0DEull);
+    std::vector<Ref> ref(lanes, Ref(0));
+    for (int k = 0; k < lanes; ++k) {
+        std::uint64_t st[4];
+        g.lane_state(k, st);
+        load_ref(ref[k], st);
+        ref[k].skip_ahead(lo, hi);
+    }
+    g.skip_ahead(lo, hi);
+    for (int k = 0; k < lanes; ++k) {
+        std::uint64_t st[4];
+        g.lane_state(k, st);
+        if (!lane_is(ref[k], st)) {
+            std::printf("FAIL %s skip_ahead: lane %d\n", name, k);
+            ++g_fail;
+            return;
+        }
+    }
+    std::printf("ok   %s skip_ahead (%d lanes)\n", name, lanes);
+}
+
+template<class Backend, class Ref = Xoshiro256ssScalar>
+static void check_backend(const char* name, int lanes, bool long_jump) {
+    constexpr int kJumps = 3;
+    constexpr int kDraws = 16;   // per lane, per round
+
+    Backend g(0xC0FFEEull);
+    std::vector<Ref> ref(lanes, Ref(0));
+    for (int k = 0; k < lanes; ++k) {
+        std::uint64_t st[4];
+        g.lane_state(k, st);
+        load_ref(ref[k], st);
+    }
+
+    std::vector<std::uint64_t> out(std::size_t(lanes) * kDraws);
+    for (int j = 1; j <= kJumps; ++j) {
+        if (long_jump) g.long_jump(); else g.jump();
+        for (auto& r : ref) { if (long_jump) r.long_jump(); else r.jump(); }
+
+        g.generate_u64(out.data(), out.size());
+        for (int t = 0; t < kDraws; ++t) {
+            for (int k = 0; k < lanes; ++k) {
+                const std::uint64_t want = ref[k].next_u64();
+                const std::uint64_t got  = out[std::size_t(t) * lanes + k];
+                if (got != want) {
+                    std::printf("FAIL %s %s: lane %d jump %d draw %d: 0x%016llx != 0x%016llx\n",
+                                name, long_jump ? "long_jump" : "jump", k, j, t,
+                                (unsigned long long)got, (unsigned long long)want);
+                    ++g_fail;
+                    return;
+                }
+            }
+        }
+    }
+    std::printf("ok   %s %s (%d lanes x %d jumps)\n", name, long_jump ? "long_jump" : "jump", lanes, kJumps);
+}
+
+// scalar engine: jump() must match the published reference loop
+static void check_scalar() {
+    static constexpr std::uint64_t J[4] = {
+        0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+        0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+    };
+    Xoshiro256ssScalar a(42), b(42);
+    a.jump();
+
+    std::uint64_t n0=0, n1=0, n2=0, n3=0;
+    for (int i = 0; i < 4; ++i)
+        for (int bit = 0; bit < 64; ++bit) {
+            if (J[i] & (1ull << bit)) { n0 ^= b.s0; n1 ^= b.s1; n2 ^= b.s2; n3 ^= b.s3; }
+            (void)b.next_u64();
+        }
+    if (a.s0 != n0 || a.s1 != n1 || a.s2 != n2 || a.s3 != n3) {
+        std::printf("FAIL scalar jump differs from reference\n");
+        ++g_fail;
+        return;
+    }
+
+    // long_jump must differ from jump and leave a non-zero state
+    Xoshiro256ssScalar c(42);
+    c.long_jump();
+    if ((c.s0 | c.s1 | c.s2 | c.s3) == 0 || (c.s0 == a.s0 && c.s1 == a.s1)) {
+        std::printf("FAIL scalar long_jump\n");
+        ++g_fail;
+        return;
+    }
+    std::printf("ok   scalar jump/long_jump\n");
+}
+
+// xoroshiro128++ SIMD lanes: lane 0 is the scalar engine with the same seed,
+// and the bulk paths (odd lengths included) interleave the lanes
+template<class Backend>
+static void check_xoroshiro_lanes(const char* name, int lanes) {
+    Backend g(0x5eedull);
+    std::vector<Xoroshiro128ppScalar> ref(lanes, Xoroshiro128ppScalar(0));
+    for (int k = 0; k < lanes; ++k) {
+        std::uint64_t st[4];
+        g.lane_state(k, st);
+        load_ref(ref[k], st);
+    }
+    const Xoroshiro128ppScalar lane0(0x5eedull);
+    if (ref[0].s0 != lane0.s0 || ref[0].s1 != lane0.s1) {
+        std::printf("FAIL %s lane 0 seeding\n", name);
+        ++g_fail;
+        return;
+    }
+    // 4 unrolled rounds + one vector + a partial one; the partial step
+    // still advances every lane
+    const std::size_t n = std::size_t(lanes) * 5 + 1;
+    std::vector<std::uint64_t> out(n);
+    g.generate_u64(out.data(), n);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (out[i] != ref[i % lanes].next_u64()) {
+            std::printf("FAIL %s u64 stream at %zu\n", name, i);
+            ++g_fail;
+            return;
+        }
+    }
+    for (int k = 1; k < lanes; ++k) (void)ref[k].next_u64();
+    double d[4];
+    g.generate_double(d, 4);
+    for (int i = 0; i < 4; ++i) {
+        const double want = double(ref[i].next_u64() >> 12) * (1.0 / 4503599627370496.0);
+        if (d[i] != want) { std::printf("FAIL %s double %d\n", name, i); ++g_fail; return; }
+    }
+    std::printf("ok   %s xoroshiro128pp lanes\n", name);
+}
+
+// xoroshiro128++: skip_ahead vs stepping, 2^63 x2 == jump(), 2^95 x2 == long_jump()
+static void check_xoroshiro128pp() {
+    auto same = [](const Xoroshiro128ppScalar& a, const Xoroshiro128ppScalar& b) {
+        return a.s0 == b.s0 && a.s1 == b.s1;
+    };
+    const std::uint64_t small[] = { 0, 1, 127, 128, 1000, 100003 };
+    for (std::uint64_t d : small) {
+        Xoroshiro128ppScalar a(99), b(99);
+        a.skip_ahead(d);
+        for (std::uint64_t i = 0; i < d; ++i) (void)b.next_u64();
+        if (!same(a, b)) {
+            std::printf("FAIL xoroshiro128pp skip_ahead(%llu) != stepping\n", (unsigned long long)d);
+            ++g_fail;
+            return;
+        }
+    }
+    Xoroshiro128ppScalar j(5), k(5), lj(5), lk(5);
+    j.jump();
+    k.skip_ahead(1ull << 63); k.skip_ahead(1ull << 63);
+    lj.long_jump();
+    lk.skip_ahead(0, 1ull << 31); lk.skip_ahead(0, 1ull << 31);
+    if (!same(j, k) || !same(lj, lk)) {
+        std::printf("FAIL xoroshiro128pp jump/long_jump != skip_ahead\n");
+        ++g_fail;
+        return;
+    }
+    std::printf("ok   xoroshiro128pp jump/long_jump/skip_ahead\n");
+}
+
+// facade: every algorithm is reachable, and Init::stream == stream x jump(),
+// taken in one O(log stream) step: long_jump() is 2^32 jump()s (xoshiro256**:
+// 2^64, i.e. stream ~0 and one more jump())
+static void check_facade_init() {
+    const ua::Algorithm algos[] = { ua::Algorithm::Xoshiro256ss, ua::Algorithm::Philox4x32_10, ua::Algorithm::Xoroshiro128pp,
+                                    ua::Algorithm::ChaCha8, ua::Algorithm::Ars4x32_7, ua::Algorithm::Pcg64Dxsm };
+    for (ua::Algorithm a : algos) {
+        const bool xo = a == ua::Algorithm::Xoshiro256ss;
+        ua::Rng r(ua::Init{ a, 1234, 3 });
+        ua::Rng q(1234, a);
+        q.jump(); q.jump(); q.jump();
+        ua::Rng big(ua::Init{ a, 1234, xo ? ~0ull : 1ull << 32 });
+        ua::Rng lj(1234, a);
+        if (xo) big.jump();
+        lj.long_jump();
+        std::uint64_t x[40], y[40], bx[40], by[40];
+        r.generate_u64(x, 40);
+        q.generate_u64(y, 40);
+        big.generate_u64(bx, 40);
+        lj.generate_u64(by, 40);
+        if (r.algorithm() != a) { std::printf("FAIL ua::Rng algorithm() %d\n", int(a)); ++g_fail; return; }
+        for (int i = 0; i < 40; ++i) {
+            if (x[i] != y[i]) { std::printf("FAIL ua::Rng Init stream, algo %d\n", int(a)); ++g_fail; return; }
+            if (bx[i] != by[i]) { std::printf("FAIL ua::Rng Init stream 2^32 / 2^64, algo %d\n", int(a)); ++g_fail; return; }
+        }
+        double d[16], z[16];
+        r.generate_double(d, 16);
+        r.generate_normal(z, 16);
+        for (int i = 0; i < 16; ++i) {
+            if (!(d[i] >= 0.0 && d[i] < 1.0) || z[i] != z[i]) { std::printf("FAIL ua::Rng algo %d outputs\n", int(a)); ++g_fail; return; }
+        }
+        std::printf("ok   ua::Rng algo %d on tier %d\n", int(a), int(r.simd_tier()));
+    }
+    {
+        ua::Init in{ ua::Algorithm::Xoshiro256ss, 1234, 3 };
+        in.interleave = 3;
+        ua::Rng r(in);
+        in.stream = 0;
+        ua::Rng q(in);
+        q.jump(); q.jump(); q.jump();
+        std::uint64_t x[40], y[40];
+        r.generate_u64(x, 40);
+        q.generate_u64(y, 40);
+        for (int i = 0; i < 40; ++i) {
+            if (x[i] != y[i]) { std::printf("FAIL ua::Rng Init stream, interleave 3\n"); ++g_fail; return; }
+        }
+        std::printf("ok   ua::Rng Init stream, interleave 3\n");
+    }
+}
+
+// odd request sizes: each call emits n values and drops the rest of its last
+// step, and nothing past out[n-1] is written (masked tail stores)
+template<class Backend>
+static void check_odd_lengths(const char* name, int lanes) {
+    Backend g(0x0ddull);
+    std::vector<Xoshiro256ssScalar> ref(lanes, Xoshiro256ssScalar(0));
+    for (int k = 0; k < lanes; ++k) {
+        std::uint64_t st[4];
+        g.lane_state(k, st);
+        load_ref(ref[k], st);
+    }
+    const std::size_t sizes[] = { 5, 13, 37, 1, 100, 63, 7, 99 };
+    const std::uint64_t kGuard = 0xfeedfacecafebeefull;
+    for (std::size_t n : sizes) {
+        std::vector<std::uint64_t> out(n + 8, kGuard);
+        g.generate_u64(out.data(), n);
+        for (std::size_t t = 0; t * lanes < n; ++t) {
+            for (int k = 0; k < lanes; ++k) {
+                const std::uint64_t want = ref[k].next_u64();
+                const std::size_t idx = t * lanes + k;
+                if (idx < n && out[idx] != want) {
+                    std::printf("FAIL %s odd length %zu at %zu\n", name, n, idx);
+                    ++g_fail;
+                    return;
+                }
+            }
+        }
+        for (std::size_t i = n; i < n + 8; ++i) {
+            if (out[i] != kGuard) { std::printf("FAIL %s wrote past n=%zu\n", name, n); ++g_fail; return; }
+        }
+    }
+    std::printf("ok   %s odd lengths 1..100\n", name);
+}
+
+// every '**' multiply kernel must give the same stream (odd length: tail path)
+template<class Backend>
+static void check_scramblers(const char* name) {
+    using ua::detail::XoshiroScrambler;
+    const XoshiroScrambler kinds[] = { XoshiroScrambler::Emulated, XoshiroScrambler::ShiftAdd,
+                                       XoshiroScrambler::Mullo, XoshiroScrambler::Auto };
+    std::uint64_t want[75];
+    Backend ref(31337, XoshiroScrambler::Emulated);
+    ref.generate_u64(want, 75);
+    for (XoshiroScrambler k : kinds) {
+        Backend g(31337, k);
+        std::uint64_t got[75];
+        g.generate_u64(got, 75);
+        for (int i = 0; i < 75; ++i) {
+            if (got[i] != want[i]) {
+                std::printf("FAIL %s scrambler %d (resolved %d) at %d\n", name, int(k), int(g.scrambler()), i);
+                ++g_fail;
+                return;
+            }
+        }
+    }
+    std::printf("ok   %s scrambler kernels agree\n", name);
+}
+
+// Init::interleave: the facade stream is the interleaved backend's, and a
+// tail that splits a step drops the rest of that step on every set
+template<class Backend>
+static void check_interleaved_facade(const char* name, unsigned k, ua::SimdTier tier) {
+    ua::Init init{ ua::Algorithm::Xoshiro256ss, 77, 0 };
+    init.interleave = k;
+    ua::Rng rng(init);
+    if (rng.simd_tier() != tier) { std::printf("skip %s facade (tier %d)\n", name, int(rng.simd_tier())); return; }
+    Backend ref(77);
+    std::uint64_t got[203], want[203];
+    rng.generate_u64(got, 101);
+    rng.generate_u64(got + 101, 102);
+    ref.generate_u64(want, 101);
+    ref.generate_u64(want + 101, 102);
+    for (int i = 0; i < 203; ++i) {
+        if (got[i] != want[i]) { std::printf("FAIL %s facade u64 %d\n", name, i); ++g_fail; return; }
+    }
+    double d[37];
+    rng.generate_double(d, 37);
+    for (double v : d) {
+        if (!(v >= 0.0 && v < 1.0)) { std::printf("FAIL %s facade double\n", name); ++g_fail; return; }
+    }
+    std::printf("ok   %s facade (Init::interleave = %u)\n", name, k);
+}
+
+#if defined(UA_BUILD_WITH_AVX2) && defined(UA_BUILD_WITH_AVX512)
+// AVX512VL tier: same stream as the AVX2 backend (masked tails included),
+// and Init::avx512_ymm selects it through the facade
+static void check_avx512vl() {
+    ua::detail::Xoshiro256ssAVX512VL g(4242);
+    ua::detail::Xoshiro256ssAVX2 ref(4242);
+    const std::size_t sizes[] = { 5, 7, 64, 99, 1, 2, 3 };
+    for (std::size_t n : sizes) {
+        std::uint64_t got[128] = {}, want[128] = {};
+        double gd[128] = {}, wd[128] = {};
+        g.generate_u64(got, n);
+        ref.generate_u64(want, n);
+        g.generate_double(gd, n);
+        ref.generate_double(wd, n);
+        for (std::size_t i = 0; i < 128; ++i) {
+            if (got[i] != want[i] || gd[i] != wd[i]) {
+                std::printf("FAIL avx512vl != avx2 (n=%zu, i=%zu)\n", n, i);
+                ++g_fail;
+                return;
+            }
+        }
+    }
+    ua::Init init{ ua::Algorithm::Xoshiro256ss, 4242, 0 };
+    init.avx512_ymm = true;
+    ua::Rng rng(init);
+    if (!std::getenv("UA_FORCE_BACKEND") && rng.simd_tier() != ua::SimdTier::AVX512VL) {
+        std::printf("FAIL Init::avx512_ymm did not select AVX512VL\n");
+        ++g_fail;
+        return;
+    }
+    std::printf("ok   avx512vl == avx2 stream, facade tier %d\n", int(rng.simd_tier()));
+}
+#endif
+
+int main() {
+    const ua::CpuFeatures f = ua::query_cpu_features();
+
+    check_scalar();
+    check_scalar_skip();
+    check_xoroshiro128pp();
+    check_facade_init();
+
+#if defined(UA_BUILD_WITH_AVX2)
+    if (f.avx2) {
+        check_backend<ua::detail::Xoshiro256ssAVX2>("avx2", 4, false);
+        check_backend<ua::detail::Xoshiro256ssAVX2>("avx2", 4, true);
+        check_backend_skip<ua::detail::Xoshiro256ssAVX2>("avx2", 4);
+        check_scramblers<ua::detail::Xoshiro256ssAVX2>("avx2");
+        check_odd_lengths<ua::detail::Xoshiro256ssAVX2>("avx2", 4);
+        check_backend<ua::detail::Xoshiro256ssAVX2Interleaved<2>>("avx2 x2", 8, false);
+        check_backend<ua::detail::Xoshiro256ssAVX2Interleaved<3>>("avx2 x3", 12, true);
+        check_backend_skip<ua::detail::Xoshiro256ssAVX2Interleaved<4>>("avx2 x4", 16);
+        check_interleaved_facade<ua::detail::Xoshiro256ssAVX2Interleaved<3>>("avx2 x3", 3, ua::SimdTier::AVX2);
+        check_xoroshiro_lanes<ua::detail::Xoroshiro128ppAVX2>("avx2", 4);
+        check_backend<ua::detail::Xoroshiro128ppAVX2, Xoroshiro128ppScalar>("xoroshiro avx2", 4, false);
+        check_backend<ua::detail::Xoroshiro128ppAVX2, Xoroshiro128ppScalar>("xoroshiro avx2", 4, true);
+        check_backend_skip<ua::detail::Xoroshiro128ppAVX2, Xoroshiro128ppScalar>("xoroshiro avx2", 4);
+    } else {
+        std::printf("skip avx2 (cpu)\n");
+    }
+#endif
+#if defined(UA_BUILD_WITH_AVX512)
+    if (ua::avx512_ok(f)) {
+        check_backend<ua::detail::Xoshiro256ssAVX512>("avx512", 8, false);
+        check_backend<ua::detail::Xoshiro256ssAVX512>("avx512", 8, true);
+        check_backend_skip<ua::detail::Xoshiro256ssAVX512>("avx512", 8);
+        check_scramblers<ua::detail::Xoshiro256ssAVX512>("avx512");
+        check_odd_lengths<ua::detail::Xoshiro256ssAVX512>("avx512", 8);
+        check_backend<ua::detail::Xoshiro256ssAVX512VL>("avx512vl", 4, false);
+        check_backend<ua::detail::Xoshiro256ssAVX512VL>("avx512vl", 4, true);
+        check_backend_skip<ua::detail::Xoshiro256ssAVX512VL>("avx512vl", 4);
+        check_odd_lengths<ua::detail::Xoshiro256ssAVX512VL>("avx512vl", 4);
+  #if defined(UA_BUILD_WITH_AVX2)
+        check_avx512vl();
+  #endif
+        check_backend<ua::detail::Xoshiro256ssAVX512Interleaved<2>>("avx512 x2", 16, false);
+        check_backend<ua::detail::Xoshiro256ssAVX512Interleaved<3>>("avx512 x3", 24, true);
+        check_backend_skip<ua::detail::Xoshiro256ssAVX512Interleaved<4>>("avx512 x4", 32);
+        check_interleaved_facade<ua::detail::Xoshiro256ssAVX512Interleaved<3>>("avx512 x3", 3, ua::SimdTier::AVX512F);
+        check_xoroshiro_lanes<ua::detail::Xoroshiro128ppAVX512>("avx512", 8);
+        check_backend<ua::detail::Xoroshiro128ppAVX512, Xoroshiro128ppScalar>("xoroshiro avx512", 8, false);
+        check_backend<ua::detail::Xoroshiro128ppAVX512, Xoroshiro128ppScalar>("xoroshiro avx512", 8, true);
+        check_backend_skip<ua::detail::Xoroshiro128ppAVX512, Xoroshiro128ppScalar>("xoroshiro avx512", 8);
+    } else {
+        std::printf("skip avx512 (cpu)\n");
+    }
+#endif
+
+    // facade: jumps must be reachable and keep the stream alive
+    ua::Rng rng(7);
+    std::uint64_t before[8], after[8];
+    rng.generate_u64(before, 8);
+    rng.jump();
+    rng.long_jump();
+    rng.skip_ahead(12345, 1);
+    rng.generate_u64(after, 8);
+    if (before[0] == after[0] && before[1] == after[1]) {
+        std::printf("FAIL ua::Rng jump had no effect\n");
+        ++g_fail;
+    }
+
+    return g_fail ? 1 : 0;
+}
@@ -0,0 +1,43 @@
+// Shared by the kernel tests: a SIMD kernel against a reference kernel over
+// lengths that cut the vector width every way, in place included, nothing
+// written past the end.
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+// 1031: odd, past every chunk / vector multiple
+static const std::size_t kLengths[] = { 1, 3, 4, 7, 8, 9, 17, 1031 };
+static constexpr std::size_t kMaxLength = 1031;
+
+// same bits when tol_ulp = 0 (or want is infinite), else within tol_ulp
+// ulps of |want| + floor
+static bool close_ulp(double got, double want, double tol_ulp, double floor = 0.0) {
+    if (tol_ulp == 0.0 || std::isinf(want)) return std::memcmp(&got, &want, sizeof(double)) == 0;
+    return std::fabs(got - want) <= tol_ulp * (std::fabs(want) + floor) * 0x1p-52;
+}
+
+// run(in, n, out) / ref(in, n, out) take n items of `width` doubles from in
+// and return the doubles written to out, which has room for width * n +
+// slack. For every n in kLengths both must write the same count, close_ulp
+// to each other; run in place over a copy of in must give the same bits, and
+// nothing may land past the room. Returns 0, or the first failing n.
+template<class Run, class Ref>
+static std::size_t kernel_vs_ref(const double* in, std::size_t width, std::size_t slack,
+                                 Run run, Ref ref, double tol_ulp, double floor = 0.0) {
+    for (std::size_t n : kLengths) {
+        const std::size_t cap = width * n + slack;
+        std::vector<double> want(cap), got(cap + 1, -99.0), inplace(cap);
+        std::copy(in, in + width * n, inplace.begin());
+        const std::size_t nw = ref(in, n, want.data());
+        const std::size_t ng = run(in, n, got.data());
+        const std::size_t ni = run(inplace.data(), n, inplace.data());
+        bool ok = nw == ng && ng == ni && got[cap] == -99.0;
+        for (std::size_t j = 0; ok && j < nw; ++j)
+            ok = close_ulp(got[j], want[j], tol_ulp, floor) && std::memcmp(&inplace[j], &got[j], sizeof(double)) == 0;
+        if (!ok) return n;
+    }
+    return 0;
+}
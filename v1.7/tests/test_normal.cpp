@@ -0,0 +1,546 @@
+// Ziggurat normals: table entries against an 80-digit evaluation of the
+// layer recurrence, the SIMD rectangle passes against the scalar one (values
+// and miss lists, odd lengths included), and the facade's N(0,1) moments
+// and tail mass on whatever tier it picked. Box–Muller: the kernels against
+// each other and against long double, and NormalGenerator's moments. Polar:
+// the compacting kernels against the scalar one, PolarNormal's moments.
+// Inverse CDF: the kernels against each other and against a long double
+// Newton step, monotonicity (to rounding) across the AS241 branch points, and
+// Rng::generate_normal_icdf against the kernel on the same u64. Floats:
+// the unit-float kernels against their definition, the Box–Muller float
+// kernels against each other, and Rng::generate_float /
+// generate_normal_float against the kernels on the same u64. The standalone
+// generators' kernels follow ua::Rng's tier (UA_FORCE_BACKEND included).
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <cfloat>
+#include <vector>
+#include <algorithm>
+
+#include "ua/ua_cpuid.h"
+#include "ua/ua_rng.h"
+#include "ua/ua_normal_ziggurat.h"
+#include "ua/ua_normal_avx2.h"
+#include "ua/ua_normal_polar.h"
+#include "ua/ua_normal_icdf.h"
+#include "ua/ua_float.h"
+#include "ua/ua_xoshiro256ss_scalar.h"
+
+#include "test_kernels.h"
+
+static int g_fail = 0;
+
+static void check_tables() {
+    struct Ref { int i; std::uint64_t ki; double wi, fi; };
+    // Python decimal at 80 digits, rounded once
+    static const Ref refs[] = {
+        {   0, 0xef33d8025ef65ull, 0x1.f493b7815d983p-51, 0x1.0000000000000p+0  },
+        {   1, 0x0ull,             0x1.b8d0be3fdf701p-55, 0x1.f446ac979f084p-1  },
+        {   2, 0xc08be98fbc6b5ull, 0x1.250af3c2c5bc6p-54, 0x1.eb7545b6ca913p-1  },
+        { 127, 0xfeddf813c8ad2ull, 0x1.875036f7a7ec7p-52, 0x1.3e5e8d08ed2d8p-2  },
+        { 254, 0xf66c5f7f0302cull, 0x1.b981f3878fdb0p-51, 0x1.55f9f43c1b06fp-9  },
+        { 255, 0xf1a5a4b331c49ull, 0x1.d3bb48209ad33p-51, 0x1.4a605b6b9f70dp-10 },
+    };
+    const ua::ZigguratNormal::Tables& t = ua::ZigguratNormal::tables;
+    for (const Ref& r : refs) {
+        if (t.ki[r.i] != r.ki || t.wi[r.i] != r.wi || t.fi[r.i] != r.fi) {
+            std::printf("FAIL ziggurat table entry %d\n", r.i); ++g_fail; return;
+        }
+    }
+    // layers 2..255 are rectangles of width x[i] = wi[i] * 2^52 between
+    // f[i] and f[i-1]; each has area V
+    for (int i = 2; i < 256; ++i) {
+        const double area = t.wi[i] * 4503599627370496.0 * (t.fi[i - 1] - t.fi[i]);
+        if (std::fabs(area / ua::ZigguratNormal::V - 1.0) > 1e-9) {
+            std::printf("FAIL ziggurat strip %d area\n", i); ++g_fail; return;
+        }
+    }
+    std::printf("ok   ziggurat tables (256 layers)\n");
+}
+
+// SIMD rectangle pass == scalar ZigguratNormal::rect, value and miss list
+using RectFn = std::size_t (*)(const std::uint64_t*, std::size_t, double*, std::uint32_t*) noexcept;
+
+static void check_rect(const char* name, RectFn rect) {
+    ua::detail::Xoshiro256ssScalar g(31337);
+    std::vector<std::uint64_t> u(1031);
+    g.generate_u64(u.data(), u.size());
+    // force misses: layer 1 never accepts, layer 0 rarely
+    for (std::size_t j = 0; j < u.size(); j += 5) u[j] &= ~0xfeull;
+    for (std::size_t n : { std::size_t(1), std::size_t(3), std::size_t(7), std::size_t(8),
+                           std::size_t(13), std::size_t(64), std::size_t(1031) }) {
+        std::vector<double> got(n + 1, -99.0);
+        std::vector<std::uint32_t> rare(n + 8);
+        const std::size_t nr = rect(u.data(), n, got.data(), rare.data());
+        std::size_t k = 0;
+        for (std::size_t j = 0; j < n; ++j) {
+            double want;
+            const bool hit = ua::ZigguratNormal::rect(u[j], want);
+            if (got[j] != want || (!hit && (k >= nr || rare[k++] != j))) {
+                std::printf("FAIL %s rect n=%zu at %zu\n", name, n, j); ++g_fail; return;
+            }
+        }
+        if (k != nr || got[n] != -99.0) { std::printf("FAIL %s rect n=%zu misses\n", name, n); ++g_fail; return; }
+    }
+    std::printf("ok   ziggurat %s rectangle pass == scalar\n", name);
+}
+
+static void check_moments(const char* name, const double* z, std::size_t n) {
+    double m = 0, v = 0, tail = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        m += z[i]; v += z[i] * z[i];
+        if (std::fabs(z[i]) > 3.0) tail += 1;
+    }
+    m /= double(n); v = v / double(n) - m * m; tail /= double(n);
+    // 1M samples: sd(mean) 1e-3, sd(var) 1.4e-3, P(|z|>3) = 0.0026998 +- 5e-5
+    if (std::fabs(m) > 0.006 || std::fabs(v - 1.0) > 0.008 || std::fabs(tail - 0.0026998) > 0.0003) {
+        std::printf("FAIL %s moments mean %g var %g tail %g\n", name, m, v, tail); ++g_fail; return;
+    }
+    std::printf("ok   %s N(0,1) moments\n", name);
+}
+
+static void check_facade() {
+    std::vector<double> z(1 << 20);
+    for (ua::Algorithm a : { ua::Algorithm::Xoshiro256ss, ua::Algorithm::Philox4x32_10, ua::Algorithm::Pcg64Dxsm }) {
+        ua::Rng rng(2024, a);
+        // odd pieces: chunk tails and the slow-path buffer both get exercised
+        std::size_t i = 0;
+        for (std::size_t step : { std::size_t(1), std::size_t(5), std::size_t(511), std::size_t(513) }) {
+            rng.generate_normal(z.data() + i, step);
+            i += step;
+        }
+        rng.generate_normal(z.data() + i, z.size() - i);
+        char name[64];
+        std::snprintf(name, sizeof(name), "ua::Rng algo %d tier %d", int(a), int(rng.simd_tier()));
+        check_moments(name, z.data(), z.size());
+    }
+    ua::detail::Xoshiro256ssScalar g(77);
+    ua::ZigguratNormal::generate(g, z.data(), z.size());
+    check_moments("ZigguratNormal::generate", z.data(), z.size());
+}
+
+// Box–Muller kernel against a reference kernel (kernel_vs_ref, by pairs)
+static void check_box_muller(const char* name, ua::detail::BoxMullerFn bm,
+                             ua::detail::BoxMullerFn ref, double tol_ulp) {
+    ua::detail::Xoshiro256ssScalar g(4242);
+    std::vector<double> u(2 * kMaxLength);
+    g.generate_double(u.data(), u.size());
+    u[0] = 0.0; u[1] = 0.0; u[2] = 0.5; u[3] = 0.125; u[5] = 0.75;   // r = 0, quadrant edges
+    auto pairs = [](ua::detail::BoxMullerFn f) {
+        return [f](const double* in, std::size_t n, double* out) { f(in, n, out); return 2 * n; };
+    };
+    if (const std::size_t n = kernel_vs_ref(u.data(), 2, 0, pairs(bm), pairs(ref), tol_ulp)) {
+        std::printf("FAIL box-muller %s pairs=%zu\n", name, n); ++g_fail; return;
+    }
+    std::printf("ok   box-muller %s\n", name);
+}
+
+// against long double. The SIMD kernels' ln is within 0.75 ulp and their
+// sin / cos within 0.79 ulp, so r cos / r sin stay within 3 ulp; the scalar
+// kernel rounds 2 pi r once more (4 ulp)
+static void check_box_muller_ulp(const char* name, ua::detail::BoxMullerFn bm, double max_ulp) {
+    if (LDBL_MANT_DIG < 64) { std::printf("skip box-muller %s ulp (no extended long double)\n", name); return; }
+    const long double two_pi = 6.283185307179586476925286766559005768L;
+    ua::detail::Xoshiro256ssScalar g(99);
+    std::vector<double> u(1 << 20), z(1 << 20);
+    g.generate_double(u.data(), u.size());
+    bm(u.data(), u.size() / 2, z.data());
+    double worst = 0.0;
+    for (std::size_t j = 0; j < u.size(); j += 2) {
+        // reference reduced in turns like the kernels, so u near 1/2 is not
+        // swamped by the rounding of 2 pi u
+        const long double q = std::nearbyint(4.0L * u[j + 1]);
+        const long double a = two_pi * ((long double)u[j + 1] - q / 4);
+        const int qi = int(q) & 3;
+        const long double sa = std::sin(a), ca = std::cos(a);
+        const long double s = qi == 0 ? sa : qi == 1 ? ca : qi == 2 ? -sa : -ca;
+        const long double c = qi == 0 ? ca : qi == 1 ? -sa : qi == 2 ? -ca : sa;
+        const long double r = std::sqrt(-2.0L * std::log(1.0L - (long double)u[j]));
+        for (int h = 0; h < 2; ++h) {
+            const long double ref = r * (h ? s : c);
+            if (ref == 0.0L) continue;
+            int e;
+            std::frexp(ref, &e);
+            const double err = double(std::fabs((long double)z[j + h] - ref) / std::ldexp(1.0L, e - 53));
+            if (err > worst) worst = err;
+        }
+    }
+    if (worst > max_ulp) { std::printf("FAIL box-muller %s max error %.2f ulp\n", name, worst); ++g_fail; return; }
+    std::printf("ok   box-muller %s max error %.2f ulp\n", name, worst);
+}
+
+static void check_normal_generator() {
+    ua::Rng rng(7, ua::Algorithm::Philox4x32_10);
+    ua::NormalGenerator<ua::Rng> gen(rng);
+    std::vector<double> z((1 << 20) + 1, -99.0);
+    std::size_t i = 0;
+    for (std::size_t step : { std::size_t(1), std::size_t(3), std::size_t(1023), std::size_t(1025) }) {
+        gen.generate(z.data() + i, step);
+        i += step;
+    }
+    gen.generate(z.data() + i, z.size() - 1 - i);
+    if (z.back() != -99.0) { std::printf("FAIL NormalGenerator overrun\n"); ++g_fail; return; }
+    check_moments("NormalGenerator (Box-Muller)", z.data(), z.size() - 1);
+}
+
+// Polar kernel against a reference kernel (kernel_vs_ref, by pairs): same
+// accepted pairs in the same order, nothing written past 2 * pairs +
+// POLAR_SLACK
+static void check_polar(const char* name, ua::detail::PolarFn pk, ua::detail::PolarFn ref, double tol_ulp) {
+    ua::detail::Xoshiro256ssScalar g(515);
+    std::vector<double> u(2 * kMaxLength);
+    g.generate_double(u.data(), u.size());
+    u[0] = 0.5; u[1] = 0.5;   // s = 0: rejected
+    if (const std::size_t n = kernel_vs_ref(u.data(), 2, ua::detail::POLAR_SLACK, pk, ref, tol_ulp)) {
+        std::printf("FAIL polar %s pairs=%zu\n", name, n); ++g_fail; return;
+    }
+    std::printf("ok   polar %s\n", name);
+}
+
+static void check_polar_normal() {
+    ua::Rng rng(11, ua::Algorithm::Xoshiro256ss);
+    std::vector<double> z((1 << 20) + 1, -99.0);
+    ua::PolarNormal<ua::Rng> tls(rng);
+    std::size_t i = 0;
+    for (std::size_t step : { std::size_t(1), std::size_t(3), std::size_t(1023), std::size_t(1025) }) {
+        tls.generate(z.data() + i, step);
+        i += step;
+    }
+    tls.generate(z.data() + i, z.size() - 1 - i);
+    if (z.back() != -99.0) { std::printf("FAIL PolarNormal overrun\n"); ++g_fail; return; }
+    check_moments("PolarNormal (thread_local scratch)", z.data(), z.size() - 1);
+
+    // caller's scratch, as small as allowed and a few pairs wide
+    double tiny[ua::PolarNormal<ua::Rng>::MIN_SCRATCH];
+    ua::PolarNormal<ua::Rng> t1(rng, tiny, sizeof(tiny) / sizeof(tiny[0]));
+    t1.generate(z.data(), 7);
+    std::vector<double> small(100 + ua::detail::POLAR_SLACK);
+    ua::PolarNormal<ua::Rng> own(rng, small.data(), small.size());
+    own.generate(z.data() + 7, z.size() - 8);
+    check_moments("PolarNormal (caller scratch)", z.data(), z.size() - 1);
+
+    // too short for the kernel (below MIN_SCRATCH, even below POLAR_SLACK):
+    // left untouched, the thread_local buffer is used instead
+    for (std::size_t len : { std::size_t(0), std::size_t(5), ua::detail::POLAR_SLACK, ua::detail::POLAR_SLACK + 1 }) {
+        double shortbuf[ua::detail::POLAR_SLACK + 2];
+        for (double& v : shortbuf) v = -99.0;
+        ua::PolarNormal<ua::Rng> bad(rng, shortbuf, len);
+        bad.generate(z.data(), 1000);
+        for (double v : shortbuf) {
+            if (v != -99.0) { std::printf("FAIL PolarNormal wrote a %zu-double scratch\n", len); ++g_fail; return; }
+        }
+    }
+    double m = 0;
+    for (std::size_t j = 0; j < 1000; ++j) m += z[j];
+    if (!(std::fabs(m / 1000) < 0.2)) { std::printf("FAIL PolarNormal short scratch mean %g\n", m / 1000); ++g_fail; return; }
+    std::printf("ok   PolarNormal short scratch falls back to thread_local\n");
+}
+
+// uniforms that hit every AS241 branch and its edges: the split points
+// |u - 1/2| = 0.425 and r = 5 (u = e^-25), deep tails, 0 / 1 / 1/2
+static std::vector<double> icdf_inputs(std::size_t n) {
+    ua::detail::Xoshiro256ssScalar g(1809);
+    std::vector<double> u(n);
+    g.generate_double(u.data(), n);
+    const double edges[] = { 0.0, 1.0, 0.5, 0.075, 0.925, std::nextafter(0.075, 0.0), std::nextafter(0.925, 1.0),
+                             std::exp(-25.0), std::nextafter(std::exp(-25.0), 1.0), 1.0 - std::exp(-25.0),
+                             0x1p-53, 1.0 - 0x1p-53, 0x1p-1022, 0x1p-1074, 1e-300, 0x1p-30 };
+    for (std::size_t k = 0; k < sizeof(edges) / sizeof(edges[0]) && k < n; ++k) u[k] = edges[k];
+    // tail sweep: u = v 2^-e, v in [1/2, 1), e up to 1000
+    for (std::size_t k = 16; k < n; k += 7) u[k] = std::ldexp(0.5 + 0.5 * u[k], -int(k % 1000));
+    return u;
+}
+
+// Inverse-CDF kernel against a reference kernel (kernel_vs_ref)
+static void check_icdf(const char* name, ua::detail::NormalIcdfFn fn, ua::detail::NormalIcdfFn ref, double tol_ulp) {
+    const std::vector<double> u = icdf_inputs(kMaxLength);
+    auto map = [](ua::detail::NormalIcdfFn f) {
+        return [f](const double* in, std::size_t n, double* out) { f(in, n, out); return n; };
+    };
+    if (const std::size_t n = kernel_vs_ref(u.data(), 1, 0, map(fn), map(ref), tol_ulp)) {
+        std::printf("FAIL icdf %s n=%zu\n", name, n); ++g_fail; return;
+    }
+    std::printf("ok   icdf %s\n", name);
+}
+
+// against long double: one Newton step on Phi(x) = u from the kernel's own x
+// (erf near 1/2, the upper tail through 1 - u, exact for u > 1/2), then error
+// in ulp of the double result. AS241 itself is within 0.7 ulp; the rounding
+// of its degree-7 rationals in double adds up to ~6 ulp. Monotone (to
+// rounding) on a sorted sweep.
+static void check_icdf_accuracy(const char* name, ua::detail::NormalIcdfFn fn, double max_ulp) {
+    std::vector<double> u = icdf_inputs(1 << 20), x(u.size());
+    fn(u.data(), u.size(), x.data());
+    if (!(x[0] == -INFINITY && x[1] == INFINITY && x[2] == 0.0)) {
+        std::printf("FAIL icdf %s u = 0 / 1 / 0.5 give %g %g %g\n", name, x[0], x[1], x[2]); ++g_fail; return;
+    }
+    double worst = 0.0;
+    if (LDBL_MANT_DIG >= 64) {
+        const long double rsqrt2 = 0.707106781186547524400844362104849039L;
+        const long double rsqrt2pi = 0.398942280401432677939946059934381868L;
+        for (std::size_t j = 0; j < u.size(); ++j) {
+            if (u[j] == 0.0 || u[j] == 1.0 || x[j] == 0.0) continue;
+            const long double xl = x[j];
+            const long double pdf = rsqrt2pi * std::exp(-0.5L * xl * xl);
+            const long double ref =
+                std::fabs(xl) < 1 ? xl - (0.5L * std::erf(xl * rsqrt2) - ((long double)u[j] - 0.5L)) / pdf
+                : u[j] <= 0.5     ? xl - (0.5L * std::erfc(-xl * rsqrt2) - u[j]) / pdf
+                                  : xl + (0.5L * std::erfc(xl * rsqrt2) - (1.0L - u[j])) / pdf;
+            int e;
+            std::frexp(ref, &e);
+            const double err = double(std::fabs(xl - ref) / std::ldexp(1.0L, e - 53));
+            if (err > worst) worst = err;
+        }
+    }
+    // dense steps across the branch points
+    for (double c : { 0.075, 0.925, std::exp(-25.0), 1.0 - std::exp(-25.0) }) {
+        double v = c;
+        for (int k = 0; k < 64; ++k) v = std::nextafter(v, 0.0);
+        for (int k = 0; k < 128; ++k) { u.push_back(v); v = std::nextafter(v, 1.0); }
+    }
+    std::sort(u.begin(), u.end());
+    x.resize(u.size());
+    fn(u.data(), u.size(), x.data());
+    // where |dx/du| is below one ulp of x per ulp of u, rounding alone can
+    // step back an ulp: monotone up to 2 ulp
+    for (std::size_t j = 1; j < u.size(); ++j)
+        if (x[j] < x[j - 1] - 2.0 * std::fabs(x[j]) * 0x1p-52) {
+            std::printf("FAIL icdf %s not monotone at u = %a\n", name, u[j]); ++g_fail; return;
+        }
+    if (worst > max_ulp) { std::printf("FAIL icdf %s max error %.2f ulp\n", name, worst); ++g_fail; return; }
+    std::printf("ok   icdf %s max error %.2f ulp, monotone to 2 ulp\n", name, worst);
+}
+
+// generate_normal_icdf = the kernel on (2k + 1) 2^-53 of the u64 that the
+// same generator returns for the same (512-chunked) requests; N(0,1) moments
+static void check_normal_icdf_facade() {
+    std::vector<double> z(1 << 20), want(1 << 20);
+    std::vector<std::uint64_t> w(1 << 20);
+    for (ua::Algorithm a : { ua::Algorithm::Xoshiro256ss, ua::Algorithm::Philox4x32_10 }) {
+        ua::Rng rng(31, a), twin(31, a);
+        std::size_t i = 0;
+        for (std::size_t step : { std::size_t(1), std::size_t(5), std::size_t(511), std::size_t(513), z.size() - 1030 }) {
+            rng.generate_normal_icdf(z.data() + i, step);
+            for (std::size_t k = 0; k < step; k += 512) twin.generate_u64(w.data() + i + k, std::min<std::size_t>(512, step - k));
+            i += step;
+        }
+        for (std::size_t j = 0; j < w.size(); ++j) want[j] = (double(w[j] >> 12) + 0.5) * 0x1p-52;
+        ua::detail::normal_icdf_scalar(want.data(), want.size(), want.data());
+        char name[64];
+        std::snprintf(name, sizeof(name), "generate_normal_icdf algo %d tier %d", int(a), int(rng.simd_tier()));
+        for (std::size_t j = 0; j < z.size(); ++j)
+            if (!(std::fabs(z[j] - want[j]) <= 8.0 * std::fabs(want[j]) * 0x1p-52)) {
+                std::printf("FAIL %s at %zu: %a vs %a\n", name, j, z[j], want[j]); ++g_fail; return;
+            }
+        check_moments(name, z.data(), z.size());
+    }
+}
+
+// ---------------------------------- floats ----------------------------------
+
+static std::vector<std::uint64_t> float_words(std::size_t n) {
+    ua::detail::Xoshiro256ssScalar g(512);
+    std::vector<std::uint64_t> x(n);
+    g.generate_u64(x.data(), n);
+    // largest radius, r = 0, and the angle's quadrant edges and top
+    x[0] = 0; x[1] = 0xFFFFFFFFull; x[2] = 0x4000000000000000ull | 123;
+    x[3] = 0x8000000000000000ull | 0xFFFFFFFEull; x[4] = ~0ull;
+    return x;
+}
+
+// every float against the top 24 bits of its half times 2^-24 (the top bit
+// included, unlike v1.6's u32_to_unit_float), odd lengths, nothing written
+// past n
+static void check_unit_float(const char* name, ua::detail::UnitFloatFn fn) {
+    const std::vector<std::uint64_t> x = float_words(1031);
+    for (std::size_t n : { std::size_t(1), std::size_t(7), std::size_t(8), std::size_t(17), std::size_t(31),
+                           std::size_t(33), std::size_t(2061) }) {
+        std::vector<float> got(n + 1, -99.0f);
+        fn(x.data(), n, got.data());
+        for (std::size_t j = 0; j < n; ++j) {
+            const std::uint32_t h = std::uint32_t(x[j / 2] >> (32 * (j & 1)));
+            const float want = float(h >> 8) * 0x1p-24f;
+            if (std::memcmp(&got[j], &want, sizeof(float)) != 0 || !(got[j] >= 0.0f && got[j] < 1.0f)) {
+                std::printf("FAIL unit float %s n=%zu at %zu\n", name, n, j); ++g_fail; return;
+            }
+        }
+        if (got[n] != -99.0f) { std::printf("FAIL unit float %s n=%zu overrun\n", name, n); ++g_fail; return; }
+        if (n > 8 && (got[7] != 0.5f || got[8] != 1.0f - 0x1p-24f)) { std::printf("FAIL unit float %s top bit\n", name); ++g_fail; return; }
+    }
+    std::printf("ok   unit float %s\n", name);
+}
+
+// Box–Muller float kernel against a reference kernel, odd lengths, nothing
+// written past n, within tol_ulp of the radius r (cos / sin near 0 carry
+// the absolute error of r); tol_ulp = 0: same bits
+static void check_normal_float(const char* name, ua::detail::NormalFloatFn fn, ua::detail::NormalFloatFn ref, double tol_ulp) {
+    const std::vector<std::uint64_t> x = float_words(1031);
+    double worst = 0.0;
+    for (std::size_t n : { std::size_t(1), std::size_t(2), std::size_t(15), std::size_t(16), std::size_t(17),
+                           std::size_t(31), std::size_t(33), std::size_t(2061) }) {
+        std::vector<float> want(n), got(n + 1, -99.0f);
+        ref(x.data(), n, want.data());
+        fn(x.data(), n, got.data());
+        for (std::size_t j = 0; j < n; ++j) {
+            const float u = float(std::int32_t((std::uint32_t(x[j / 2]) >> 1) | 1u)) * 0x1p-31f;
+            const double r = std::sqrt(-2.0 * std::log(double(u)));
+            const double err = std::fabs(double(got[j]) - double(want[j])) / (r * 0x1p-24);
+            const bool same = tol_ulp == 0.0 ? std::memcmp(&got[j], &want[j], sizeof(float)) == 0 : (r == 0.0 ? got[j] == 0.0f : err <= tol_ulp);
+            if (!same || !(std::fabs(got[j]) <= 6.56f)) {
+                std::printf("FAIL normal float %s n=%zu at %zu: %a vs %a\n", name, n, j, double(got[j]), double(want[j])); ++g_fail; return;
+            }
+            if (r > 0.0) worst = std::max(worst, err);
+        }
+        if (got[n] != -99.0f) { std::printf("FAIL normal float %s n=%zu overrun\n", name, n); ++g_fail; return; }
+    }
+    if (tol_ulp == 0.0) std::printf("ok   normal float %s\n", name);
+    else std::printf("ok   normal float %s max error %.2f ulp of r\n", name, worst);
+}
+
+// the facade against the scalar kernels on the u64 of a twin generator,
+// requested piece by piece the way generate_float splits them (1024 floats,
+// (m + 1) / 2 words each); moments of the normals
+static void check_float_facade() {
+    const std::size_t n = 1 << 20;
+    std::vector<float> z(n), want(n);
+    std::vector<std::uint64_t> w(n / 2 + 8);
+    std::vector<double> d(n);
+    for (ua::Algorithm a : { ua::Algorithm::Xoshiro256ss, ua::Algorithm::Philox4x32_10 }) {
+        for (bool normal : { false, true }) {
+            ua::Rng rng(77, a), twin(77, a);
+            std::size_t i = 0;
+            for (std::size_t step : { std::size_t(1), std::size_t(5), std::size_t(1023), std::size_t(1025), n - 2054 }) {
+                if (normal) rng.generate_normal_float(z.data() + i, step);
+                else        rng.generate_float(z.data() + i, step);
+                for (std::size_t k = 0; k < step; k += 1024) {
+                    const std::size_t m = std::min<std::size_t>(1024, step - k);
+                    twin.generate_u64(w.data(), (m + 1) / 2);
+                    if (normal) ua::detail::normal_float_scalar(w.data(), m, want.data() + i + k);
+                    else        ua::detail::unit_float_scalar(w.data(), m, want.data() + i + k);
+                }
+                i += step;
+            }
+            char name[80];
+            std::snprintf(name, sizeof(name), "generate_%s algo %d tier %d", normal ? "normal_float" : "float", int(a), int(rng.simd_tier()));
+            for (std::size_t j = 0; j < n; ++j)
+                if (!(std::fabs(z[j] - want[j]) <= (normal ? 4.0 * 6.56 * 0x1p-24 : 0.0))) {
+                    std::printf("FAIL %s at %zu: %a vs %a\n", name, j, double(z[j]), double(want[j])); ++g_fail; return;
+                }
+            if (normal) {
+                for (std::size_t j = 0; j < n; ++j) d[j] = z[j];
+                check_moments(name, d.data(), n);
+                continue;
+            }
+            double m = 0, v = 0;
+            for (std::size_t j = 0; j < n; ++j) { m += z[j]; v += double(z[j]) * z[j]; }
+            m /= double(n); v = v / double(n) - m * m;
+            // sd(mean) 2.8e-4, sd(var) 7.4e-5
+            if (std::fabs(m - 0.5) > 0.0015 || std::fabs(v - 1.0 / 12) > 0.0004) {
+                std::printf("FAIL %s mean %g var %g\n", name, m, v); ++g_fail;
+            } else std::printf("ok   %s U[0,1) moments\n", name);
+        }
+    }
+}
+
+// NormalGenerator / PolarNormal / normal_icdf take the kernels of the tier a
+// default ua::Rng runs on; AVX512VL runs the AVX2 ones
+static void check_kernel_choice() {
+    const ua::SimdTier t = ua::Rng(1).simd_tier();
+    auto pick = [t](auto scalar, auto avx2, auto avx512) {
+        return t == ua::SimdTier::AVX512F ? avx512 : t == ua::SimdTier::Scalar ? scalar : avx2;
+    };
+    using namespace ua::detail;
+    if (box_muller_kernel() != pick(&box_muller_scalar, &box_muller_avx2, &box_muller_avx512) ||
+        polar_kernel() != pick(&polar_scalar, &polar_avx2, &polar_avx512) ||
+        normal_icdf_kernel() != pick(&normal_icdf_scalar, &normal_icdf_avx2, &normal_icdf_avx512)) {
+        std::printf("FAIL standalone kernels != ua::Rng tier %d\n", int(t)); ++g_fail; return;
+    }
+    std::printf("ok   standalone kernels follow ua::Rng tier %d\n", int(t));
+}
+
+int main() {
+    check_tables();
+    check_rect("scalar", [](const std::uint64_t* u, std::size_t n, double* out, std::uint32_t* rare) noexcept {
+        std::size_t nr = 0;
+        for (std::size_t j = 0; j < n; ++j)
+            if (!ua::ZigguratNormal::rect(u[j], out[j])) rare[nr++] = std::uint32_t(j);
+        return nr;
+    });
+
+    const ua::CpuFeatures f = ua::query_cpu_features();
+#if defined(UA_BUILD_WITH_AVX2)
+    if (f.avx2) check_rect("avx2", &ua::detail::ziggurat_rect_avx2);
+    else std::printf("skip avx2 (cpu)\n");
+#endif
+#if defined(UA_BUILD_WITH_AVX512)
+    if (ua::avx512_ok(f)) check_rect("avx512", &ua::detail::ziggurat_rect_avx512);
+    else std::printf("skip avx512 (cpu)\n");
+#endif
+    check_box_muller_ulp("scalar", &ua::detail::box_muller_scalar, 4.0);
+#if defined(UA_BUILD_WITH_AVX2)
+    if (f.avx2 && f.fma) {
+        check_box_muller("avx2 ~ scalar", &ua::detail::box_muller_avx2, &ua::detail::box_muller_scalar, 8.0);
+        check_box_muller_ulp("avx2", &ua::detail::box_muller_avx2, 3.0);
+    }
+#endif
+#if defined(UA_BUILD_WITH_AVX512)
+    if (ua::avx512_ok(f)) {
+        check_box_muller("avx512 ~ scalar", &ua::detail::box_muller_avx512, &ua::detail::box_muller_scalar, 8.0);
+#if defined(UA_BUILD_WITH_AVX2)
+        check_box_muller("avx512 == avx2", &ua::detail::box_muller_avx512, &ua::detail::box_muller_avx2, 0.0);
+#endif
+    }
+#endif
+#if defined(UA_BUILD_WITH_AVX2)
+    if (f.avx2 && f.fma) check_polar("avx2 ~ scalar", &ua::detail::polar_avx2, &ua::detail::polar_scalar, 4.0);
+#endif
+#if defined(UA_BUILD_WITH_AVX512)
+    if (ua::avx512_ok(f)) {
+        check_polar("avx512 ~ scalar", &ua::detail::polar_avx512, &ua::detail::polar_scalar, 4.0);
+#if defined(UA_BUILD_WITH_AVX2)
+        check_polar("avx512 == avx2", &ua::detail::polar_avx512, &ua::detail::polar_avx2, 0.0);
+#endif
+    }
+#endif
+    check_icdf_accuracy("scalar", &ua::detail::normal_icdf_scalar, 8.0);
+#if defined(UA_BUILD_WITH_AVX2)
+    if (f.avx2 && f.fma) {
+        check_icdf("avx2 ~ scalar", &ua::detail::normal_icdf_avx2, &ua::detail::normal_icdf_scalar, 8.0);
+        check_icdf_accuracy("avx2", &ua::detail::normal_icdf_avx2, 8.0);
+    }
+#endif
+#if defined(UA_BUILD_WITH_AVX512)
+    if (ua::avx512_ok(f)) {
+        check_icdf("avx512 ~ scalar", &ua::detail::normal_icdf_avx512, &ua::detail::normal_icdf_scalar, 8.0);
+#if defined(UA_BUILD_WITH_AVX2)
+        check_icdf("avx512 == avx2", &ua::detail::normal_icdf_avx512, &ua::detail::normal_icdf_avx2, 0.0);
+#endif
+    }
+#endif
+    check_unit_float("scalar", &ua::detail::unit_float_scalar);
+#if defined(UA_BUILD_WITH_AVX2)
+    if (f.avx2 && f.fma) {
+        check_unit_float("avx2", &ua::detail::unit_float_avx2);
+        check_normal_float("avx2 ~ scalar", &ua::detail::normal_float_avx2, &ua::detail::normal_float_scalar, 4.0);
+    }
+#endif
+#if defined(UA_BUILD_WITH_AVX512)
+    if (ua::avx512_ok(f)) {
+        check_unit_float("avx512", &ua::detail::unit_float_avx512);
+        check_normal_float("avx512 ~ scalar", &ua::detail::normal_float_avx512, &ua::detail::normal_float_scalar, 4.0);
+#if defined(UA_BUILD_WITH_AVX2)
+        check_normal_float("avx512 == avx2", &ua::detail::normal_float_avx512, &ua::detail::normal_float_avx2, 0.0);
+#endif
+    }
+#endif
+    (void)f;
+    check_facade();
+    check_kernel_choice();
+    check_normal_generator();
+    check_polar_normal();
+    check_normal_icdf_facade();
+    check_float_facade();
+    return g_fail ? 1 : 0;
+}
@@ -0,0 +1,115 @@
+// PCG64-DXSM: NumPy parity (SeedSequence seeding, random_raw, advance,
+// jumped, Generator.random) and the multi-lane backends against the scalar
+// stream for arbitrary n, tails included. Reference values come from
+// numpy.random.PCG64DXSM.
+#include <cstdio>
+#include <cstdint>
+
+#include "ua/ua_cpuid.h"
+#include "ua/ua_rng.h"
+#include "ua/ua_pcg64_dxsm.h"
+
+static int g_fail = 0;
+
+static void check_numpy() {
+    struct Kat { std::uint64_t seed, s_hi, s_lo, raw[4]; };
+    static const Kat kats[] = {
+        { 0, 0x1aa1b5345996452dull, 0x09585eb7a69561e3ull,
+          {0xd97e4a147f788a70ull, 0x8dfa7bce56e3a253ull, 0x13556ed9f53d3c10ull, 0x55dbf1c241341e98ull} },
+        { 12345, 0x1905e0335aae9634ull, 0x9199b0d09775add5ull,
+          {0xee9ce7d91fd0146full, 0x5666c45f046a0883ull, 0x378c2161cf28e2bdull, 0x5a4af4efd795681eull} },
+        { 0xdeadbeefcafef00dull, 0xfeb9db61fb796566ull, 0x1692db4a627741fdull,
+          {0x9b58f60727c37fb7ull, 0x00820e09008549aeull, 0x5333ad346431ab7dull, 0xf5037ccf0633a606ull} },
+    };
+    for (const Kat& k : kats) {
+        ua::detail::Pcg64DxsmScalar g(k.seed);
+        if (g.s_hi != k.s_hi || g.s_lo != k.s_lo) { std::printf("FAIL pcg64 seeding %llu\n", (unsigned long long)k.seed); ++g_fail; return; }
+        for (int i = 0; i < 4; ++i) {
+            if (g.next() != k.raw[i]) { std::printf("FAIL pcg64 random_raw %llu\n", (unsigned long long)k.seed); ++g_fail; return; }
+        }
+    }
+    {
+        ua::detail::Pcg64DxsmScalar g(12345);
+        g.advance(1000003);
+        if (g.next() != 0xbe814501a2ea949dull || g.next() != 0x8141cd8c3763d78dull) { std::printf("FAIL pcg64 advance\n"); ++g_fail; }
+    }
+    {
+        ua::detail::Pcg64DxsmScalar g(12345);
+        g.jump();
+        if (g.next() != 0xa76015e245a5ae49ull) { std::printf("FAIL pcg64 jumped(1)\n"); ++g_fail; }
+        ua::detail::Pcg64DxsmScalar h(12345);
+        h.jump(); h.jump(); h.jump();
+        if (h.next() != 0x389c0197bc891677ull) { std::printf("FAIL pcg64 jumped(3)\n"); ++g_fail; }
+    }
+    {
+        // Generator(PCG64DXSM(12345)).random(3)
+        static const double want[3] = { 0.9320816903198763, 0.3375056011176768, 0.21698197019501064 };
+        ua::detail::Pcg64DxsmScalar g(12345);
+        double d[3];
+        g.generate_double(d, 3);
+        for (int i = 0; i < 3; ++i) if (d[i] != want[i]) { std::printf("FAIL pcg64 random() %d\n", i); ++g_fail; break; }
+    }
+    if (!g_fail) std::printf("ok   pcg64 NumPy seeding / raw / advance / jumped / random\n");
+}
+
+// uneven call sizes must still give the scalar stream (tails advance lanes)
+template<class G>
+static void check_backend(const char* name) {
+    static const std::size_t sizes[] = { 1, 7, 64, 3, 13, 200, 5 };
+    G g(987654321);
+    ua::detail::Pcg64DxsmScalar ref(987654321);
+    std::uint64_t got[256], want[256];
+    for (std::size_t n : sizes) {
+        g.generate_u64(got, n);
+        ref.generate_u64(want, n);
+        for (std::size_t i = 0; i < n; ++i)
+            if (got[i] != want[i]) { std::printf("FAIL %s u64 (n=%zu, i=%zu)\n", name, n, i); ++g_fail; return; }
+    }
+    g.advance(123456789, 3);
+    ref.advance(123456789, 3);
+    double gd[301], wd[301];
+    g.generate_double(gd, 301);
+    ref.generate_double(wd, 301);
+    for (int i = 0; i < 301; ++i)
+        if (gd[i] != wd[i]) { std::printf("FAIL %s double %d\n", name, i); ++g_fail; return; }
+    g.jump(); ref.jump();
+    g.generate_u64(got, 33);
+    ref.generate_u64(want, 33);
+    for (int i = 0; i < 33; ++i)
+        if (got[i] != want[i]) { std::printf("FAIL %s jump\n", name); ++g_fail; return; }
+    std::printf("ok   pcg64 %s == scalar (tails, advance, jump)\n", name);
+}
+
+static void check_facade() {
+    std::uint64_t got[37], want[37];
+    ua::Rng rng(12345, ua::Algorithm::Pcg64Dxsm);
+    ua::detail::Pcg64DxsmScalar ref(12345);
+    rng.generate_u64(got, 37);
+    ref.generate_u64(want, 37);
+    for (int i = 0; i < 37; ++i) {
+        if (got[i] != want[i]) { std::printf("FAIL ua::Rng pcg64 u64 %d\n", i); ++g_fail; return; }
+    }
+    double z[1024];
+    rng.generate_normal(z, 1024);
+    double m = 0;
+    for (double v : z) m += v;
+    if (m / 1024 > 0.2 || m / 1024 < -0.2) { std::printf("FAIL ua::Rng pcg64 normal mean\n"); ++g_fail; return; }
+    std::printf("ok   ua::Rng pcg64 (tier %d) matches scalar\n", int(rng.simd_tier()));
+}
+
+int main() {
+    check_numpy();
+    check_facade();
+
+    const ua::CpuFeatures f = ua::query_cpu_features();
+#if defined(UA_BUILD_WITH_AVX2)
+    if (f.avx2) check_backend<ua::detail::Pcg64DxsmAVX2>("avx2");
+    else std::printf("skip avx2 (cpu)\n");
+#endif
+#if defined(UA_BUILD_WITH_AVX512)
+    if (ua::avx512_ok(f)) check_backend<ua::detail::Pcg64DxsmAVX512>("avx512");
+    else std::printf("skip avx512 (cpu)\n");
+#endif
+    (void)f;
+    return g_fail ? 1 : 0;
+}
@@ -0,0 +1,185 @@
+// Philox4x32 backends: Random123 known answers, stream == random access, and
+// 128-bit counter carries (c0 -> c1 -> c2 -> c3) under skip_ahead_blocks().
+// Built with AVX2 flags (header-only AVX2 backend); SIMD checks are skipped
+// on CPUs without the ISA. Every tier must produce the scalar stream.
+#include <cstdio>
+#include <cstdint>
+
+#include "ua/ua_cpuid.h"
+#include "ua/ua_rng.h"
+#include "ua/ua_philox4x32_scalar.h"
+#include "ua/ua_philox4x32_avx2.h"
+#if defined(UA_BUILD_WITH_AVX512)
+  #include "ua/ua_philox4x32_avx512.h"
+#endif
+
+static int g_fail = 0;
+
+static void check_kat() {
+    struct Kat { std::uint32_t ctr[4], key[2], out[4]; };
+    static const Kat kats[] = {
+        { {0,0,0,0}, {0,0}, {0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u} },
+        { {0xffffffffu,0xffffffffu,0xffffffffu,0xffffffffu}, {0xffffffffu,0xffffffffu},
+          {0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu} },
+        { {0x243f6a88u,0x85a308d3u,0x13198a2eu,0x03707344u}, {0xa4093822u,0x299f31d0u},
+          {0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u} },
+    };
+    for (const Kat& k : kats) {
+        std::uint32_t out[4];
+        ua::philox4x32_10(k.ctr, k.key, out);
+        for (int w = 0; w < 4; ++w) {
+            if (out[w] != k.out[w]) { std::printf("FAIL philox KAT word %d\n", w); ++g_fail; return; }
+        }
+    }
+    std::printf("ok   philox4x32_10 known answers\n");
+}
+
+// n u64 from the vector stream must equal blocks base, base+1, ... via block_at
+template<class G>
+static bool stream_matches(G& g, std::uint64_t lo, std::uint64_t hi, std::size_t n) {
+    std::uint64_t buf[80];
+    g.generate_u64(buf, n);
+    for (std::size_t j = 0; 2 * j < n; ++j) {
+        std::uint64_t blo = lo + j, bhi = hi + (blo < lo ? 1 : 0);
+        std::uint32_t o[4];
+        g.block_at(blo, bhi, o);
+        const std::uint64_t a = (std::uint64_t(o[1]) << 32) | o[0];
+        const std::uint64_t b = (std::uint64_t(o[3]) << 32) | o[2];
+        if (buf[2 * j] != a || (2 * j + 1 < n && buf[2 * j + 1] != b)) return false;
+    }
+    return true;
+}
+
+// land a few blocks before each 32-bit word boundary so a vector step carries
+struct Case { std::uint64_t lo, hi; const char* what; };
+static const Case kCarry[] = {
+    { 0x00000000fffffffbull, 0,                     "c0 -> c1" },
+    { 0xfffffffffffffffdull, 0,                     "c1 -> c2" },
+    { 0xfffffffffffffffaull, 0x00000000ffffffffull, "c2 -> c3" },
+};
+
+template<class G>
+static void check_backend(const char* name) {
+    int fails = g_fail;
+    {
+        G g(2024);
+        if (!stream_matches(g, 0, 0, 80)) { std::printf("FAIL %s stream != block_at\n", name); ++g_fail; }
+    }
+    for (const Case& c : kCarry) {
+        G g(77);
+        g.skip_ahead_blocks(c.lo, c.hi);
+        if (!stream_matches(g, c.lo, c.hi, 64)) { std::printf("FAIL %s carry %s\n", name, c.what); ++g_fail; }
+    }
+    {
+        // jump() == 2^64 blocks
+        G g(5);
+        g.jump();
+        if (!stream_matches(g, 0, 1, 64)) { std::printf("FAIL %s jump\n", name); ++g_fail; }
+    }
+    if (fails == g_fail) std::printf("ok   philox %s stream / carries / jump\n", name);
+}
+
+// Odd, split requests: u64 and double calls of sizes that cut the step,
+// skip_ahead_blocks() and jump() from the middle of a block. The stream must
+// still be blocks in counter order (block_at), whatever the tier's step.
+static const std::size_t kSplit[] = { 5, 8, 1, 3, 37, 2, 64, 13, 33, 31 };
+
+template<class G>
+static void check_split(const char* name) {
+    G g(42);
+    std::uint64_t pos = 0, bhi = 0;   // stream position: word pos of block row bhi*2^64
+    auto want = [&](std::uint64_t p) {
+        std::uint32_t o[4];
+        g.block_at(p / 2, bhi, o);
+        return p & 1 ? (std::uint64_t(o[3]) << 32) | o[2] : (std::uint64_t(o[1]) << 32) | o[0];
+    };
+    for (int round = 0; round < 3; ++round) {
+        for (std::size_t k = 0; k < sizeof(kSplit) / sizeof(kSplit[0]); ++k) {
+            const std::size_t n = kSplit[k];
+            std::uint64_t u[64];
+            double d[64];
+            if (k & 1) g.generate_double(d, n);
+            else       g.generate_u64(u, n);
+            for (std::size_t j = 0; j < n; ++j) {
+                const std::uint64_t w = want(pos + j);
+                const bool ok = k & 1 ? d[j] == double(w >> 12) * 0x1p-52 : u[j] == w;
+                if (!ok) { std::printf("FAIL philox %s split round %d call %zu word %zu\n", name, round, k, j); ++g_fail; return; }
+            }
+            pos += n;
+        }
+        if (round == 0) { g.skip_ahead_blocks(1001); pos += 2002; }
+        if (round == 1) { g.jump(); bhi = 1; }
+    }
+    std::printf("ok   philox %s split odd requests\n", name);
+}
+
+// the facade must give the scalar u64/double stream whatever tier it picked,
+// also when the requests cut its step
+static void check_facade() {
+    std::uint64_t got[96], want[96];
+    double gd[64], wd[64];
+    ua::Rng rng(31337, ua::Algorithm::Philox4x32_10);
+    ua::detail::Philox4x32Scalar ref(31337);
+    for (std::size_t i = 0, k = 0; i < 96; i += kSplit[k], ++k) {
+        const std::size_t n = 96 - i < kSplit[k] ? 96 - i : kSplit[k];
+        rng.generate_u64(got + i, n);
+    }
+    ref.generate_u64(want, 96);
+    rng.skip_ahead(1000);
+    ref.skip_ahead_blocks(1000);
+    rng.generate_double(gd, 64);
+    ref.generate_double(wd, 64);
+    for (int i = 0; i < 96; ++i) {
+        if (got[i] != want[i]) { std::printf("FAIL ua::Rng philox u64 %d\n", i); ++g_fail; return; }
+    }
+    for (int i = 0; i < 64; ++i) {
+        if (gd[i] != wd[i]) { std::printf("FAIL ua::Rng philox double %d\n", i); ++g_fail; return; }
+    }
+    double z[1000];
+    rng.generate_normal(z, 1000);
+    double m = 0;
+    for (double v : z) m += v;
+    if (m / 1000 > 0.2 || m / 1000 < -0.2) { std::printf("FAIL ua::Rng philox normal mean\n"); ++g_fail; return; }
+    std::printf("ok   ua::Rng philox (tier %d) matches scalar\n", int(rng.simd_tier()));
+}
+
+int main() {
+    check_kat();
+
+    check_backend<ua::detail::Philox4x32Scalar>("scalar");
+    check_split<ua::detail::Philox4x32Scalar>("scalar");
+    check_facade();
+
+    const ua::CpuFeatures f = ua::query_cpu_features();
+#if defined(UA_BUILD_WITH_AVX512)
+    if (ua::avx512_ok(f)) {
+        check_backend<ua::detail::Philox4x32AVX512>("avx512");
+        check_split<ua::detail::Philox4x32AVX512>("avx512");
+    }
+    else std::printf("skip avx512 (cpu)\n");
+#endif
+
+    if (!f.avx2) {
+        std::printf("skip avx2 (cpu)\n");
+        return g_fail ? 1 : 0;
+    }
+
+    {
+        ua::Philox4x32AVX2 g(2024);
+        if (!stream_matches(g, 0, 0, 80)) { std::printf("FAIL stream != block_at\n"); ++g_fail; }
+        // 80 u64 = 40 blocks = 5 whole steps; then an odd tail
+        if (!stream_matches(g, 40, 0, 37)) { std::printf("FAIL odd tail\n"); ++g_fail; }
+    }
+
+    for (const Case& c : kCarry) {
+        ua::Philox4x32AVX2 g(77);
+        g.skip_ahead_blocks(c.lo, c.hi);
+        if (!stream_matches(g, c.lo, c.hi, 64)) { std::printf("FAIL carry %s\n", c.what); ++g_fail; }
+        else std::printf("ok   carry %s\n", c.what);
+    }
+
+    check_split<ua::Philox4x32AVX2>("avx2");
+
+    if (!g_fail) std::printf("ok   philox avx2 stream / skip_ahead_blocks\n");
+    return g_fail ? 1 : 0;
+}